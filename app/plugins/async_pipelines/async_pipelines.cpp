@@ -0,0 +1,97 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async_pipelines.h"
+
+#include <core/util/thread_pool.hpp>
+
+#include "core/device.h"
+#include "rendering/render_context.h"
+
+namespace plugins
+{
+AsyncPipelines::AsyncPipelines() :
+    AsyncPipelinesTags("Async Pipelines",
+                       "Compile pipelines on worker threads instead of in the draws that need them.",
+                       {vkb::Hook::PostDraw, vkb::Hook::OnAppClose},
+                       {},
+                       {{"async-pipelines", "What draws do until their pipeline is compiled: wait, skip or fallback"}})
+{
+}
+
+AsyncPipelines::~AsyncPipelines() = default;
+
+bool AsyncPipelines::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "async-pipelines")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"async-pipelines\" is missing the compile mode!");
+			return false;
+		}
+
+		if (arguments[1] == "wait")
+		{
+			mode = vkb::PipelineCompileMode::Wait;
+		}
+		else if (arguments[1] == "skip")
+		{
+			mode = vkb::PipelineCompileMode::Skip;
+		}
+		else if (arguments[1] == "fallback")
+		{
+			mode = vkb::PipelineCompileMode::Fallback;
+		}
+		else
+		{
+			LOGE("Unknown compile mode \"{}\" for option \"async-pipelines\", expected wait, skip or fallback", arguments[1]);
+			return false;
+		}
+
+		thread_pool = std::make_unique<vkb::ThreadPool>();
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void AsyncPipelines::on_post_draw(vkb::rendering::RenderContextC &context)
+{
+	// The device only exists once the application is prepared, so the cache is set up after the first frame
+	if (!resource_cache && thread_pool)
+	{
+		resource_cache = &context.get_device().get_resource_cache();
+		resource_cache->set_async_pipeline_compilation(thread_pool.get(), mode);
+	}
+}
+
+void AsyncPipelines::on_app_close(const std::string &app_info)
+{
+	if (resource_cache)
+	{
+		// Waits for the pipelines still compiling, the next application gets a new device and cache
+		resource_cache->set_async_pipeline_compilation(nullptr);
+		resource_cache->merge_pipeline_caches();
+		resource_cache = nullptr;
+	}
+}
+}        // namespace plugins
@@ -0,0 +1,65 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "platform/plugins/plugin_base.h"
+#include "resource_cache.h"
+
+namespace vkb
+{
+class ThreadPool;
+}
+
+namespace plugins
+{
+using AsyncPipelinesTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Async Pipelines
+ *
+ * Compiles the pipelines that draws miss on a pool of worker threads, so that new pipelines don't stall the frame.
+ * Until a pipeline is compiled its draws wait, are skipped, or use the fallback pipeline the sample registered.
+ * Enable the pipeline_compile_time and pipeline_stall_frames stats to see the effect.
+ *
+ * Usage: vulkan_sample sample afbc --async-pipelines skip
+ *
+ */
+class AsyncPipelines : public AsyncPipelinesTags
+{
+  public:
+	AsyncPipelines();
+
+	virtual ~AsyncPipelines();
+
+	virtual void on_post_draw(vkb::rendering::RenderContextC &context) override;
+
+	virtual void on_app_close(const std::string &app_info) override;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+  private:
+	vkb::PipelineCompileMode mode{vkb::PipelineCompileMode::Skip};
+
+	std::unique_ptr<vkb::ThreadPool> thread_pool;
+
+	/// The cache of the running application, once its first frame is drawn
+	vkb::ResourceCache *resource_cache{nullptr};
+};
+}        // namespace plugins
@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -18,16 +18,78 @@
 
 #include "benchmark_mode.h"
 
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "filesystem/filesystem.hpp"
 #include "platform/platform.h"
+#include "vulkan_sample.h"
 
 namespace plugins
 {
+namespace
+{
+// Frames per run when several runs are requested without a length
+constexpr uint32_t DEFAULT_FRAMES_PER_RUN = 1000;
+
+std::string to_json(const BenchmarkMode::FrameTimeSummary &summary)
+{
+	if (summary.frame_count == 0)
+	{
+		return "null";
+	}
+
+	return fmt::format("{{\"frames\": {}, \"mean_ms\": {:.3f}, \"min_ms\": {:.3f}, \"p50_ms\": {:.3f}, \"p95_ms\": {:.3f}, \"p99_ms\": {:.3f}, \"max_ms\": {:.3f}, \"histogram\": [{}]}}",
+	                   summary.frame_count, summary.mean, summary.min, summary.p50, summary.p95, summary.p99, summary.max, fmt::join(summary.histogram, ", "));
+}
+
+std::string to_json(const BenchmarkMode::Result &result)
+{
+	std::string runs;
+	for (size_t i = 0; i < result.cpu_runs.size(); ++i)
+	{
+		runs += fmt::format("{}\n    {{\"cpu\": {}, \"gpu\": {}}}", i > 0 ? "," : "", to_json(result.cpu_runs[i]), to_json(result.gpu_runs[i]));
+	}
+
+	return fmt::format("{{\n  \"sample\": \"{}\",\n  \"histogram_bounds_ms\": [{}],\n  \"cpu\": {},\n  \"gpu\": {},\n  \"run_mean_stddev_ms\": {{\"cpu\": {:.3f}, \"gpu\": {:.3f}}},\n  \"runs\": [{}\n  ]\n}}",
+	                   result.app_id,
+	                   fmt::join(vkb::FRAME_TIME_HISTOGRAM_BOUNDS_MS, ", "),
+	                   to_json(result.cpu),
+	                   to_json(result.gpu),
+	                   result.cpu_run_stddev,
+	                   result.gpu_run_stddev,
+	                   runs);
+}
+
+/**
+ * @brief Calls a function with the stats of an application, if it is a vulkan sample
+ */
+template <typename Function>
+void with_stats(vkb::Application &app, Function &&function)
+{
+	if (auto *sample = dynamic_cast<vkb::VulkanSampleC *>(&app))
+	{
+		function(sample->get_stats());
+	}
+	else if (auto *sample = dynamic_cast<vkb::VulkanSampleCpp *>(&app))
+	{
+		function(sample->get_stats());
+	}
+}
+}        // namespace
+
 BenchmarkMode::BenchmarkMode() :
     BenchmarkModeTags("Benchmark Mode",
-                      "Log frame averages after running an app.",
-                      {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose},
+                      "Measure the frame times of an app and report their distribution when it closes.",
+                      {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose, vkb::Hook::PostDraw, vkb::Hook::OnPlatformClose},
                       {},
-                      {{"benchmark", "Enable benchmark mode"}})
+                      {{"benchmark", "Enable benchmark mode"},
+                       {"benchmark-warmup", "Number of frames to run before measuring, 60 by default, implies --benchmark"},
+                       {"benchmark-frames", "Number of frames of each run, the app closes after the last run unless another plugin controls it, implies --benchmark"},
+                       {"benchmark-runs", "Number of runs to measure the variance across, 1000 frames each unless --benchmark-frames is given, implies --benchmark"},
+                       {"benchmark-report", "Write a JSON and a CSV report of each app, and a summary of all of them, to the given folder, implies --benchmark"}})
 {
 }
 
@@ -37,32 +99,264 @@ bool BenchmarkMode::handle_option(std::deque<std::string> &arguments)
 	std::string option = arguments[0].substr(2);
 	if (option == "benchmark")
 	{
-		// Whilst in benchmark mode fix the fps so that separate runs are consistently simulated
-		// This will effect the graph outputs of framerate
-		platform->force_simulation_fps(60.0f);
-		platform->force_render(true);
+		enable();
 
 		arguments.pop_front();
 		return true;
 	}
+	else if (option == "benchmark-warmup" || option == "benchmark-frames" || option == "benchmark-runs" || option == "benchmark-report")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"{}\" is missing the actual value!", option);
+			return false;
+		}
+
+		if (option == "benchmark-warmup")
+		{
+			warmup_frames = static_cast<uint32_t>(std::stoul(arguments[1]));
+		}
+		else if (option == "benchmark-frames")
+		{
+			frames_per_run = static_cast<uint32_t>(std::stoul(arguments[1]));
+		}
+		else if (option == "benchmark-runs")
+		{
+			run_count = std::max(1u, static_cast<uint32_t>(std::stoul(arguments[1])));
+		}
+		else
+		{
+			report_directory = arguments[1];
+		}
+
+		enable();
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
 	return false;
 }
 
+void BenchmarkMode::enable()
+{
+	// Whilst in benchmark mode fix the fps so that separate runs are consistently simulated
+	// This will effect the graph outputs of framerate
+	platform->force_simulation_fps(60.0f);
+	platform->force_render(true);
+}
+
 void BenchmarkMode::on_update(float delta_time)
 {
-	elapsed_time += delta_time;
-	total_frames++;
+	// The delta time of the hook is the wall-clock time of the last frame, the fixed simulation time is only applied after it
+	if (app_id.empty() || runs_complete)
+	{
+		return;
+	}
+
+	if (remaining_warmup_frames > 0)
+	{
+		remaining_warmup_frames--;
+		return;
+	}
+
+	if (runs.empty() || (frames_per_run > 0 && runs.back().cpu_frame_times.size() >= frames_per_run))
+	{
+		if (frames_per_run > 0 && runs.size() == run_count)
+		{
+			runs_complete = true;
+
+			// Plugins with full control, such as batch mode, decide themselves when to move on
+			if (!platform->using_plugin<vkb::tags::FullControl>())
+			{
+				platform->close();
+			}
+			return;
+		}
+
+		runs.emplace_back();
+		runs.back().cpu_frame_times.reserve(frames_per_run);
+		runs.back().gpu_frame_times.reserve(frames_per_run);
+	}
+
+	runs.back().cpu_frame_times.push_back(delta_time);
+}
+
+void BenchmarkMode::on_post_draw(vkb::rendering::RenderContextC &context)
+{
+	if (app_id.empty() || runs_complete || runs.empty())
+	{
+		return;
+	}
+
+	with_stats(platform->get_app(), [this](auto &stats) {
+		if (auto gpu_frame_time = stats.get_gpu_frame_time())
+		{
+			runs.back().gpu_frame_times.push_back(*gpu_frame_time);
+		}
+	});
 }
 
-void BenchmarkMode::on_app_start(const std::string &app_id)
+void BenchmarkMode::on_app_start(const std::string &app_info)
 {
-	elapsed_time = 0;
-	total_frames = 0;
+	// Batch mode starts the next app without closing the previous one
+	finish_benchmark();
+
+	app_id                  = app_info;
+	remaining_warmup_frames = warmup_frames;
+	runs_complete           = false;
+	runs.clear();
+
+	if (run_count > 1 && frames_per_run == 0)
+	{
+		frames_per_run = DEFAULT_FRAMES_PER_RUN;
+	}
+
+	with_stats(platform->get_app(), [](auto &stats) { stats.enable_gpu_frame_timing(); });
+
 	LOGI("Starting Benchmark for {}", app_id);
 }
 
-void BenchmarkMode::on_app_close(const std::string &app_id)
+void BenchmarkMode::on_app_close(const std::string &app_info)
+{
+	finish_benchmark();
+}
+
+void BenchmarkMode::on_platform_close()
+{
+	finish_benchmark();
+
+	if (!report_directory.empty() && !results.empty())
+	{
+		write_summary_reports();
+	}
+}
+
+void BenchmarkMode::finish_benchmark()
 {
-	LOGI("Benchmark for {} completed in {} seconds (ran {} frames, averaged {} fps)", app_id, elapsed_time, total_frames, total_frames / elapsed_time);
+	if (app_id.empty())
+	{
+		return;
+	}
+
+	Result result;
+	result.app_id = app_id;
+	result.runs   = std::move(runs);
+
+	std::vector<float> cpu_frame_times;
+	std::vector<float> gpu_frame_times;
+	for (auto &run : result.runs)
+	{
+		cpu_frame_times.insert(cpu_frame_times.end(), run.cpu_frame_times.begin(), run.cpu_frame_times.end());
+		gpu_frame_times.insert(gpu_frame_times.end(), run.gpu_frame_times.begin(), run.gpu_frame_times.end());
+
+		result.cpu_runs.push_back(vkb::summarize_frame_times(run.cpu_frame_times));
+		result.gpu_runs.push_back(vkb::summarize_frame_times(run.gpu_frame_times));
+	}
+
+	result.cpu            = vkb::summarize_frame_times(std::move(cpu_frame_times));
+	result.gpu            = vkb::summarize_frame_times(std::move(gpu_frame_times));
+	result.cpu_run_stddev = vkb::get_mean_stddev(result.cpu_runs);
+	result.gpu_run_stddev = vkb::get_mean_stddev(result.gpu_runs);
+
+	app_id.clear();
+	runs.clear();
+
+	if (result.cpu.frame_count == 0)
+	{
+		LOGW("Benchmark for {} closed before any frame was measured", result.app_id);
+		return;
+	}
+
+	auto &cpu = result.cpu;
+	LOGI("Benchmark for {} completed, measured {} frames in {} runs after {} warm-up frames", result.app_id, cpu.frame_count, result.runs.size(), warmup_frames);
+	LOGI("CPU frame time: mean {:.2f} ms ({:.1f} fps), p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms, run to run deviation {:.2f} ms",
+	     cpu.mean, 1000.0f / cpu.mean, cpu.p50, cpu.p95, cpu.p99, cpu.max, result.cpu_run_stddev);
+
+	if (auto &gpu = result.gpu; gpu.frame_count > 0)
+	{
+		LOGI("GPU frame time: mean {:.2f} ms, p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms, run to run deviation {:.2f} ms",
+		     gpu.mean, gpu.p50, gpu.p95, gpu.p99, gpu.max, result.gpu_run_stddev);
+	}
+
+	if (!report_directory.empty())
+	{
+		write_reports(result);
+	}
+
+	// The frame times are only written to the report of the app
+	result.runs.clear();
+	results.push_back(std::move(result));
+}
+
+void BenchmarkMode::write_reports(const Result &result) const
+{
+	auto fs = vkb::filesystem::get();
+	fs->create_directory(report_directory);
+
+	// One row per frame, GPU times are read a few frames late so a run can have a few less than CPU times
+	std::string csv = "run,frame,cpu_ms,gpu_ms\n";
+	for (size_t run = 0; run < result.runs.size(); ++run)
+	{
+		auto &cpu_frame_times = result.runs[run].cpu_frame_times;
+		auto &gpu_frame_times = result.runs[run].gpu_frame_times;
+		for (size_t frame = 0; frame < std::max(cpu_frame_times.size(), gpu_frame_times.size()); ++frame)
+		{
+			csv += fmt::format("{},{},", run, frame);
+			if (frame < cpu_frame_times.size())
+			{
+				csv += fmt::format("{:.3f}", cpu_frame_times[frame] * 1000.0f);
+			}
+			csv += ",";
+			if (frame < gpu_frame_times.size())
+			{
+				csv += fmt::format("{:.3f}", gpu_frame_times[frame] * 1000.0f);
+			}
+			csv += "\n";
+		}
+	}
+
+	vkb::filesystem::Path directory{report_directory};
+	fs->write_file(directory / (result.app_id + ".json"), to_json(result) + "\n");
+	fs->write_file(directory / (result.app_id + ".csv"), csv);
+
+	LOGI("Benchmark report written to {}", (directory / (result.app_id + ".json")).string());
+}
+
+void BenchmarkMode::write_summary_reports() const
+{
+	auto fs = vkb::filesystem::get();
+	fs->create_directory(report_directory);
+
+	std::string json = "[\n";
+	std::string csv  = "sample,runs,frames,cpu_mean_ms,cpu_p50_ms,cpu_p95_ms,cpu_p99_ms,cpu_max_ms,cpu_run_stddev_ms,"
+	                   "gpu_mean_ms,gpu_p50_ms,gpu_p95_ms,gpu_p99_ms,gpu_max_ms,gpu_run_stddev_ms\n";
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		auto &result = results[i];
+		auto &cpu    = result.cpu;
+		auto &gpu    = result.gpu;
+
+		json += (i > 0 ? ",\n" : "") + to_json(result);
+
+		csv += fmt::format("{},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},",
+		                   result.app_id, result.cpu_runs.size(), cpu.frame_count, cpu.mean, cpu.p50, cpu.p95, cpu.p99, cpu.max, result.cpu_run_stddev);
+		if (gpu.frame_count > 0)
+		{
+			csv += fmt::format("{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}\n", gpu.mean, gpu.p50, gpu.p95, gpu.p99, gpu.max, result.gpu_run_stddev);
+		}
+		else
+		{
+			csv += ",,,,,\n";
+		}
+	}
+	json += "\n]\n";
+
+	vkb::filesystem::Path directory{report_directory};
+	fs->write_file(directory / "summary.json", json);
+	fs->write_file(directory / "summary.csv", csv);
+
+	LOGI("Benchmark summary of {} apps written to {}", results.size(), (directory / "summary.csv").string());
 }
 }        // namespace plugins
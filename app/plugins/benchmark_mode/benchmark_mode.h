@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "platform/plugins/plugin_base.h"
+#include "stats/frame_time_summary.h"
 
 namespace plugins
 {
@@ -29,9 +30,16 @@ using BenchmarkModeTags = vkb::PluginBase<BenchmarkMode, vkb::tags::Passive>;
 /**
  * @brief Benchmark Mode
  *
- * When enabled frame time statistics of a samples run will be printed to the console when an application closes. The simulation frame time (delta time) is also locked to 60FPS so that statistics can be compared more accurately across different devices.
+ * When enabled the wall-clock CPU time and, for samples that record their frames through vkb::VulkanSample, the GPU time
+ * of every frame is captured. The first frames are skipped as a warm-up, and the rest is split into runs of a fixed number
+ * of frames. When an application closes the mean, percentiles, maximum and histogram of its frame times are logged, and
+ * optionally written to a JSON and a CSV report. Combined with batch mode a summary report of all the samples is written
+ * when the platform closes. The simulation frame time (delta time) is also locked to 60FPS so that separate runs are
+ * simulated the same.
  *
  * Usage: vulkan_samples sample afbc --benchmark
+ *        vulkan_samples sample afbc --benchmark-runs 5 --benchmark-frames 1000 --benchmark-report reports
+ *        vulkan_samples batch --category performance --duration 20 --benchmark-report reports
  *
  */
 class BenchmarkMode : public BenchmarkModeTags
@@ -44,11 +52,80 @@ class BenchmarkMode : public BenchmarkModeTags
 	virtual void on_update(float delta_time) override;
 	virtual void on_app_start(const std::string &app_info) override;
 	virtual void on_app_close(const std::string &app_info) override;
+	virtual void on_post_draw(vkb::rendering::RenderContextC &context) override;
+	virtual void on_platform_close() override;
 
 	bool handle_option(std::deque<std::string> &arguments) override;
 
+	using FrameTimeSummary = vkb::FrameTimeSummary;
+
+	/**
+	 * @brief Frame times of one run, in seconds. GPU times are only captured for some samples.
+	 */
+	struct Run
+	{
+		std::vector<float> cpu_frame_times;
+
+		std::vector<float> gpu_frame_times;
+	};
+
+	/**
+	 * @brief The results of the benchmark of one application
+	 */
+	struct Result
+	{
+		std::string app_id;
+
+		std::vector<Run> runs;
+
+		/// Summaries of the frames of all the runs
+		FrameTimeSummary cpu;
+
+		FrameTimeSummary gpu;
+
+		/// Summaries of each run
+		std::vector<FrameTimeSummary> cpu_runs;
+
+		std::vector<FrameTimeSummary> gpu_runs;
+
+		/// Standard deviation of the mean frame times of the runs, in milliseconds
+		float cpu_run_stddev{0.0f};
+
+		float gpu_run_stddev{0.0f};
+	};
+
   private:
-	float    elapsed_time = 0.0f;
-	uint32_t total_frames = 0;
+	void enable();
+
+	/// Summarizes the runs of the current application, logs them and writes its reports
+	void finish_benchmark();
+
+	void write_reports(const Result &result) const;
+
+	void write_summary_reports() const;
+
+	/// Number of frames of each application that are not measured
+	uint32_t warmup_frames{60};
+
+	/// Number of frames of each run, 0 to measure until the application closes in a single run
+	uint32_t frames_per_run{0};
+
+	uint32_t run_count{1};
+
+	/// Folder the reports are written to, no reports are written if it is empty
+	std::string report_directory;
+
+	/// Application being measured, empty if none is
+	std::string app_id;
+
+	uint32_t remaining_warmup_frames{0};
+
+	/// Set when all the runs of the current application are complete
+	bool runs_complete{false};
+
+	std::vector<Run> runs;
+
+	/// Results of the applications measured so far, for the summary report
+	std::vector<Result> results;
 };
-}        // namespace plugins
\ No newline at end of file
+}        // namespace plugins
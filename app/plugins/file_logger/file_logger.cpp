@@ -1,4 +1,4 @@
-/* Copyright (c) 2021-2025, Arm Limited and Contributors
+/* Copyright (c) 2021-2026, Arm Limited and Contributors
  * Copyright (c) 2021-2025, Sascha Willems
  * Copyright (c) 2025, NVIDIA CORPORATION. All rights reserved.
  *
@@ -21,6 +21,7 @@
 
 #include "apps.h"
 
+#include <core/util/logging.hpp>
 #include <fmt/format.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
@@ -45,7 +46,7 @@ bool FileLogger::handle_option(std::deque<std::string> &arguments)
 		}
 		std::string log_file = arguments[1];
 
-		spdlog::default_logger()->sinks().push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_file, true));
+		vkb::logging::add_sink(std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_file, true));
 
 		arguments.pop_front();
 		arguments.pop_front();
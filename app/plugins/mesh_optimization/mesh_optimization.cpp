@@ -0,0 +1,64 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mesh_optimization.h"
+
+#include "gltf_loader.h"
+
+namespace plugins
+{
+MeshOptimization::MeshOptimization() :
+    MeshOptimizationTags("Mesh Optimization",
+                         "Optimize the vertex and index streams of glTF meshes as they are loaded.",
+                         {},
+                         {},
+                         {{"optimize-meshes", "Reorder triangles and vertices for the vertex caches, merge duplicate vertices and use 16-bit indices where possible"},
+                          {"quantize-vertices", "Store normals, tangents and texture coordinates in smaller formats, implies --optimize-meshes"},
+                          {"interleave-vertices", "Upload the vertex attributes of each mesh as one interleaved buffer, implies --optimize-meshes"}})
+{
+}
+
+bool MeshOptimization::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "optimize-meshes")
+	{
+		vkb::GLTFLoader::set_mesh_optimization(options);
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "quantize-vertices")
+	{
+		options.quantize_attributes = true;
+		vkb::GLTFLoader::set_mesh_optimization(options);
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "interleave-vertices")
+	{
+		options.interleave = true;
+		vkb::GLTFLoader::set_mesh_optimization(options);
+
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,48 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "geometry/mesh_optimizer.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using MeshOptimizationTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Mesh Optimization
+ *
+ * Optimizes the vertex and index streams of glTF meshes as they are loaded
+ *
+ * Usage: vulkan_sample sample afbc --optimize-meshes
+ *        vulkan_sample sample afbc --optimize-meshes --quantize-vertices --interleave-vertices
+ *
+ */
+class MeshOptimization : public MeshOptimizationTags
+{
+  public:
+	MeshOptimization();
+
+	virtual ~MeshOptimization() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+  private:
+	vkb::MeshOptimizationOptions options;
+};
+}        // namespace plugins
@@ -0,0 +1,49 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "persistent_pipeline_cache.h"
+
+#include "resource_cache.h"
+
+namespace plugins
+{
+PersistentPipelineCache::PersistentPipelineCache() :
+    PersistentPipelineCacheTags("Persistent Pipeline Cache",
+                                "Keep the pipeline cache on disk across runs.",
+                                {},
+                                {},
+                                {{"pipeline-cache", "Load the pipeline cache from " + vkb::ResourceCache::get_pipeline_cache_directory() + " and save it back"},
+                                 {"pipeline-cache-warmup", "Also create the pipelines of the previous run when the device is created"}})
+{
+}
+
+bool PersistentPipelineCache::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "pipeline-cache" || option == "pipeline-cache-warmup")
+	{
+		// The warm-up implies the cache, whichever of the options comes first
+		warmup |= option == "pipeline-cache-warmup";
+		vkb::ResourceCache::set_persistent_pipeline_cache_enabled(true, warmup);
+
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,48 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using PersistentPipelineCacheTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Persistent Pipeline Cache
+ *
+ * Loads the pipeline cache of the device from disk when the device is created, and saves it back periodically and when
+ * the device is destroyed, so that later runs create their pipelines from a warm cache. With the warm-up the resources
+ * of the previous run are created again at startup, so that their pipelines are ready before the first frame.
+ *
+ * Usage: vulkan_sample sample afbc --pipeline-cache --pipeline-cache-warmup
+ *
+ */
+class PersistentPipelineCache : public PersistentPipelineCacheTags
+{
+  public:
+	PersistentPipelineCache();
+
+	virtual ~PersistentPipelineCache() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+  private:
+	bool warmup{false};
+};
+}        // namespace plugins
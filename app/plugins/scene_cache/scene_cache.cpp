@@ -0,0 +1,76 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_cache.h"
+
+#include "gltf_loader.h"
+
+namespace plugins
+{
+SceneCache::SceneCache() :
+    SceneCacheTags("Scene Cache",
+                   "Bake glTF scenes into binary scene caches and load scenes from them.",
+                   {},
+                   {{"bake-scene-cache", "Bake the scene cache of the given glTF files, relative to the assets directory"}},
+                   {{"scene-cache", "Load scenes from their scene cache when a valid one exists"}})
+{
+}
+
+bool SceneCache::handle_command(std::deque<std::string> &arguments) const
+{
+	assert(!arguments.empty());
+	if (arguments[0] == "bake-scene-cache")
+	{
+		if (arguments.size() < 2 || arguments[1].substr(0, 2) == "--")
+		{
+			LOGE("Command \"bake-scene-cache\" is missing the glTF files to bake!");
+			return false;
+		}
+		arguments.pop_front();
+
+		bool success = true;
+		while (!arguments.empty() && arguments[0].substr(0, 2) != "--")
+		{
+			success &= vkb::GLTFLoader::bake_scene_cache(arguments[0]);
+			arguments.pop_front();
+		}
+
+		if (!success)
+		{
+			LOGE("Failed to bake some of the scene caches");
+		}
+
+		platform->close();
+		return true;
+	}
+	return false;
+}
+
+bool SceneCache::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "scene-cache")
+	{
+		vkb::GLTFLoader::set_scene_cache_enabled(true);
+
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,47 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/platform.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using SceneCacheTags = vkb::PluginBase<vkb::tags::Entrypoint>;
+
+/**
+ * @brief Scene Cache
+ *
+ * Bakes glTF files into binary scene caches offline, and enables loading scenes from them
+ *
+ * Usage: vulkan_sample bake-scene-cache scenes/sponza/Sponza01.gltf
+ *        vulkan_sample sample afbc --scene-cache
+ *
+ */
+class SceneCache : public SceneCacheTags
+{
+  public:
+	SceneCache();
+
+	virtual ~SceneCache() = default;
+
+	bool handle_command(std::deque<std::string> &arguments) const override;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+};
+}        // namespace plugins
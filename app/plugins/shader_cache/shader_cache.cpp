@@ -0,0 +1,51 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shader_cache.h"
+
+#include "shader_reflection_cache.h"
+
+namespace plugins
+{
+ShaderCache::ShaderCache() :
+    ShaderCacheTags("Shader Cache",
+                    "Cache the reflection of shader modules on disk across runs.",
+                    {vkb::Hook::OnAppClose},
+                    {},
+                    {{"shader-cache", "Read and write the reflection of shader modules in " + vkb::ShaderReflectionCache::get_directory()}})
+{
+}
+
+bool ShaderCache::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "shader-cache")
+	{
+		vkb::ShaderReflectionCache::set_disk_cache_enabled(true);
+
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void ShaderCache::on_app_close(const std::string &app_info)
+{
+	vkb::ShaderReflectionCache::get().log_stats();
+}
+}        // namespace plugins
@@ -0,0 +1,46 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using ShaderCacheTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Shader Cache
+ *
+ * Stores the reflection of each shader module on disk, so that later runs skip reflecting the shaders they already saw.
+ * When the application closes the hits and misses of the cache are logged, with the reflection time the hits saved.
+ *
+ * Usage: vulkan_sample sample afbc --shader-cache
+ *
+ */
+class ShaderCache : public ShaderCacheTags
+{
+  public:
+	ShaderCache();
+
+	virtual ~ShaderCache() = default;
+
+	virtual void on_app_close(const std::string &app_info) override;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+};
+}        // namespace plugins
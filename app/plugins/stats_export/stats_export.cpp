@@ -0,0 +1,52 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_export.h"
+
+#include "stats/stats.h"
+
+namespace plugins
+{
+StatsExport::StatsExport() :
+    StatsExportTags("Stats Export",
+                    "Write the stats of a sample to a file at the full sampling rate.",
+                    {},
+                    {},
+                    {{"stats-export", "Write the stats to the given file, as CSV for a .csv extension and as a Chrome trace otherwise"}})
+{
+}
+
+bool StatsExport::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "stats-export")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"stats-export\" is missing the actual file name!");
+			return false;
+		}
+		vkb::Stats::set_export_path(arguments[1]);
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
@@ -0,0 +1,44 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using StatsExportTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Stats Export
+ *
+ * Writes every sample of the stats shown by a sample to a file, as CSV for a .csv extension and as a Chrome trace otherwise
+ *
+ * Usage: vulkan_sample sample afbc --stats-export stats.csv
+ *        vulkan_sample sample afbc --stats-export stats.json
+ *
+ */
+class StatsExport : public StatsExportTags
+{
+  public:
+	StatsExport();
+
+	virtual ~StatsExport() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+};
+}        // namespace plugins
@@ -1,5 +1,5 @@
 #[[
- Copyright (c) 2019-2025, Arm Limited and Contributors
+ Copyright (c) 2019-2026, Arm Limited and Contributors
 
  SPDX-License-Identifier: Apache-2.0
 
@@ -125,8 +125,15 @@ set(VKB_WSI_SELECTION "XCB" CACHE STRING "Select WSI target (XCB, XLIB, WAYLAND,
 set(VKB_CLANG_TIDY OFF CACHE STRING "Use CMake Clang Tidy integration")
 set(VKB_CLANG_TIDY_EXTRAS "-header-filter=framework,samples,app;-checks=-*,google-*,-google-runtime-references;--fix;--fix-errors" CACHE STRING "Clang Tidy Parameters")
 set(VKB_PROFILING OFF CACHE BOOL "Enable Tracy profiling")
+set(VKB_LOG_ACTIVE_LEVEL "DEBUG" CACHE STRING "Compile out log calls below this level (DEBUG, INFO, WARN, ERROR)")
 set(VKB_SKIP_SLANG_SHADER_COMPILATION OFF CACHE BOOL "Skips compilation for Slang shader")
 
+set(VKB_LOG_ACTIVE_LEVELS DEBUG INFO WARN ERROR)
+set_property(CACHE VKB_LOG_ACTIVE_LEVEL PROPERTY STRINGS ${VKB_LOG_ACTIVE_LEVELS})
+if(NOT VKB_LOG_ACTIVE_LEVEL IN_LIST VKB_LOG_ACTIVE_LEVELS)
+    message(FATAL_ERROR "VKB_LOG_ACTIVE_LEVEL is `${VKB_LOG_ACTIVE_LEVEL}`, it must be one of ${VKB_LOG_ACTIVE_LEVELS}")
+endif()
+
 set(CMAKE_RUNTIME_OUTPUT_DIRECTORY "bin/${CMAKE_BUILD_TYPE}/${TARGET_ARCH}")
 set(CMAKE_LIBRARY_OUTPUT_DIRECTORY "lib/${CMAKE_BUILD_TYPE}/${TARGET_ARCH}")
 set(CMAKE_ARCHIVE_OUTPUT_DIRECTORY "lib/${CMAKE_BUILD_TYPE}/${TARGET_ARCH}")
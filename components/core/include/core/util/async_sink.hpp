@@ -0,0 +1,175 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/sinks/sink.h>
+
+namespace vkb
+{
+namespace logging
+{
+/**
+ * @brief What a thread logging to a full queue does
+ */
+enum class OverflowPolicy
+{
+	/// Wait until the background thread makes room, nothing is lost
+	Block,
+
+	/// Drop the message
+	Drop,
+
+	/// Drop the message, and log how many were dropped once the queue has room again
+	Count
+};
+
+struct AsyncOptions
+{
+	/// Number of messages the queue holds, rounded up to a power of two
+	size_t queue_size{8192};
+
+	OverflowPolicy overflow_policy{OverflowPolicy::Count};
+};
+
+/**
+ * @brief A sink that queues messages, and writes them to other sinks from a background thread.
+ *
+ * The queue is a bounded lock-free queue (Vyukov's bounded MPMC queue, with a single consumer), so logging threads
+ * never wait for each other or for the output, only for a full queue with OverflowPolicy::Block. Messages are copied
+ * to the queue unformatted, and formatted by the sinks on the background thread, which flushes them whenever the queue
+ * is empty.
+ */
+class AsyncSink : public spdlog::sinks::sink
+{
+  public:
+	AsyncSink(std::vector<spdlog::sink_ptr> sinks, const AsyncOptions &options = {});
+
+	AsyncSink(const AsyncSink &) = delete;
+
+	AsyncSink(AsyncSink &&) = delete;
+
+	/**
+	 * @brief Writes the queued messages, then joins the background thread
+	 */
+	~AsyncSink() override;
+
+	AsyncSink &operator=(const AsyncSink &) = delete;
+
+	AsyncSink &operator=(AsyncSink &&) = delete;
+
+	void log(const spdlog::details::log_msg &msg) override;
+
+	/**
+	 * @brief Waits until the messages queued so far are written, then flushes the sinks
+	 */
+	void flush() override;
+
+	void set_pattern(const std::string &pattern) override;
+
+	void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+
+	/**
+	 * @brief Adds a sink that the following messages are written to
+	 */
+	void add_sink(spdlog::sink_ptr sink);
+
+	/**
+	 * @return The number of messages dropped because the queue was full
+	 */
+	size_t get_dropped_count() const;
+
+  private:
+	/// Messages up to this size are stored in the queue, longer ones allocate
+	static constexpr size_t INLINE_PAYLOAD_SIZE = 256;
+
+	static constexpr size_t MAX_LOGGER_NAME_SIZE = 32;
+
+	struct Entry
+	{
+		/// Position the entry can be written at when it equals the enqueue position, and read at when it is one more
+		std::atomic<size_t> sequence{0};
+
+		spdlog::log_clock::time_point time;
+
+		spdlog::level::level_enum level{spdlog::level::off};
+
+		size_t thread_id{0};
+
+		spdlog::source_loc source;
+
+		std::array<char, MAX_LOGGER_NAME_SIZE> logger_name;
+
+		size_t logger_name_size{0};
+
+		std::array<char, INLINE_PAYLOAD_SIZE> payload;
+
+		size_t payload_size{0};
+
+		std::string long_payload;
+	};
+
+	bool try_push(const spdlog::details::log_msg &msg);
+
+	/// Writes the queued messages to the sinks
+	/// @return The number of messages written
+	size_t drain();
+
+	void write(const spdlog::details::log_msg &msg);
+
+	void worker_loop();
+
+	std::unique_ptr<Entry[]> entries;
+
+	size_t mask;
+
+	OverflowPolicy overflow_policy;
+
+	/// Next position to write, shared by the logging threads
+	alignas(64) std::atomic<size_t> enqueue_position{0};
+
+	/// Next position to read, only written by the background thread
+	alignas(64) std::atomic<size_t> dequeue_position{0};
+
+	std::atomic<size_t> dropped_count{0};
+
+	/// Dropped messages that were already reported with OverflowPolicy::Count
+	size_t reported_dropped_count{0};
+
+	/// Bumped after each message is queued, the background thread waits on it when the queue is empty
+	std::atomic<uint32_t> wake_counter{0};
+
+	std::atomic<bool> stopping{false};
+
+	/// Guards the sinks, which are only used by the background thread apart from flush and configuration calls
+	std::mutex sinks_mutex;
+
+	std::vector<spdlog::sink_ptr> sinks;
+
+	std::thread worker;
+};
+}        // namespace logging
+}        // namespace vkb
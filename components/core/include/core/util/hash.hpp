@@ -1,4 +1,4 @@
-/* Copyright (c) 2023, Thomas Atkinson
+/* Copyright (c) 2023-2026, Thomas Atkinson
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,14 +17,157 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#	include <intrin.h>
+#endif
+
 namespace vkb
 {
+namespace hash_detail
+{
+constexpr uint64_t SECRET[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+/**
+ * @brief Full 64x64 to 128 bit multiplication, returning the two halves in place
+ */
+inline void multiply(uint64_t &a, uint64_t &b)
+{
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = static_cast<__uint128_t>(a) * b;
+	a             = static_cast<uint64_t>(r);
+	b             = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	a = _umul128(a, b, &b);
+#else
+	uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+	uint64_t lo = t + (rm1 << 32);
+	c += lo < t;
+	a = lo;
+	b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b)
+{
+	multiply(a, b);
+	return a ^ b;
+}
+
+inline uint64_t read8(const uint8_t *p)
+{
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline uint64_t read4(const uint8_t *p)
+{
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline uint64_t read3(const uint8_t *p, size_t size)
+{
+	return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+}
+}        // namespace hash_detail
+
+/**
+ * @brief Hashes a block of memory to 64 bits, following the wyhash algorithm.
+ *        It processes 48 bytes per iteration, so large blobs such as SPIR-V or pixel data hash at memory speed,
+ *        and it passes SMHasher, which the byte-wise std::hash<std::string> implementations aren't required to.
+ * @param data The bytes to hash
+ * @param size The number of bytes
+ * @param seed Starting value, different seeds give independent hashes of the same data
+ */
+inline uint64_t hash_bytes(const void *data, size_t size, uint64_t seed = 0)
+{
+	using namespace hash_detail;
+
+	auto p = static_cast<const uint8_t *>(data);
+
+	seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+
+	uint64_t a, b;
+	if (size <= 16)
+	{
+		if (size >= 4)
+		{
+			a = (read4(p) << 32) | read4(p + ((size >> 3) << 2));
+			b = (read4(p + size - 4) << 32) | read4(p + size - 4 - ((size >> 3) << 2));
+		}
+		else if (size > 0)
+		{
+			a = read3(p, size);
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+	else
+	{
+		size_t remaining = size;
+		if (remaining > 48)
+		{
+			uint64_t seed1 = seed, seed2 = seed;
+			do
+			{
+				seed  = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+				seed1 = mix(read8(p + 16) ^ SECRET[2], read8(p + 24) ^ seed1);
+				seed2 = mix(read8(p + 32) ^ SECRET[3], read8(p + 40) ^ seed2);
+				p += 48;
+				remaining -= 48;
+			} while (remaining > 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while (remaining > 16)
+		{
+			seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+			p += 16;
+			remaining -= 16;
+		}
+		a = read8(p + remaining - 16);
+		b = read8(p + remaining - 8);
+	}
+
+	a ^= SECRET[1];
+	b ^= seed;
+	multiply(a, b);
+	return mix(a ^ SECRET[0] ^ size, b ^ SECRET[1]);
+}
+
+/**
+ * @brief Combines a hash into a seed.
+ *        The 64-bit version multiplies into 128 bits and folds, so every input bit affects every output bit;
+ *        the classic 0x9e3779b9 shift-xor mix leaves the high bits of a 64-bit seed poorly distributed.
+ *        The operands are folded back into the product, so that an operand that happens to be zero doesn't zero
+ *        the product and lose the other input.
+ */
 inline void hash_combine(size_t &seed, size_t hash)
 {
-	hash += 0x9e3779b9 + (seed << 6) + (seed >> 2);
-	seed ^= hash;
+	if constexpr (sizeof(size_t) == sizeof(uint64_t))
+	{
+		uint64_t a = seed ^ hash_detail::SECRET[0];
+		uint64_t b = hash ^ hash_detail::SECRET[1];
+
+		uint64_t lo = a, hi = b;
+		hash_detail::multiply(lo, hi);
+
+		seed = static_cast<size_t>((lo ^ a) ^ (hi ^ b));
+	}
+	else
+	{
+		hash += 0x9e3779b9 + (seed << 6) + (seed >> 2);
+		seed ^= hash;
+	}
 }
 
 /**
@@ -38,4 +181,12 @@ inline void hash_combine(size_t &seed, const T &v)
 
 	hash_combine(seed, hasher(v));
 }
-}        // namespace vkb
\ No newline at end of file
+
+/**
+ * @brief Combines the hash of a block of memory into a seed, without copying it into a std::string first
+ */
+inline void hash_combine_bytes(size_t &seed, const void *data, size_t size)
+{
+	hash_combine(seed, static_cast<size_t>(hash_bytes(data, size)));
+}
+}        // namespace vkb
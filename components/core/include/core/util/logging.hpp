@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -20,18 +20,77 @@
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
+#include "core/util/async_sink.hpp"
+
 #define LOGGER_FORMAT "[%^%l%$] %v"
 #define PROJECT_NAME "VulkanSamples"
 
-#define LOGI(...) spdlog::info(__VA_ARGS__);
-#define LOGW(...) spdlog::warn(__VA_ARGS__);
-#define LOGE(...) spdlog::error("{}", fmt::format(__VA_ARGS__));
-#define LOGD(...) spdlog::debug(__VA_ARGS__);
+// Levels for VKB_LOG_ACTIVE_LEVEL, log calls below the active level are compiled out.
+// They start at 1, so that an undefined level name, which the preprocessor reads as 0, is rejected below
+#define VKB_LOG_LEVEL_DEBUG 1
+#define VKB_LOG_LEVEL_INFO 2
+#define VKB_LOG_LEVEL_WARN 3
+#define VKB_LOG_LEVEL_ERROR 4
+
+#ifndef VKB_LOG_ACTIVE_LEVEL
+#	define VKB_LOG_ACTIVE_LEVEL VKB_LOG_LEVEL_DEBUG
+#endif
+
+#if VKB_LOG_ACTIVE_LEVEL != VKB_LOG_LEVEL_DEBUG && VKB_LOG_ACTIVE_LEVEL != VKB_LOG_LEVEL_INFO && \
+    VKB_LOG_ACTIVE_LEVEL != VKB_LOG_LEVEL_WARN && VKB_LOG_ACTIVE_LEVEL != VKB_LOG_LEVEL_ERROR
+#	error "VKB_LOG_ACTIVE_LEVEL must be one of VKB_LOG_LEVEL_DEBUG, VKB_LOG_LEVEL_INFO, VKB_LOG_LEVEL_WARN or VKB_LOG_LEVEL_ERROR"
+#endif
+
+// The arguments of a stripped call are still compiled, so that variables only used by it are not reported as unused
+#define VKB_LOG_STRIPPED(...)           \
+	do                                  \
+	{                                   \
+		if constexpr (false)            \
+		{                               \
+			spdlog::debug(__VA_ARGS__); \
+		}                               \
+	} while (false);
+
+#if VKB_LOG_ACTIVE_LEVEL <= VKB_LOG_LEVEL_INFO
+#	define LOGI(...) spdlog::info(__VA_ARGS__);
+#else
+#	define LOGI(...) VKB_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if VKB_LOG_ACTIVE_LEVEL <= VKB_LOG_LEVEL_WARN
+#	define LOGW(...) spdlog::warn(__VA_ARGS__);
+#else
+#	define LOGW(...) VKB_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if VKB_LOG_ACTIVE_LEVEL <= VKB_LOG_LEVEL_ERROR
+#	define LOGE(...) spdlog::error("{}", fmt::format(__VA_ARGS__));
+#else
+#	define LOGE(...) VKB_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if VKB_LOG_ACTIVE_LEVEL <= VKB_LOG_LEVEL_DEBUG
+#	define LOGD(...) spdlog::debug(__VA_ARGS__);
+#else
+#	define LOGD(...) VKB_LOG_STRIPPED(__VA_ARGS__)
+#endif
 
 namespace vkb
 {
 namespace logging
 {
 void init();
-}
-}        // namespace vkb
\ No newline at end of file
+
+/**
+ * @brief Moves the sinks of the default logger behind an AsyncSink, so that logging does not wait for the output.
+ *        Errors still wait for the queued messages to be written, so that they are not lost if the app then crashes.
+ *        Must be called before other threads log.
+ */
+void enable_async(const AsyncOptions &options = {});
+
+/**
+ * @brief Adds a sink to the default logger, behind the queue if async logging is enabled
+ */
+void add_sink(spdlog::sink_ptr sink);
+}        // namespace logging
+}        // namespace vkb
@@ -0,0 +1,109 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief A fixed-size pool of worker threads consuming tasks from a shared FIFO queue.
+ *        Unlike std::async, the number of threads never exceeds the size given at construction,
+ *        so pushing hundreds of tasks does not oversubscribe the CPU.
+ */
+class ThreadPool
+{
+  public:
+	/**
+	 * @brief Starts the worker threads
+	 * @param thread_count Number of workers, 0 selects one per hardware thread
+	 */
+	explicit ThreadPool(uint32_t thread_count = 0);
+
+	ThreadPool(const ThreadPool &) = delete;
+
+	ThreadPool(ThreadPool &&) = delete;
+
+	/**
+	 * @brief Finishes all queued tasks, then joins the worker threads
+	 */
+	~ThreadPool();
+
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	ThreadPool &operator=(ThreadPool &&) = delete;
+
+	/**
+	 * @brief Queues a task for execution on one of the workers
+	 * @return A future holding the result of the task, or the exception it threw
+	 */
+	template <typename F>
+	std::future<std::invoke_result_t<std::decay_t<F>>> push(F &&task);
+
+	uint32_t get_thread_count() const;
+
+	/**
+	 * @return True if called from a task running on one of the workers of this pool.
+	 *         Such a task must not block on tasks it pushes, they may be queued behind it.
+	 */
+	bool is_worker_thread() const;
+
+	/**
+	 * @return The number of hardware threads, never less than one
+	 */
+	static uint32_t get_hardware_thread_count();
+
+  private:
+	void enqueue(std::function<void()> &&task);
+
+	void worker_loop();
+
+	std::vector<std::thread> workers;
+
+	std::deque<std::function<void()>> tasks;
+
+	std::mutex tasks_mutex;
+
+	std::condition_variable tasks_condition;
+
+	bool stopping{false};
+};
+
+template <typename F>
+std::future<std::invoke_result_t<std::decay_t<F>>> ThreadPool::push(F &&task)
+{
+	using ResultType = std::invoke_result_t<std::decay_t<F>>;
+
+	// std::function requires a copyable callable, so the move-only packaged_task is shared
+	auto packaged_task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(task));
+	auto future        = packaged_task->get_future();
+
+	enqueue([packaged_task]() { (*packaged_task)(); });
+
+	return future;
+}
+}        // namespace vkb
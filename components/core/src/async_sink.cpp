@@ -0,0 +1,255 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/util/async_sink.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/fmt/fmt.h>
+
+namespace vkb
+{
+namespace logging
+{
+AsyncSink::AsyncSink(std::vector<spdlog::sink_ptr> sinks, const AsyncOptions &options) :
+    entries{std::make_unique<Entry[]>(std::bit_ceil(std::max<size_t>(options.queue_size, 2)))},
+    mask{std::bit_ceil(std::max<size_t>(options.queue_size, 2)) - 1},
+    overflow_policy{options.overflow_policy},
+    sinks{std::move(sinks)}
+{
+	for (size_t i = 0; i <= mask; ++i)
+	{
+		entries[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	worker = std::thread(&AsyncSink::worker_loop, this);
+}
+
+AsyncSink::~AsyncSink()
+{
+	stopping.store(true, std::memory_order_release);
+	wake_counter.fetch_add(1, std::memory_order_release);
+	wake_counter.notify_one();
+
+	worker.join();
+}
+
+void AsyncSink::log(const spdlog::details::log_msg &msg)
+{
+	if (try_push(msg))
+	{
+		return;
+	}
+
+	if (overflow_policy == OverflowPolicy::Block)
+	{
+		while (!try_push(msg))
+		{
+			std::this_thread::yield();
+		}
+		return;
+	}
+
+	dropped_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool AsyncSink::try_push(const spdlog::details::log_msg &msg)
+{
+	size_t position = enqueue_position.load(std::memory_order_relaxed);
+	Entry *entry    = nullptr;
+
+	// Claim the entry at the enqueue position, unless the background thread has not read it since the last lap
+	while (true)
+	{
+		entry = &entries[position & mask];
+
+		auto difference = static_cast<std::ptrdiff_t>(entry->sequence.load(std::memory_order_acquire) - position);
+		if (difference == 0)
+		{
+			if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (difference < 0)
+		{
+			return false;
+		}
+		else
+		{
+			position = enqueue_position.load(std::memory_order_relaxed);
+		}
+	}
+
+	entry->time      = msg.time;
+	entry->level     = msg.level;
+	entry->thread_id = msg.thread_id;
+	entry->source    = msg.source;
+
+	entry->logger_name_size = std::min(msg.logger_name.size(), MAX_LOGGER_NAME_SIZE);
+	std::copy_n(msg.logger_name.data(), entry->logger_name_size, entry->logger_name.data());
+
+	entry->payload_size = msg.payload.size();
+	if (msg.payload.size() <= INLINE_PAYLOAD_SIZE)
+	{
+		std::copy_n(msg.payload.data(), msg.payload.size(), entry->payload.data());
+	}
+	else
+	{
+		entry->long_payload.assign(msg.payload.data(), msg.payload.size());
+	}
+
+	entry->sequence.store(position + 1, std::memory_order_release);
+
+	wake_counter.fetch_add(1, std::memory_order_release);
+	wake_counter.notify_one();
+
+	return true;
+}
+
+size_t AsyncSink::drain()
+{
+	size_t position = dequeue_position.load(std::memory_order_relaxed);
+	size_t count    = 0;
+
+	std::lock_guard<std::mutex> lock(sinks_mutex);
+
+	while (true)
+	{
+		Entry &entry = entries[position & mask];
+		if (entry.sequence.load(std::memory_order_acquire) != position + 1)
+		{
+			break;
+		}
+
+		const char *payload = entry.payload_size <= INLINE_PAYLOAD_SIZE ? entry.payload.data() : entry.long_payload.data();
+
+		spdlog::details::log_msg msg{entry.time,
+		                             entry.source,
+		                             spdlog::string_view_t{entry.logger_name.data(), entry.logger_name_size},
+		                             entry.level,
+		                             spdlog::string_view_t{payload, entry.payload_size}};
+		msg.thread_id = entry.thread_id;
+
+		write(msg);
+
+		// Hand the entry back to the logging threads for the next lap
+		entry.sequence.store(position + mask + 1, std::memory_order_release);
+		dequeue_position.store(++position, std::memory_order_release);
+		count++;
+	}
+
+	size_t dropped = dropped_count.load(std::memory_order_relaxed);
+	if (overflow_policy == OverflowPolicy::Count && dropped != reported_dropped_count)
+	{
+		auto text = fmt::format("{} log messages were dropped as the log queue was full", dropped - reported_dropped_count);
+
+		write(spdlog::details::log_msg{spdlog::string_view_t{}, spdlog::level::warn, spdlog::string_view_t{text}});
+		reported_dropped_count = dropped;
+	}
+
+	if (count > 0)
+	{
+		for (auto &sink : sinks)
+		{
+			sink->flush();
+		}
+	}
+
+	return count;
+}
+
+void AsyncSink::write(const spdlog::details::log_msg &msg)
+{
+	for (auto &sink : sinks)
+	{
+		if (sink->should_log(msg.level))
+		{
+			sink->log(msg);
+		}
+	}
+}
+
+void AsyncSink::worker_loop()
+{
+	while (true)
+	{
+		// Read before draining, so a message queued after the drain changes it and the wait returns at once
+		uint32_t wake_value = wake_counter.load(std::memory_order_acquire);
+
+		if (drain() > 0)
+		{
+			continue;
+		}
+
+		if (stopping.load(std::memory_order_acquire))
+		{
+			break;
+		}
+
+		wake_counter.wait(wake_value, std::memory_order_acquire);
+	}
+}
+
+void AsyncSink::flush()
+{
+	// Wait for the background thread to write the messages queued so far
+	size_t position = enqueue_position.load(std::memory_order_acquire);
+	while (dequeue_position.load(std::memory_order_acquire) < position && !stopping.load(std::memory_order_acquire))
+	{
+		std::this_thread::yield();
+	}
+
+	std::lock_guard<std::mutex> lock(sinks_mutex);
+	for (auto &sink : sinks)
+	{
+		sink->flush();
+	}
+}
+
+void AsyncSink::set_pattern(const std::string &pattern)
+{
+	std::lock_guard<std::mutex> lock(sinks_mutex);
+	for (auto &sink : sinks)
+	{
+		sink->set_pattern(pattern);
+	}
+}
+
+void AsyncSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter)
+{
+	std::lock_guard<std::mutex> lock(sinks_mutex);
+	for (auto &sink : sinks)
+	{
+		sink->set_formatter(sink_formatter->clone());
+	}
+}
+
+void AsyncSink::add_sink(spdlog::sink_ptr sink)
+{
+	std::lock_guard<std::mutex> lock(sinks_mutex);
+	sinks.push_back(std::move(sink));
+}
+
+size_t AsyncSink::get_dropped_count() const
+{
+	return dropped_count.load(std::memory_order_relaxed);
+}
+}        // namespace logging
+}        // namespace vkb
@@ -29,6 +29,12 @@ namespace vkb
 {
 namespace logging
 {
+namespace
+{
+/// The sink of the default logger while async logging is enabled
+std::weak_ptr<AsyncSink> async_sink;
+}        // namespace
+
 void init()
 {
 	// Taken from "spdlog/cfg/env.h" and renamed SPDLOG_LEVEL to VKB_LOG_LEVEL
@@ -48,5 +54,33 @@ void init()
 	logger->set_level(spdlog::level::trace);
 	spdlog::set_default_logger(logger);
 }
+
+void enable_async(const AsyncOptions &options)
+{
+	auto logger = spdlog::default_logger();
+	if (!logger || !async_sink.expired())
+	{
+		return;
+	}
+
+	auto sink = std::make_shared<AsyncSink>(logger->sinks(), options);
+
+	logger->sinks().assign(1, sink);
+	logger->flush_on(spdlog::level::err);
+
+	async_sink = sink;
+}
+
+void add_sink(spdlog::sink_ptr sink)
+{
+	if (auto queue = async_sink.lock())
+	{
+		queue->add_sink(std::move(sink));
+	}
+	else
+	{
+		spdlog::default_logger()->sinks().push_back(std::move(sink));
+	}
+}
 }        // namespace logging
-}        // namespace vkb
\ No newline at end of file
+}        // namespace vkb
@@ -0,0 +1,106 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <core/util/thread_pool.hpp>
+
+namespace vkb
+{
+namespace
+{
+/// The pool whose worker runs on the current thread, if any
+thread_local const ThreadPool *current_thread_pool{nullptr};
+}        // namespace
+
+ThreadPool::ThreadPool(uint32_t thread_count)
+{
+	if (thread_count == 0)
+	{
+		thread_count = get_hardware_thread_count();
+	}
+
+	workers.reserve(thread_count);
+	for (uint32_t i = 0; i < thread_count; ++i)
+	{
+		workers.emplace_back([this]() { worker_loop(); });
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock{tasks_mutex};
+		stopping = true;
+	}
+	tasks_condition.notify_all();
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+}
+
+uint32_t ThreadPool::get_thread_count() const
+{
+	return static_cast<uint32_t>(workers.size());
+}
+
+bool ThreadPool::is_worker_thread() const
+{
+	return current_thread_pool == this;
+}
+
+uint32_t ThreadPool::get_hardware_thread_count()
+{
+	auto count = std::thread::hardware_concurrency();
+	return count == 0 ? 1 : count;
+}
+
+void ThreadPool::enqueue(std::function<void()> &&task)
+{
+	{
+		std::lock_guard<std::mutex> lock{tasks_mutex};
+		tasks.push_back(std::move(task));
+	}
+	tasks_condition.notify_one();
+}
+
+void ThreadPool::worker_loop()
+{
+	current_thread_pool = this;
+
+	while (true)
+	{
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock{tasks_mutex};
+			tasks_condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+			// Drain the queue before exiting so that no pushed future is left without a result
+			if (tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+
+		task();
+	}
+}
+}        // namespace vkb
@@ -18,12 +18,16 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "core/platform/context.hpp"
 #include "core/util/logging.hpp"
+#include "core/util/thread_pool.hpp"
 
 namespace vkb
 {
@@ -38,6 +42,50 @@ struct FileStat
 
 using Path = std::filesystem::path;
 
+/**
+ * @brief A read-only view of the contents of a file, valid for the lifetime of the object.
+ *        The view is either a memory mapping of the file, released through the unmap callback,
+ *        or a buffer owned by the object when the filesystem can't map files.
+ */
+class MappedFile
+{
+  public:
+	MappedFile() = default;
+
+	MappedFile(const uint8_t *data, size_t size, std::function<void()> &&unmap);
+
+	explicit MappedFile(std::vector<uint8_t> &&buffer);
+
+	MappedFile(const MappedFile &) = delete;
+
+	MappedFile(MappedFile &&other) noexcept;
+
+	~MappedFile();
+
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	MappedFile &operator=(MappedFile &&other) noexcept;
+
+	const uint8_t *data() const;
+
+	size_t size() const;
+
+	bool empty() const;
+
+	std::span<const uint8_t> view() const;
+
+  private:
+	void release();
+
+	const uint8_t *mapped_data{nullptr};
+
+	size_t mapped_size{0};
+
+	std::function<void()> unmap;
+
+	std::vector<uint8_t> buffer;
+};
+
 // A thin filesystem wrapper
 class FileSystem
 {
@@ -60,11 +108,28 @@ class FileSystem
 
 	void write_file(const Path &path, const std::string &data);
 
+	// Write a file through a temporary one next to it, so that an interrupted run never leaves a partial file behind
+	void write_file_atomically(const Path &path, const std::vector<uint8_t> &data);
+
 	// Read the entire file into a string
 	std::string read_file_string(const Path &path);
 
 	// Read the entire file into a vector of bytes
 	std::vector<uint8_t> read_file_binary(const Path &path);
+
+	// Map the entire file read-only, the default implementation reads it into an owned buffer
+	virtual MappedFile map_file(const Path &path);
+
+	/**
+	 * @brief Maps a batch of files on a thread pool
+	 * @param paths The files to map
+	 * @param thread_pool The pool the files are mapped on
+	 * @param on_mapped Called on a worker thread with the index of the path and its mapping once a file is mapped
+	 * @return One future per path, rethrowing the error if the file couldn't be mapped
+	 */
+	std::vector<std::future<void>> map_files_async(const std::vector<Path>                           &paths,
+	                                               ThreadPool                                        &thread_pool,
+	                                               std::function<void(size_t index, MappedFile &&file)> on_mapped);
 };
 
 using FileSystemPtr = std::shared_ptr<FileSystem>;
@@ -26,6 +26,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "filesystem/filesystem.hpp"
+
 namespace vkb
 {
 namespace fs
@@ -95,6 +97,14 @@ void create_path(const std::string &root, const std::string &path);
  */
 std::vector<uint8_t> read_asset(const std::string &filename);
 
+/**
+ * @brief Helper to map an asset file read-only, without copying its contents
+ *
+ * @param filename The path to the file (relative to the assets directory)
+ * @return The mapped file, its contents stay valid as long as it is alive
+ */
+vkb::filesystem::MappedFile map_asset(const std::string &filename);
+
 /**
  * @brief Helper to read a text file into a single string
  *
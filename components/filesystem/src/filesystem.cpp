@@ -17,6 +17,8 @@
 
 #include "filesystem/filesystem.hpp"
 
+#include <utility>
+
 #include "core/platform/context.hpp"
 #include "core/util/error.hpp"
 
@@ -40,6 +42,76 @@ void init_with_context(const PlatformContext &context)
 	    context.temp_directory());
 }
 
+MappedFile::MappedFile(const uint8_t *data, size_t size, std::function<void()> &&unmap) :
+    mapped_data{data}, mapped_size{size}, unmap{std::move(unmap)}
+{}
+
+MappedFile::MappedFile(std::vector<uint8_t> &&buffer) :
+    buffer{std::move(buffer)}
+{
+	mapped_data = this->buffer.data();
+	mapped_size = this->buffer.size();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile::~MappedFile()
+{
+	release();
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+
+		// Moving a vector keeps its storage, so a view into an owned buffer stays valid
+		mapped_data = std::exchange(other.mapped_data, nullptr);
+		mapped_size = std::exchange(other.mapped_size, 0);
+		unmap       = std::exchange(other.unmap, nullptr);
+		buffer      = std::move(other.buffer);
+	}
+
+	return *this;
+}
+
+const uint8_t *MappedFile::data() const
+{
+	return mapped_data;
+}
+
+size_t MappedFile::size() const
+{
+	return mapped_size;
+}
+
+bool MappedFile::empty() const
+{
+	return mapped_size == 0;
+}
+
+std::span<const uint8_t> MappedFile::view() const
+{
+	return {mapped_data, mapped_size};
+}
+
+void MappedFile::release()
+{
+	if (unmap)
+	{
+		unmap();
+		unmap = nullptr;
+	}
+
+	buffer.clear();
+	mapped_data = nullptr;
+	mapped_size = 0;
+}
+
 FileSystemPtr get()
 {
 	assert(fs && "Filesystem not initialized");
@@ -51,6 +123,23 @@ void FileSystem::write_file(const Path &path, const std::string &data)
 	write_file(path, std::vector<uint8_t>(data.begin(), data.end()));
 }
 
+void FileSystem::write_file_atomically(const Path &path, const std::vector<uint8_t> &data)
+{
+	auto temp_path = path;
+	temp_path += ".tmp";
+
+	write_file(temp_path, data);
+
+	std::error_code error;
+	std::filesystem::rename(temp_path, path, error);
+	if (error)
+	{
+		std::error_code ignored;
+		std::filesystem::remove(temp_path, ignored);
+		throw std::runtime_error("Failed to replace file at path: " + path.string() + ": " + error.message());
+	}
+}
+
 std::string FileSystem::read_file_string(const Path &path)
 {
 	auto bin = read_file_binary(path);
@@ -63,5 +152,35 @@ std::vector<uint8_t> FileSystem::read_file_binary(const Path &path)
 	return read_chunk(path, 0, stat.size);
 }
 
+MappedFile FileSystem::map_file(const Path &path)
+{
+	if (!is_file(path))
+	{
+		throw std::runtime_error("Failed to map file at path: " + path.string());
+	}
+
+	return MappedFile{read_file_binary(path)};
+}
+
+std::vector<std::future<void>> FileSystem::map_files_async(const std::vector<Path>                           &paths,
+                                                           ThreadPool                                        &thread_pool,
+                                                           std::function<void(size_t index, MappedFile &&file)> on_mapped)
+{
+	// Shared by the tasks so the callback outlives this call
+	auto callback = std::make_shared<std::function<void(size_t, MappedFile &&)>>(std::move(on_mapped));
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(paths.size());
+
+	for (size_t i = 0; i < paths.size(); ++i)
+	{
+		futures.push_back(thread_pool.push([this, callback, path = paths[i], i]() {
+			(*callback)(i, map_file(path));
+		}));
+	}
+
+	return futures;
+}
+
 }        // namespace filesystem
 }        // namespace vkb
\ No newline at end of file
@@ -22,6 +22,17 @@
 #include <filesystem>
 #include <fstream>
 
+#if defined(PLATFORM__WINDOWS)
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
 namespace vkb
 {
 namespace filesystem
@@ -128,6 +139,60 @@ void StdFileSystem::write_file(const Path &path, const std::vector<uint8_t> &dat
 	file.write(reinterpret_cast<const char *>(data.data()), data.size());
 }
 
+MappedFile StdFileSystem::map_file(const Path &path)
+{
+	auto size = stat_file(path).size;
+
+	// Empty files can't be mapped
+	if (size == 0)
+	{
+		return FileSystem::map_file(path);
+	}
+
+#if defined(PLATFORM__WINDOWS)
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("Failed to open file for mapping at path: " + path.string());
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		throw std::runtime_error("Failed to map file at path: " + path.string());
+	}
+
+	auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == nullptr)
+	{
+		throw std::runtime_error("Failed to map file at path: " + path.string());
+	}
+
+	return MappedFile{static_cast<const uint8_t *>(data), size, [data]() { UnmapViewOfFile(data); }};
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		throw std::runtime_error("Failed to open file for mapping at path: " + path.string());
+	}
+
+	// The mapping keeps its own reference to the file, so the descriptor can be closed right away
+	void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		throw std::runtime_error("Failed to map file at path: " + path.string());
+	}
+
+	// Loaders read the contents front to back
+	madvise(data, size, MADV_SEQUENTIAL);
+
+	return MappedFile{static_cast<const uint8_t *>(data), size, [data, size]() { munmap(data, size); }};
+#endif
+}
+
 void StdFileSystem::remove(const Path &path)
 {
 	std::error_code ec;
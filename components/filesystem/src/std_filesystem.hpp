@@ -47,6 +47,8 @@ class StdFileSystem final : public FileSystem
 
 	void write_file(const Path &path, const std::vector<uint8_t> &data) override;
 
+	MappedFile map_file(const Path &path) override;
+
 	virtual void remove(const Path &path) override;
 
 	virtual void set_external_storage_directory(const std::string &dir) override;
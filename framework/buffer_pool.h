@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  * Copyright (c) 2024-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -174,7 +174,23 @@ class BufferBlock
 	bool can_allocate(DeviceSizeType size) const;
 
 	DeviceSizeType get_size() const;
-	void           reset();
+
+	/**
+	 * @return The number of bytes handed out since the last reset, including alignment padding
+	 */
+	DeviceSizeType get_used_size() const;
+
+	/**
+	 * @return The number of bytes skipped to align allocations since the last reset
+	 */
+	DeviceSizeType get_padding() const;
+
+	/**
+	 * @return The number of consecutive resets that found the block unused
+	 */
+	uint32_t get_idle_frames() const;
+
+	void reset();
 
   private:
 	/**
@@ -186,8 +202,10 @@ class BufferBlock
 
   private:
 	vkb::core::BufferCpp buffer;
-	vk::DeviceSize       alignment = 0;        // Memory alignment, it may change according to the usage
-	vk::DeviceSize       offset    = 0;        // Current offset, it increases on every allocation
+	vk::DeviceSize       alignment   = 0;        // Memory alignment, it may change according to the usage
+	vk::DeviceSize       offset      = 0;        // Current offset, it increases on every allocation
+	vk::DeviceSize       padding     = 0;        // Bytes lost to alignment since the last reset
+	uint32_t             idle_frames = 0;        // Number of consecutive resets without any allocation
 };
 
 using BufferBlockC   = BufferBlock<vkb::BindingType::C>;
@@ -215,7 +233,8 @@ BufferAllocation<bindingType> BufferBlock<bindingType>::allocate(DeviceSizeType
 	{
 		// Move the current offset and return an allocation
 		auto aligned = aligned_offset();
-		offset       = aligned + size;
+		padding += aligned - offset;
+		offset = aligned + size;
 		if constexpr (bindingType == vkb::BindingType::Cpp)
 		{
 			return BufferAllocationCpp{buffer, size, aligned};
@@ -243,10 +262,30 @@ typename BufferBlock<bindingType>::DeviceSizeType BufferBlock<bindingType>::get_
 	return buffer.get_size();
 }
 
+template <vkb::BindingType bindingType>
+typename BufferBlock<bindingType>::DeviceSizeType BufferBlock<bindingType>::get_used_size() const
+{
+	return static_cast<DeviceSizeType>(offset);
+}
+
+template <vkb::BindingType bindingType>
+typename BufferBlock<bindingType>::DeviceSizeType BufferBlock<bindingType>::get_padding() const
+{
+	return static_cast<DeviceSizeType>(padding);
+}
+
+template <vkb::BindingType bindingType>
+uint32_t BufferBlock<bindingType>::get_idle_frames() const
+{
+	return idle_frames;
+}
+
 template <vkb::BindingType bindingType>
 void BufferBlock<bindingType>::reset()
 {
-	offset = 0;
+	idle_frames = (offset == 0) ? idle_frames + 1 : 0;
+	offset      = 0;
+	padding     = 0;
 }
 
 template <vkb::BindingType bindingType>
@@ -295,6 +334,9 @@ vk::DeviceSize BufferBlock<bindingType>::determine_alignment(vk::BufferUsageFlag
  * overwritten. The minimum allocation size is 256 kb, if you ask for more you get a dedicated
  * buffer allocation.
  *
+ * The pool keeps the usage of the last frame and its high-water mark. Blocks that stayed unused
+ * for a number of frames, e.g. the extra blocks requested by a spike frame, can be released.
+ *
  * We re-use descriptor sets: we only need one for the corresponding buffer infos (and we only
  * have one VkBuffer per BufferBlock), then it is bound and we use dynamic offsets.
  */
@@ -311,14 +353,47 @@ class BufferPool
 
 	BufferBlock<bindingType> &request_buffer_block(DeviceSizeType minimum_size, bool minimal = false);
 
+	/**
+	 * @brief Resets all the blocks, recording how much of them was used since the previous reset
+	 */
 	void reset();
 
+	/**
+	 * @brief Destroys the blocks that were unused for the given number of frames
+	 * @param idle_frame_count Number of consecutive resets a block has to stay unused to be released
+	 * @return The number of released blocks
+	 */
+	size_t release_idle_blocks(uint32_t idle_frame_count);
+
+	/**
+	 * @return The number of bytes used between the last two resets, including alignment padding
+	 */
+	DeviceSizeType get_frame_size() const;
+
+	/**
+	 * @return The number of bytes lost to alignment between the last two resets
+	 */
+	DeviceSizeType get_frame_padding() const;
+
+	/**
+	 * @return The largest number of bytes used between two resets
+	 */
+	DeviceSizeType get_high_water_mark() const;
+
+	/**
+	 * @return The total size of the blocks currently held by the pool
+	 */
+	DeviceSizeType get_capacity() const;
+
   private:
 	vkb::core::DeviceCpp                        &device;
 	std::vector<std::unique_ptr<BufferBlockCpp>> buffer_blocks;         /// List of blocks requested (need to be pointers in order to keep their address constant on vector resizing)
 	vk::DeviceSize                               block_size = 0;        /// Minimum size of the blocks
 	vk::BufferUsageFlags                         usage;
 	VmaMemoryUsage                               memory_usage{};
+	vk::DeviceSize                               frame_size      = 0;        /// Bytes used between the last two resets
+	vk::DeviceSize                               frame_padding   = 0;        /// Bytes lost to alignment between the last two resets
+	vk::DeviceSize                               high_water_mark = 0;        /// Largest frame_size seen
 };
 
 using BufferPoolC   = BufferPool<vkb::BindingType::C>;
@@ -368,10 +443,55 @@ void BufferPool<bindingType>::reset()
 	// Attention: Resetting the BufferPool is not supposed to clear the BufferBlocks, but just reset them!
 	//						The actual VkBuffers are used to hash the DescriptorSet in RenderFrame::request_descriptor_set.
 	//						Don't know (for now) how that works with resetted buffers!
+	frame_size    = 0;
+	frame_padding = 0;
 	for (auto &buffer_block : buffer_blocks)
 	{
+		frame_size += buffer_block->get_used_size();
+		frame_padding += buffer_block->get_padding();
 		buffer_block->reset();
 	}
+	high_water_mark = std::max(high_water_mark, frame_size);
+}
+
+template <vkb::BindingType bindingType>
+size_t BufferPool<bindingType>::release_idle_blocks(uint32_t idle_frame_count)
+{
+	auto released = std::erase_if(buffer_blocks, [idle_frame_count](auto const &buffer_block) { return buffer_block->get_idle_frames() >= idle_frame_count; });
+	if (released)
+	{
+		LOGD("Released {} idle buffer blocks ({})", released, vk::to_string(usage));
+	}
+	return released;
+}
+
+template <vkb::BindingType bindingType>
+typename BufferPool<bindingType>::DeviceSizeType BufferPool<bindingType>::get_frame_size() const
+{
+	return static_cast<DeviceSizeType>(frame_size);
+}
+
+template <vkb::BindingType bindingType>
+typename BufferPool<bindingType>::DeviceSizeType BufferPool<bindingType>::get_frame_padding() const
+{
+	return static_cast<DeviceSizeType>(frame_padding);
+}
+
+template <vkb::BindingType bindingType>
+typename BufferPool<bindingType>::DeviceSizeType BufferPool<bindingType>::get_high_water_mark() const
+{
+	return static_cast<DeviceSizeType>(high_water_mark);
+}
+
+template <vkb::BindingType bindingType>
+typename BufferPool<bindingType>::DeviceSizeType BufferPool<bindingType>::get_capacity() const
+{
+	vk::DeviceSize capacity = 0;
+	for (auto const &buffer_block : buffer_blocks)
+	{
+		capacity += buffer_block->get_size();
+	}
+	return static_cast<DeviceSizeType>(capacity);
 }
 
 }        // namespace vkb
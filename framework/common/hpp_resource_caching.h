@@ -410,5 +410,78 @@ T &request_resource(vkb::core::DeviceCpp &device, vkb::HPPResourceRecord *record
 
 	return res_it->second;
 }
+
+/**
+ * @brief Hashes the descriptor infos of one binding of a descriptor set
+ * @return The hash, or 0 if the binding has no infos
+ */
+inline size_t hash_descriptor_binding(uint32_t                                    binding_index,
+                                      BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
+                                      BindingMap<vk::DescriptorImageInfo> const  &image_infos)
+{
+	auto buffer_it = buffer_infos.find(binding_index);
+	auto image_it  = image_infos.find(binding_index);
+	if (buffer_it == buffer_infos.end() && image_it == image_infos.end())
+	{
+		return 0;
+	}
+
+	size_t hash = 0;
+	vkb::hash_combine(hash, binding_index);
+	if (buffer_it != buffer_infos.end())
+	{
+		for (auto const &[array_element, buffer_info] : buffer_it->second)
+		{
+			vkb::hash_combine(hash, array_element);
+			vkb::hash_combine(hash, buffer_info);
+		}
+	}
+	if (image_it != image_infos.end())
+	{
+		for (auto const &[array_element, image_info] : image_it->second)
+		{
+			vkb::hash_combine(hash, array_element);
+			vkb::hash_combine(hash, image_info);
+		}
+	}
+	return hash;
+}
+
+/**
+ * @brief Computes the key of a descriptor set in the cache of a render frame, by combining the layout with the hash of
+ *        each binding in ascending order. Bindings that hash to 0 are skipped, so that a caller keeping the hashes of
+ *        its bindings, like the command buffer, can build the same key without walking all the infos again.
+ */
+inline size_t get_descriptor_set_key(vkb::core::HPPDescriptorSetLayout const    &descriptor_set_layout,
+                                     BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
+                                     BindingMap<vk::DescriptorImageInfo> const  &image_infos)
+{
+	size_t key = 0;
+	vkb::hash_combine(key, descriptor_set_layout.get_handle());
+
+	auto buffer_it = buffer_infos.begin();
+	auto image_it  = image_infos.begin();
+	while (buffer_it != buffer_infos.end() || image_it != image_infos.end())
+	{
+		uint32_t binding_index = std::min(buffer_it != buffer_infos.end() ? buffer_it->first : UINT32_MAX,
+		                                  image_it != image_infos.end() ? image_it->first : UINT32_MAX);
+
+		if (size_t binding_hash = hash_descriptor_binding(binding_index, buffer_infos, image_infos))
+		{
+			vkb::hash_combine(key, binding_hash);
+		}
+
+		if (buffer_it != buffer_infos.end() && buffer_it->first == binding_index)
+		{
+			++buffer_it;
+		}
+		if (image_it != image_infos.end() && image_it->first == binding_index)
+		{
+			++image_it;
+		}
+	}
+
+	return key;
+}
 }        // namespace common
 }        // namespace vkb
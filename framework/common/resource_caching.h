@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -555,7 +555,7 @@ inline void hash_param<std::vector<uint8_t>>(
     size_t                     &seed,
     const std::vector<uint8_t> &value)
 {
-	hash_combine(seed, std::string{value.begin(), value.end()});
+	hash_combine_bytes(seed, value.data(), value.size());
 }
 
 template <>
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <span>
+
 #include "common/error.h"
 
 #include "common/glm_common.h"
@@ -41,7 +43,7 @@ std::string get_extension(const std::string &uri);
  * @param data
  * @return data_hash hash of the data
  */
-size_t calculate_hash(const std::vector<uint8_t> &data);
+size_t calculate_hash(std::span<const uint8_t> data);
 
 /**
  * @param name String to convert to snake case
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  * Copyright (c) 2024-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <array>
+#include <bit>
+
 #include "common/hpp_vk_common.h"
 #include "core/device.h"
 #include "core/hpp_descriptor_set_layout.h"
@@ -219,8 +222,9 @@ class CommandBuffer
   private:
 	/**
 	 * @brief Flushes the command buffer, pushing the new changes
+	 * @return False if the pipeline is still compiling in the background and the draw or dispatch has to be skipped
 	 */
-	void flush(vk::PipelineBindPoint pipeline_bind_point);
+	bool flush(vk::PipelineBindPoint pipeline_bind_point);
 
 	/**
 	 * @brief Flush the push constant state
@@ -252,9 +256,9 @@ class CommandBuffer
 	                                                     vkb::common::HPPBufferMemoryBarrier const &memory_barrier);
 	void                      copy_buffer_impl(vkb::core::BufferCpp const &src_buffer, vkb::core::BufferCpp const &dst_buffer, vk::DeviceSize size);
 	void                      execute_commands_impl(std::vector<std::shared_ptr<vkb::core::CommandBuffer<vkb::BindingType::Cpp>>> &secondary_command_buffers);
-	void                      flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
+	bool                      flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
 	void                      flush_descriptor_state_impl(vk::PipelineBindPoint pipeline_bind_point);
-	void                      flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
+	bool                      flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point);
 	vkb::core::HPPRenderPass &get_render_pass_impl(vkb::core::DeviceCpp                                           &device,
 	                                               vkb::rendering::HPPRenderTarget const                          &render_target,
 	                                               std::vector<vkb::common::HPPLoadStoreInfo> const               &load_store_infos,
@@ -263,17 +267,32 @@ class CommandBuffer
 	vk::Result                reset_impl(vkb::CommandBufferResetMode reset_mode);
 
   private:
-	vkb::core::CommandPoolCpp                                              &command_pool;
-	vkb::core::HPPFramebuffer const                                        *current_framebuffer = nullptr;
-	vkb::core::HPPRenderPass const                                         *current_render_pass = nullptr;
-	std::unordered_map<uint32_t, vkb::core::HPPDescriptorSetLayout const *> descriptor_set_layout_binding_state;
-	vk::Extent2D                                                            last_framebuffer_extent = {};
-	vk::Extent2D                                                            last_render_area_extent = {};
-	const vk::CommandBufferLevel                                            level                   = {};
-	const uint32_t                                                          max_push_constants_size = {};
-	vkb::rendering::HPPPipelineState                                        pipeline_state          = {};
-	vkb::HPPResourceBindingState                                            resource_binding_state  = {};
-	std::vector<uint8_t>                                                    stored_push_constants   = {};
+	vkb::core::CommandPoolCpp                                                            &command_pool;
+	vkb::core::HPPFramebuffer const                                                      *current_framebuffer                 = nullptr;
+	vkb::core::HPPRenderPass const                                                       *current_render_pass                 = nullptr;
+	std::array<vkb::core::HPPDescriptorSetLayout const *, vkb::MAX_BOUND_DESCRIPTOR_SETS> descriptor_set_layout_binding_state = {};
+	vk::Extent2D                                                                          last_framebuffer_extent             = {};
+	vk::Extent2D                                                                          last_render_area_extent             = {};
+	const vk::CommandBufferLevel                                                          level                               = {};
+	const uint32_t                                                                        max_push_constants_size             = {};
+	vkb::rendering::HPPPipelineState                                                      pipeline_state                      = {};
+	vkb::HPPResourceBindingState                                                          resource_binding_state              = {};
+	std::vector<uint8_t>                                                                  stored_push_constants               = {};
+
+	/**
+	 * @brief The descriptor infos last written for a set, kept so that a flush only rewrites and rehashes the changed
+	 *        bindings without allocating
+	 */
+	struct DescriptorInfos
+	{
+		vkb::core::HPPDescriptorSetLayout const       *layout = nullptr;
+		BindingMap<vk::DescriptorBufferInfo>           buffer_infos;
+		BindingMap<vk::DescriptorImageInfo>            image_infos;
+		std::array<size_t, vkb::MAX_RESOURCE_BINDINGS> binding_hashes{};        // See vkb::common::hash_descriptor_binding
+	};
+
+	std::array<DescriptorInfos, vkb::MAX_BOUND_DESCRIPTOR_SETS> descriptor_infos = {};
+	std::vector<uint32_t>                                       dynamic_offsets  = {};
 
 	// If true, it becomes the responsibility of the caller to update ANY descriptor bindings
 	// that contain update after bind, as they wont be implicitly updated
@@ -370,7 +389,8 @@ inline void CommandBuffer<bindingType>::begin_impl(vk::CommandBufferUsageFlags
 	// Reset state
 	pipeline_state.reset();
 	resource_binding_state.reset();
-	descriptor_set_layout_binding_state.clear();
+	descriptor_set_layout_binding_state.fill(nullptr);
+	descriptor_infos = {};
 	stored_push_constants.clear();
 
 	vk::CommandBufferBeginInfo       begin_info{.flags = flags};
@@ -416,7 +436,8 @@ inline void CommandBuffer<bindingType>::begin_render_pass(RenderTargetType const
 	// Reset state
 	pipeline_state.reset();
 	resource_binding_state.reset();
-	descriptor_set_layout_binding_state.clear();
+	descriptor_set_layout_binding_state.fill(nullptr);
+	descriptor_infos = {};
 
 	auto &render_pass = get_render_pass(render_target, load_store_infos, subpasses);
 	auto &framebuffer = this->get_device().get_resource_cache().request_framebuffer(render_target, render_pass);
@@ -759,14 +780,20 @@ inline void CommandBuffer<bindingType>::copy_image_to_buffer(ImageType const
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::dispatch(uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z)
 {
-	flush(vk::PipelineBindPoint::eCompute);
+	if (!flush(vk::PipelineBindPoint::eCompute))
+	{
+		return;
+	}
 	this->get_resource().dispatch(group_count_x, group_count_y, group_count_z);
 }
 
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::dispatch_indirect(vkb::core::Buffer<bindingType> const &buffer, DeviceSizeType offset)
 {
-	flush(vk::PipelineBindPoint::eCompute);
+	if (!flush(vk::PipelineBindPoint::eCompute))
+	{
+		return;
+	}
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
 		this->get_resource().dispatchIndirect(buffer.get_handle(), offset);
@@ -780,7 +807,10 @@ inline void CommandBuffer<bindingType>::dispatch_indirect(vkb::core::Buffer<bind
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance)
 {
-	flush(vk::PipelineBindPoint::eGraphics);
+	if (!flush(vk::PipelineBindPoint::eGraphics))
+	{
+		return;
+	}
 	this->get_resource().draw(vertex_count, instance_count, first_vertex, first_instance);
 }
 
@@ -788,14 +818,20 @@ template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::draw_indexed(
     uint32_t index_count, uint32_t instance_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
 {
-	flush(vk::PipelineBindPoint::eGraphics);
+	if (!flush(vk::PipelineBindPoint::eGraphics))
+	{
+		return;
+	}
 	this->get_resource().drawIndexed(index_count, instance_count, first_index, vertex_offset, first_instance);
 }
 
 template <vkb::BindingType bindingType>
 inline void CommandBuffer<bindingType>::draw_indexed_indirect(vkb::core::Buffer<bindingType> const &buffer, DeviceSizeType offset, uint32_t draw_count, uint32_t stride)
 {
-	flush(vk::PipelineBindPoint::eGraphics);
+	if (!flush(vk::PipelineBindPoint::eGraphics))
+	{
+		return;
+	}
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
 		this->get_resource().drawIndexedIndirect(buffer.get_handle(), offset, draw_count, stride);
@@ -999,7 +1035,8 @@ inline void CommandBuffer<bindingType>::next_subpass()
 
 	// Reset descriptor sets
 	resource_binding_state.reset();
-	descriptor_set_layout_binding_state.clear();
+	descriptor_set_layout_binding_state.fill(nullptr);
+	descriptor_infos = {};
 
 	// Clear stored push constants
 	stored_push_constants.clear();
@@ -1290,24 +1327,32 @@ inline void CommandBuffer<bindingType>::write_timestamp(PipelineStagFlagBitsType
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::flush(vk::PipelineBindPoint pipeline_bind_point)
+inline bool CommandBuffer<bindingType>::flush(vk::PipelineBindPoint pipeline_bind_point)
 {
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		flush_impl(this->get_device(), pipeline_bind_point);
+		return flush_impl(this->get_device(), pipeline_bind_point);
 	}
 	else
 	{
-		flush_impl(reinterpret_cast<vkb::core::DeviceCpp &>(this->get_device()), pipeline_bind_point);
+		return flush_impl(reinterpret_cast<vkb::core::DeviceCpp &>(this->get_device()), pipeline_bind_point);
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
+inline bool CommandBuffer<bindingType>::flush_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
 {
-	flush_pipeline_state_impl(device, pipeline_bind_point);
+	if (!flush_pipeline_state_impl(device, pipeline_bind_point))
+	{
+		// Push constants only apply to the next draw, so they are dropped with the skipped one;
+		// the descriptor state stays dirty and is flushed with the next draw
+		stored_push_constants.clear();
+		return false;
+	}
+
 	flush_push_constants();
 	flush_descriptor_state_impl(pipeline_bind_point);
+	return true;
 }
 
 template <vkb::BindingType bindingType>
@@ -1317,7 +1362,8 @@ inline void CommandBuffer<bindingType>::flush_descriptor_state_impl(vk::Pipeline
 
 	const auto &pipeline_layout = pipeline_state.get_pipeline_layout();
 
-	std::unordered_set<uint32_t> update_descriptor_sets;
+	// Sets whose bound layout differs from the one of the pipeline, so that the command buffer later updates them
+	uint32_t update_descriptor_sets = 0;
 
 	// Iterate over the shader sets to check if they have already been bound
 	// If they have, add the set so that the command buffer later updates it
@@ -1325,172 +1371,215 @@ inline void CommandBuffer<bindingType>::flush_descriptor_state_impl(vk::Pipeline
 	{
 		uint32_t descriptor_set_id = set_it.first;
 
-		auto descriptor_set_layout_it = descriptor_set_layout_binding_state.find(descriptor_set_id);
+		// Sets past the tracked ones can't have resources bound by the command buffer
+		if (descriptor_set_id >= vkb::MAX_BOUND_DESCRIPTOR_SETS)
+		{
+			continue;
+		}
+
+		auto descriptor_set_layout = descriptor_set_layout_binding_state[descriptor_set_id];
 
-		if (descriptor_set_layout_it != descriptor_set_layout_binding_state.end())
+		if (descriptor_set_layout && descriptor_set_layout->get_handle() != pipeline_layout.get_descriptor_set_layout(descriptor_set_id).get_handle())
 		{
-			if (descriptor_set_layout_it->second->get_handle() != pipeline_layout.get_descriptor_set_layout(descriptor_set_id).get_handle())
-			{
-				update_descriptor_sets.emplace(descriptor_set_id);
-			}
+			update_descriptor_sets |= 1u << descriptor_set_id;
 		}
 	}
 
 	// Validate that the bound descriptor set layouts exist in the pipeline layout
-	for (auto set_it = descriptor_set_layout_binding_state.begin(); set_it != descriptor_set_layout_binding_state.end();)
+	for (uint32_t descriptor_set_id = 0; descriptor_set_id < vkb::MAX_BOUND_DESCRIPTOR_SETS; ++descriptor_set_id)
 	{
-		if (!pipeline_layout.has_descriptor_set_layout(set_it->first))
-		{
-			set_it = descriptor_set_layout_binding_state.erase(set_it);
-		}
-		else
+		if (descriptor_set_layout_binding_state[descriptor_set_id] && !pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
 		{
-			++set_it;
+			descriptor_set_layout_binding_state[descriptor_set_id] = nullptr;
 		}
 	}
 
-	// Check if a descriptor set needs to be created
-	if (resource_binding_state.is_dirty() || !update_descriptor_sets.empty())
+	// Only the resource sets whose state changed or whose layout needs updating get a descriptor set
+	uint32_t flush_sets = resource_binding_state.get_dirty_sets() | (update_descriptor_sets & resource_binding_state.get_bound_sets());
+
+	for (; flush_sets != 0; flush_sets &= flush_sets - 1)
 	{
-		resource_binding_state.clear_dirty();
+		uint32_t descriptor_set_id = std::countr_zero(flush_sets);
 
-		// Iterate over all of the resource sets bound by the command buffer
-		for (auto &resource_set_it : resource_binding_state.get_resource_sets())
-		{
-			uint32_t descriptor_set_id = resource_set_it.first;
-			auto    &resource_set      = resource_set_it.second;
+		auto    &resource_set   = resource_binding_state.get_resource_set(descriptor_set_id);
+		uint32_t dirty_bindings = resource_set.get_dirty_bindings();
 
-			// Don't update resource set if it's not in the update list OR its state hasn't changed
-			if (!resource_set.is_dirty() && (update_descriptor_sets.find(descriptor_set_id) == update_descriptor_sets.end()))
-			{
-				continue;
-			}
+		// Clear dirty flag for resource set
+		resource_binding_state.clear_dirty(descriptor_set_id);
+
+		// Skip resource set if a descriptor set layout doesn't exist for it, its infos miss the changes skipped here
+		if (!pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
+		{
+			descriptor_infos[descriptor_set_id].layout = nullptr;
+			continue;
+		}
 
-			// Clear dirty flag for resource set
-			resource_binding_state.clear_dirty(descriptor_set_id);
+		auto &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(descriptor_set_id);
 
-			// Skip resource set if a descriptor set layout doesn't exist for it
-			if (!pipeline_layout.has_descriptor_set_layout(descriptor_set_id))
-			{
-				continue;
-			}
+		// Make descriptor set layout bound for current set
+		descriptor_set_layout_binding_state[descriptor_set_id] = &descriptor_set_layout;
 
-			auto &descriptor_set_layout = pipeline_layout.get_descriptor_set_layout(descriptor_set_id);
+		// The infos depend on the descriptor types of the layout, so a new layout rewrites all of them
+		auto &infos = descriptor_infos[descriptor_set_id];
+		if (infos.layout != &descriptor_set_layout)
+		{
+			infos.layout = &descriptor_set_layout;
+			infos.buffer_infos.clear();
+			infos.image_infos.clear();
+			infos.binding_hashes.fill(0);
 
-			// Make descriptor set layout bound for current set
-			descriptor_set_layout_binding_state[descriptor_set_id] = &descriptor_set_layout;
+			dirty_bindings = resource_set.get_bound_bindings();
+		}
 
-			BindingMap<vk::DescriptorBufferInfo> buffer_infos;
-			BindingMap<vk::DescriptorImageInfo>  image_infos;
+		// Iterate over the changed resource bindings, the infos of the others are still valid
+		for (; dirty_bindings != 0; dirty_bindings &= dirty_bindings - 1)
+		{
+			uint32_t binding_index = std::countr_zero(dirty_bindings);
 
-			std::vector<uint32_t> dynamic_offsets;
+			// Check if binding exists in the pipeline layout
+			auto binding_info = descriptor_set_layout.find_layout_binding(binding_index);
+			if (!binding_info)
+			{
+				continue;
+			}
 
-			// Iterate over all resource bindings
-			for (auto &binding_it : resource_set.get_resource_bindings())
+			// Iterate over all binding resources
+			auto binding_resources = resource_set.get_resources(binding_index);
+			for (uint32_t array_element = 0; array_element < binding_resources.size(); ++array_element)
 			{
-				auto  binding_index     = binding_it.first;
-				auto &binding_resources = binding_it.second;
+				auto &resource_info = binding_resources[array_element];
 
-				// Check if binding exists in the pipeline layout
-				if (auto binding_info = descriptor_set_layout.get_layout_binding(binding_index))
-				{
-					// Iterate over all binding resources
-					for (auto &element_it : binding_resources)
-					{
-						auto  array_element = element_it.first;
-						auto &resource_info = element_it.second;
+				// Pointer references
+				auto &buffer     = resource_info.buffer;
+				auto &sampler    = resource_info.sampler;
+				auto &image_view = resource_info.image_view;
 
-						// Pointer references
-						auto &buffer     = resource_info.buffer;
-						auto &sampler    = resource_info.sampler;
-						auto &image_view = resource_info.image_view;
+				// Get buffer info
+				if (buffer != nullptr && vkb::common::is_buffer_descriptor_type(binding_info->descriptorType))
+				{
+					vk::DescriptorBufferInfo buffer_info{resource_info.buffer->get_handle(), resource_info.offset, resource_info.range};
 
-						// Get buffer info
-						if (buffer != nullptr && vkb::common::is_buffer_descriptor_type(binding_info->descriptorType))
-						{
-							vk::DescriptorBufferInfo buffer_info{resource_info.buffer->get_handle(), resource_info.offset, resource_info.range};
+					// The offset is passed when binding the descriptor set instead
+					if (vkb::common::is_dynamic_buffer_descriptor_type(binding_info->descriptorType))
+					{
+						buffer_info.offset = 0;
+					}
 
-							if (vkb::common::is_dynamic_buffer_descriptor_type(binding_info->descriptorType))
-							{
-								dynamic_offsets.push_back(to_u32(buffer_info.offset));
-								buffer_info.offset = 0;
-							}
+					infos.buffer_infos[binding_index][array_element] = buffer_info;
+				}
 
-							buffer_infos[binding_index][array_element] = buffer_info;
-						}
+				// Get image info
+				else if (image_view != nullptr || sampler != nullptr)
+				{
+					// Can be null for input attachments
+					vk::DescriptorImageInfo image_info{sampler ? sampler->get_handle() : nullptr, image_view->get_handle()};
 
-						// Get image info
-						else if (image_view != nullptr || sampler != nullptr)
+					if (image_view != nullptr)
+					{
+						// Add image layout info based on descriptor type
+						switch (binding_info->descriptorType)
 						{
-							// Can be null for input attachments
-							vk::DescriptorImageInfo image_info{sampler ? sampler->get_handle() : nullptr, image_view->get_handle()};
-
-							if (image_view != nullptr)
-							{
-								// Add image layout info based on descriptor type
-								switch (binding_info->descriptorType)
-								{
-									case vk::DescriptorType::eCombinedImageSampler:
-										image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-										break;
-									case vk::DescriptorType::eInputAttachment:
-										image_info.imageLayout = vkb::common::is_depth_format(image_view->get_format()) ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
-										break;
-									case vk::DescriptorType::eStorageImage:
-										image_info.imageLayout = vk::ImageLayout::eGeneral;
-										break;
-									default:
-										continue;
-								}
-							}
-
-							image_infos[binding_index][array_element] = image_info;
+							case vk::DescriptorType::eCombinedImageSampler:
+								image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+								break;
+							case vk::DescriptorType::eInputAttachment:
+								image_info.imageLayout = vkb::common::is_depth_format(image_view->get_format()) ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eShaderReadOnlyOptimal;
+								break;
+							case vk::DescriptorType::eStorageImage:
+								image_info.imageLayout = vk::ImageLayout::eGeneral;
+								break;
+							default:
+								continue;
 						}
 					}
 
-					assert((!update_after_bind || (buffer_infos.count(binding_index) > 0 || (image_infos.count(binding_index) > 0))) &&
-					       "binding index with no buffer or image infos can't be checked for adding to bindings_to_update");
+					infos.image_infos[binding_index][array_element] = image_info;
 				}
 			}
 
-			vk::DescriptorSet descriptor_set_handle = command_pool.get_render_frame()->request_descriptor_set(
-			    descriptor_set_layout, buffer_infos, image_infos, update_after_bind, command_pool.get_thread_index());
+			assert((!update_after_bind || (infos.buffer_infos.count(binding_index) > 0 || (infos.image_infos.count(binding_index) > 0))) &&
+			       "binding index with no buffer or image infos can't be checked for adding to bindings_to_update");
 
-			// Bind descriptor set
-			this->get_resource().bindDescriptorSets(pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_id, descriptor_set_handle, dynamic_offsets);
+			infos.binding_hashes[binding_index] = vkb::common::hash_descriptor_binding(binding_index, infos.buffer_infos, infos.image_infos);
 		}
+
+		// Same key as vkb::common::get_descriptor_set_key, from the hashes of the unchanged bindings
+		size_t descriptor_set_key = 0;
+		vkb::hash_combine(descriptor_set_key, descriptor_set_layout.get_handle());
+		for (auto binding_hash : infos.binding_hashes)
+		{
+			if (binding_hash)
+			{
+				vkb::hash_combine(descriptor_set_key, binding_hash);
+			}
+		}
+
+		// Dynamic offsets go in the order of the bindings and their elements
+		dynamic_offsets.clear();
+		for (auto &[binding_index, binding_infos] : infos.buffer_infos)
+		{
+			if (vkb::common::is_dynamic_buffer_descriptor_type(descriptor_set_layout.find_layout_binding(binding_index)->descriptorType))
+			{
+				auto binding_resources = resource_set.get_resources(binding_index);
+				for (auto &[array_element, buffer_info] : binding_infos)
+				{
+					dynamic_offsets.push_back(to_u32(binding_resources[array_element].offset));
+				}
+			}
+		}
+
+		vk::DescriptorSet descriptor_set_handle = command_pool.get_render_frame()->request_descriptor_set(
+		    descriptor_set_layout, infos.buffer_infos, infos.image_infos, descriptor_set_key, update_after_bind, command_pool.get_thread_index());
+
+		// Bind descriptor set
+		this->get_resource().bindDescriptorSets(pipeline_bind_point, pipeline_layout.get_handle(), descriptor_set_id, descriptor_set_handle, dynamic_offsets);
 	}
 }
 
 template <vkb::BindingType bindingType>
-inline void CommandBuffer<bindingType>::flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
+inline bool CommandBuffer<bindingType>::flush_pipeline_state_impl(vkb::core::DeviceCpp &device, vk::PipelineBindPoint pipeline_bind_point)
 {
 	// Create a new pipeline only if the graphics state changed
 	if (!pipeline_state.is_dirty())
 	{
-		return;
+		return true;
 	}
 
-	pipeline_state.clear_dirty();
-
-	// Create and bind pipeline
+	// Request and bind pipeline, which may still be compiling in the background
+	vk::Pipeline pipeline_handle;
+	bool         is_fallback = false;
 	if (pipeline_bind_point == vk::PipelineBindPoint::eGraphics)
 	{
 		pipeline_state.set_render_pass(*current_render_pass);
-		auto &pipeline = device.get_resource_cache().request_graphics_pipeline(pipeline_state);
-
-		this->get_resource().bindPipeline(pipeline_bind_point, pipeline.get_handle());
+		if (auto pipeline = device.get_resource_cache().request_graphics_pipeline_for_draw(pipeline_state, is_fallback))
+		{
+			pipeline_handle = pipeline->get_handle();
+		}
 	}
 	else if (pipeline_bind_point == vk::PipelineBindPoint::eCompute)
 	{
-		auto &pipeline = device.get_resource_cache().request_compute_pipeline(pipeline_state);
-
-		this->get_resource().bindPipeline(pipeline_bind_point, pipeline.get_handle());
+		if (auto pipeline = device.get_resource_cache().request_compute_pipeline_for_dispatch(pipeline_state, is_fallback))
+		{
+			pipeline_handle = pipeline->get_handle();
+		}
 	}
 	else
 	{
 		throw "Only graphics and compute pipeline bind points are supported now";
 	}
+
+	// Until the pipeline is compiled the state stays dirty, so that the next draw requests it again
+	if (!pipeline_handle)
+	{
+		return false;
+	}
+	if (!is_fallback)
+	{
+		pipeline_state.clear_dirty();
+	}
+
+	this->get_resource().bindPipeline(pipeline_bind_point, pipeline_handle);
+	return true;
 }
 
 template <vkb::BindingType bindingType>
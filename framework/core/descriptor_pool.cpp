@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -76,6 +76,7 @@ void DescriptorPool::reset()
 	// Clear internal tracking of descriptor set allocations
 	std::fill(pool_sets_count.begin(), pool_sets_count.end(), 0);
 	set_pool_mapping.clear();
+	recycled_sets.clear();
 
 	// Reset the pool index from which descriptor sets are allocated
 	pool_index = 0;
@@ -94,6 +95,13 @@ void DescriptorPool::set_descriptor_set_layout(const DescriptorSetLayout &set_la
 
 VkDescriptorSet DescriptorPool::allocate()
 {
+	if (!recycled_sets.empty())
+	{
+		VkDescriptorSet handle = recycled_sets.back();
+		recycled_sets.pop_back();
+		return handle;
+	}
+
 	pool_index = find_available_pool(pool_index);
 
 	// Increment allocated set count for the current pool
@@ -152,6 +160,23 @@ VkResult DescriptorPool::free(VkDescriptorSet descriptor_set)
 	return VK_SUCCESS;
 }
 
+void DescriptorPool::recycle(VkDescriptorSet descriptor_set)
+{
+	assert(set_pool_mapping.count(descriptor_set) > 0 && "Descriptor set was not allocated from this pool");
+
+	recycled_sets.push_back(descriptor_set);
+}
+
+size_t DescriptorPool::get_pool_count() const
+{
+	return pools.size();
+}
+
+size_t DescriptorPool::get_live_set_count() const
+{
+	return set_pool_mapping.size() - recycled_sets.size();
+}
+
 std::uint32_t DescriptorPool::find_available_pool(std::uint32_t search_index)
 {
 	// Create a new pool
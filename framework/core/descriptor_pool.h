@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -61,10 +61,29 @@ class DescriptorPool
 
 	void set_descriptor_set_layout(const DescriptorSetLayout &set_layout);
 
+	/**
+	 * @brief Allocates a descriptor set, reusing a recycled one first
+	 */
 	VkDescriptorSet allocate();
 
 	VkResult free(VkDescriptorSet descriptor_set);
 
+	/**
+	 * @brief Returns a descriptor set the GPU no longer uses to the pool, for allocate to hand out again.
+	 *        Its contents are rewritten by the next owner, so the pools do not need to support freeing sets.
+	 */
+	void recycle(VkDescriptorSet descriptor_set);
+
+	/**
+	 * @return The number of VkDescriptorPool objects created
+	 */
+	size_t get_pool_count() const;
+
+	/**
+	 * @return The number of descriptor sets allocated and not recycled
+	 */
+	size_t get_live_set_count() const;
+
   private:
 	vkb::core::DeviceC &device;
 
@@ -88,6 +107,9 @@ class DescriptorPool
 	// Map between descriptor set and pool index
 	std::unordered_map<VkDescriptorSet, uint32_t> set_pool_mapping;
 
+	// Descriptor sets returned with recycle, still allocated from their pools
+	std::vector<VkDescriptorSet> recycled_sets;
+
 	// Find next pool index or create new pool
 	uint32_t find_available_pool(uint32_t pool_index);
 };
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -257,6 +257,18 @@ std::unique_ptr<VkDescriptorSetLayoutBinding> DescriptorSetLayout::get_layout_bi
 	return get_layout_binding(it->second);
 }
 
+const VkDescriptorSetLayoutBinding *DescriptorSetLayout::find_layout_binding(const uint32_t binding_index) const
+{
+	auto it = bindings_lookup.find(binding_index);
+
+	if (it == bindings_lookup.end())
+	{
+		return nullptr;
+	}
+
+	return &it->second;
+}
+
 VkDescriptorBindingFlagsEXT DescriptorSetLayout::get_layout_binding_flag(const uint32_t binding_index) const
 {
 	auto it = binding_flags_lookup.find(binding_index);
@@ -26,6 +26,7 @@
 #include "hpp_queue.h"
 #include "hpp_resource_cache.h"
 #include "queue.h"
+#include "stats/stats_counters.h"
 #include <utility>
 #include <vulkan/vulkan.hpp>
 
@@ -123,6 +124,7 @@ class Device
 	CoreQueueType const                 &get_queue_by_flags(QueueFlagsType queue_flags, uint32_t queue_index) const;
 	CoreQueueType const                 &get_queue_by_present(uint32_t queue_index) const;
 	ResourceCacheType                   &get_resource_cache();
+	vkb::StatsCounters                  &get_stats_counters();
 	bool                                 is_extension_enabled(const char *extension) const;
 	bool                                 is_image_format_supported(FormatType format) const;
 	void                                 wait_idle() const;
@@ -146,6 +148,7 @@ class Device
 	vkb::core::PhysicalDeviceCpp                 &gpu;
 	std::vector<std::vector<vkb::core::HPPQueue>> queues;
 	vkb::HPPResourceCache                         resource_cache;
+	vkb::StatsCounters                            stats_counters;
 	vk::SurfaceKHR                                surface = nullptr;
 };
 
@@ -201,6 +204,9 @@ inline Device<vkb::BindingType::C>::Device(vkb::core::PhysicalDeviceC &gpu, VkDe
 template <vkb::BindingType bindingType>
 inline Device<bindingType>::~Device()
 {
+	// Save the pipeline cache before clear() destroys it, with the pipelines still compiling in the background
+	resource_cache.wait_for_pipelines();
+	resource_cache.save_pipeline_cache();
 	resource_cache.clear();
 	command_pool.reset();
 	fence_pool.reset();
@@ -469,6 +475,12 @@ inline typename Device<bindingType>::ResourceCacheType &Device<bindingType>::get
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::StatsCounters &Device<bindingType>::get_stats_counters()
+{
+	return stats_counters;
+}
+
 template <vkb::BindingType bindingType>
 inline bool Device<bindingType>::is_extension_enabled(const char *extension) const
 {
@@ -779,6 +791,11 @@ inline void Device<bindingType>::init(std::unordered_map<const char *, bool> con
 		    get_queue_by_flags_impl(vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute, 0).get_family_index());
 		fence_pool = std::make_unique<vkb::HPPFencePool>(*reinterpret_cast<vkb::core::DeviceCpp *>(this));
 	}
+
+	if (vkb::ResourceCache::is_persistent_pipeline_cache_enabled())
+	{
+		resource_cache.load_pipeline_cache();
+	}
 }
 
 }        // namespace core
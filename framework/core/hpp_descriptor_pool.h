@@ -37,12 +37,19 @@ using DeviceC   = Device<vkb::BindingType::C>;
 class HPPDescriptorPool : private vkb::DescriptorPool
 {
   public:
+	using vkb::DescriptorPool::get_live_set_count;
+	using vkb::DescriptorPool::get_pool_count;
 	using vkb::DescriptorPool::reset;
 
 	HPPDescriptorPool(vkb::core::DeviceCpp &device, const vkb::core::HPPDescriptorSetLayout &descriptor_set_layout, uint32_t pool_size = MAX_SETS_PER_POOL) :
 	    vkb::DescriptorPool(
 	        reinterpret_cast<vkb::core::DeviceC &>(device), reinterpret_cast<vkb::DescriptorSetLayout const &>(descriptor_set_layout), pool_size)
 	{}
+
+	void recycle(vk::DescriptorSet descriptor_set)
+	{
+		vkb::DescriptorPool::recycle(static_cast<VkDescriptorSet>(descriptor_set));
+	}
 };
 }        // namespace core
 }        // namespace vkb
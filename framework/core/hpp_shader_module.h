@@ -91,7 +91,10 @@ class HPPShaderSource : private vkb::ShaderSource
 };
 
 class HPPShaderVariant : private vkb::ShaderVariant
-{};
+{
+  public:
+	using vkb::ShaderVariant::get_id;
+};
 
 class HPPShaderModule : private vkb::ShaderModule
 {
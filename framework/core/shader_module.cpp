@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,10 +17,12 @@
 
 #include "shader_module.h"
 
+#include <cstring>
+
 #include "core/util/logging.hpp"
 #include "device.h"
 #include "filesystem/legacy.h"
-#include "spirv_reflection.h"
+#include "shader_reflection_cache.h"
 
 namespace vkb
 {
@@ -33,32 +35,31 @@ ShaderModule::ShaderModule(vkb::core::DeviceC   &device,
 {
 	debug_name = fmt::format("{} [variant {:X}] [entrypoint {}]", shader_source.get_filename(), shader_variant.get_id(), entry_point);
 
-	// Shaders in binary SPIR-V format can be loaded directly
-	spirv = vkb::fs::read_shader_binary_u32(shader_source.get_filename());
+	// The source holds the bytes of the SPIR-V file, so it is not read again
+	const std::string &source = shader_source.get_source();
+	assert(source.size() % sizeof(uint32_t) == 0);
+	spirv.resize(source.size() / sizeof(uint32_t));
+	std::memcpy(spirv.data(), source.data(), source.size());
 
-	// Reflection is used to dynamically create descriptor bindings
+	// The id of the source is the hash of these bytes, which makes it unique for the binary
+	id = shader_source.get_id();
 
-	SPIRVReflection spirv_reflection;
-	// Reflect all shader resources
-	if (!spirv_reflection.reflect_shader_resources(stage, spirv, resources, shader_variant))
+	// Reflection is used to dynamically create descriptor bindings, it is cached across modules and runs
+	auto &reflection_cache = ShaderReflectionCache::get();
+	if (!reflection_cache.reflect_shader_resources(ShaderReflectionCache::get_key(id, stage, shader_variant), stage, spirv, resources, shader_variant))
 	{
 		throw VulkanException{VK_ERROR_INITIALIZATION_FAILED};
 	}
-
-	// Generate a unique id, determined by source and variant
-	std::hash<std::string> hasher{};
-	id = hasher(std::string{reinterpret_cast<const char *>(spirv.data()),
-	                        reinterpret_cast<const char *>(spirv.data() + spirv.size())});
 }
 
 ShaderModule::ShaderModule(ShaderModule &&other) :
     device{other.device},
     id{other.id},
     stage{other.stage},
-    entry_point{other.entry_point},
-    debug_name{other.debug_name},
-    spirv{other.spirv},
-    resources{other.resources}
+    entry_point{std::move(other.entry_point)},
+    debug_name{std::move(other.debug_name)},
+    spirv{std::move(other.spirv)},
+    resources{std::move(other.resources)}
 {
 	other.stage = {};
 }
@@ -153,8 +154,7 @@ ShaderSource::ShaderSource(const std::string &filename) :
     filename{filename},
     source{fs::read_text_file(filename)}
 {
-	std::hash<std::string> hasher{};
-	id = hasher(std::string{this->source.cbegin(), this->source.cend()});
+	id = static_cast<size_t>(hash_bytes(source.data(), source.size()));
 }
 
 size_t ShaderSource::get_id() const
@@ -170,8 +170,7 @@ const std::string &ShaderSource::get_filename() const
 void ShaderSource::set_source(const std::string &source_)
 {
 	source = source_;
-	std::hash<std::string> hasher{};
-	id = hasher(std::string{this->source.cbegin(), this->source.cend()});
+	id = static_cast<size_t>(hash_bytes(source.data(), source.size()));
 }
 
 const std::string &ShaderSource::get_source() const
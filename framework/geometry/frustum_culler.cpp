@@ -0,0 +1,204 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frustum_culler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <numeric>
+
+#include <core/util/thread_pool.hpp>
+
+#include "common/helpers.h"
+
+namespace vkb
+{
+namespace
+{
+// Number of boxes tested by one task when culling on a thread pool,
+// below that the cost of scheduling the task outweighs the tests
+constexpr uint32_t CULL_BATCH_SIZE = 4096;
+
+// Half extent of boxes which are never culled, large enough to intersect every plane
+// and small enough for the plane tests not to overflow
+constexpr float ALWAYS_VISIBLE_EXTENT = 1e30f;
+}        // namespace
+
+void FrustumCuller::clear()
+{
+	center_x.clear();
+	center_y.clear();
+	center_z.clear();
+	extent_x.clear();
+	extent_y.clear();
+	extent_z.clear();
+	visibility.clear();
+	visible_count = 0;
+}
+
+uint32_t FrustumCuller::add(const glm::vec3 &min, const glm::vec3 &max, const glm::mat4 &transform)
+{
+	glm::vec3 center  = transform * glm::vec4((min + max) * 0.5f, 1.0f);
+	glm::vec3 extents = glm::mat3(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])), glm::abs(glm::vec3(transform[2]))) * ((max - min) * 0.5f);
+
+	center_x.push_back(center.x);
+	center_y.push_back(center.y);
+	center_z.push_back(center.z);
+	extent_x.push_back(extents.x);
+	extent_y.push_back(extents.y);
+	extent_z.push_back(extents.z);
+
+	return to_u32(center_x.size() - 1);
+}
+
+uint32_t FrustumCuller::add_always_visible()
+{
+	center_x.push_back(0.0f);
+	center_y.push_back(0.0f);
+	center_z.push_back(0.0f);
+	extent_x.push_back(ALWAYS_VISIBLE_EXTENT);
+	extent_y.push_back(ALWAYS_VISIBLE_EXTENT);
+	extent_z.push_back(ALWAYS_VISIBLE_EXTENT);
+
+	return to_u32(center_x.size() - 1);
+}
+
+void FrustumCuller::cull(const glm::mat4 &view_projection, const glm::vec3 &camera_position_)
+{
+	uint32_t count = get_count();
+
+	visibility.assign(count, 1);
+
+	if (!enabled)
+	{
+		visible_count = count;
+		return;
+	}
+
+	frustum.update(view_projection);
+	camera_position = camera_position_;
+
+	if (thread_pool && count > CULL_BATCH_SIZE)
+	{
+		std::vector<std::future<void>> batches;
+		for (uint32_t begin = 0; begin < count; begin += CULL_BATCH_SIZE)
+		{
+			uint32_t end = std::min(count, begin + CULL_BATCH_SIZE);
+			batches.push_back(thread_pool->push([this, begin, end]() { cull_range(begin, end); }));
+		}
+
+		for (auto &batch : batches)
+		{
+			batch.get();
+		}
+	}
+	else
+	{
+		cull_range(0, count);
+	}
+
+	visible_count = std::accumulate(visibility.begin(), visibility.end(), 0u);
+}
+
+void FrustumCuller::cull_range(uint32_t begin, uint32_t end)
+{
+	const float *cx      = center_x.data();
+	const float *cy      = center_y.data();
+	const float *cz      = center_z.data();
+	const float *ex      = extent_x.data();
+	const float *ey      = extent_y.data();
+	const float *ez      = extent_z.data();
+	uint8_t     *visible = visibility.data();
+
+	// One plane at a time over the whole range, so the inner loops have no dependency between boxes
+	for (auto &plane : frustum.get_planes())
+	{
+		const float nx = plane.x, ny = plane.y, nz = plane.z, w = plane.w;
+		const float ax = std::abs(nx), ay = std::abs(ny), az = std::abs(nz);
+
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			float distance = nx * cx[i] + ny * cy[i] + nz * cz[i] + w;
+			float radius   = ax * ex[i] + ay * ey[i] + az * ez[i];
+			visible[i] &= static_cast<uint8_t>(distance + radius > 0.0f);
+		}
+	}
+
+	if (max_distance > 0.0f || min_size_ratio > 0.0f)
+	{
+		const float px           = camera_position.x, py = camera_position.y, pz = camera_position.z;
+		const float far_distance = max_distance > 0.0f ? max_distance : std::numeric_limits<float>::max();
+
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			float dx = cx[i] - px, dy = cy[i] - py, dz = cz[i] - pz;
+
+			float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+			float radius   = std::sqrt(ex[i] * ex[i] + ey[i] * ey[i] + ez[i] * ez[i]);
+
+			visible[i] &= static_cast<uint8_t>((distance - radius <= far_distance) & (radius >= min_size_ratio * distance));
+		}
+	}
+}
+
+bool FrustumCuller::is_visible(uint32_t index) const
+{
+	return visibility[index] != 0;
+}
+
+glm::vec3 FrustumCuller::get_center(uint32_t index) const
+{
+	return {center_x[index], center_y[index], center_z[index]};
+}
+
+uint32_t FrustumCuller::get_count() const
+{
+	return to_u32(center_x.size());
+}
+
+uint32_t FrustumCuller::get_visible_count() const
+{
+	return visible_count;
+}
+
+void FrustumCuller::set_enabled(bool enabled_)
+{
+	enabled = enabled_;
+}
+
+bool FrustumCuller::is_enabled() const
+{
+	return enabled;
+}
+
+void FrustumCuller::set_max_distance(float distance)
+{
+	max_distance = distance;
+}
+
+void FrustumCuller::set_min_size_ratio(float ratio)
+{
+	min_size_ratio = ratio;
+}
+
+void FrustumCuller::set_thread_pool(ThreadPool *thread_pool_)
+{
+	thread_pool = thread_pool_;
+}
+}        // namespace vkb
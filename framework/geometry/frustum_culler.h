@@ -0,0 +1,132 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/glm_common.h"
+#include "geometry/frustum.h"
+
+namespace vkb
+{
+class ThreadPool;
+
+/**
+ * @brief Culls world space bounding boxes against a frustum, and optionally against distance and size thresholds.
+ *
+ * Boxes are stored as separate arrays of centers and half extents, so each plane is tested against a run of
+ * consecutive floats with the same instructions, which the compiler vectorizes (SSE, NEON) without branches.
+ * Large sets can be split across the workers of a thread pool.
+ */
+class FrustumCuller
+{
+  public:
+	/**
+	 * @brief Removes all boxes, keeping the storage for the next frame
+	 */
+	void clear();
+
+	/**
+	 * @brief Adds a box in local space, transformed to world space by the given matrix
+	 * @return The index of the box
+	 */
+	uint32_t add(const glm::vec3 &min, const glm::vec3 &max, const glm::mat4 &transform);
+
+	/**
+	 * @brief Adds a box which is never culled, e.g. for geometry without bounds
+	 * @return The index of the box
+	 */
+	uint32_t add_always_visible();
+
+	/**
+	 * @brief Tests all boxes
+	 * @param view_projection The matrix boxes are culled with, the frustum planes are extracted from it
+	 * @param camera_position World position of the camera, used by the distance and size thresholds
+	 */
+	void cull(const glm::mat4 &view_projection, const glm::vec3 &camera_position);
+
+	/**
+	 * @param index Index of a box
+	 * @return True if the box passed all the tests of the last call to cull
+	 */
+	bool is_visible(uint32_t index) const;
+
+	/**
+	 * @return The world space center of a box
+	 */
+	glm::vec3 get_center(uint32_t index) const;
+
+	uint32_t get_count() const;
+
+	uint32_t get_visible_count() const;
+
+	/**
+	 * @brief Enables or disables culling, when disabled every box is visible
+	 */
+	void set_enabled(bool enabled);
+
+	bool is_enabled() const;
+
+	/**
+	 * @brief Culls boxes whose closest point is further than a distance from the camera
+	 * @param distance The maximum distance, 0 disables the test
+	 */
+	void set_max_distance(float distance);
+
+	/**
+	 * @brief Culls boxes whose bounding sphere covers less than a fraction of the view,
+	 *        measured as the ratio of its radius to its distance from the camera
+	 * @param ratio The minimum ratio, 0 disables the test
+	 */
+	void set_min_size_ratio(float ratio);
+
+	/**
+	 * @brief Spreads the tests of large sets of boxes over the workers of a thread pool
+	 * @param thread_pool The thread pool, or nullptr to cull on the calling thread
+	 */
+	void set_thread_pool(ThreadPool *thread_pool);
+
+  private:
+	void cull_range(uint32_t begin, uint32_t end);
+
+	bool enabled{true};
+
+	float max_distance{0.0f};
+
+	float min_size_ratio{0.0f};
+
+	ThreadPool *thread_pool{nullptr};
+
+	Frustum frustum;
+
+	glm::vec3 camera_position{0.0f};
+
+	std::vector<float> center_x;
+	std::vector<float> center_y;
+	std::vector<float> center_z;
+	std::vector<float> extent_x;
+	std::vector<float> extent_y;
+	std::vector<float> extent_z;
+
+	// One byte per box rather than a bit, so that ranges can be written by different threads
+	std::vector<uint8_t> visibility;
+
+	uint32_t visible_count{0};
+};
+}        // namespace vkb
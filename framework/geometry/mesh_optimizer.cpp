@@ -0,0 +1,768 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geometry/mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#include <glm/gtc/packing.hpp>
+
+#include <core/util/hash.hpp>
+
+#include "common/vk_common.h"
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+// Size of the FIFO cache the statistics and the overdraw clusters are measured with
+constexpr uint32_t FIFO_CACHE_SIZE = 16;
+
+// Constants of Tom Forsyth's vertex scores, which model an LRU cache
+constexpr uint32_t LRU_CACHE_SIZE      = 32;
+constexpr uint32_t MAX_VALENCE_SCORE   = 32;
+constexpr float    CACHE_DECAY_POWER   = 1.5f;
+constexpr float    LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float    VALENCE_BOOST_SCALE = 2.0f;
+constexpr float    VALENCE_BOOST_POWER = 0.5f;
+
+uint32_t get_element_size(VkFormat format)
+{
+	int32_t bits = get_bits_per_pixel(format);
+	assert(bits > 0 && bits % 8 == 0 && "Unsupported vertex format");
+	return static_cast<uint32_t>(bits) / 8;
+}
+
+uint32_t get_index_size(VkIndexType index_type)
+{
+	return index_type == VK_INDEX_TYPE_UINT16 ? 2 : 4;
+}
+
+/**
+ * @brief Triangles using each vertex, as one array with an offset per vertex
+ */
+struct TriangleAdjacency
+{
+	TriangleAdjacency(std::span<const uint32_t> indices, size_t vertex_count) :
+	    counts(vertex_count, 0),
+	    offsets(vertex_count + 1, 0),
+	    triangles(indices.size())
+	{
+		for (auto index : indices)
+		{
+			counts[index]++;
+		}
+		std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+		std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::span<uint32_t> get_triangles(uint32_t vertex)
+	{
+		return {triangles.data() + offsets[vertex], counts[vertex]};
+	}
+
+	/// Number of triangles of each vertex, drops as triangles are removed
+	std::vector<uint32_t> counts;
+
+	std::vector<uint32_t> offsets;
+
+	std::vector<uint32_t> triangles;
+};
+
+/**
+ * @brief Simulated FIFO cache, a vertex is cached while it is among the last FIFO_CACHE_SIZE misses
+ */
+class FifoCache
+{
+  public:
+	explicit FifoCache(size_t vertex_count) :
+	    timestamps(vertex_count, 0)
+	{}
+
+	uint32_t add_triangle(const uint32_t *triangle)
+	{
+		uint32_t misses = 0;
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			if (time - timestamps[triangle[k]] > FIFO_CACHE_SIZE)
+			{
+				timestamps[triangle[k]] = time++;
+				misses++;
+			}
+		}
+		return misses;
+	}
+
+	void clear()
+	{
+		time += FIFO_CACHE_SIZE + 1;
+	}
+
+  private:
+	std::vector<uint32_t> timestamps;
+
+	uint32_t time{FIFO_CACHE_SIZE + 1};
+};
+
+struct VertexScoreTables
+{
+	VertexScoreTables()
+	{
+		for (uint32_t i = 0; i < LRU_CACHE_SIZE; ++i)
+		{
+			// The vertices of the last triangle get a fixed score, so that the next triangle doesn't just reuse its edge
+			cache[i] = i < 3 ? LAST_TRIANGLE_SCORE :
+			                   std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(LRU_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+		}
+
+		// Vertices with few triangles left are preferred, so that no lonely triangles are left behind
+		valence[0] = 0.0f;
+		for (uint32_t i = 1; i <= MAX_VALENCE_SCORE; ++i)
+		{
+			valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+		}
+	}
+
+	float get_score(int32_t cache_position, uint32_t remaining_triangles) const
+	{
+		float score = cache_position >= 0 ? cache[cache_position] : 0.0f;
+		return score + valence[std::min(remaining_triangles, MAX_VALENCE_SCORE)];
+	}
+
+	std::array<float, LRU_CACHE_SIZE> cache;
+
+	std::array<float, MAX_VALENCE_SCORE + 1> valence;
+};
+
+const VertexScoreTables &get_vertex_score_tables()
+{
+	static const VertexScoreTables tables;
+	return tables;
+}
+
+std::vector<glm::vec3> read_positions(const MeshData &mesh)
+{
+	auto it = std::ranges::find_if(mesh.streams, [](const MeshVertexStream &stream) {
+		return stream.name == "position" && stream.format == VK_FORMAT_R32G32B32_SFLOAT;
+	});
+
+	if (it == mesh.streams.end())
+	{
+		return {};
+	}
+
+	std::vector<glm::vec3> positions(mesh.vertex_count);
+	for (uint32_t v = 0; v < mesh.vertex_count; ++v)
+	{
+		std::memcpy(&positions[v], it->data.data() + size_t(v) * it->stride, sizeof(glm::vec3));
+	}
+	return positions;
+}
+
+glm::vec2 encode_octahedral(glm::vec3 normal)
+{
+	normal /= std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+
+	if (normal.z >= 0.0f)
+	{
+		return {normal.x, normal.y};
+	}
+
+	// The lower hemisphere is folded over the diagonals of the square
+	return {(1.0f - std::abs(normal.y)) * (normal.x >= 0.0f ? 1.0f : -1.0f),
+	        (1.0f - std::abs(normal.x)) * (normal.y >= 0.0f ? 1.0f : -1.0f)};
+}
+
+/**
+ * @brief Rewrites a stream in a smaller format, streams the options don't cover are left as they are
+ */
+void quantize_stream(MeshVertexStream &stream, uint32_t vertex_count, const MeshOptimizationOptions &options)
+{
+	auto read = [&stream](uint32_t vertex, auto &value) {
+		std::memcpy(&value, stream.data.data() + size_t(vertex) * stream.stride, sizeof(value));
+	};
+
+	VkFormat format = VK_FORMAT_UNDEFINED;
+
+	if (stream.name == "position" && stream.format == VK_FORMAT_R32G32B32_SFLOAT)
+	{
+		// Three component half formats are not required for vertex buffers, w is filled with 1
+		format = options.quantize_positions ? VK_FORMAT_R16G16B16A16_SFLOAT : VK_FORMAT_UNDEFINED;
+	}
+	else if (!options.quantize_attributes)
+	{
+		return;
+	}
+	else if (stream.name == "normal" && stream.format == VK_FORMAT_R32G32B32_SFLOAT)
+	{
+		format = options.octahedral_normals ? VK_FORMAT_R16G16_SNORM : VK_FORMAT_R8G8B8A8_SNORM;
+	}
+	else if (stream.name == "tangent" && stream.format == VK_FORMAT_R32G32B32A32_SFLOAT)
+	{
+		format = VK_FORMAT_R8G8B8A8_SNORM;
+	}
+	else if (stream.name.starts_with("texcoord") && stream.format == VK_FORMAT_R32G32_SFLOAT)
+	{
+		// Repeating coordinates would lose too much precision in 16 bits, so only those within [0, 1] are quantized
+		bool normalized = true;
+		for (uint32_t v = 0; v < vertex_count && normalized; ++v)
+		{
+			glm::vec2 uv;
+			read(v, uv);
+			normalized = uv.x >= 0.0f && uv.x <= 1.0f && uv.y >= 0.0f && uv.y <= 1.0f;
+		}
+		format = normalized ? VK_FORMAT_R16G16_UNORM : VK_FORMAT_UNDEFINED;
+	}
+
+	if (format == VK_FORMAT_UNDEFINED)
+	{
+		return;
+	}
+
+	uint32_t             element_size = get_element_size(format);
+	std::vector<uint8_t> data(size_t(vertex_count) * element_size);
+
+	auto write = [&data, element_size](uint32_t vertex, auto value) {
+		std::memcpy(data.data() + size_t(vertex) * element_size, &value, sizeof(value));
+	};
+
+	for (uint32_t v = 0; v < vertex_count; ++v)
+	{
+		if (stream.name == "position")
+		{
+			glm::vec3 position;
+			read(v, position);
+			write(v, glm::packHalf4x16(glm::vec4(position, 1.0f)));
+		}
+		else if (stream.name == "normal")
+		{
+			glm::vec3 normal;
+			read(v, normal);
+
+			float length = glm::length(normal);
+			normal       = length > 0.0f ? normal / length : glm::vec3{0.0f, 0.0f, 1.0f};
+
+			if (options.octahedral_normals)
+			{
+				write(v, glm::packSnorm2x16(encode_octahedral(normal)));
+			}
+			else
+			{
+				write(v, glm::packSnorm4x8(glm::vec4(normal, 0.0f)));
+			}
+		}
+		else if (stream.name == "tangent")
+		{
+			glm::vec4 tangent;
+			read(v, tangent);
+			write(v, glm::packSnorm4x8(tangent));
+		}
+		else
+		{
+			glm::vec2 uv;
+			read(v, uv);
+			write(v, glm::packUnorm2x16(uv));
+		}
+	}
+
+	stream.format = format;
+	stream.stride = element_size;
+	stream.data   = std::move(data);
+}
+}        // namespace
+
+float MeshOptimizationStats::get_acmr_before() const
+{
+	return triangle_count ? static_cast<float>(cache_misses_before) / static_cast<float>(triangle_count) : 0.0f;
+}
+
+float MeshOptimizationStats::get_acmr_after() const
+{
+	return triangle_count ? static_cast<float>(cache_misses_after) / static_cast<float>(triangle_count) : 0.0f;
+}
+
+MeshOptimizationStats &MeshOptimizationStats::operator+=(const MeshOptimizationStats &other)
+{
+	triangle_count += other.triangle_count;
+	cache_misses_before += other.cache_misses_before;
+	cache_misses_after += other.cache_misses_after;
+	vertex_count_before += other.vertex_count_before;
+	vertex_count_after += other.vertex_count_after;
+	vertex_bytes_before += other.vertex_bytes_before;
+	vertex_bytes_after += other.vertex_bytes_after;
+	index_bytes_before += other.index_bytes_before;
+	index_bytes_after += other.index_bytes_after;
+	return *this;
+}
+
+size_t compute_cache_misses(std::span<const uint32_t> indices, size_t vertex_count)
+{
+	FifoCache cache{vertex_count};
+
+	size_t misses = 0;
+	for (size_t i = 0; i + 3 <= indices.size(); i += 3)
+	{
+		misses += cache.add_triangle(indices.data() + i);
+	}
+	return misses;
+}
+
+void optimize_vertex_cache(std::span<uint32_t> indices, size_t vertex_count)
+{
+	assert(indices.size() % 3 == 0 && "Only triangle lists can be optimized");
+
+	size_t triangle_count = indices.size() / 3;
+	if (triangle_count == 0)
+	{
+		return;
+	}
+
+	auto &tables = get_vertex_score_tables();
+
+	// Adjacency only keeps the triangles that are still to be emitted
+	TriangleAdjacency adjacency{indices, vertex_count};
+
+	std::vector<int32_t> cache_positions(vertex_count, -1);
+	std::vector<float>   vertex_scores(vertex_count);
+	for (uint32_t v = 0; v < vertex_count; ++v)
+	{
+		vertex_scores[v] = tables.get_score(-1, adjacency.counts[v]);
+	}
+
+	std::vector<float> triangle_scores(triangle_count);
+	for (size_t t = 0; t < triangle_count; ++t)
+	{
+		triangle_scores[t] = vertex_scores[indices[t * 3]] + vertex_scores[indices[t * 3 + 1]] + vertex_scores[indices[t * 3 + 2]];
+	}
+
+	std::vector<uint8_t>  emitted(triangle_count, 0);
+	std::vector<uint32_t> output;
+	output.reserve(indices.size());
+
+	// The cache briefly holds the three vertices of the new triangle on top of a full cache
+	std::array<uint32_t, LRU_CACHE_SIZE + 3> cache;
+	std::array<uint32_t, LRU_CACHE_SIZE + 3> new_cache;
+	size_t                                   cache_size = 0;
+
+	uint32_t best_triangle = INVALID_INDEX;
+	size_t   input_cursor  = 0;
+
+	while (output.size() < indices.size())
+	{
+		// Nothing left around the cache, restart from the next triangle in input order
+		if (best_triangle == INVALID_INDEX)
+		{
+			while (emitted[input_cursor])
+			{
+				++input_cursor;
+			}
+			best_triangle = static_cast<uint32_t>(input_cursor);
+		}
+
+		const uint32_t *triangle = indices.data() + size_t(best_triangle) * 3;
+		output.insert(output.end(), triangle, triangle + 3);
+		emitted[best_triangle] = 1;
+
+		size_t new_cache_size = 0;
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			new_cache[new_cache_size++] = triangle[k];
+
+			auto triangles = adjacency.get_triangles(triangle[k]);
+			auto it        = std::ranges::find(triangles, best_triangle);
+			std::swap(*it, triangles.back());
+			adjacency.counts[triangle[k]]--;
+		}
+		for (size_t i = 0; i < cache_size; ++i)
+		{
+			auto vertex = cache[i];
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+			{
+				new_cache[new_cache_size++] = vertex;
+			}
+		}
+
+		// Rescore the cached vertices, and the ones that were just pushed out of the cache, along with their triangles
+		for (size_t i = 0; i < new_cache_size; ++i)
+		{
+			auto    vertex   = new_cache[i];
+			int32_t position = i < LRU_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+
+			cache_positions[vertex] = position;
+
+			float score = tables.get_score(position, adjacency.counts[vertex]);
+			float delta = score - vertex_scores[vertex];
+
+			vertex_scores[vertex] = score;
+			for (auto t : adjacency.get_triangles(vertex))
+			{
+				triangle_scores[t] += delta;
+			}
+		}
+
+		best_triangle    = INVALID_INDEX;
+		float best_score = std::numeric_limits<float>::lowest();
+
+		cache_size = std::min<size_t>(new_cache_size, LRU_CACHE_SIZE);
+		for (size_t i = 0; i < cache_size; ++i)
+		{
+			cache[i] = new_cache[i];
+			for (auto t : adjacency.get_triangles(cache[i]))
+			{
+				if (triangle_scores[t] > best_score)
+				{
+					best_triangle = t;
+					best_score    = triangle_scores[t];
+				}
+			}
+		}
+	}
+
+	std::ranges::copy(output, indices.begin());
+}
+
+void optimize_overdraw(std::span<uint32_t> indices, std::span<const glm::vec3> positions, float threshold)
+{
+	assert(indices.size() % 3 == 0 && "Only triangle lists can be optimized");
+
+	uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+	if (triangle_count == 0)
+	{
+		return;
+	}
+
+	FifoCache cache{positions.size()};
+
+	// A triangle that shares no vertex with the ones before it starts a new patch of the mesh
+	std::vector<uint32_t> patches;
+	for (uint32_t t = 0; t < triangle_count; ++t)
+	{
+		if (cache.add_triangle(indices.data() + size_t(t) * 3) == 3)
+		{
+			patches.push_back(t);
+		}
+	}
+	patches.push_back(triangle_count);
+
+	// Patches are split further wherever the triangles so far reach the miss ratio of the whole patch, within the threshold
+	std::vector<uint32_t> clusters;
+	for (size_t p = 0; p + 1 < patches.size(); ++p)
+	{
+		uint32_t start = patches[p];
+		uint32_t end   = patches[p + 1];
+
+		cache.clear();
+		uint32_t patch_misses = 0;
+		for (uint32_t t = start; t < end; ++t)
+		{
+			patch_misses += cache.add_triangle(indices.data() + size_t(t) * 3);
+		}
+
+		float cluster_threshold = threshold * static_cast<float>(patch_misses) / static_cast<float>(end - start);
+
+		clusters.push_back(start);
+		cache.clear();
+
+		uint32_t cluster_misses    = 0;
+		uint32_t cluster_triangles = 0;
+		for (uint32_t t = start; t < end; ++t)
+		{
+			cluster_misses += cache.add_triangle(indices.data() + size_t(t) * 3);
+			cluster_triangles++;
+
+			if (static_cast<float>(cluster_misses) <= cluster_threshold * static_cast<float>(cluster_triangles))
+			{
+				clusters.push_back(t + 1);
+				cache.clear();
+				cluster_misses    = 0;
+				cluster_triangles = 0;
+			}
+		}
+
+		// The last cluster is usually a few triangles with a poor miss ratio, so it is merged into the one before
+		if (clusters.back() != start)
+		{
+			clusters.pop_back();
+		}
+	}
+	clusters.push_back(triangle_count);
+
+	glm::vec3 mesh_center{0.0f};
+	for (auto index : indices)
+	{
+		mesh_center += positions[index];
+	}
+	mesh_center /= static_cast<float>(indices.size());
+
+	// Clusters facing away from the center of the mesh are likely to occlude the others, so they go first
+	size_t             cluster_count = clusters.size() - 1;
+	std::vector<float> sort_keys(cluster_count);
+	for (size_t c = 0; c < cluster_count; ++c)
+	{
+		glm::vec3 center{0.0f};
+		glm::vec3 normal{0.0f};
+		float     area = 0.0f;
+
+		for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t)
+		{
+			auto &p0 = positions[indices[size_t(t) * 3 + 0]];
+			auto &p1 = positions[indices[size_t(t) * 3 + 1]];
+			auto &p2 = positions[indices[size_t(t) * 3 + 2]];
+
+			glm::vec3 triangle_normal = glm::cross(p1 - p0, p2 - p0);
+			float     triangle_area   = glm::length(triangle_normal);
+
+			center += (p0 + p1 + p2) * (triangle_area / 3.0f);
+			normal += triangle_normal;
+			area += triangle_area;
+		}
+
+		if (area > 0.0f)
+		{
+			center /= area;
+		}
+
+		float normal_length = glm::length(normal);
+		if (normal_length > 0.0f)
+		{
+			normal /= normal_length;
+		}
+
+		sort_keys[c] = glm::dot(center - mesh_center, normal);
+	}
+
+	std::vector<uint32_t> order(cluster_count);
+	std::iota(order.begin(), order.end(), 0);
+	std::ranges::stable_sort(order, [&sort_keys](uint32_t a, uint32_t b) { return sort_keys[a] > sort_keys[b]; });
+
+	std::vector<uint32_t> output;
+	output.reserve(indices.size());
+	for (auto c : order)
+	{
+		output.insert(output.end(), indices.begin() + size_t(clusters[c]) * 3, indices.begin() + size_t(clusters[c + 1]) * 3);
+	}
+
+	std::ranges::copy(output, indices.begin());
+}
+
+std::vector<uint32_t> find_duplicate_vertices(const std::vector<MeshVertexStream> &streams, uint32_t vertex_count)
+{
+	std::vector<uint32_t> element_sizes;
+	for (auto &stream : streams)
+	{
+		element_sizes.push_back(get_element_size(stream.format));
+	}
+
+	auto hash_vertex = [&](uint32_t vertex) {
+		size_t hash = 0;
+		for (size_t s = 0; s < streams.size(); ++s)
+		{
+			hash_combine_bytes(hash, streams[s].data.data() + size_t(vertex) * streams[s].stride, element_sizes[s]);
+		}
+		return hash;
+	};
+
+	auto equal_vertices = [&](uint32_t a, uint32_t b) {
+		for (size_t s = 0; s < streams.size(); ++s)
+		{
+			auto data = streams[s].data.data();
+			if (std::memcmp(data + size_t(a) * streams[s].stride, data + size_t(b) * streams[s].stride, element_sizes[s]) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	// Open addressing table of the first vertex of each set of equal vertices, at most half full
+	size_t table_size = 16;
+	while (table_size < size_t(vertex_count) * 2)
+	{
+		table_size *= 2;
+	}
+	std::vector<uint32_t> table(table_size, INVALID_INDEX);
+
+	std::vector<uint32_t> remap(vertex_count);
+	for (uint32_t v = 0; v < vertex_count; ++v)
+	{
+		size_t slot = hash_vertex(v) & (table_size - 1);
+		while (table[slot] != INVALID_INDEX && !equal_vertices(table[slot], v))
+		{
+			slot = (slot + 1) & (table_size - 1);
+		}
+
+		if (table[slot] == INVALID_INDEX)
+		{
+			table[slot] = v;
+		}
+		remap[v] = table[slot];
+	}
+
+	return remap;
+}
+
+MeshOptimizationStats optimize_mesh(MeshData &mesh, const MeshOptimizationOptions &options)
+{
+	assert(mesh.indices.size() % 3 == 0 && "Only triangle lists can be optimized");
+
+	MeshOptimizationStats stats;
+	stats.triangle_count      = mesh.indices.size() / 3;
+	stats.cache_misses_before = compute_cache_misses(mesh.indices, mesh.vertex_count);
+	stats.vertex_count_before = mesh.vertex_count;
+	stats.index_bytes_before  = mesh.indices.size() * get_index_size(mesh.index_type);
+	for (auto &stream : mesh.streams)
+	{
+		stats.vertex_bytes_before += stream.data.size();
+	}
+
+	if (options.optimize_vertex_fetch)
+	{
+		auto remap = find_duplicate_vertices(mesh.streams, mesh.vertex_count);
+		for (auto &index : mesh.indices)
+		{
+			index = remap[index];
+		}
+	}
+
+	if (options.optimize_vertex_cache)
+	{
+		optimize_vertex_cache(mesh.indices, mesh.vertex_count);
+	}
+
+	if (options.optimize_overdraw)
+	{
+		// Without positions there is nothing to sort the clusters by
+		auto positions = read_positions(mesh);
+		if (!positions.empty())
+		{
+			optimize_overdraw(mesh.indices, positions, options.overdraw_threshold);
+		}
+	}
+
+	if (options.optimize_vertex_fetch)
+	{
+		// Number the vertices in the order the indices first use them, which drops unused and duplicate vertices
+		std::vector<uint32_t> remap(mesh.vertex_count, INVALID_INDEX);
+		uint32_t              vertex_count = 0;
+		for (auto &index : mesh.indices)
+		{
+			if (remap[index] == INVALID_INDEX)
+			{
+				remap[index] = vertex_count++;
+			}
+			index = remap[index];
+		}
+
+		for (auto &stream : mesh.streams)
+		{
+			uint32_t             element_size = get_element_size(stream.format);
+			std::vector<uint8_t> data(size_t(vertex_count) * element_size);
+			for (uint32_t v = 0; v < mesh.vertex_count; ++v)
+			{
+				if (remap[v] != INVALID_INDEX)
+				{
+					std::memcpy(data.data() + size_t(remap[v]) * element_size, stream.data.data() + size_t(v) * stream.stride, element_size);
+				}
+			}
+			stream.stride = element_size;
+			stream.data   = std::move(data);
+		}
+
+		mesh.vertex_count = vertex_count;
+	}
+
+	for (auto &stream : mesh.streams)
+	{
+		quantize_stream(stream, mesh.vertex_count, options);
+	}
+
+	// The largest 16-bit index is left out, as it restarts primitives when that is enabled
+	if (options.narrow_indices && mesh.vertex_count <= std::numeric_limits<uint16_t>::max())
+	{
+		mesh.index_type = VK_INDEX_TYPE_UINT16;
+	}
+
+	stats.cache_misses_after = compute_cache_misses(mesh.indices, mesh.vertex_count);
+	stats.vertex_count_after = mesh.vertex_count;
+	stats.index_bytes_after  = mesh.indices.size() * get_index_size(mesh.index_type);
+	for (auto &stream : mesh.streams)
+	{
+		stats.vertex_bytes_after += stream.data.size();
+	}
+
+	return stats;
+}
+
+std::vector<uint8_t> pack_indices(const MeshData &mesh)
+{
+	std::vector<uint8_t> data(mesh.indices.size() * get_index_size(mesh.index_type));
+
+	if (mesh.index_type == VK_INDEX_TYPE_UINT16)
+	{
+		for (size_t i = 0; i < mesh.indices.size(); ++i)
+		{
+			auto index = static_cast<uint16_t>(mesh.indices[i]);
+			std::memcpy(data.data() + i * sizeof(uint16_t), &index, sizeof(uint16_t));
+		}
+	}
+	else
+	{
+		std::memcpy(data.data(), mesh.indices.data(), data.size());
+	}
+
+	return data;
+}
+
+InterleavedVertices interleave_vertex_streams(const std::vector<MeshVertexStream> &streams, uint32_t vertex_count)
+{
+	InterleavedVertices vertices;
+
+	std::vector<uint32_t> element_sizes;
+	for (auto &stream : streams)
+	{
+		element_sizes.push_back(get_element_size(stream.format));
+		vertices.offsets.push_back(vertices.stride);
+		vertices.stride += (element_sizes.back() + 3) & ~3u;
+	}
+
+	vertices.data.resize(size_t(vertex_count) * vertices.stride);
+	for (size_t s = 0; s < streams.size(); ++s)
+	{
+		for (uint32_t v = 0; v < vertex_count; ++v)
+		{
+			std::memcpy(vertices.data.data() + size_t(v) * vertices.stride + vertices.offsets[s],
+			            streams[s].data.data() + size_t(v) * streams[s].stride,
+			            element_sizes[s]);
+		}
+	}
+
+	return vertices;
+}
+}        // namespace vkb
@@ -0,0 +1,180 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <volk.h>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Steps of optimize_mesh, all of them keep the rendered result the same unless stated otherwise
+ */
+struct MeshOptimizationOptions
+{
+	/// Reorders the triangles so that consecutive triangles share vertices in the post-transform cache
+	bool optimize_vertex_cache{true};
+
+	/// Reorders clusters of triangles so that the outer ones are drawn first, for less overdraw
+	bool optimize_overdraw{true};
+
+	/// How many more cache misses than optimize_vertex_cache alone the overdraw clusters may cost
+	float overdraw_threshold{1.05f};
+
+	/// Merges identical vertices and stores the vertices in the order the indices first use them
+	bool optimize_vertex_fetch{true};
+
+	/// Stores normals and tangents as 8-bit snorm, and texture coordinates within [0, 1] as 16-bit unorm
+	bool quantize_attributes{false};
+
+	/// Stores positions as half floats, only precise enough for meshes that are small around their origin
+	bool quantize_positions{false};
+
+	/// Stores quantized normals as two 16-bit snorm octahedral coordinates, which the shaders have to decode
+	bool octahedral_normals{false};
+
+	/// Stores the indices as 16-bit when there are few enough vertices
+	bool narrow_indices{true};
+
+	/// Uploads all the attributes of a mesh as one interleaved vertex buffer, see interleave_vertex_streams()
+	bool interleave{false};
+};
+
+/**
+ * @brief Sizes and vertex cache efficiency of a mesh before and after optimize_mesh
+ */
+struct MeshOptimizationStats
+{
+	size_t triangle_count{0};
+
+	/// Misses of a simulated FIFO post-transform cache, see compute_cache_misses()
+	size_t cache_misses_before{0};
+
+	size_t cache_misses_after{0};
+
+	size_t vertex_count_before{0};
+
+	size_t vertex_count_after{0};
+
+	size_t vertex_bytes_before{0};
+
+	size_t vertex_bytes_after{0};
+
+	size_t index_bytes_before{0};
+
+	size_t index_bytes_after{0};
+
+	/**
+	 * @return The average number of cache misses per triangle, between 0.5 for a regular grid and 3
+	 */
+	float get_acmr_before() const;
+
+	float get_acmr_after() const;
+
+	MeshOptimizationStats &operator+=(const MeshOptimizationStats &other);
+};
+
+/**
+ * @brief A vertex attribute, with one element of the given format every stride bytes
+ */
+struct MeshVertexStream
+{
+	std::string name;
+
+	VkFormat format{VK_FORMAT_UNDEFINED};
+
+	uint32_t stride{0};
+
+	std::vector<uint8_t> data;
+};
+
+/**
+ * @brief An indexed triangle list, with one stream per vertex attribute.
+ *        Streams are matched to attributes by their glTF name in lower case, such as "position" or "texcoord_0".
+ */
+struct MeshData
+{
+	uint32_t vertex_count{0};
+
+	std::vector<MeshVertexStream> streams;
+
+	std::vector<uint32_t> indices;
+
+	/// The type the indices are uploaded with
+	VkIndexType index_type{VK_INDEX_TYPE_UINT32};
+};
+
+/**
+ * @brief Simulates a FIFO post-transform vertex cache of the usual hardware size
+ * @return The number of vertices transformed to draw the triangles
+ */
+size_t compute_cache_misses(std::span<const uint32_t> indices, size_t vertex_count);
+
+/**
+ * @brief Reorders triangles for the post-transform vertex cache, with Tom Forsyth's linear-speed algorithm
+ */
+void optimize_vertex_cache(std::span<uint32_t> indices, size_t vertex_count);
+
+/**
+ * @brief Splits triangles already ordered for the vertex cache into clusters, and sorts the clusters so that the ones
+ *        facing away from the center of the mesh are drawn first (Sander et al., Fast Triangle Reordering for
+ *        Vertex Locality and Reduced Overdraw)
+ * @param threshold How many more cache misses the clusters may cost, 1.05 allows 5% more
+ */
+void optimize_overdraw(std::span<uint32_t> indices, std::span<const glm::vec3> positions, float threshold);
+
+/**
+ * @brief Builds a table that maps each vertex to the first vertex with the same attributes
+ */
+std::vector<uint32_t> find_duplicate_vertices(const std::vector<MeshVertexStream> &streams, uint32_t vertex_count);
+
+/**
+ * @brief Optimizes the layout of a mesh in place, as set by the options
+ * @return The mesh statistics before and after
+ */
+MeshOptimizationStats optimize_mesh(MeshData &mesh, const MeshOptimizationOptions &options);
+
+/**
+ * @return The indices of a mesh as the bytes of its index type
+ */
+std::vector<uint8_t> pack_indices(const MeshData &mesh);
+
+/**
+ * @brief The vertex streams of a mesh packed into a single buffer
+ */
+struct InterleavedVertices
+{
+	uint32_t stride{0};
+
+	/// Offset of each stream within a vertex, in the order of the streams
+	std::vector<uint32_t> offsets;
+
+	std::vector<uint8_t> data;
+};
+
+/**
+ * @brief Interleaves vertex streams, with each attribute aligned to 4 bytes
+ */
+InterleavedVertices interleave_vertex_streams(const std::vector<MeshVertexStream> &streams, uint32_t vertex_count);
+}        // namespace vkb
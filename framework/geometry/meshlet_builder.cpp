@@ -0,0 +1,346 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geometry/meshlet_builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <numeric>
+
+#include <core/util/thread_pool.hpp>
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+// Below this, the triangles of a meshlet face too many directions for its cone to ever cull it
+constexpr float MIN_CONE_SPREAD = 0.1f;
+
+/**
+ * @brief Spreads the lower 10 bits of a value to every third bit
+ */
+uint32_t spread_bits(uint32_t value)
+{
+	value &= 0x3ff;
+	value = (value | (value << 16)) & 0x030000ff;
+	value = (value | (value << 8)) & 0x0300f00f;
+	value = (value | (value << 4)) & 0x030c30c3;
+	value = (value | (value << 2)) & 0x09249249;
+	return value;
+}
+
+/**
+ * @return The triangles sorted by the 30-bit Morton code of their centers
+ */
+std::vector<uint32_t> sort_spatially(const std::vector<glm::vec3> &centers)
+{
+	glm::vec3 min{std::numeric_limits<float>::max()};
+	glm::vec3 max{std::numeric_limits<float>::lowest()};
+	for (auto &center : centers)
+	{
+		min = glm::min(min, center);
+		max = glm::max(max, center);
+	}
+
+	glm::vec3 extent = max - min;
+	float     scale  = 1023.0f / std::max(std::max(extent.x, std::max(extent.y, extent.z)), std::numeric_limits<float>::min());
+
+	// The code goes in the upper half of each key and the triangle in the lower half, so sorting the keys sorts the triangles
+	std::vector<uint64_t> keys(centers.size());
+	for (size_t i = 0; i < centers.size(); ++i)
+	{
+		glm::vec3 cell = (centers[i] - min) * scale;
+		uint64_t  code = spread_bits(static_cast<uint32_t>(cell.x)) |
+		                (spread_bits(static_cast<uint32_t>(cell.y)) << 1) |
+		                (spread_bits(static_cast<uint32_t>(cell.z)) << 2);
+		keys[i]        = (code << 32) | i;
+	}
+
+	std::ranges::sort(keys);
+
+	std::vector<uint32_t> order(centers.size());
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		order[i] = static_cast<uint32_t>(keys[i]);
+	}
+
+	return order;
+}
+
+/**
+ * @brief Computes the bounding sphere and normal cone of the last meshlet of a buffer
+ */
+void compute_culling_data(MeshletBuffer &meshlets, std::span<const glm::vec3> positions, const std::vector<glm::vec3> &normals, const std::vector<uint32_t> &triangle_ids)
+{
+	uint32_t vertex_offset = meshlets.vertex_offsets.back();
+	uint32_t vertex_count  = meshlets.vertex_counts.back();
+
+	glm::vec3 min{std::numeric_limits<float>::max()};
+	glm::vec3 max{std::numeric_limits<float>::lowest()};
+	for (uint32_t i = 0; i < vertex_count; ++i)
+	{
+		auto &position = positions[meshlets.vertices[vertex_offset + i]];
+		min            = glm::min(min, position);
+		max            = glm::max(max, position);
+	}
+
+	glm::vec3 center = (min + max) * 0.5f;
+	float     radius = 0.0f;
+	for (uint32_t i = 0; i < vertex_count; ++i)
+	{
+		radius = std::max(radius, glm::length(positions[meshlets.vertices[vertex_offset + i]] - center));
+	}
+
+	meshlets.bounds.emplace_back(center, radius);
+
+	glm::vec3 axis{0.0f};
+	for (auto triangle : triangle_ids)
+	{
+		axis += normals[triangle];
+	}
+
+	float cutoff = 1.0f;
+
+	float axis_length = glm::length(axis);
+	if (axis_length > 0.0f)
+	{
+		axis /= axis_length;
+
+		// Smallest cosine between the axis and a triangle normal, degenerate triangles have no normal and don't count
+		float min_dot = 1.0f;
+		for (auto triangle : triangle_ids)
+		{
+			if (normals[triangle] != glm::vec3{0.0f})
+			{
+				min_dot = std::min(min_dot, glm::dot(axis, normals[triangle]));
+			}
+		}
+
+		if (min_dot > MIN_CONE_SPREAD)
+		{
+			cutoff = std::sqrt(1.0f - min_dot * min_dot);
+		}
+	}
+
+	meshlets.cones.emplace_back(axis, cutoff);
+}
+}        // namespace
+
+size_t MeshletBuffer::size() const
+{
+	return vertex_offsets.size();
+}
+
+MeshletBuffer build_meshlets(const MeshletSource &source, const MeshletLimits &limits)
+{
+	assert(source.indices.size() % 3 == 0 && "Meshlets are built from triangle lists");
+	assert(limits.max_vertices >= 3 && limits.max_vertices <= 256 && "Invalid meshlet vertex limit");
+	assert(limits.max_triangles >= 1 && "Invalid meshlet triangle limit");
+
+	auto &indices   = source.indices;
+	auto &positions = source.positions;
+
+	auto triangle_count = indices.size() / 3;
+	auto vertex_count   = positions.size();
+
+	MeshletBuffer meshlets;
+	if (triangle_count == 0)
+	{
+		return meshlets;
+	}
+
+	// Triangles using each vertex, as one array with an offset per vertex
+	std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+	for (auto index : indices)
+	{
+		adjacency_offsets[index + 1]++;
+	}
+	std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> cursors(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			adjacency[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<glm::vec3> centers(triangle_count);
+	std::vector<glm::vec3> normals(triangle_count);
+	for (size_t i = 0; i < triangle_count; ++i)
+	{
+		auto &a = positions[indices[i * 3 + 0]];
+		auto &b = positions[indices[i * 3 + 1]];
+		auto &c = positions[indices[i * 3 + 2]];
+
+		centers[i] = (a + b + c) / 3.0f;
+
+		glm::vec3 normal = glm::cross(b - a, c - a);
+		float     area   = glm::length(normal);
+		normals[i]       = area > 0.0f ? normal / area : glm::vec3{0.0f};
+	}
+
+	auto seed_order = sort_spatially(centers);
+
+	std::vector<uint8_t>  emitted(triangle_count, 0);
+	std::vector<uint32_t> local_indices(vertex_count, INVALID_INDEX);
+
+	// State of the meshlet being built, the candidates are the free triangles sharing a vertex with it
+	std::vector<uint32_t> triangle_ids;
+	std::vector<uint32_t> candidates;
+	uint32_t              vertex_offset = 0;
+	glm::vec3             center_sum{0.0f};
+
+	auto count_new_vertices = [&](uint32_t triangle) {
+		uint32_t count = 0;
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			count += local_indices[indices[triangle * 3 + k]] == INVALID_INDEX ? 1 : 0;
+		}
+		return count;
+	};
+
+	auto add_triangle = [&](uint32_t triangle) {
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			auto vertex = indices[triangle * 3 + k];
+			if (local_indices[vertex] == INVALID_INDEX)
+			{
+				local_indices[vertex] = static_cast<uint32_t>(meshlets.vertices.size()) - vertex_offset;
+				meshlets.vertices.push_back(vertex);
+
+				for (uint32_t j = adjacency_offsets[vertex]; j < adjacency_offsets[vertex + 1]; ++j)
+				{
+					if (!emitted[adjacency[j]] && adjacency[j] != triangle)
+					{
+						candidates.push_back(adjacency[j]);
+					}
+				}
+			}
+			meshlets.triangles.push_back(static_cast<uint8_t>(local_indices[vertex]));
+		}
+
+		emitted[triangle] = 1;
+		triangle_ids.push_back(triangle);
+		center_sum += centers[triangle];
+	};
+
+	auto finish_meshlet = [&]() {
+		auto meshlet_vertex_count = static_cast<uint32_t>(meshlets.vertices.size()) - vertex_offset;
+
+		meshlets.vertex_offsets.push_back(vertex_offset);
+		meshlets.vertex_counts.push_back(meshlet_vertex_count);
+		meshlets.triangle_offsets.push_back(static_cast<uint32_t>(meshlets.triangles.size() / 3 - triangle_ids.size()));
+		meshlets.triangle_counts.push_back(static_cast<uint32_t>(triangle_ids.size()));
+
+		compute_culling_data(meshlets, positions, normals, triangle_ids);
+
+		for (uint32_t i = vertex_offset; i < meshlets.vertices.size(); ++i)
+		{
+			local_indices[meshlets.vertices[i]] = INVALID_INDEX;
+		}
+
+		vertex_offset = static_cast<uint32_t>(meshlets.vertices.size());
+		triangle_ids.clear();
+		candidates.clear();
+		center_sum = glm::vec3{0.0f};
+	};
+
+	size_t seed_cursor = 0;
+	size_t remaining   = triangle_count;
+
+	while (remaining > 0)
+	{
+		uint32_t best_triangle     = INVALID_INDEX;
+		uint32_t best_new_vertices = 4;
+		float    best_distance     = std::numeric_limits<float>::max();
+
+		// Prefer the connected triangle that adds the fewest vertices, then the one closest to the meshlet
+		if (!triangle_ids.empty())
+		{
+			glm::vec3 center = center_sum / static_cast<float>(triangle_ids.size());
+
+			// Candidates that were added to the meshlet since they were found are dropped on the way
+			std::erase_if(candidates, [&emitted](uint32_t triangle) { return emitted[triangle] != 0; });
+
+			for (auto triangle : candidates)
+			{
+				auto  new_vertices = count_new_vertices(triangle);
+				auto  offset       = centers[triangle] - center;
+				float distance     = glm::dot(offset, offset);
+				if (new_vertices < best_new_vertices || (new_vertices == best_new_vertices && distance < best_distance))
+				{
+					best_triangle     = triangle;
+					best_new_vertices = new_vertices;
+					best_distance     = distance;
+				}
+			}
+		}
+
+		// Nothing connected is left, continue with the next free triangle in spatial order
+		if (best_triangle == INVALID_INDEX)
+		{
+			while (emitted[seed_order[seed_cursor]])
+			{
+				++seed_cursor;
+			}
+			best_triangle     = seed_order[seed_cursor];
+			best_new_vertices = count_new_vertices(best_triangle);
+		}
+
+		auto meshlet_vertex_count = static_cast<uint32_t>(meshlets.vertices.size()) - vertex_offset;
+		if (!triangle_ids.empty() &&
+		    (meshlet_vertex_count + best_new_vertices > limits.max_vertices || triangle_ids.size() + 1 > limits.max_triangles))
+		{
+			finish_meshlet();
+			continue;
+		}
+
+		add_triangle(best_triangle);
+		remaining--;
+	}
+
+	finish_meshlet();
+
+	return meshlets;
+}
+
+std::vector<MeshletBuffer> build_meshlets(std::span<const MeshletSource> sources, ThreadPool &thread_pool, const MeshletLimits &limits)
+{
+	std::vector<std::future<MeshletBuffer>> futures;
+	futures.reserve(sources.size());
+	for (auto &source : sources)
+	{
+		futures.push_back(thread_pool.push([&source, &limits]() { return build_meshlets(source, limits); }));
+	}
+
+	std::vector<MeshletBuffer> meshlets;
+	meshlets.reserve(sources.size());
+	for (auto &future : futures)
+	{
+		meshlets.push_back(future.get());
+	}
+
+	return meshlets;
+}
+}        // namespace vkb
@@ -0,0 +1,98 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+class ThreadPool;
+
+/**
+ * @brief Size limits of the meshlets built by build_meshlets, usually the output limits of the mesh shader
+ */
+struct MeshletLimits
+{
+	/// At most 256, as triangles index the vertices of their meshlet with a byte
+	uint32_t max_vertices{64};
+
+	uint32_t max_triangles{124};
+};
+
+/**
+ * @brief The meshlets of a mesh as a flat structure of arrays, laid out so that each array can be uploaded as is.
+ *
+ * Meshlet i uses vertex_counts[i] entries of vertices from vertex_offsets[i], which index the vertex buffer of the mesh,
+ * and triangle_counts[i] triangles from triangle_offsets[i]. Each triangle is three bytes in triangles, which index
+ * the vertices of the meshlet.
+ *
+ * A meshlet faces away from a camera, and can be culled, when
+ * dot(center - camera, cone_axis) >= cone_cutoff * length(center - camera) + radius
+ */
+struct MeshletBuffer
+{
+	std::vector<uint32_t> vertex_offsets;
+
+	std::vector<uint32_t> vertex_counts;
+
+	/// Offsets in triangles, not bytes
+	std::vector<uint32_t> triangle_offsets;
+
+	std::vector<uint32_t> triangle_counts;
+
+	/// Bounding sphere of each meshlet, center in xyz and radius in w
+	std::vector<glm::vec4> bounds;
+
+	/// Normal cone of each meshlet, axis in xyz and cutoff in w. A cutoff of 1 never culls.
+	std::vector<glm::vec4> cones;
+
+	std::vector<uint32_t> vertices;
+
+	std::vector<uint8_t> triangles;
+
+	size_t size() const;
+};
+
+/**
+ * @brief A triangle list and the positions it indexes
+ */
+struct MeshletSource
+{
+	std::span<const uint32_t> indices;
+
+	std::span<const glm::vec3> positions;
+};
+
+/**
+ * @brief Splits a triangle list into meshlets.
+ *
+ * Meshlets are grown from a seed triangle by adding the connected triangle that brings the fewest new vertices,
+ * and among those the one closest to the center of the meshlet, until a limit is reached.
+ * Seeds are taken in Morton order of the triangle centers, so that consecutive meshlets are close to each other.
+ */
+MeshletBuffer build_meshlets(const MeshletSource &source, const MeshletLimits &limits = {});
+
+/**
+ * @brief Builds the meshlets of several meshes in parallel, one task per mesh
+ */
+std::vector<MeshletBuffer> build_meshlets(std::span<const MeshletSource> sources, ThreadPool &thread_pool, const MeshletLimits &limits = {});
+}        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  * Copyright (c) 2019-2025, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -19,8 +19,11 @@
 #define TINYGLTF_IMPLEMENTATION
 #include "gltf_loader.h"
 
+#include <array>
+#include <cstring>
 #include <future>
 #include <limits>
+#include <numeric>
 #include <queue>
 
 #include "common/error.h"
@@ -29,6 +32,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <core/util/profiling.hpp>
+#include <core/util/thread_pool.hpp>
 
 #include "api_vulkan_sample.h"
 #include "common/utils.h"
@@ -37,6 +41,8 @@
 #include "core/image.h"
 #include "core/util/logging.hpp"
 #include "filesystem/legacy.h"
+#include "geometry/meshlet_builder.h"
+#include "scene_cache.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/image.h"
 #include "scene_graph/components/image/astc.h"
@@ -333,54 +339,301 @@ inline void upload_image_to_gpu(vkb::core::CommandBufferC &command_buffer, vkb::
 	}
 }
 
-inline void prepare_meshlets(std::vector<Meshlet> &meshlets, std::unique_ptr<vkb::sg::SubMesh> &submesh, std::vector<unsigned char> &index_data)
+/**
+ * @brief Builds the meshlets of a submesh in the layout the mesh shader samples read, where the indices
+ *        of each meshlet point into the vertex buffer of the submesh
+ */
+inline std::vector<Meshlet> prepare_meshlets(std::span<const uint32_t> indices, std::span<const glm::vec3> positions)
 {
-	Meshlet meshlet;
-	meshlet.vertex_count = 0;
-	meshlet.index_count  = 0;
+	// The samples draw a line per triangle, and output two vertices per line, so 64 output vertices allow 32 triangles
+	MeshletLimits limits;
+	limits.max_vertices  = 64;
+	limits.max_triangles = 32;
 
-	std::set<uint32_t> vertices;                  // set for unique vertices
-	uint32_t           triangle_check = 0;        // each meshlet needs to contain full primitives
+	auto meshlet_buffer = build_meshlets({indices, positions}, limits);
 
-	for (uint32_t i = 0; i < submesh->vertex_indices; i++)
+	std::vector<Meshlet> meshlets(meshlet_buffer.size());
+	for (size_t i = 0; i < meshlets.size(); ++i)
 	{
-		// index_data is unsigned char type, casting to uint32_t* will give proper value
-		meshlet.indices[meshlet.index_count] = *(reinterpret_cast<uint32_t *>(index_data.data()) + i);
+		auto vertices  = meshlet_buffer.vertices.data() + meshlet_buffer.vertex_offsets[i];
+		auto triangles = meshlet_buffer.triangles.data() + size_t(meshlet_buffer.triangle_offsets[i]) * 3;
+
+		auto &meshlet        = meshlets[i];
+		meshlet.vertex_count = meshlet_buffer.vertex_counts[i];
+		meshlet.index_count  = meshlet_buffer.triangle_counts[i] * 3;
 
-		if (vertices.insert(meshlet.indices[meshlet.index_count]).second)
+		std::copy(vertices, vertices + meshlet.vertex_count, meshlet.vertices);
+		for (uint32_t j = 0; j < meshlet.index_count; ++j)
 		{
-			++meshlet.vertex_count;
+			meshlet.indices[j] = vertices[triangles[j]];
 		}
+	}
+
+	return meshlets;
+}
+
+/**
+ * @brief Runs optimize_mesh() on the streams of an indexed primitive, and points the primitive to the optimized streams
+ * @param storage Owns the optimized streams
+ */
+inline void optimize_primitive(SceneCache::Primitive &primitive, std::vector<std::vector<uint8_t>> &storage, const MeshOptimizationOptions &options, MeshOptimizationStats &stats)
+{
+	MeshData mesh;
+	mesh.vertex_count = primitive.vertices_count;
+	mesh.index_type   = primitive.index_type;
+
+	for (auto &vertex_stream : primitive.vertex_streams)
+	{
+		mesh.streams.push_back({vertex_stream.name, vertex_stream.format, vertex_stream.stride, {vertex_stream.data, vertex_stream.data + vertex_stream.size}});
+	}
+
+	mesh.indices.resize(primitive.vertex_indices);
+	if (primitive.index_type == VK_INDEX_TYPE_UINT16)
+	{
+		auto indices = reinterpret_cast<const uint16_t *>(primitive.index_data);
+		std::copy(indices, indices + primitive.vertex_indices, mesh.indices.begin());
+	}
+	else
+	{
+		std::memcpy(mesh.indices.data(), primitive.index_data, mesh.indices.size() * sizeof(uint32_t));
+	}
+
+	stats += optimize_mesh(mesh, options);
+
+	primitive.vertices_count = mesh.vertex_count;
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		auto &vertex_data = storage.emplace_back(std::move(mesh.streams[i].data));
+
+		auto &vertex_stream  = primitive.vertex_streams[i];
+		vertex_stream.format = mesh.streams[i].format;
+		vertex_stream.stride = mesh.streams[i].stride;
+		vertex_stream.data   = vertex_data.data();
+		vertex_stream.size   = vertex_data.size();
+	}
+
+	auto &index_data = storage.emplace_back(pack_indices(mesh));
+
+	primitive.index_type = mesh.index_type;
+	primitive.index_data = index_data.data();
+	primitive.index_size = index_data.size();
+}
+
+inline void log_mesh_optimization_stats(const MeshOptimizationStats &stats)
+{
+	LOGI("Mesh optimization: ACMR {:.3f} -> {:.3f}, {} -> {} vertices, vertex data {} -> {} KiB, index data {} -> {} KiB",
+	     stats.get_acmr_before(),
+	     stats.get_acmr_after(),
+	     stats.vertex_count_before,
+	     stats.vertex_count_after,
+	     stats.vertex_bytes_before / 1024,
+	     stats.vertex_bytes_after / 1024,
+	     stats.index_bytes_before / 1024,
+	     stats.index_bytes_after / 1024);
+}
+
+/**
+ * @brief Extracts the vertex and index streams of a glTF primitive in the layout they are uploaded with
+ * @param storage Owns the extracted streams, the returned primitive points into it
+ * @param mesh_optimization If set, indexed triangle primitives are optimized, and their statistics added to mesh_optimization_stats
+ */
+inline SceneCache::Primitive extract_primitive(const tinygltf::Model                        &model,
+                                               const tinygltf::Primitive                    &gltf_primitive,
+                                               std::vector<std::vector<uint8_t>>            &storage,
+                                               const std::optional<MeshOptimizationOptions> &mesh_optimization,
+                                               MeshOptimizationStats                        &mesh_optimization_stats)
+{
+	SceneCache::Primitive primitive;
+
+	sg::AABB bounds;
+
+	for (auto &attribute : gltf_primitive.attributes)
+	{
+		std::string attrib_name = attribute.first;
+		std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
 
-		meshlet.index_count++;
-		triangle_check = triangle_check < 3 ? ++triangle_check : 1;
+		auto &vertex_data = storage.emplace_back(get_attribute_data(&model, attribute.second));
 
-		// 96 because for each traingle we draw a line in a mesh shader sample, 32 triangles/lines per meshlet = 64 vertices on output
-		if (meshlet.vertex_count == 64 || meshlet.index_count == 96 || i == submesh->vertex_indices - 1)
+		SceneCache::VertexStream vertex_stream;
+		vertex_stream.name   = attrib_name;
+		vertex_stream.format = get_attribute_format(&model, attribute.second);
+		vertex_stream.stride = to_u32(get_attribute_stride(&model, attribute.second));
+		vertex_stream.data   = vertex_data.data();
+		vertex_stream.size   = vertex_data.size();
+
+		if (attrib_name == "position")
 		{
-			if (i == submesh->vertex_indices - 1)
-			{
-				assert(triangle_check == 3);
-			}
+			assert(attribute.second < model.accessors.size());
+			auto &accessor           = model.accessors[attribute.second];
+			primitive.vertices_count = to_u32(accessor.count);
 
-			uint32_t counter = 0;
-			for (auto v : vertices)
+			// The glTF spec requires min and max on position accessors, only fall back to the data when they are missing
+			if (accessor.minValues.size() == 3 && accessor.maxValues.size() == 3)
 			{
-				meshlet.vertices[counter++] = v;
+				bounds.update(glm::vec3(accessor.minValues[0], accessor.minValues[1], accessor.minValues[2]));
+				bounds.update(glm::vec3(accessor.maxValues[0], accessor.maxValues[1], accessor.maxValues[2]));
 			}
-			if (triangle_check != 3)
+			else if (vertex_stream.format == VK_FORMAT_R32G32B32_SFLOAT)
 			{
-				meshlet.index_count -= triangle_check;
-				i -= triangle_check;
-				triangle_check = 0;
+				for (size_t offset = 0; offset + sizeof(glm::vec3) <= vertex_data.size(); offset += vertex_stream.stride)
+				{
+					glm::vec3 position;
+					std::memcpy(&position, vertex_data.data() + offset, sizeof(glm::vec3));
+					bounds.update(position);
+				}
 			}
+		}
+
+		primitive.vertex_streams.push_back(std::move(vertex_stream));
+	}
+
+	primitive.bounds_min = bounds.get_min();
+	primitive.bounds_max = bounds.get_max();
+
+	if (gltf_primitive.indices >= 0)
+	{
+		primitive.vertex_indices = to_u32(get_attribute_size(&model, gltf_primitive.indices));
+
+		auto format = get_attribute_format(&model, gltf_primitive.indices);
+
+		auto &index_data = storage.emplace_back(get_attribute_data(&model, gltf_primitive.indices));
+
+		switch (format)
+		{
+			case VK_FORMAT_R8_UINT:
+				// Converts uint8 data into uint16 data, still represented by a uint8 vector
+				index_data           = convert_underlying_data_stride(index_data, 1, 2);
+				primitive.index_type = VK_INDEX_TYPE_UINT16;
+				break;
+			case VK_FORMAT_R16_UINT:
+				primitive.index_type = VK_INDEX_TYPE_UINT16;
+				break;
+			case VK_FORMAT_R32_UINT:
+				primitive.index_type = VK_INDEX_TYPE_UINT32;
+				break;
+			default:
+				LOGE("gltf primitive has invalid format type");
+				break;
+		}
+
+		primitive.index_data = index_data.data();
+		primitive.index_size = index_data.size();
+
+		if (mesh_optimization && (gltf_primitive.mode == TINYGLTF_MODE_TRIANGLES || gltf_primitive.mode == -1))
+		{
+			optimize_primitive(primitive, storage, *mesh_optimization, mesh_optimization_stats);
+		}
+	}
+	else
+	{
+		primitive.vertices_count = to_u32(get_attribute_size(&model, gltf_primitive.attributes.at("POSITION")));
+	}
+
+	return primitive;
+}
+
+/**
+ * @brief Decodes a glTF image on the CPU, either from its embedded data or from its uri, and generates the mip chain
+ *        of RGBA8 images which only have a base level
+ * @param content_type Color if a material samples the image as base color or emissive, which the glTF specification requires
+ *        to be sRGB encoded. The mips of those images are filtered in linear space, whatever their format.
+ * @param staging_device If set, files are decoded straight into staging buffers on this device where the loader supports it,
+ *        with room for the mip chain, which is generated from the decoded pixels before they are staged
+ */
+inline std::unique_ptr<sg::Image> decode_image(tinygltf::Image &gltf_image, const std::string &model_path, sg::Image::ContentType content_type, vkb::core::DeviceC *staging_device = nullptr)
+{
+	if (gltf_image.name.empty())
+	{
+		gltf_image.name = gltf_image.uri;
+	}
+
+	if (!gltf_image.image.empty())
+	{
+		// Image embedded in gltf file
+		auto mipmap = sg::Mipmap{
+		    /* .level = */ 0,
+		    /* .offset = */ 0,
+		    /* .extent = */ {/* .width = */ static_cast<uint32_t>(gltf_image.width),
+		                     /* .height = */ static_cast<uint32_t>(gltf_image.height),
+		                     /* .depth = */ 1u}};
+		std::vector<sg::Mipmap> mipmaps{mipmap};
+
+		bool rgba8 = gltf_image.component == 4 && gltf_image.bits == 8;
+
+		auto image = std::make_unique<sg::Image>(gltf_image.name, std::move(gltf_image.image), std::move(mipmaps));
+
+		// Embedded images are decoded by tinygltf into the CPU data, as R8G8B8A8_UNORM, so the mips are generated there
+		if (rgba8)
+		{
+			image->generate_mipmaps(nullptr, content_type);
+		}
+
+		return image;
+	}
+
+	// Load image from uri, the loaders generate the mip chain as they decode so that staged pixels never have to be read back
+	auto image_uri = model_path + "/" + gltf_image.uri;
+	return sg::Image::load(gltf_image.name, image_uri, vkb::sg::Image::Unknown, staging_device, content_type);
+}
+
+/**
+ * @brief Hashes everything a scene cache is generated from: the glTF document, its buffers,
+ *        the contents of the image files it references, and the mesh optimization options
+ */
+inline uint64_t hash_gltf_sources(const tinygltf::Model &model, const std::string &file_name, const std::string &model_path, const std::optional<MeshOptimizationOptions> &mesh_optimization)
+{
+	size_t hash = vkb::calculate_hash(vkb::fs::map_asset(file_name).view());
+
+	for (auto &buffer : model.buffers)
+	{
+		vkb::hash_combine(hash, vkb::calculate_hash(buffer.data));
+	}
+
+	for (auto &gltf_image : model.images)
+	{
+		if (gltf_image.uri.empty())
+		{
+			vkb::hash_combine(hash, vkb::calculate_hash(gltf_image.image));
+			continue;
+		}
+
+		vkb::hash_combine(hash, gltf_image.uri);
 
-			meshlets.push_back(meshlet);
-			meshlet.vertex_count = 0;
-			meshlet.index_count  = 0;
-			vertices.clear();
+		// The contents are hashed rather than the size and modification time, which copies and checkouts don't preserve
+		try
+		{
+			vkb::hash_combine(hash, vkb::calculate_hash(vkb::fs::map_asset(model_path + "/" + gltf_image.uri).view()));
+		}
+		catch (const std::runtime_error &)
+		{
+			// A missing image is reported when it is decoded
 		}
 	}
+
+	if (mesh_optimization)
+	{
+		vkb::hash_combine(hash, mesh_optimization->optimize_vertex_cache);
+		vkb::hash_combine(hash, mesh_optimization->optimize_overdraw);
+		vkb::hash_combine(hash, mesh_optimization->overdraw_threshold);
+		vkb::hash_combine(hash, mesh_optimization->optimize_vertex_fetch);
+		vkb::hash_combine(hash, mesh_optimization->quantize_attributes);
+		vkb::hash_combine(hash, mesh_optimization->quantize_positions);
+		vkb::hash_combine(hash, mesh_optimization->octahedral_normals);
+		vkb::hash_combine(hash, mesh_optimization->narrow_indices);
+	}
+
+	return hash;
+}
+
+/**
+ * @return The directory of a glTF file relative to the assets directory, empty if there is none
+ */
+inline std::string get_model_path(const std::string &file_name)
+{
+	size_t pos = file_name.find_last_of('/');
+
+	return pos == std::string::npos ? std::string{} : file_name.substr(0, pos);
 }
 
 static inline bool texture_needs_srgb_colorspace(const std::string &name)
@@ -397,11 +650,45 @@ static inline bool texture_needs_srgb_colorspace(const std::string &name)
 	return false;
 }
 
+/**
+ * @return Color if a material samples the image as a texture that needs the sRGB colorspace, Unknown otherwise
+ */
+inline sg::Image::ContentType get_image_content_type(const tinygltf::Model &model, const tinygltf::Image &gltf_image)
+{
+	auto samples_image_as_color = [&model, &gltf_image](const tinygltf::ParameterMap &values) {
+		return std::ranges::any_of(values, [&model, &gltf_image](const auto &gltf_value) {
+			if (gltf_value.first.find("Texture") == std::string::npos || !texture_needs_srgb_colorspace(gltf_value.first))
+			{
+				return false;
+			}
+
+			auto texture_index = gltf_value.second.TextureIndex();
+			if (texture_index < 0 || texture_index >= static_cast<int>(model.textures.size()))
+			{
+				return false;
+			}
+
+			auto source = model.textures[texture_index].source;
+			return source >= 0 && source < static_cast<int>(model.images.size()) && &model.images[source] == &gltf_image;
+		});
+	};
+
+	bool color = std::ranges::any_of(model.materials, [&samples_image_as_color](const tinygltf::Material &gltf_material) {
+		return samples_image_as_color(gltf_material.values) || samples_image_as_color(gltf_material.additionalValues);
+	});
+
+	return color ? sg::Image::Color : sg::Image::Unknown;
+}
+
 }        // namespace
 
 std::unordered_map<std::string, bool> GLTFLoader::supported_extensions = {
     {KHR_LIGHTS_PUNCTUAL_EXTENSION, false}};
 
+bool GLTFLoader::scene_cache_enabled = false;
+
+std::optional<MeshOptimizationOptions> GLTFLoader::mesh_optimization;
+
 GLTFLoader::GLTFLoader(vkb::core::DeviceC &device) :
     device{device}
 {
@@ -447,7 +734,31 @@ std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &f
 		model_path.clear();
 	}
 
-	return std::make_unique<sg::Scene>(load_scene(scene_index, additional_buffer_usage_flags));
+	if (scene_cache_enabled)
+	{
+		scene_cache = SceneCache::load(SceneCache::get_path(file_name), hash_gltf_sources(model, file_name, model_path, mesh_optimization));
+
+		if (scene_cache && !is_scene_cache_usable(*scene_cache))
+		{
+			LOGW("Scene cache for {} doesn't match the glTF file. Falling back to glTF.", file_name);
+			scene_cache.reset();
+		}
+
+		if (scene_cache)
+		{
+			LOGI("Loading {} from scene cache", file_name);
+		}
+		else
+		{
+			LOGI("No valid scene cache for {}, run \"bake-scene-cache {}\" to create one", file_name, file_name);
+		}
+	}
+
+	auto scene = std::make_unique<sg::Scene>(load_scene(scene_index, additional_buffer_usage_flags));
+
+	scene_cache.reset();
+
+	return scene;
 }
 
 std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string &file_name, uint32_t index, bool storage_buffer, VkBufferUsageFlags additional_buffer_usage_flags)
@@ -494,6 +805,108 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string
 	return std::move(load_model(index, storage_buffer, additional_buffer_usage_flags));
 }
 
+void GLTFLoader::set_scene_cache_enabled(bool enabled)
+{
+	scene_cache_enabled = enabled;
+}
+
+void GLTFLoader::set_mesh_optimization(const std::optional<MeshOptimizationOptions> &options)
+{
+	mesh_optimization = options;
+}
+
+bool GLTFLoader::bake_scene_cache(const std::string &file_name)
+{
+	PROFILE_SCOPE("Bake GLTF Scene Cache");
+
+	std::string err;
+	std::string warn;
+
+	tinygltf::TinyGLTF gltf_loader;
+	tinygltf::Model    gltf_model;
+
+	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
+
+	if (!gltf_loader.LoadASCIIFromFile(&gltf_model, &err, &warn, gltf_file.c_str()) || !err.empty())
+	{
+		LOGE("Failed to load gltf file {}: {}", gltf_file.c_str(), err.c_str());
+		return false;
+	}
+
+	auto gltf_model_path = get_model_path(file_name);
+
+	Timer timer;
+	timer.start();
+
+	SceneCache::Writer writer;
+
+	// Decode in parallel, with the same mip chains as the glTF path generates, so that a warm load only has to upload
+	{
+		ThreadPool decode_pool;
+
+		std::vector<std::future<std::unique_ptr<sg::Image>>> image_futures;
+		image_futures.reserve(gltf_model.images.size());
+		for (auto &gltf_image : gltf_model.images)
+		{
+			image_futures.push_back(decode_pool.push([&gltf_model, &gltf_image, &gltf_model_path]() {
+				return decode_image(gltf_image, gltf_model_path, get_image_content_type(gltf_model, gltf_image));
+			}));
+		}
+
+		for (auto &image_future : image_futures)
+		{
+			writer.add_image(*image_future.get());
+		}
+	}
+
+	MeshOptimizationStats mesh_optimization_stats;
+
+	for (auto &gltf_mesh : gltf_model.meshes)
+	{
+		for (auto &gltf_primitive : gltf_mesh.primitives)
+		{
+			std::vector<std::vector<uint8_t>> primitive_storage;
+			writer.add_primitive(extract_primitive(gltf_model, gltf_primitive, primitive_storage, mesh_optimization, mesh_optimization_stats));
+		}
+	}
+
+	if (mesh_optimization)
+	{
+		log_mesh_optimization_stats(mesh_optimization_stats);
+	}
+
+	try
+	{
+		writer.write(SceneCache::get_path(file_name), hash_gltf_sources(gltf_model, file_name, gltf_model_path, mesh_optimization));
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGE("Failed to write scene cache for {}: {}", file_name, e.what());
+		return false;
+	}
+
+	LOGI("Baked scene cache for {} in {} seconds", file_name, vkb::to_string(timer.stop()));
+
+	return true;
+}
+
+bool GLTFLoader::is_scene_cache_usable(const SceneCache &cache) const
+{
+	if (cache.get_images().size() != model.images.size())
+	{
+		return false;
+	}
+
+	size_t primitive_count = 0;
+	for (auto &gltf_mesh : model.meshes)
+	{
+		primitive_count += gltf_mesh.primitives.size();
+	}
+
+	// ASTC images this device can't sample are transcoded one by one when the scene is loaded
+	return cache.get_primitives().size() == primitive_count;
+}
+
 sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_buffer_usage_flags)
 {
 	PROFILE_SCOPE("Process Scene");
@@ -552,28 +965,96 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 	// Load images
 	auto image_count = to_u32(model.images.size());
 
-	std::vector<std::future<std::unique_ptr<sg::Image>>> image_component_futures;
+	// Per-image decode durations, written by the workers and summed for the stage report
+	std::vector<double> decode_times(image_count, 0.0);
+
+	// Decode on a fixed number of workers so that scenes with hundreds of images do not oversubscribe
+	// the CPU. This thread records and submits the uploads, so it is not counted as a worker.
+	ThreadPool decode_pool{std::max(1u, ThreadPool::get_hardware_thread_count() - 1)};
+
+	// Images found in the scene cache are not decoded, their pixels are staged straight from the cache.
+	// Cached ASTC images that this device can't sample are transcoded on the workers, the others stay usable.
+	auto is_staged_from_cache = [this](size_t image_index) {
+		if (!scene_cache)
+		{
+			return false;
+		}
+
+		auto format = scene_cache->get_images()[image_index].format;
+		return !sg::is_astc(format) || device.is_image_format_supported(format);
+	};
+
+	std::vector<std::future<std::unique_ptr<sg::Image>>> image_component_futures(image_count);
 	for (size_t image_index = 0; image_index < image_count; image_index++)
 	{
-		image_component_futures.push_back(std::async(
-		    [this, image_index]() {
-			    auto image = parse_image(model.images[image_index]);
+		if (is_staged_from_cache(image_index))
+		{
+			continue;
+		}
+
+		image_component_futures[image_index] = decode_pool.push(
+		    [this, image_index, &decode_times]() {
+			    Timer decode_timer;
+			    decode_timer.start();
+
+			    std::unique_ptr<sg::Image> image;
+
+			    if (scene_cache)
+			    {
+				    image = std::make_unique<sg::Astc>(*SceneCache::create_image(scene_cache->get_images()[image_index], true));
+				    image->create_vk_image(device);
+			    }
+			    else
+			    {
+				    image = parse_image(model.images[image_index]);
+			    }
+
+			    decode_times[image_index] = decode_timer.stop();
 
 			    LOGI("Loaded gltf image #{} ({})", image_index, model.images[image_index].uri.c_str());
 
 			    return image;
-		    }));
+		    });
 	}
 
 	std::vector<std::unique_ptr<sg::Image>> image_components;
+	image_components.reserve(image_count);
 
 	// Upload images to GPU. We do this in batches of 64MB of data to avoid needing
 	// double the amount of memory (all the images and all the corresponding buffers).
 	// This helps keep memory footprint lower which is helpful on smaller devices.
+	// Batches go through a ring of two staging slots: while the GPU copies one batch,
+	// the next one is staged and the workers keep decoding ahead of it.
+	struct UploadSlot
+	{
+		VkFence                         fence{VK_NULL_HANDLE};
+		std::vector<vkb::core::BufferC> staging_buffers;
+	};
+
+	std::array<UploadSlot, 2> upload_slots;
+
+	auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+
+	Timer  stage_timer;
+	double decode_wait_time = 0.0;
+	double staging_time     = 0.0;
+	double gpu_wait_time    = 0.0;
+	size_t batch_count      = 0;
+
 	size_t image_index = 0;
 	while (image_index < image_count)
 	{
-		std::vector<vkb::core::BufferC> transient_buffers;
+		auto &slot = upload_slots[batch_count % upload_slots.size()];
+
+		// Recycle the staging buffers of the slot once the GPU has finished the batch that last used it
+		if (slot.fence != VK_NULL_HANDLE)
+		{
+			stage_timer.start();
+			VK_CHECK(vkWaitForFences(device.get_handle(), 1, &slot.fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+			gpu_wait_time += stage_timer.stop();
+
+			slot.staging_buffers.clear();
+		}
 
 		auto command_buffer = device.get_command_pool().request_command_buffer();
 
@@ -584,44 +1065,86 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 		// Deal with 64MB of image data at a time to keep memory footprint low
 		while (image_index < image_count && batch_size < 64 * 1024 * 1024)
 		{
-			// Wait for this image to complete loading, then stage for upload
-			image_components.push_back(image_component_futures[image_index].get());
+			const uint8_t *image_data{nullptr};
+			size_t         image_size{0};
+
+			if (is_staged_from_cache(image_index))
+			{
+				auto &cached_image = scene_cache->get_images()[image_index];
+
+				image_components.push_back(SceneCache::create_image(cached_image));
+				image_components.back()->create_vk_image(device);
+
+				image_data = cached_image.data;
+				image_size = cached_image.size;
+			}
+			else
+			{
+				// Wait for this image to complete loading, then stage for upload
+				stage_timer.start();
+				image_components.push_back(image_component_futures[image_index].get());
+				decode_wait_time += stage_timer.stop();
+
+				image_data = image_components.back()->get_data().data();
+				image_size = image_components.back()->get_data().size();
+			}
+
+			stage_timer.start();
 
 			auto &image = image_components[image_index];
 
-			core::Buffer stage_buffer = vkb::core::BufferC::create_staging_buffer(device, image->get_data());
+			// Images decoded straight into staging memory are uploaded from it, the others are copied into a new staging buffer
+			auto decoded_stage_buffer = image->release_staging_buffer();
+
+			core::Buffer stage_buffer = decoded_stage_buffer ? std::move(*decoded_stage_buffer) : vkb::core::BufferC::create_staging_buffer(device, image_size, image_data);
 
-			batch_size += image->get_data().size();
+			batch_size += stage_buffer.get_size();
 
 			upload_image_to_gpu(*command_buffer, stage_buffer, *image);
 
-			transient_buffers.push_back(std::move(stage_buffer));
+			slot.staging_buffers.push_back(std::move(stage_buffer));
+
+			staging_time += stage_timer.stop();
 
 			image_index++;
 		}
 
 		command_buffer->end();
 
-		auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+		// The command pool is only reset once all batches are done, as up to two of them are in flight
+		slot.fence = device.get_fence_pool().request_fence();
+		queue.submit(*command_buffer, slot.fence);
 
-		queue.submit(*command_buffer, device.get_fence_pool().request_fence());
+		batch_count++;
+	}
+
+	stage_timer.start();
+	device.get_fence_pool().wait();
+	gpu_wait_time += stage_timer.stop();
 
-		device.get_fence_pool().wait();
-		device.get_fence_pool().reset();
-		device.get_command_pool().reset_pool();
-		device.wait_idle();
+	device.get_fence_pool().reset();
+	device.get_command_pool().reset_pool();
 
-		// Remove the staging buffers for the batch we just processed
-		transient_buffers.clear();
+	// Remove the staging buffers of the last batches
+	for (auto &slot : upload_slots)
+	{
+		slot.staging_buffers.clear();
 	}
 
 	scene.set_components(std::move(image_components));
 
 	auto elapsed_time = timer.stop();
 
-	auto thread_count = std::thread::hardware_concurrency();
-	thread_count      = thread_count == 0 ? 1 : thread_count;
-	LOGI("Time spent loading images: {} seconds across {} threads.", vkb::to_string(elapsed_time), thread_count);
+	LOGI("Time spent loading images: {} seconds across {} threads.", vkb::to_string(elapsed_time), decode_pool.get_thread_count());
+
+	// Decode time is summed over all workers; when the stages overlap, the waits on the loading thread stay
+	// well below it and the elapsed time approaches the slowest stage rather than the sum of all of them
+	LOGI("Image loading stages: decode {} seconds (all workers), waiting for decode {} seconds, staging {} seconds, waiting for GPU {} seconds, {} upload batches.",
+	     vkb::to_string(std::accumulate(decode_times.begin(), decode_times.end(), 0.0)),
+	     vkb::to_string(decode_wait_time),
+	     vkb::to_string(staging_time),
+	     vkb::to_string(gpu_wait_time),
+	     batch_count);
 
 	// Load textures
 	auto images                  = scene.get_components<sg::Image>();
@@ -727,6 +1250,11 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 	// Load meshes
 	auto materials = scene.get_components<sg::PBRMaterial>();
 
+	// Index of the primitive across all meshes, as stored in the scene cache
+	size_t primitive_index = 0;
+
+	MeshOptimizationStats mesh_optimization_stats;
+
 	for (auto &gltf_mesh : model.meshes)
 	{
 		PROFILE_SCOPE("Processing Mesh");
@@ -740,76 +1268,84 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 			auto submesh_name = fmt::format("'{}' mesh, primitive #{}", gltf_mesh.name, i_primitive);
 			auto submesh      = std::make_unique<sg::SubMesh>(std::move(submesh_name));
 
-			for (auto &attribute : gltf_primitive.attributes)
-			{
-				std::string attrib_name = attribute.first;
-				std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
+			std::vector<std::vector<uint8_t>> primitive_storage;
 
-				auto vertex_data = get_attribute_data(&model, attribute.second);
+			SceneCache::Primitive primitive = scene_cache ? scene_cache->get_primitives()[primitive_index] :
+			                                                extract_primitive(model, gltf_primitive, primitive_storage, mesh_optimization, mesh_optimization_stats);
 
-				if (attrib_name == "position")
+			primitive_index++;
+
+			if (mesh_optimization && mesh_optimization->interleave && !primitive.vertex_streams.empty())
+			{
+				std::vector<MeshVertexStream> streams;
+				for (auto &vertex_stream : primitive.vertex_streams)
 				{
-					assert(attribute.second < model.accessors.size());
-					submesh->vertices_count = to_u32(model.accessors[attribute.second].count);
+					streams.push_back({vertex_stream.name, vertex_stream.format, vertex_stream.stride, {vertex_stream.data, vertex_stream.data + vertex_stream.size}});
 				}
 
+				auto vertices = interleave_vertex_streams(streams, primitive.vertices_count);
+
 				vkb::core::BufferC buffer{device,
-				                          vertex_data.size(),
+				                          vertices.data.size(),
 				                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
 				                          VMA_MEMORY_USAGE_CPU_TO_GPU};
-				buffer.update(vertex_data);
-				buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
-				                                  gltf_mesh.name, i_primitive, attrib_name));
+				buffer.update(vertices.data.data(), vertices.data.size());
+				buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: interleaved vertex buffer", gltf_mesh.name, i_primitive));
 
-				submesh->vertex_buffers.insert(std::make_pair(attrib_name, std::move(buffer)));
+				// Every attribute reads the one buffer at its own offset
+				submesh->vertex_buffers.insert(std::make_pair("vertex_buffer", std::move(buffer)));
 
-				sg::VertexAttribute attrib;
-				attrib.format = get_attribute_format(&model, attribute.second);
-				attrib.stride = to_u32(get_attribute_stride(&model, attribute.second));
+				for (size_t i = 0; i < streams.size(); ++i)
+				{
+					sg::VertexAttribute attrib;
+					attrib.format = streams[i].format;
+					attrib.stride = vertices.stride;
+					attrib.offset = vertices.offsets[i];
 
-				submesh->set_attribute(attrib_name, attrib);
+					submesh->set_attribute(streams[i].name, attrib);
+				}
 			}
-
-			if (gltf_primitive.indices >= 0)
+			else
 			{
-				submesh->vertex_indices = to_u32(get_attribute_size(&model, gltf_primitive.indices));
+				for (auto &vertex_stream : primitive.vertex_streams)
+				{
+					vkb::core::BufferC buffer{device,
+					                          vertex_stream.size,
+					                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
+					                          VMA_MEMORY_USAGE_CPU_TO_GPU};
+					buffer.update(vertex_stream.data, vertex_stream.size);
+					buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
+					                                  gltf_mesh.name, i_primitive, vertex_stream.name));
 
-				auto format = get_attribute_format(&model, gltf_primitive.indices);
+					submesh->vertex_buffers.insert(std::make_pair(vertex_stream.name, std::move(buffer)));
 
-				auto index_data = get_attribute_data(&model, gltf_primitive.indices);
+					sg::VertexAttribute attrib;
+					attrib.format = vertex_stream.format;
+					attrib.stride = vertex_stream.stride;
 
-				switch (format)
-				{
-					case VK_FORMAT_R8_UINT:
-						// Converts uint8 data into uint16 data, still represented by a uint8 vector
-						index_data          = convert_underlying_data_stride(index_data, 1, 2);
-						submesh->index_type = VK_INDEX_TYPE_UINT16;
-						break;
-					case VK_FORMAT_R16_UINT:
-						submesh->index_type = VK_INDEX_TYPE_UINT16;
-						break;
-					case VK_FORMAT_R32_UINT:
-						submesh->index_type = VK_INDEX_TYPE_UINT32;
-						break;
-					default:
-						LOGE("gltf primitive has invalid format type");
-						break;
+					submesh->set_attribute(vertex_stream.name, attrib);
 				}
+			}
+
+			submesh->vertices_count = primitive.vertices_count;
+
+			if (primitive.index_data)
+			{
+				submesh->vertex_indices = primitive.vertex_indices;
+				submesh->index_type     = primitive.index_type;
 
 				submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
-				                                                             index_data.size(),
+				                                                             primitive.index_size,
 				                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags,
 				                                                             VMA_MEMORY_USAGE_GPU_TO_CPU);
 				submesh->index_buffer->set_debug_name(fmt::format("'{}' mesh, primitive #{}: index buffer",
 				                                                  gltf_mesh.name, i_primitive));
 
-				submesh->index_buffer->update(index_data);
-			}
-			else
-			{
-				submesh->vertices_count = to_u32(get_attribute_size(&model, gltf_primitive.attributes.at("POSITION")));
+				submesh->index_buffer->update(primitive.index_data, primitive.index_size);
 			}
 
+			mesh->update_bounds({primitive.bounds_min, primitive.bounds_max});
+
 			if (gltf_primitive.material < 0)
 			{
 				submesh->set_material(*default_material);
@@ -828,6 +1364,12 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 		scene.add_component(std::move(mesh));
 	}
 
+	// Cached primitives were optimized when they were baked
+	if (mesh_optimization && !scene_cache)
+	{
+		log_mesh_optimization_stats(mesh_optimization_stats);
+	}
+
 	device.get_fence_pool().wait();
 	device.get_fence_pool().reset();
 	device.get_command_pool().reset_pool();
@@ -889,12 +1431,17 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 
 	std::vector<std::unique_ptr<sg::Animation>> animations;
 
+	// Keyframe times by input accessor, so that samplers using the same accessor share them
+	std::unordered_map<int, std::shared_ptr<const std::vector<float>>> animation_inputs;
+
 	// Load animations
 	for (size_t animation_index = 0; animation_index < model.animations.size(); ++animation_index)
 	{
 		auto &gltf_animation = model.animations[animation_index];
 
-		std::vector<sg::AnimationSampler> samplers;
+		auto animation = std::make_unique<sg::Animation>(gltf_animation.name);
+
+		std::vector<uint32_t> samplers;
 
 		for (size_t sampler_index = 0; sampler_index < gltf_animation.samplers.size(); ++sampler_index)
 		{
@@ -918,14 +1465,16 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 				LOGW("Gltf animation sampler #{} has unknown interpolation value", sampler_index);
 			}
 
-			auto input_accessor      = model.accessors[gltf_sampler.input];
-			auto input_accessor_data = get_attribute_data(&model, gltf_sampler.input);
-
-			const float *data = reinterpret_cast<const float *>(input_accessor_data.data());
-			for (size_t i = 0; i < input_accessor.count; ++i)
+			auto &inputs = animation_inputs[gltf_sampler.input];
+			if (!inputs)
 			{
-				sampler.inputs.push_back(data[i]);
+				auto input_accessor      = model.accessors[gltf_sampler.input];
+				auto input_accessor_data = get_attribute_data(&model, gltf_sampler.input);
+
+				const float *data = reinterpret_cast<const float *>(input_accessor_data.data());
+				inputs            = std::make_shared<const std::vector<float>>(data, data + input_accessor.count);
 			}
+			sampler.inputs = inputs;
 
 			auto output_accessor      = model.accessors[gltf_sampler.output];
 			auto output_accessor_data = get_attribute_data(&model, gltf_sampler.output);
@@ -957,11 +1506,9 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 				}
 			}
 
-			samplers.push_back(sampler);
+			samplers.push_back(animation->add_sampler(sampler));
 		}
 
-		auto animation = std::make_unique<sg::Animation>(gltf_animation.name);
-
 		for (size_t channel_index = 0; channel_index < gltf_animation.channels.size(); ++channel_index)
 		{
 			auto &gltf_channel = gltf_animation.channels[channel_index];
@@ -993,7 +1540,7 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 			float start_time{std::numeric_limits<float>::max()};
 			float end_time{std::numeric_limits<float>::min()};
 
-			for (auto input : samplers[gltf_channel.sampler].inputs)
+			for (auto input : *animation_inputs[gltf_animation.samplers[gltf_channel.sampler].input])
 			{
 				if (input < start_time)
 				{
@@ -1274,11 +1821,27 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 		// Always do uint32
 		submesh->index_type = VK_INDEX_TYPE_UINT32;
 
+		// The vertices keep the layout of the Vertex struct, so only the triangle order is optimized
+		if (mesh_optimization && (gltf_primitive.mode == TINYGLTF_MODE_TRIANGLES || gltf_primitive.mode == -1))
+		{
+			std::span<uint32_t> indices{reinterpret_cast<uint32_t *>(index_data.data()), submesh->vertex_indices};
+
+			if (mesh_optimization->optimize_vertex_cache)
+			{
+				optimize_vertex_cache(indices, vertex_count);
+			}
+
+			if (mesh_optimization->optimize_overdraw)
+			{
+				optimize_overdraw(indices, {reinterpret_cast<const glm::vec3 *>(pos), vertex_count}, mesh_optimization->overdraw_threshold);
+			}
+		}
+
 		if (storage_buffer)
 		{
 			// prepare meshlets
-			std::vector<Meshlet> meshlets;
-			prepare_meshlets(meshlets, submesh, index_data);
+			auto meshlets = prepare_meshlets({reinterpret_cast<const uint32_t *>(index_data.data()), submesh->vertex_indices},
+			                                 {reinterpret_cast<const glm::vec3 *>(pos), vertex_count});
 
 			// vertex_indices and index_buffer are used for meshlets now
 			submesh->vertex_indices = static_cast<uint32_t>(meshlets.size());
@@ -1455,31 +2018,8 @@ std::unique_ptr<sg::PBRMaterial> GLTFLoader::parse_material(const tinygltf::Mate
 
 std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image) const
 {
-	std::unique_ptr<sg::Image> image{nullptr};
-
-	if (gltf_image.name.empty())
-	{
-		gltf_image.name = gltf_image.uri;
-	}
-
-	if (!gltf_image.image.empty())
-	{
-		// Image embedded in gltf file
-		auto mipmap = sg::Mipmap{
-		    /* .level = */ 0,
-		    /* .offset = */ 0,
-		    /* .extent = */ {/* .width = */ static_cast<uint32_t>(gltf_image.width),
-		                     /* .height = */ static_cast<uint32_t>(gltf_image.height),
-		                     /* .depth = */ 1u}};
-		std::vector<sg::Mipmap> mipmaps{mipmap};
-		image = std::make_unique<sg::Image>(gltf_image.name, std::move(gltf_image.image), std::move(mipmaps));
-	}
-	else
-	{
-		// Load image from uri
-		auto image_uri = model_path + "/" + gltf_image.uri;
-		image          = sg::Image::load(gltf_image.name, image_uri, vkb::sg::Image::Unknown);
-	}
+	// The decoded pixels and their generated mips go straight into staging memory, except for images that still need transcoding
+	auto image = decode_image(gltf_image, model_path, get_image_content_type(model, gltf_image), &device);
 
 	// Check whether the format is supported by the GPU
 	if (sg::is_astc(image->get_format()))
@@ -1487,7 +2027,6 @@ std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image)
 		if (!device.is_image_format_supported(image->get_format()))
 		{
 			image = std::make_unique<sg::Astc>(*image);
-			image->generate_mipmaps();
 		}
 	}
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  * Copyright (c) 2019-2025, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -21,12 +21,15 @@
 #include "common/vk_common.h"
 #include <memory>
 #include <mutex>
+#include <optional>
 
 #define TINYGLTF_NO_STB_IMAGE
 #define TINYGLTF_NO_STB_IMAGE_WRITE
 #define TINYGLTF_NO_EXTERNAL_IMAGE
 #include <tiny_gltf.h>
 
+#include "geometry/mesh_optimizer.h"
+#include "scene_cache.h"
 #include "scene_graph/components/sampler.h"
 #include "scene_graph/node.h"
 #include "timer.h"
@@ -92,6 +95,28 @@ class GLTFLoader
 	 */
 	std::unique_ptr<sg::SubMesh> read_model_from_file(const std::string &file_name, uint32_t index, bool storage_buffer = false, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
+	/**
+	 * @brief Enables loading scenes from their scene cache, see bake_scene_cache().
+	 *        Scenes without a valid cache are loaded from glTF as usual.
+	 */
+	static void set_scene_cache_enabled(bool enabled);
+
+	/**
+	 * @brief Decodes the images and extracts the mesh streams of a glTF file, and writes them to its scene cache.
+	 *        Does not need a device, so caches can be baked offline.
+	 * @param file_name The glTF file, relative to the assets directory
+	 * @returns True if the cache was written
+	 */
+	static bool bake_scene_cache(const std::string &file_name);
+
+	/**
+	 * @brief Enables optimizing the vertex and index streams of each triangle primitive as it is loaded, see optimize_mesh().
+	 *        Scene caches hold the optimized streams, baking and loading them with other options treats them as stale.
+	 *        read_model_from_file() keeps the layout of its Vertex struct, so only the order of its triangles is optimized.
+	 * @param options The optimizations to run, or std::nullopt to upload the streams as the glTF file stores them
+	 */
+	static void set_mesh_optimization(const std::optional<MeshOptimizationOptions> &options);
+
   protected:
 	virtual std::unique_ptr<vkb::scene_graph::NodeC> parse_node(const tinygltf::Node &gltf_node, size_t index) const;
 
@@ -143,8 +168,20 @@ class GLTFLoader
 	static std::unordered_map<std::string, bool> supported_extensions;
 
   private:
+	/**
+	 * @brief Checks that a scene cache matches the structure of the loaded glTF model
+	 */
+	bool is_scene_cache_usable(const SceneCache &cache) const;
+
 	sg::Scene load_scene(int scene_index = -1, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
 	std::unique_ptr<sg::SubMesh> load_model(uint32_t index, bool storage_buffer = false, VkBufferUsageFlags additional_buffer_usage_flags = 0);
+
+	/// The cache of the scene being loaded, if scene caches are enabled and a valid one exists
+	std::unique_ptr<SceneCache> scene_cache;
+
+	static bool scene_cache_enabled;
+
+	static std::optional<MeshOptimizationOptions> mesh_optimization;
 };
 }        // namespace vkb
@@ -49,12 +49,15 @@ struct HPPResourceInfo
 class HPPResourceSet : private vkb::ResourceSet
 {
   public:
+	using vkb::ResourceSet::get_bound_bindings;
+	using vkb::ResourceSet::get_dirty_bindings;
 	using vkb::ResourceSet::is_dirty;
 
   public:
-	const BindingMap<HPPResourceInfo> &get_resource_bindings() const
+	std::span<const HPPResourceInfo> get_resources(uint32_t binding) const
 	{
-		return reinterpret_cast<BindingMap<HPPResourceInfo> const &>(vkb::ResourceSet::get_resource_bindings());
+		auto resources = vkb::ResourceSet::get_resources(binding);
+		return {reinterpret_cast<HPPResourceInfo const *>(resources.data()), resources.size()};
 	}
 };
 
@@ -62,6 +65,8 @@ class HPPResourceBindingState : private vkb::ResourceBindingState
 {
   public:
 	using vkb::ResourceBindingState::clear_dirty;
+	using vkb::ResourceBindingState::get_bound_sets;
+	using vkb::ResourceBindingState::get_dirty_sets;
 	using vkb::ResourceBindingState::is_dirty;
 	using vkb::ResourceBindingState::reset;
 
@@ -92,9 +97,9 @@ class HPPResourceBindingState : private vkb::ResourceBindingState
 		vkb::ResourceBindingState::bind_input(reinterpret_cast<vkb::core::ImageView const &>(image_view), set, binding, array_element);
 	}
 
-	const std::unordered_map<uint32_t, vkb::HPPResourceSet> &get_resource_sets()
+	const vkb::HPPResourceSet &get_resource_set(uint32_t set) const
 	{
-		return reinterpret_cast<std::unordered_map<uint32_t, vkb::HPPResourceSet> const &>(vkb::ResourceBindingState::get_resource_sets());
+		return reinterpret_cast<vkb::HPPResourceSet const &>(vkb::ResourceBindingState::get_resource_set(set));
 	}
 };
 }        // namespace vkb
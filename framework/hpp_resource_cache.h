@@ -19,29 +19,38 @@
 
 #include <core/hpp_descriptor_set.h>
 #include <core/hpp_framebuffer.h>
+#include <core/hpp_pipeline.h>
 #include <core/hpp_pipeline_layout.h>
 #include <core/hpp_render_pass.h>
-#include <hpp_resource_record.h>
-#include <hpp_resource_replay.h>
+#include <resource_cache.h>
 #include <vulkan/vulkan.hpp>
 
 namespace vkb
 {
+namespace common
+{
+struct HPPLoadStoreInfo;
+}
+
 namespace core
 {
 template <vkb::BindingType bindingType>
 class Device;
+using DeviceC   = Device<vkb::BindingType::C>;
 using DeviceCpp = Device<vkb::BindingType::Cpp>;
 
 class HPPDescriptorPool;
 class HPPDescriptorSetLayout;
 class HPPImageView;
+struct HPPSubpassInfo;
 }        // namespace core
 
 namespace rendering
 {
+struct HPPAttachment;
+class HPPPipelineState;
 class HPPRenderTarget;
-}
+}        // namespace rendering
 
 /**
  * @brief Struct to hold the internal state of the Resource Cache
@@ -49,74 +58,145 @@ class HPPRenderTarget;
  */
 struct HPPResourceCacheState
 {
-	std::unordered_map<std::size_t, vkb::core::HPPShaderModule>        shader_modules;
-	std::unordered_map<std::size_t, vkb::core::HPPPipelineLayout>      pipeline_layouts;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorSetLayout> descriptor_set_layouts;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>      descriptor_pools;
-	std::unordered_map<std::size_t, vkb::core::HPPRenderPass>          render_passes;
-	std::unordered_map<std::size_t, vkb::core::HPPGraphicsPipeline>    graphics_pipelines;
-	std::unordered_map<std::size_t, vkb::core::HPPComputePipeline>     compute_pipelines;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>       descriptor_sets;
-	std::unordered_map<std::size_t, vkb::core::HPPFramebuffer>         framebuffers;
+	ShardedResourceMap<vkb::core::HPPShaderModule>        shader_modules;
+	ShardedResourceMap<vkb::core::HPPPipelineLayout>      pipeline_layouts;
+	ShardedResourceMap<vkb::core::HPPDescriptorSetLayout> descriptor_set_layouts;
+	ShardedResourceMap<vkb::core::HPPDescriptorPool>      descriptor_pools;
+	ShardedResourceMap<vkb::core::HPPRenderPass>          render_passes;
+	ShardedResourceMap<vkb::core::HPPGraphicsPipeline>    graphics_pipelines;
+	ShardedResourceMap<vkb::core::HPPComputePipeline>     compute_pipelines;
+	ShardedResourceMap<vkb::core::HPPDescriptorSet>       descriptor_sets;
+	ShardedResourceMap<vkb::core::HPPFramebuffer>         framebuffers;
 };
 
 /**
- * @brief vulkan.hpp version of the vkb::ResourceCache class
+ * @brief facade class around vkb::ResourceCache, providing a vulkan.hpp-based interface
  *
  * See vkb::ResourceCache for documentation
  */
-class HPPResourceCache
+class HPPResourceCache : private vkb::ResourceCache
 {
   public:
-	HPPResourceCache(vkb::core::DeviceCpp &device);
-
-	HPPResourceCache(const HPPResourceCache &)            = delete;
-	HPPResourceCache(HPPResourceCache &&)                 = delete;
-	HPPResourceCache &operator=(const HPPResourceCache &) = delete;
-	HPPResourceCache &operator=(HPPResourceCache &&)      = delete;
-
-	void                               clear();
-	void                               clear_framebuffers();
-	void                               clear_pipelines();
-	const HPPResourceCacheState       &get_internal_state() const;
-	vkb::core::HPPComputePipeline     &request_compute_pipeline(vkb::rendering::HPPPipelineState &pipeline_state);
-	vkb::core::HPPDescriptorSet       &request_descriptor_set(vkb::core::HPPDescriptorSetLayout          &descriptor_set_layout,
-	                                                          const BindingMap<vk::DescriptorBufferInfo> &buffer_infos,
-	                                                          const BindingMap<vk::DescriptorImageInfo>  &image_infos);
+	using vkb::ResourceCache::clear;
+	using vkb::ResourceCache::clear_framebuffers;
+	using vkb::ResourceCache::clear_pipelines;
+	using vkb::ResourceCache::load_pipeline_cache;
+	using vkb::ResourceCache::merge_pipeline_caches;
+	using vkb::ResourceCache::save_pipeline_cache;
+	using vkb::ResourceCache::serialize;
+	using vkb::ResourceCache::set_async_pipeline_compilation;
+	using vkb::ResourceCache::update_pipeline_cache;
+	using vkb::ResourceCache::wait_for_pipelines;
+	using vkb::ResourceCache::warmup;
+
+	HPPResourceCache(vkb::core::DeviceCpp &device) :
+	    vkb::ResourceCache(reinterpret_cast<vkb::core::DeviceC &>(device))
+	{}
+
+	const HPPResourceCacheState &get_internal_state() const
+	{
+		return reinterpret_cast<HPPResourceCacheState const &>(vkb::ResourceCache::get_internal_state());
+	}
+
+	vkb::core::HPPComputePipeline &request_compute_pipeline(vkb::rendering::HPPPipelineState &pipeline_state)
+	{
+		return reinterpret_cast<vkb::core::HPPComputePipeline &>(
+		    vkb::ResourceCache::request_compute_pipeline(reinterpret_cast<vkb::PipelineState &>(pipeline_state)));
+	}
+
+	vkb::core::HPPComputePipeline *request_compute_pipeline_for_dispatch(vkb::rendering::HPPPipelineState &pipeline_state, bool &is_fallback)
+	{
+		return reinterpret_cast<vkb::core::HPPComputePipeline *>(
+		    vkb::ResourceCache::request_compute_pipeline_for_dispatch(reinterpret_cast<vkb::PipelineState &>(pipeline_state), is_fallback));
+	}
+
+	vkb::core::HPPDescriptorSet &request_descriptor_set(vkb::core::HPPDescriptorSetLayout          &descriptor_set_layout,
+	                                                    const BindingMap<vk::DescriptorBufferInfo> &buffer_infos,
+	                                                    const BindingMap<vk::DescriptorImageInfo>  &image_infos)
+	{
+		return reinterpret_cast<vkb::core::HPPDescriptorSet &>(
+		    vkb::ResourceCache::request_descriptor_set(reinterpret_cast<vkb::DescriptorSetLayout &>(descriptor_set_layout),
+		                                               reinterpret_cast<BindingMap<VkDescriptorBufferInfo> const &>(buffer_infos),
+		                                               reinterpret_cast<BindingMap<VkDescriptorImageInfo> const &>(image_infos)));
+	}
+
 	vkb::core::HPPDescriptorSetLayout &request_descriptor_set_layout(const uint32_t                                   set_index,
 	                                                                 const std::vector<vkb::core::HPPShaderModule *> &shader_modules,
-	                                                                 const std::vector<vkb::core::HPPShaderResource> &set_resources);
-	vkb::core::HPPFramebuffer         &request_framebuffer(const vkb::rendering::HPPRenderTarget &render_target, const vkb::core::HPPRenderPass &render_pass);
-	vkb::core::HPPGraphicsPipeline    &request_graphics_pipeline(vkb::rendering::HPPPipelineState &pipeline_state);
-	vkb::core::HPPPipelineLayout      &request_pipeline_layout(const std::vector<vkb::core::HPPShaderModule *> &shader_modules);
-	vkb::core::HPPRenderPass          &request_render_pass(const std::vector<vkb::rendering::HPPAttachment> &attachments,
-	                                                       const std::vector<vkb::common::HPPLoadStoreInfo> &load_store_infos,
-	                                                       const std::vector<vkb::core::HPPSubpassInfo>     &subpasses);
-	vkb::core::HPPShaderModule        &request_shader_module(
-	           vk::ShaderStageFlagBits stage, const vkb::core::HPPShaderSource &glsl_source, const vkb::core::HPPShaderVariant &shader_variant = {});
-	std::vector<uint8_t> serialize();
-	void                 set_pipeline_cache(vk::PipelineCache pipeline_cache);
+	                                                                 const std::vector<vkb::core::HPPShaderResource> &set_resources)
+	{
+		return reinterpret_cast<vkb::core::HPPDescriptorSetLayout &>(
+		    vkb::ResourceCache::request_descriptor_set_layout(set_index,
+		                                                      reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(shader_modules),
+		                                                      reinterpret_cast<std::vector<vkb::ShaderResource> const &>(set_resources)));
+	}
+
+	vkb::core::HPPFramebuffer &request_framebuffer(const vkb::rendering::HPPRenderTarget &render_target, const vkb::core::HPPRenderPass &render_pass)
+	{
+		return reinterpret_cast<vkb::core::HPPFramebuffer &>(
+		    vkb::ResourceCache::request_framebuffer(reinterpret_cast<vkb::RenderTarget const &>(render_target),
+		                                            reinterpret_cast<vkb::RenderPass const &>(render_pass)));
+	}
+
+	vkb::core::HPPGraphicsPipeline &request_graphics_pipeline(vkb::rendering::HPPPipelineState &pipeline_state)
+	{
+		return reinterpret_cast<vkb::core::HPPGraphicsPipeline &>(
+		    vkb::ResourceCache::request_graphics_pipeline(reinterpret_cast<vkb::PipelineState &>(pipeline_state)));
+	}
+
+	vkb::core::HPPGraphicsPipeline *request_graphics_pipeline_for_draw(vkb::rendering::HPPPipelineState &pipeline_state, bool &is_fallback)
+	{
+		return reinterpret_cast<vkb::core::HPPGraphicsPipeline *>(
+		    vkb::ResourceCache::request_graphics_pipeline_for_draw(reinterpret_cast<vkb::PipelineState &>(pipeline_state), is_fallback));
+	}
+
+	vkb::core::HPPPipelineLayout &request_pipeline_layout(const std::vector<vkb::core::HPPShaderModule *> &shader_modules)
+	{
+		return reinterpret_cast<vkb::core::HPPPipelineLayout &>(
+		    vkb::ResourceCache::request_pipeline_layout(reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(shader_modules)));
+	}
+
+	vkb::core::HPPRenderPass &request_render_pass(const std::vector<vkb::rendering::HPPAttachment> &attachments,
+	                                              const std::vector<vkb::common::HPPLoadStoreInfo> &load_store_infos,
+	                                              const std::vector<vkb::core::HPPSubpassInfo>     &subpasses)
+	{
+		return reinterpret_cast<vkb::core::HPPRenderPass &>(
+		    vkb::ResourceCache::request_render_pass(reinterpret_cast<std::vector<vkb::Attachment> const &>(attachments),
+		                                            reinterpret_cast<std::vector<vkb::LoadStoreInfo> const &>(load_store_infos),
+		                                            reinterpret_cast<std::vector<vkb::SubpassInfo> const &>(subpasses)));
+	}
+
+	vkb::core::HPPShaderModule &request_shader_module(vk::ShaderStageFlagBits            stage,
+	                                                  const vkb::core::HPPShaderSource  &glsl_source,
+	                                                  const vkb::core::HPPShaderVariant &shader_variant = {})
+	{
+		return reinterpret_cast<vkb::core::HPPShaderModule &>(
+		    vkb::ResourceCache::request_shader_module(static_cast<VkShaderStageFlagBits>(stage),
+		                                              reinterpret_cast<vkb::ShaderSource const &>(glsl_source),
+		                                              reinterpret_cast<vkb::ShaderVariant const &>(shader_variant)));
+	}
+
+	void set_fallback_pipeline(vkb::core::HPPComputePipeline &pipeline)
+	{
+		vkb::ResourceCache::set_fallback_pipeline(reinterpret_cast<vkb::ComputePipeline &>(pipeline));
+	}
+
+	void set_fallback_pipeline(vkb::core::HPPGraphicsPipeline &pipeline)
+	{
+		vkb::ResourceCache::set_fallback_pipeline(reinterpret_cast<vkb::GraphicsPipeline &>(pipeline));
+	}
+
+	void set_pipeline_cache(vk::PipelineCache pipeline_cache)
+	{
+		vkb::ResourceCache::set_pipeline_cache(static_cast<VkPipelineCache>(pipeline_cache));
+	}
 
 	/// @brief Update those descriptor sets referring to old views
 	/// @param old_views Old image views referred by descriptor sets
 	/// @param new_views New image views to be referred
-	void update_descriptor_sets(const std::vector<vkb::core::HPPImageView> &old_views, const std::vector<vkb::core::HPPImageView> &new_views);
-
-	void warmup(const std::vector<uint8_t> &data);
-
-  private:
-	vkb::core::DeviceCpp  &device;
-	vkb::HPPResourceRecord recorder                    = {};
-	vkb::HPPResourceReplay replayer                    = {};
-	vk::PipelineCache      pipeline_cache              = nullptr;
-	HPPResourceCacheState  state                       = {};
-	std::mutex             descriptor_set_mutex        = {};
-	std::mutex             pipeline_layout_mutex       = {};
-	std::mutex             shader_module_mutex         = {};
-	std::mutex             descriptor_set_layout_mutex = {};
-	std::mutex             graphics_pipeline_mutex     = {};
-	std::mutex             render_pass_mutex           = {};
-	std::mutex             compute_pipeline_mutex      = {};
-	std::mutex             framebuffer_mutex           = {};
+	void update_descriptor_sets(const std::vector<vkb::core::HPPImageView> &old_views, const std::vector<vkb::core::HPPImageView> &new_views)
+	{
+		vkb::ResourceCache::update_descriptor_sets(reinterpret_cast<std::vector<vkb::core::ImageView> const &>(old_views),
+		                                           reinterpret_cast<std::vector<vkb::core::ImageView> const &>(new_views));
+	}
 };
 }        // namespace vkb
@@ -51,7 +51,6 @@ class HPPResourceRecord : private vkb::ResourceRecord
 {
   public:
 	using vkb::ResourceRecord::get_data;
-	using vkb::ResourceRecord::set_data;
 
 	size_t register_graphics_pipeline(vk::PipelineCache pipeline_cache, vkb::rendering::HPPPipelineState &pipeline_state)
 	{
@@ -22,7 +22,6 @@
 namespace vkb
 {
 class HPPResourceCache;
-class HPPResourceRecord;
 
 /**
  * @brief facade class around vkb::ResourceReplay, providing a vulkan.hpp-based interface
@@ -32,9 +31,9 @@ class HPPResourceRecord;
 class HPPResourceReplay : private vkb::ResourceReplay
 {
   public:
-	void play(vkb::HPPResourceCache &resource_cache, vkb::HPPResourceRecord &recorder)
+	bool play(vkb::HPPResourceCache &resource_cache, const uint8_t *data, size_t size, ThreadPool *thread_pool = nullptr)
 	{
-		vkb::ResourceReplay::play(reinterpret_cast<vkb::ResourceCache &>(resource_cache), reinterpret_cast<vkb::ResourceRecord &>(recorder));
+		return vkb::ResourceReplay::play(resource_cache, data, size, thread_pool);
 	}
 };
 }        // namespace vkb
@@ -0,0 +1,138 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace vkb
+{
+namespace rendering
+{
+/**
+ * @brief A sortable draw: a packed 64-bit key and the index of the draw it was made for
+ */
+struct DrawKey
+{
+	uint64_t key;
+
+	uint32_t index;
+};
+
+/**
+ * @brief Converts a non-negative distance to bits which compare as integers in the same order as the floats
+ */
+inline uint32_t distance_to_bits(float distance)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &distance, sizeof(bits));
+
+	// Negative values can only come from rounding, clamp them to zero
+	return (bits & 0x80000000u) ? 0u : bits;
+}
+
+/**
+ * @brief Key of an opaque draw, which groups draws by pipeline state first, then by material,
+ *        and sorts front-to-back within a group so that early depth testing still rejects most hidden fragments
+ * @param pipeline_bits 16 bits identifying the pipeline state (shader variant, cull and front face)
+ * @param material_bits 16 bits identifying the material
+ * @param distance Distance, or squared distance, from the camera
+ */
+inline uint64_t make_opaque_draw_key(uint16_t pipeline_bits, uint16_t material_bits, float distance)
+{
+	return (static_cast<uint64_t>(pipeline_bits) << 48) | (static_cast<uint64_t>(material_bits) << 32) | distance_to_bits(distance);
+}
+
+/**
+ * @brief Key of a blended draw, which only depends on the distance and sorts back-to-front, as blending requires
+ */
+inline uint64_t make_transparent_draw_key(float distance)
+{
+	return ~distance_to_bits(distance) & 0xffffffffu;
+}
+
+/**
+ * @brief Folds a 64-bit value, such as a hash or a pointer, into 16 bits for use in a draw key.
+ *        Two values folding to the same bits only cost a lost grouping opportunity, not a wrong draw.
+ */
+inline uint16_t fold_draw_key_bits(uint64_t value)
+{
+	value ^= value >> 32;
+	value ^= value >> 16;
+	return static_cast<uint16_t>(value);
+}
+
+/**
+ * @brief Sorts draw keys in ascending key order with a stable LSD radix sort on 8-bit digits.
+ *        Digits that are the same for all keys are skipped, so keys only using their low 32 bits take four passes.
+ *        Both vectors keep their capacity, so sorting each frame into the same vectors doesn't allocate once warm.
+ * @param keys The keys to sort, sorted on return
+ * @param scratch Temporary storage, its contents on return are unspecified
+ */
+inline void sort_draw_keys(std::vector<DrawKey> &keys, std::vector<DrawKey> &scratch)
+{
+	constexpr uint32_t digit_count = sizeof(uint64_t);
+
+	const size_t count = keys.size();
+	if (count < 2)
+	{
+		return;
+	}
+
+	// Histograms of all digits are built in a single pass over the keys
+	std::array<std::array<uint32_t, 256>, digit_count> histograms{};
+	for (auto &draw_key : keys)
+	{
+		for (uint32_t digit = 0; digit < digit_count; ++digit)
+		{
+			++histograms[digit][(draw_key.key >> (digit * 8)) & 0xff];
+		}
+	}
+
+	scratch.resize(count);
+
+	for (uint32_t digit = 0; digit < digit_count; ++digit)
+	{
+		auto &histogram = histograms[digit];
+
+		// All keys share this digit, the pass would not change the order
+		if (histogram[(keys[0].key >> (digit * 8)) & 0xff] == count)
+		{
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (auto &bucket : histogram)
+		{
+			uint32_t bucket_count = bucket;
+			bucket                = offset;
+			offset += bucket_count;
+		}
+
+		for (auto &draw_key : keys)
+		{
+			scratch[histogram[(draw_key.key >> (digit * 8)) & 0xff]++] = draw_key;
+		}
+
+		keys.swap(scratch);
+	}
+}
+}        // namespace rendering
+}        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -49,6 +49,13 @@ enum DescriptorManagementStrategy
  * RenderTarget::CreateFunc. A custom RenderTarget::CreateFunc can be provided if a different
  * render target is required.
  *
+ * Buffer pools are only reset once the fences of the frame are signaled, so their memory is reused
+ * across the frames in flight without overwriting data the GPU may still read. Blocks a frame stopped
+ * using for BUFFER_BLOCK_IDLE_FRAMES frames are released, so memory grown by a spike frame is returned.
+ *
+ * Cached descriptor sets are evicted at the same point, when unused for DESCRIPTOR_SET_IDLE_FRAMES frames
+ * or least recently used past the capacity of the cache, and recycled to their descriptor pool.
+ *
  * A RenderFrame cannot be destroyed individually since frames are managed by the RenderContext,
  * the whole context must be destroyed. This is because each RenderFrame holds Vulkan objects
  * such as the swapchain image.
@@ -72,6 +79,16 @@ class RenderFrame
 	using RenderTargetType        = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::rendering::HPPRenderTarget, vkb::RenderTarget>::type;
 	using SemaphorePoolType       = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::HPPSemaphorePool, vkb::SemaphorePool>::type;
 
+  public:
+	/// Number of frames a buffer block has to stay unused before it is released
+	static constexpr uint32_t BUFFER_BLOCK_IDLE_FRAMES = 120;
+
+	/// Number of frames a cached descriptor set has to stay unused before it is evicted
+	static constexpr uint32_t DESCRIPTOR_SET_IDLE_FRAMES = 60;
+
+	/// Number of descriptor sets each thread caches by default
+	static constexpr size_t DEFAULT_DESCRIPTOR_SET_CACHE_CAPACITY = 4096;
+
   public:
 	RenderFrame(vkb::core::Device<bindingType> &device, std::unique_ptr<RenderTargetType> &&render_target, size_t thread_count = 1);
 	RenderFrame(RenderFrame<bindingType> const &)            = delete;
@@ -100,6 +117,11 @@ class RenderFrame
 	vkb::core::CommandPool<bindingType> &get_command_pool(
 	    QueueType const &queue, vkb::CommandBufferResetMode reset_mode = vkb::CommandBufferResetMode::ResetPool, size_t thread_index = 0);
 
+	/**
+	 * @return The largest number of bytes allocated from the buffer pools of the given usage within one frame
+	 */
+	DeviceSizeType get_buffer_high_water_mark(BufferUsageFlagsType usage) const;
+
 	vkb::core::Device<bindingType> &get_device();
 	FencePoolType                  &get_fence_pool();
 	FencePoolType const            &get_fence_pool() const;
@@ -112,7 +134,19 @@ class RenderFrame
 	                                                       BindingMap<DescriptorImageInfoType> const  &image_infos,
 	                                                       bool                                        update_after_bind,
 	                                                       size_t                                      thread_index = 0);
-	void                            reset();
+
+	/**
+	 * @brief Requests a descriptor set with a key computed by the caller, which must equal
+	 *        vkb::common::get_descriptor_set_key of the layout and infos
+	 */
+	DescriptorSetType request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
+	                                         BindingMap<DescriptorBufferInfoType> const &buffer_infos,
+	                                         BindingMap<DescriptorImageInfoType> const  &image_infos,
+	                                         size_t                                      key,
+	                                         bool                                        update_after_bind,
+	                                         size_t                                      thread_index = 0);
+
+	void reset();
 
 	/**
 	 * @brief Sets a new buffer allocation strategy
@@ -126,6 +160,11 @@ class RenderFrame
 	 */
 	void set_descriptor_management_strategy(DescriptorManagementStrategy new_strategy);
 
+	/**
+	 * @brief Sets how many descriptor sets each thread caches, it should be above the number of sets a frame uses
+	 */
+	void set_descriptor_set_cache_capacity(size_t capacity);
+
 	/**
 	 * @brief Updates all the descriptor sets in the current frame at a specific thread index
 	 */
@@ -153,21 +192,47 @@ class RenderFrame
 	vk::DescriptorSet request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const    &descriptor_set_layout,
 	                                              BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
 	                                              BindingMap<vk::DescriptorImageInfo> const  &image_infos,
+	                                              size_t                                      key,
 	                                              bool                                        update_after_bind,
 	                                              size_t                                      thread_index = 0);
 
+	/**
+	 * @brief Recycles the cached descriptor sets that were idle for too long or are past the capacity, and reports the caches to the stats
+	 */
+	void evict_descriptor_sets();
+
+	/**
+	 * @brief A cached descriptor set, with the pool it goes back to when evicted
+	 */
+	struct CachedDescriptorSet
+	{
+		vkb::core::HPPDescriptorSet   descriptor_set;
+		vkb::core::HPPDescriptorPool *descriptor_pool = nullptr;
+		uint64_t                      last_used_frame = 0;
+	};
+
+	struct DescriptorSetCache
+	{
+		std::unordered_map<std::size_t, CachedDescriptorSet> descriptor_sets;
+		uint64_t                                             hits   = 0;
+		uint64_t                                             misses = 0;
+	};
+
   private:
 	vkb::core::DeviceCpp                                                                             &device;
 	std::map<vk::BufferUsageFlags, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>> buffer_pools;
 	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;           // Commands pools per queue family index
 	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>>                        descriptor_pools;        // Descriptor pools per thread
-	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>>                         descriptor_sets;         // Descriptor sets per thread
+	std::vector<DescriptorSetCache>                                                                   descriptor_set_caches;   // Descriptor sets per thread
 	vkb::HPPFencePool                                                                                 fence_pool;
 	vkb::HPPSemaphorePool                                                                             semaphore_pool;
 	std::unique_ptr<vkb::rendering::HPPRenderTarget>                                                  swapchain_render_target;
 	size_t                                                                                            thread_count;
 	BufferAllocationStrategy                                                                          buffer_allocation_strategy     = BufferAllocationStrategy::MultipleAllocationsPerBuffer;
 	DescriptorManagementStrategy                                                                      descriptor_management_strategy = DescriptorManagementStrategy::StoreInCache;
+	size_t                                                                                            descriptor_set_cache_capacity  = DEFAULT_DESCRIPTOR_SET_CACHE_CAPACITY;
+	uint64_t                                                                                          frame_index                    = 0;        // Number of resets, to age the cached descriptor sets
+	std::vector<uint64_t>                                                                             last_used_frames;                          // Scratch space of evict_descriptor_sets, kept to reuse its allocation
 };
 
 using RenderFrameC   = RenderFrame<vkb::BindingType::C>;
@@ -177,7 +242,7 @@ template <vkb::BindingType bindingType>
 inline RenderFrame<bindingType>::RenderFrame(vkb::core::Device<bindingType>     &device_,
                                              std::unique_ptr<RenderTargetType> &&render_target,
                                              size_t                              thread_count) :
-    device(reinterpret_cast<vkb::core::DeviceCpp &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, descriptor_pools(thread_count), descriptor_sets(thread_count)
+    device(reinterpret_cast<vkb::core::DeviceCpp &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, descriptor_pools(thread_count), descriptor_set_caches(thread_count)
 {
 	static constexpr uint32_t BUFFER_POOL_BLOCK_SIZE = 256;        // Block size of a buffer pool in kilobytes
 
@@ -252,9 +317,9 @@ inline vkb::BufferAllocationCpp RenderFrame<bindingType>::allocate_buffer_impl(v
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::clear_descriptors()
 {
-	for (auto &desc_sets_per_thread : descriptor_sets)
+	for (auto &desc_set_cache : descriptor_set_caches)
 	{
-		desc_sets_per_thread.clear();
+		desc_set_cache.descriptor_sets.clear();
 	}
 
 	for (auto &desc_pools_per_thread : descriptor_pools)
@@ -346,6 +411,23 @@ inline typename vkb::core::Device<bindingType> &RenderFrame<bindingType>::get_de
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline typename RenderFrame<bindingType>::DeviceSizeType RenderFrame<bindingType>::get_buffer_high_water_mark(BufferUsageFlagsType usage) const
+{
+	vk::DeviceSize high_water_mark = 0;
+
+	auto buffer_pool_it = buffer_pools.find(static_cast<vk::BufferUsageFlags>(usage));
+	if (buffer_pool_it != buffer_pools.end())
+	{
+		for (auto const &buffer_pool : buffer_pool_it->second)
+		{
+			high_water_mark += buffer_pool.first.get_high_water_mark();
+		}
+	}
+
+	return static_cast<DeviceSizeType>(high_water_mark);
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderFrame<bindingType>::FencePoolType &RenderFrame<bindingType>::get_fence_pool()
 {
@@ -430,19 +512,42 @@ inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingT
                                                                                                              BindingMap<DescriptorImageInfoType> const  &image_infos,
                                                                                                              bool                                        update_after_bind,
                                                                                                              size_t                                      thread_index)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		size_t key = vkb::common::get_descriptor_set_key(descriptor_set_layout, buffer_infos, image_infos);
+		return request_descriptor_set(descriptor_set_layout, buffer_infos, image_infos, key, update_after_bind, thread_index);
+	}
+	else
+	{
+		size_t key = vkb::common::get_descriptor_set_key(reinterpret_cast<vkb::core::HPPDescriptorSetLayout const &>(descriptor_set_layout),
+		                                                 reinterpret_cast<BindingMap<vk::DescriptorBufferInfo> const &>(buffer_infos),
+		                                                 reinterpret_cast<BindingMap<vk::DescriptorImageInfo> const &>(image_infos));
+		return request_descriptor_set(descriptor_set_layout, buffer_infos, image_infos, key, update_after_bind, thread_index);
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingType>::request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
+                                                                                                             BindingMap<DescriptorBufferInfoType> const &buffer_infos,
+                                                                                                             BindingMap<DescriptorImageInfoType> const  &image_infos,
+                                                                                                             size_t                                      key,
+                                                                                                             bool                                        update_after_bind,
+                                                                                                             size_t                                      thread_index)
 {
 	assert(thread_index < thread_count && "Thread index is out of bounds");
 	assert(thread_index < descriptor_pools.size());
 
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		return request_descriptor_set_impl(descriptor_set_layout, buffer_infos, image_infos, update_after_bind, thread_index);
+		return request_descriptor_set_impl(descriptor_set_layout, buffer_infos, image_infos, key, update_after_bind, thread_index);
 	}
 	else
 	{
 		return static_cast<VkDescriptorSet>(request_descriptor_set_impl(reinterpret_cast<vkb::core::HPPDescriptorSetLayout const &>(descriptor_set_layout),
 		                                                                reinterpret_cast<BindingMap<vk::DescriptorBufferInfo> const &>(buffer_infos),
 		                                                                reinterpret_cast<BindingMap<vk::DescriptorImageInfo> const &>(image_infos),
+		                                                                key,
 		                                                                update_after_bind,
 		                                                                thread_index));
 	}
@@ -452,6 +557,7 @@ template <vkb::BindingType bindingType>
 inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const    &descriptor_set_layout,
                                                                                BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
                                                                                BindingMap<vk::DescriptorImageInfo> const  &image_infos,
+                                                                               size_t                                      key,
                                                                                bool                                        update_after_bind,
                                                                                size_t                                      thread_index)
 {
@@ -476,10 +582,28 @@ inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(v
 			aggregate_binding_to_update(image_infos);
 		}
 
-		// Request a descriptor set from the render frame, and write the buffer infos and image infos of all the specified bindings
-		assert(thread_index < descriptor_sets.size());
-		auto &descriptor_set =
-		    vkb::common::request_resource(device, nullptr, descriptor_sets[thread_index], descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+		// Request a descriptor set from the cache of the thread, and write the buffer infos and image infos of all the specified bindings
+		assert(thread_index < descriptor_set_caches.size());
+		auto &cache = descriptor_set_caches[thread_index];
+
+		auto descriptor_set_it = cache.descriptor_sets.find(key);
+		if (descriptor_set_it != cache.descriptor_sets.end())
+		{
+			++cache.hits;
+		}
+		else
+		{
+			++cache.misses;
+
+			// The pool hands out the sets evicted earlier before allocating new ones
+			descriptor_set_it =
+			    cache.descriptor_sets
+			        .try_emplace(key, CachedDescriptorSet{vkb::core::HPPDescriptorSet{device, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos}, &descriptor_pool})
+			        .first;
+		}
+		descriptor_set_it->second.last_used_frame = frame_index;
+
+		auto &descriptor_set = descriptor_set_it->second.descriptor_set;
 		descriptor_set.update({bindings_to_update.begin(), bindings_to_update.end()});
 		return descriptor_set.get_handle();
 	}
@@ -507,14 +631,29 @@ inline void RenderFrame<bindingType>::reset()
 		}
 	}
 
+	vk::DeviceSize allocated_size  = 0;
+	vk::DeviceSize padding_size    = 0;
+	size_t         released_blocks = 0;
 	for (auto &buffer_pools_per_usage : buffer_pools)
 	{
 		for (auto &buffer_pool : buffer_pools_per_usage.second)
 		{
 			buffer_pool.first.reset();
 			buffer_pool.second = nullptr;
+
+			allocated_size += buffer_pool.first.get_frame_size();
+			padding_size += buffer_pool.first.get_frame_padding();
+			released_blocks += buffer_pool.first.release_idle_blocks(BUFFER_BLOCK_IDLE_FRAMES);
 		}
 	}
+	device.get_stats_counters().buffer_pool.add_frame(allocated_size, padding_size);
+	device.get_stats_counters().pipelines.add_frame();
+
+	// Cached descriptor sets are keyed by buffer handles, which a new block may reuse
+	if (released_blocks)
+	{
+		clear_descriptors();
+	}
 
 	semaphore_pool.reset();
 
@@ -522,6 +661,68 @@ inline void RenderFrame<bindingType>::reset()
 	{
 		clear_descriptors();
 	}
+
+	evict_descriptor_sets();
+}
+
+template <vkb::BindingType bindingType>
+inline void RenderFrame<bindingType>::evict_descriptor_sets()
+{
+	uint64_t hits   = 0;
+	uint64_t misses = 0;
+	uint64_t sets   = 0;
+
+	for (auto &cache : descriptor_set_caches)
+	{
+		// Sets not used in the last DESCRIPTOR_SET_IDLE_FRAMES frames are evicted
+		uint64_t evict_before = frame_index >= DESCRIPTOR_SET_IDLE_FRAMES ? frame_index - DESCRIPTOR_SET_IDLE_FRAMES + 1 : 0;
+
+		// Past the capacity, the least recently used sets are evicted too
+		if (cache.descriptor_sets.size() > descriptor_set_cache_capacity)
+		{
+			last_used_frames.clear();
+			last_used_frames.reserve(cache.descriptor_sets.size());
+			for (auto &descriptor_set_it : cache.descriptor_sets)
+			{
+				last_used_frames.push_back(descriptor_set_it.second.last_used_frame);
+			}
+
+			auto newest_evicted = last_used_frames.begin() + (cache.descriptor_sets.size() - descriptor_set_cache_capacity - 1);
+			std::nth_element(last_used_frames.begin(), newest_evicted, last_used_frames.end());
+			evict_before = std::max(evict_before, *newest_evicted + 1);
+		}
+
+		// The fences of the frame were waited on, so the GPU is done with the sets and their handles can be rewritten
+		std::erase_if(cache.descriptor_sets, [evict_before](auto &descriptor_set_it) {
+			auto &cached = descriptor_set_it.second;
+			if (cached.last_used_frame < evict_before)
+			{
+				cached.descriptor_pool->recycle(cached.descriptor_set.get_handle());
+				return true;
+			}
+			return false;
+		});
+
+		hits += cache.hits;
+		misses += cache.misses;
+		sets += cache.descriptor_sets.size();
+
+		cache.hits   = 0;
+		cache.misses = 0;
+	}
+
+	uint64_t pool_pages = 0;
+	for (auto &desc_pools_per_thread : descriptor_pools)
+	{
+		for (auto &desc_pool : desc_pools_per_thread)
+		{
+			pool_pages += desc_pool.second.get_pool_count();
+		}
+	}
+
+	device.get_stats_counters().descriptor_sets.add_frame(hits, misses, sets, pool_pages);
+
+	++frame_index;
 }
 
 template <vkb::BindingType bindingType>
@@ -536,14 +737,20 @@ inline void RenderFrame<bindingType>::set_descriptor_management_strategy(Descrip
 	descriptor_management_strategy = new_strategy;
 }
 
+template <vkb::BindingType bindingType>
+inline void RenderFrame<bindingType>::set_descriptor_set_cache_capacity(size_t capacity)
+{
+	descriptor_set_cache_capacity = capacity;
+}
+
 template <vkb::BindingType bindingType>
 inline void RenderFrame<bindingType>::update_descriptor_sets(size_t thread_index)
 {
-	assert(thread_index < descriptor_sets.size());
-	auto &thread_descriptor_sets = descriptor_sets[thread_index];
+	assert(thread_index < descriptor_set_caches.size());
+	auto &thread_descriptor_sets = descriptor_set_caches[thread_index].descriptor_sets;
 	for (auto &descriptor_set_it : thread_descriptor_sets)
 	{
-		descriptor_set_it.second.update();
+		descriptor_set_it.second.descriptor_set.update();
 	}
 }
 
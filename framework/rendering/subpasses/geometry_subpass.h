@@ -19,6 +19,8 @@
 #pragma once
 
 #include "core/command_buffer.h"
+#include "geometry/frustum_culler.h"
+#include "rendering/draw_key.h"
 #include "rendering/render_context.h"
 #include "rendering/subpass.h"
 #include "scene_graph/components/aabb.h"
@@ -126,6 +128,11 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	 */
 	void set_thread_index(uint32_t index);
 
+	/**
+	 * @brief The culling stage mesh instances go through before being sorted, it can be configured or disabled
+	 */
+	FrustumCuller &get_frustum_culler();
+
   protected:
 	void                           draw_submesh(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh, FrontFaceType front_face = DefaultFrontFaceTypeValue<FrontFaceType>::value);
 	virtual void                   draw_submesh_command(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh);
@@ -135,11 +142,13 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	SceneType const               &get_scene() const;
 
 	/**
-	 * @brief Sorts objects based on distance from camera and classifies them
-	 *        into opaque and transparent in the arrays provided
+	 * @brief Culls objects outside the camera frustum, classifies the others into opaque and transparent
+	 *        and sorts them in draw order into the arrays provided.
+	 *        Opaque objects are grouped by pipeline state and material, and sorted front-to-back within a group.
+	 *        Transparent objects are sorted back-to-front.
 	 */
-	void get_sorted_nodes(std::multimap<float, std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &opaque_nodes,
-	                      std::multimap<float, std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &transparent_nodes);
+	void get_sorted_nodes(std::vector<std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &opaque_nodes,
+	                      std::vector<std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &transparent_nodes);
 
 	uint32_t                    get_thread_index() const;
 	void                        set_rasterization_state(const RasterizationStateType &rasterization_state);
@@ -156,8 +165,8 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	void                          draw_submesh_impl(vkb::core::CommandBufferCpp              &command_buffer,
 	                                                vkb::scene_graph::components::HPPSubMesh &sub_mesh,
 	                                                vk::FrontFace                             front_face = vk::FrontFace::eCounterClockwise);
-	void                          get_sorted_nodes_impl(std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &opaque_nodes,
-	                                                    std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &transparent_nodes);
+	void                          get_sorted_nodes_impl(std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &opaque_nodes,
+	                                                    std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &transparent_nodes);
 	vkb::core::HPPPipelineLayout &prepare_pipeline_layout_impl(vkb::core::CommandBufferCpp                     &command_buffer,
 	                                                           const std::vector<vkb::core::HPPShaderModule *> &shader_modules);
 	void                          prepare_pipeline_state_impl(vkb::core::CommandBufferCpp &command_buffer, vk::FrontFace front_face, bool double_sided_material);
@@ -170,6 +179,16 @@ class GeometrySubpass : public vkb::rendering::Subpass<bindingType>
 	std::vector<vkb::scene_graph::components::HPPMesh *> meshes;
 	vkb::scene_graph::HPPScene                          *scene;
 	uint32_t                                             thread_index = 0;
+	FrustumCuller                                        frustum_culler;
+
+	// Per-frame draw lists, kept as members so that their storage is reused across frames
+	std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPMesh *>>    instances;
+	std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> draws;
+	std::vector<DrawKey>                                                                            opaque_draw_keys;
+	std::vector<DrawKey>                                                                            transparent_draw_keys;
+	std::vector<DrawKey>                                                                            draw_keys_scratch;
+	std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> sorted_opaque_nodes;
+	std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> sorted_transparent_nodes;
 };
 
 using GeometrySubpassC   = GeometrySubpass<vkb::BindingType::C>;
@@ -212,38 +231,35 @@ inline void GeometrySubpass<bindingType>::draw(vkb::core::CommandBuffer<bindingT
 template <vkb::BindingType bindingType>
 inline void GeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp &command_buffer)
 {
-	std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> opaque_nodes;
-	std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> transparent_nodes;
+	get_sorted_nodes_impl(sorted_opaque_nodes, sorted_transparent_nodes);
 
-	get_sorted_nodes_impl(opaque_nodes, transparent_nodes);
-
-	// Draw opaque objects in front-to-back order
+	// Draw opaque objects grouped by state, front-to-back within a group
 	{
 		vkb::core::HPPScopedDebugLabel opaque_debug_label{command_buffer, "Opaque objects"};
 
-		for (auto node_it = opaque_nodes.begin(); node_it != opaque_nodes.end(); node_it++)
+		for (auto &[node, sub_mesh] : sorted_opaque_nodes)
 		{
 			if constexpr (bindingType == vkb::BindingType::Cpp)
 			{
-				update_uniform(command_buffer, *node_it->second.first, thread_index);
+				update_uniform(command_buffer, *node, thread_index);
 			}
 			else
 			{
 				update_uniform(reinterpret_cast<vkb::core::CommandBufferC &>(command_buffer),
-				               reinterpret_cast<vkb::scene_graph::NodeC &>(*node_it->second.first),
+				               reinterpret_cast<vkb::scene_graph::NodeC &>(*node),
 				               thread_index);
 			}
 
 			// Invert the front face if the mesh was flipped
-			const auto   &scale      = node_it->second.first->get_transform().get_scale();
+			const auto   &scale      = node->get_transform().get_scale();
 			bool          flipped    = scale.x * scale.y * scale.z < 0;
 			vk::FrontFace front_face = flipped ? vk::FrontFace::eClockwise : vk::FrontFace::eCounterClockwise;
 
-			draw_submesh_impl(command_buffer, *node_it->second.second, front_face);
+			draw_submesh_impl(command_buffer, *sub_mesh, front_face);
 		}
 	}
 
-	if (!transparent_nodes.empty())
+	if (!sorted_transparent_nodes.empty())
 	{
 		// Enable alpha blending
 		vkb::rendering::HPPColorBlendAttachmentState color_blend_attachment{.blend_enable           = true,
@@ -261,19 +277,19 @@ inline void GeometrySubpass<bindingType>::draw_impl(vkb::core::CommandBufferCpp
 		{
 			vkb::core::HPPScopedDebugLabel transparent_debug_label{command_buffer, "Transparent objects"};
 
-			for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
+			for (auto &[node, sub_mesh] : sorted_transparent_nodes)
 			{
 				if constexpr (bindingType == vkb::BindingType::Cpp)
 				{
-					update_uniform(command_buffer, *node_it->second.first, thread_index);
+					update_uniform(command_buffer, *node, thread_index);
 				}
 				else
 				{
 					update_uniform(reinterpret_cast<vkb::core::CommandBufferC &>(command_buffer),
-					               reinterpret_cast<vkb::scene_graph::NodeC &>(*node_it->second.first),
+					               reinterpret_cast<vkb::scene_graph::NodeC &>(*node),
 					               thread_index);
 				}
-				draw_submesh_impl(command_buffer, *node_it->second.second);
+				draw_submesh_impl(command_buffer, *sub_mesh);
 			}
 		}
 	}
@@ -301,6 +317,12 @@ inline void GeometrySubpass<bindingType>::set_thread_index(uint32_t index)
 	thread_index = index;
 }
 
+template <vkb::BindingType bindingType>
+inline FrustumCuller &GeometrySubpass<bindingType>::get_frustum_culler()
+{
+	return frustum_culler;
+}
+
 template <vkb::BindingType bindingType>
 inline void
     GeometrySubpass<bindingType>::draw_submesh(vkb::core::CommandBuffer<bindingType> &command_buffer, SubMeshType &sub_mesh, FrontFaceType front_face)
@@ -383,8 +405,8 @@ inline typename GeometrySubpass<bindingType>::SceneType const &GeometrySubpass<b
 
 template <vkb::BindingType bindingType>
 inline void
-    GeometrySubpass<bindingType>::get_sorted_nodes(std::multimap<float, std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &opaque_nodes,
-                                                   std::multimap<float, std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &transparent_nodes)
+    GeometrySubpass<bindingType>::get_sorted_nodes(std::vector<std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &opaque_nodes,
+                                                   std::vector<std::pair<vkb::scene_graph::Node<bindingType> *, SubMeshType *>> &transparent_nodes)
 {
 	if constexpr (bindingType == BindingType::Cpp)
 	{
@@ -393,44 +415,103 @@ inline void
 	else
 	{
 		get_sorted_nodes_impl(
-		    reinterpret_cast<std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &>(opaque_nodes),
-		    reinterpret_cast<std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &>(transparent_nodes));
+		    reinterpret_cast<std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &>(opaque_nodes),
+		    reinterpret_cast<std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &>(transparent_nodes));
 	}
 }
 
 template <vkb::BindingType bindingType>
 inline void GeometrySubpass<bindingType>::get_sorted_nodes_impl(
-    std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &opaque_nodes,
-    std::multimap<float, std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &transparent_nodes)
+    std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &opaque_nodes,
+    std::vector<std::pair<vkb::scene_graph::NodeCpp *, vkb::scene_graph::components::HPPSubMesh *>> &transparent_nodes)
 {
-	auto camera_transform = camera.get_node()->get_transform().get_world_matrix();
+	instances.clear();
+	draws.clear();
+	opaque_draw_keys.clear();
+	transparent_draw_keys.clear();
+	frustum_culler.clear();
 
 	for (auto &mesh : meshes)
 	{
+		auto &bounds = mesh->get_bounds();
+
 		for (auto &node : mesh->get_nodes())
 		{
-			auto node_transform = node->get_transform().get_world_matrix();
+			instances.emplace_back(node, mesh);
+
+			if (bounds.is_empty())
+			{
+				frustum_culler.add_always_visible();
+			}
+			else
+			{
+				frustum_culler.add(bounds.get_min(), bounds.get_max(), node->get_transform().get_world_matrix());
+			}
+		}
+	}
+
+	glm::vec3 camera_position = camera.get_node()->get_transform().get_world_matrix()[3];
+	glm::mat4 view_projection = camera.get_pre_rotation() * vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view();
+
+	frustum_culler.cull(view_projection, camera_position);
+
+	auto &culling_counters = this->get_render_context_impl().get_device().get_stats_counters().culling;
+	culling_counters.add_counts(frustum_culler.get_visible_count(), frustum_culler.get_count() - frustum_culler.get_visible_count());
+
+	for (uint32_t instance_index = 0; instance_index < instances.size(); ++instance_index)
+	{
+		if (!frustum_culler.is_visible(instance_index))
+		{
+			continue;
+		}
+
+		auto [node, mesh] = instances[instance_index];
+
+		// The squared distance sorts like the distance
+		glm::vec3 offset   = frustum_culler.get_center(instance_index) - camera_position;
+		float     distance = glm::dot(offset, offset);
 
-			const sg::AABB &mesh_bounds = mesh->get_bounds();
+		const auto &scale   = node->get_transform().get_scale();
+		bool        flipped = scale.x * scale.y * scale.z < 0;
 
-			sg::AABB world_bounds{mesh_bounds.get_min(), mesh_bounds.get_max()};
-			world_bounds.transform(node_transform);
+		for (auto &sub_mesh : mesh->get_submeshes())
+		{
+			auto index    = to_u32(draws.size());
+			auto material = sub_mesh->get_material();
 
-			float distance = glm::length(glm::vec3(camera_transform[3]) - world_bounds.get_center());
+			draws.emplace_back(node, sub_mesh);
 
-			for (auto &sub_mesh : mesh->get_submeshes())
+			if (material->get_alpha_mode() == sg::AlphaMode::Blend)
 			{
-				if (sub_mesh->get_material()->get_alpha_mode() == sg::AlphaMode::Blend)
-				{
-					transparent_nodes.emplace(distance, std::make_pair(node, sub_mesh));
-				}
-				else
-				{
-					opaque_nodes.emplace(distance, std::make_pair(node, sub_mesh));
-				}
+				transparent_draw_keys.push_back({make_transparent_draw_key(distance), index});
+			}
+			else
+			{
+				// The front face and cull mode are part of the pipeline, so they go in its lowest bits
+				uint16_t pipeline_bits = static_cast<uint16_t>(fold_draw_key_bits(sub_mesh->get_shader_variant().get_id()) << 2) |
+				                         static_cast<uint16_t>(material->is_double_sided() << 1) |
+				                         static_cast<uint16_t>(flipped);
+				uint16_t material_bits = fold_draw_key_bits(reinterpret_cast<uintptr_t>(material));
+
+				opaque_draw_keys.push_back({make_opaque_draw_key(pipeline_bits, material_bits, distance), index});
 			}
 		}
 	}
+
+	sort_draw_keys(opaque_draw_keys, draw_keys_scratch);
+	sort_draw_keys(transparent_draw_keys, draw_keys_scratch);
+
+	opaque_nodes.clear();
+	for (auto &draw_key : opaque_draw_keys)
+	{
+		opaque_nodes.push_back(draws[draw_key.index]);
+	}
+
+	transparent_nodes.clear();
+	for (auto &draw_key : transparent_draw_keys)
+	{
+		transparent_nodes.push_back(draws[draw_key.index]);
+	}
 }
 
 template <vkb::BindingType bindingType>
@@ -571,6 +652,12 @@ inline void GeometrySubpass<bindingType>::draw_submesh_impl(vkb::core::CommandBu
 	{
 		auto const *buffer_ptr = sub_mesh.find_vertex_buffer(input_resource.name);
 
+		// Submeshes with interleaved vertices have a single buffer, that every attribute reads at its own offset
+		if (!buffer_ptr)
+		{
+			buffer_ptr = sub_mesh.find_vertex_buffer("vertex_buffer");
+		}
+
 		if (buffer_ptr)
 		{
 			std::vector<std::reference_wrapper<const vkb::core::BufferCpp>> buffers;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,124 +17,231 @@
 
 #include "resource_binding_state.h"
 
+#include <bit>
+#include <stdexcept>
+#include <string>
+
 namespace vkb
 {
+namespace
+{
+/**
+ * @brief Kept out of line, so that the checks on the binding path stay a compare and a branch
+ */
+[[noreturn]] void throw_out_of_range(const char *index_name, uint32_t index, uint32_t count)
+{
+	throw std::out_of_range(std::string{index_name} + " index " + std::to_string(index) + " is out of bounds, the maximum is " + std::to_string(count - 1));
+}
+
+/**
+ * @brief The masks have a bit per set and per binding, so indices past them are rejected in every build type
+ */
+inline void check_set(uint32_t set)
+{
+	if (set >= MAX_BOUND_DESCRIPTOR_SETS) [[unlikely]]
+	{
+		throw_out_of_range("Descriptor set", set, MAX_BOUND_DESCRIPTOR_SETS);
+	}
+}
+
+inline void check_binding(uint32_t binding)
+{
+	if (binding >= MAX_RESOURCE_BINDINGS) [[unlikely]]
+	{
+		throw_out_of_range("Binding", binding, MAX_RESOURCE_BINDINGS);
+	}
+}
+}        // namespace
+
 void ResourceBindingState::reset()
 {
-	clear_dirty();
+	for (uint32_t sets = bound_sets; sets != 0; sets &= sets - 1)
+	{
+		resource_sets[std::countr_zero(sets)].reset();
+	}
 
-	resource_sets.clear();
+	bound_sets = 0;
+	dirty_sets = 0;
 }
 
-bool ResourceBindingState::is_dirty()
+bool ResourceBindingState::is_dirty() const
 {
-	return dirty;
+	return dirty_sets != 0;
 }
 
 void ResourceBindingState::clear_dirty()
 {
-	dirty = false;
+	for (uint32_t sets = dirty_sets; sets != 0; sets &= sets - 1)
+	{
+		resource_sets[std::countr_zero(sets)].clear_dirty();
+	}
+
+	dirty_sets = 0;
 }
 
 void ResourceBindingState::clear_dirty(uint32_t set)
 {
+	check_set(set);
+
 	resource_sets[set].clear_dirty();
+
+	dirty_sets &= ~(1u << set);
 }
 
 void ResourceBindingState::bind_buffer(const vkb::core::BufferC &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_buffer(buffer, offset, range, binding, array_element);
-
-	dirty = true;
+	get_bound_resource_set(set, binding).bind_buffer(buffer, offset, range, binding, array_element);
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, sampler, binding, array_element);
-
-	dirty = true;
+	get_bound_resource_set(set, binding).bind_image(image_view, sampler, binding, array_element);
 }
 
 void ResourceBindingState::bind_image(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_image(image_view, binding, array_element);
-
-	dirty = true;
+	get_bound_resource_set(set, binding).bind_image(image_view, binding, array_element);
 }
 
 void ResourceBindingState::bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element)
 {
-	resource_sets[set].bind_input(image_view, binding, array_element);
+	get_bound_resource_set(set, binding).bind_input(image_view, binding, array_element);
+}
 
-	dirty = true;
+uint32_t ResourceBindingState::get_bound_sets() const
+{
+	return bound_sets;
 }
 
-const std::unordered_map<uint32_t, ResourceSet> &ResourceBindingState::get_resource_sets()
+uint32_t ResourceBindingState::get_dirty_sets() const
 {
-	return resource_sets;
+	return dirty_sets;
+}
+
+const ResourceSet &ResourceBindingState::get_resource_set(uint32_t set) const
+{
+	check_set(set);
+
+	return resource_sets[set];
+}
+
+ResourceSet &ResourceBindingState::get_bound_resource_set(uint32_t set, uint32_t binding)
+{
+	// Both are checked before the set is marked, so a rejected binding leaves the state as it was
+	check_set(set);
+	check_binding(binding);
+
+	bound_sets |= 1u << set;
+	dirty_sets |= 1u << set;
+
+	return resource_sets[set];
 }
 
 void ResourceSet::reset()
 {
-	clear_dirty();
+	// Clearing keeps the capacity of each binding, for the resources bound next
+	for (uint32_t bindings = bound_bindings; bindings != 0; bindings &= bindings - 1)
+	{
+		resources[std::countr_zero(bindings)].clear();
+	}
 
-	resource_bindings.clear();
+	bound_bindings = 0;
+	dirty_bindings = 0;
 }
 
 bool ResourceSet::is_dirty() const
 {
-	return dirty;
+	return dirty_bindings != 0;
 }
 
 void ResourceSet::clear_dirty()
 {
-	dirty = false;
+	dirty_bindings = 0;
 }
 
 void ResourceSet::clear_dirty(uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty = false;
+	check_binding(binding);
+
+	if (array_element < resources[binding].size())
+	{
+		resources[binding][array_element].dirty = false;
+	}
 }
 
 void ResourceSet::bind_buffer(const vkb::core::BufferC &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty  = true;
-	resource_bindings[binding][array_element].buffer = &buffer;
-	resource_bindings[binding][array_element].offset = offset;
-	resource_bindings[binding][array_element].range  = range;
+	auto &resource_info = get_resource(binding, array_element);
+
+	resource_info.dirty  = true;
+	resource_info.buffer = &buffer;
+	resource_info.offset = offset;
+	resource_info.range  = range;
 
-	dirty = true;
+	dirty_bindings |= 1u << binding;
 }
 
 void ResourceSet::bind_image(const core::ImageView &image_view, const core::Sampler &sampler, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
-	resource_bindings[binding][array_element].sampler    = &sampler;
+	auto &resource_info = get_resource(binding, array_element);
+
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
+	resource_info.sampler    = &sampler;
 
-	dirty = true;
+	dirty_bindings |= 1u << binding;
 }
 
 void ResourceSet::bind_image(const core::ImageView &image_view, uint32_t binding, uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
-	resource_bindings[binding][array_element].sampler    = nullptr;
+	auto &resource_info = get_resource(binding, array_element);
 
-	dirty = true;
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
+	resource_info.sampler    = nullptr;
+
+	dirty_bindings |= 1u << binding;
 }
 
 void ResourceSet::bind_input(const core::ImageView &image_view, const uint32_t binding, const uint32_t array_element)
 {
-	resource_bindings[binding][array_element].dirty      = true;
-	resource_bindings[binding][array_element].image_view = &image_view;
+	auto &resource_info = get_resource(binding, array_element);
+
+	resource_info.dirty      = true;
+	resource_info.image_view = &image_view;
 
-	dirty = true;
+	dirty_bindings |= 1u << binding;
 }
 
-const BindingMap<ResourceInfo> &ResourceSet::get_resource_bindings() const
+uint32_t ResourceSet::get_bound_bindings() const
 {
-	return resource_bindings;
+	return bound_bindings;
 }
 
+uint32_t ResourceSet::get_dirty_bindings() const
+{
+	return dirty_bindings;
+}
+
+std::span<const ResourceInfo> ResourceSet::get_resources(uint32_t binding) const
+{
+	check_binding(binding);
+
+	return resources[binding];
+}
+
+ResourceInfo &ResourceSet::get_resource(uint32_t binding, uint32_t array_element)
+{
+	check_binding(binding);
+
+	auto &binding_resources = resources[binding];
+	if (array_element >= binding_resources.size())
+	{
+		binding_resources.resize(array_element + 1);
+	}
+
+	bound_bindings |= 1u << binding;
+
+	return binding_resources[array_element];
+}
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <array>
+#include <span>
+
 #include "common/vk_common.h"
 #include "core/buffer.h"
 
@@ -32,6 +35,12 @@ class ImageView;
 class Sampler;
 }        // namespace core
 
+/// Number of descriptor sets a command buffer tracks bindings for, each one is a bit of a mask
+constexpr uint32_t MAX_BOUND_DESCRIPTOR_SETS = 8;
+
+/// Number of bindings a resource set tracks, each one is a bit of a mask
+constexpr uint32_t MAX_RESOURCE_BINDINGS = 32;
+
 /**
  * @brief A resource info is a struct containing the actual resource data.
  *
@@ -56,7 +65,10 @@ struct ResourceInfo
  * @brief A resource set is a set of bindings containing resources that were bound
  *        by a command buffer.
  *
- * The ResourceSet has a one to one mapping with a DescriptorSet.
+ * The ResourceSet has a one to one mapping with a DescriptorSet. Bindings are stored in an array indexed by binding
+ * and array element, with a mask of the bound and changed bindings, and keep their storage when the set is reset,
+ * so that binding the same resources again does not allocate. Binding indices past MAX_RESOURCE_BINDINGS throw
+ * std::out_of_range.
  */
 class ResourceSet
 {
@@ -77,26 +89,44 @@ class ResourceSet
 
 	void bind_input(const core::ImageView &image_view, uint32_t binding, uint32_t array_element);
 
-	const BindingMap<ResourceInfo> &get_resource_bindings() const;
+	/**
+	 * @return A mask with a bit set for each binding that has resources bound
+	 */
+	uint32_t get_bound_bindings() const;
+
+	/**
+	 * @return A mask with a bit set for each binding changed since the dirty flags were cleared
+	 */
+	uint32_t get_dirty_bindings() const;
+
+	/**
+	 * @return The resources of a binding indexed by array element, elements that were not bound have no resources
+	 */
+	std::span<const ResourceInfo> get_resources(uint32_t binding) const;
 
   private:
-	bool dirty{false};
+	ResourceInfo &get_resource(uint32_t binding, uint32_t array_element);
+
+	uint32_t bound_bindings{0};
 
-	BindingMap<ResourceInfo> resource_bindings;
+	uint32_t dirty_bindings{0};
+
+	std::array<std::vector<ResourceInfo>, MAX_RESOURCE_BINDINGS> resources;
 };
 
 /**
  * @brief The resource binding state of a command buffer.
  *
  * Keeps track of all the resources bound by the command buffer. The ResourceBindingState is used by
- * the command buffer to create the appropriate descriptor sets when it comes to draw.
+ * the command buffer to create the appropriate descriptor sets when it comes to draw. Set indices past
+ * MAX_BOUND_DESCRIPTOR_SETS throw std::out_of_range.
  */
 class ResourceBindingState
 {
   public:
 	void reset();
 
-	bool is_dirty();
+	bool is_dirty() const;
 
 	void clear_dirty();
 
@@ -110,11 +140,25 @@ class ResourceBindingState
 
 	void bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element);
 
-	const std::unordered_map<uint32_t, ResourceSet> &get_resource_sets();
+	/**
+	 * @return A mask with a bit set for each set that has resources bound
+	 */
+	uint32_t get_bound_sets() const;
+
+	/**
+	 * @return A mask with a bit set for each set changed since its dirty flags were cleared
+	 */
+	uint32_t get_dirty_sets() const;
+
+	const ResourceSet &get_resource_set(uint32_t set) const;
 
   private:
-	bool dirty{false};
+	ResourceSet &get_bound_resource_set(uint32_t set, uint32_t binding);
+
+	uint32_t bound_sets{0};
+
+	uint32_t dirty_sets{0};
 
-	std::unordered_map<uint32_t, ResourceSet> resource_sets;
+	std::array<ResourceSet, MAX_BOUND_DESCRIPTOR_SETS> resource_sets;
 };
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,34 +17,244 @@
 
 #include "resource_cache.h"
 
+#include <cstring>
+
+#include <core/util/hash.hpp>
+#include <core/util/thread_pool.hpp>
+#include <filesystem/filesystem.hpp>
+
 #include "common/resource_caching.h"
 #include "core/device.h"
+#include "timer.h"
+
+#define PIPELINE_CACHE_DIRECTORY "cache/pipelines"
 
 namespace vkb
 {
 namespace
 {
+constexpr char PIPELINE_CACHE_MAGIC[8] = {'V', 'K', 'B', 'P', 'S', 'O', '\0', '\0'};
+
+struct PipelineCacheFileHeader
+{
+	char     magic[8];
+	uint32_t version;
+	uint32_t vendor_id;
+	uint32_t device_id;
+	uint32_t driver_version;
+	uint8_t  pipeline_cache_uuid[VK_UUID_SIZE];
+	uint64_t data_size;
+	uint64_t checksum;        // Of the pipeline cache data after the header
+};
+
+static_assert(sizeof(PipelineCacheFileHeader) == 56, "Pipeline cache file header layout changed, bump the version");
+
+/**
+ * @brief Writes a file through a temporary one, so that an interrupted run never leaves a partial file behind
+ */
+void write_file_atomically(const std::string &path, const std::vector<uint8_t> &contents)
+{
+	try
+	{
+		vkb::filesystem::get()->write_file_atomically(path, contents);
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGW("Failed to write {}: {}", path, e.what());
+	}
+}
+
+/**
+ * @return The pipeline cache data of a file, or nothing if it was not written by the same device and driver
+ */
+std::vector<uint8_t> read_pipeline_cache_file(const std::string &path, const VkPhysicalDeviceProperties &properties)
+{
+	auto fs = vkb::filesystem::get();
+	if (!fs->exists(path))
+	{
+		return {};
+	}
+
+	try
+	{
+		auto contents = fs->read_file_binary(path);
+
+		PipelineCacheFileHeader header{};
+		if (contents.size() < sizeof(header))
+		{
+			throw std::runtime_error{"File truncated"};
+		}
+		std::memcpy(&header, contents.data(), sizeof(header));
+
+		if (std::memcmp(header.magic, PIPELINE_CACHE_MAGIC, sizeof(PIPELINE_CACHE_MAGIC)) != 0)
+		{
+			throw std::runtime_error{"Invalid magic"};
+		}
+		if (header.version != ResourceCache::PIPELINE_CACHE_VERSION)
+		{
+			throw std::runtime_error{"Version mismatch"};
+		}
+		if (header.vendor_id != properties.vendorID || header.device_id != properties.deviceID)
+		{
+			throw std::runtime_error{"Written by another device"};
+		}
+		if (header.driver_version != properties.driverVersion ||
+		    std::memcmp(header.pipeline_cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			throw std::runtime_error{"Written by another driver"};
+		}
+		if (header.data_size != contents.size() - sizeof(header))
+		{
+			throw std::runtime_error{"Size mismatch"};
+		}
+		if (header.checksum != hash_bytes(contents.data() + sizeof(header), contents.size() - sizeof(header)))
+		{
+			throw std::runtime_error{"Checksum mismatch"};
+		}
+
+		// Some drivers don't validate the data they are given, so check that its own header matches the device too
+		VkPipelineCacheHeaderVersionOne data_header{};
+		if (header.data_size < sizeof(data_header))
+		{
+			throw std::runtime_error{"Pipeline cache data truncated"};
+		}
+		std::memcpy(&data_header, contents.data() + sizeof(header), sizeof(data_header));
+		if (data_header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+		    data_header.vendorID != properties.vendorID ||
+		    data_header.deviceID != properties.deviceID ||
+		    std::memcmp(data_header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			throw std::runtime_error{"Pipeline cache data header mismatch"};
+		}
+
+		return {contents.begin() + sizeof(header), contents.end()};
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGW("Rejecting pipeline cache {}: {}", path, e.what());
+		return {};
+	}
+}
+
+/**
+ * @brief Creates a resource for the cache, timing it if it is a pipeline
+ */
+template <class T, class... A>
+T create_resource(vkb::core::DeviceC &device, A &...args)
+{
+	// Not numbered by the size of the cache, which would lock every shard on each miss
+	const char *res_type = typeid(T).name();
+
+	LOGD("Building cache object ({})", res_type);
+
+// Only error handle in release
+#ifndef DEBUG
+	try
+	{
+#endif
+		if constexpr (std::is_base_of_v<Pipeline, T>)
+		{
+			Timer timer;
+			timer.start();
+
+			T pipeline(device, args...);
+			device.get_stats_counters().pipelines.add_compile(timer.stop<Timer::Milliseconds>());
+			return pipeline;
+		}
+		else
+		{
+			return T(device, args...);
+		}
+#ifndef DEBUG
+	}
+	catch (const std::exception &)
+	{
+		LOGE("Creation error for cache object ({})", res_type);
+		throw;
+	}
+#endif
+}
+
+/**
+ * @brief Records the creation of a resource inserted in the cache, so that warmup can replay it
+ */
 template <class T, class... A>
-T &request_resource(vkb::core::DeviceC &device, ResourceRecord &recorder, std::mutex &resource_mutex, std::unordered_map<std::size_t, T> &resources, A &...args)
+void record_resource(ResourceRecord &recorder, std::mutex &recorder_mutex, T &resource, A &...args)
 {
-	std::lock_guard<std::mutex> guard(resource_mutex);
+	RecordHelper<T, A...> record_helper;
+
+	std::lock_guard<std::mutex> guard(recorder_mutex);
+
+	size_t index = record_helper.record(recorder, args...);
+	record_helper.index(recorder, index, resource);
+}
 
-	auto &res = request_resource(device, &recorder, resources, args...);
+template <class T, class... A>
+T &request_resource(vkb::core::DeviceC &device, ResourceRecord &recorder, std::mutex &recorder_mutex, ShardedResourceMap<T> &resources, A &...args)
+{
+	std::size_t hash{0U};
+	hash_param(hash, args...);
+
+#ifdef VKB_DEBUG
+	// A differently seeded hash of the same arguments won't collide together with the key
+	std::size_t check{static_cast<std::size_t>(0x2545f4914f6cdd1dULL)};
+	hash_param(check, args...);
+	resources.verify_key(hash, check);
+#endif
+
+	return resources.find_or_create(
+	    hash,
+	    [&]() { return create_resource<T>(device, args...); },
+	    [&](T &resource) { record_resource(recorder, recorder_mutex, resource, args...); });
+}
 
-	return res;
+/**
+ * @return The key of the fallback pipeline that can stand in for the pipeline of a state
+ */
+std::size_t get_fallback_key(const PipelineState &pipeline_state)
+{
+	std::size_t key{0U};
+	hash_combine(key, pipeline_state.get_pipeline_layout().get_handle());
+	hash_combine(key, pipeline_state.get_render_pass() ? pipeline_state.get_render_pass()->get_handle() : VK_NULL_HANDLE);
+	hash_combine(key, pipeline_state.get_subpass_index());
+	return key;
 }
 }        // namespace
 
+bool ResourceCache::persistent_pipeline_cache_enabled = false;
+
+bool ResourceCache::pipeline_cache_warmup_enabled = false;
+
 ResourceCache::ResourceCache(vkb::core::DeviceC &device) :
     device{device}
 {
 }
 
-void ResourceCache::warmup(const std::vector<uint8_t> &data)
+void ResourceCache::set_persistent_pipeline_cache_enabled(bool enabled, bool warmup)
+{
+	persistent_pipeline_cache_enabled = enabled;
+	pipeline_cache_warmup_enabled     = enabled && warmup;
+}
+
+bool ResourceCache::is_persistent_pipeline_cache_enabled()
+{
+	return persistent_pipeline_cache_enabled;
+}
+
+std::string ResourceCache::get_pipeline_cache_directory()
 {
-	recorder.set_data(data);
+	return PIPELINE_CACHE_DIRECTORY;
+}
 
-	replayer.play(*this, recorder);
+void ResourceCache::warmup(const std::vector<uint8_t> &data, ThreadPool *thread_pool)
+{
+	warmup(data.data(), data.size(), thread_pool);
+}
+
+void ResourceCache::warmup(const uint8_t *data, size_t size, ThreadPool *thread_pool)
+{
+	// Objects missing from the cache are recorded again as they are created
+	replayer.play(*this, data, size, thread_pool);
 }
 
 std::vector<uint8_t> ResourceCache::serialize()
@@ -57,52 +267,461 @@ void ResourceCache::set_pipeline_cache(VkPipelineCache new_pipeline_cache)
 	pipeline_cache = new_pipeline_cache;
 }
 
+bool ResourceCache::load_pipeline_cache(ThreadPool *thread_pool)
+{
+	if (persistent_pipeline_cache != VK_NULL_HANDLE)
+	{
+		return pipeline_cache_warm;
+	}
+
+	auto path = get_pipeline_cache_path();
+	auto data = read_pipeline_cache_file(path, device.get_gpu().get_properties());
+
+	VkPipelineCacheCreateInfo create_info{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+	create_info.initialDataSize = data.size();
+	create_info.pInitialData    = data.data();
+
+	VK_CHECK(vkCreatePipelineCache(device.get_handle(), &create_info, nullptr, &persistent_pipeline_cache));
+
+	pipeline_cache      = persistent_pipeline_cache;
+	pipeline_cache_warm = !data.empty();
+
+	if (pipeline_cache_warm)
+	{
+		LOGI("Loaded pipeline cache {} ({} KiB)", path, data.size() / 1024);
+	}
+	else
+	{
+		LOGI("Starting with an empty pipeline cache, it is saved to {}", path);
+	}
+
+	if (pipeline_cache_warmup_enabled)
+	{
+		auto resources_path = path + ".resources";
+		auto fs             = vkb::filesystem::get();
+		if (fs->exists(resources_path))
+		{
+			warmup(fs->read_file_binary(resources_path), thread_pool);
+			LOGI("Warmed up {} pipelines from {}", get_pipeline_count(), resources_path);
+		}
+	}
+
+	// Taken after the warm-up, so that the pipelines it created are not counted as created by the run
+	loaded_pipeline_count = get_pipeline_count();
+
+	// Pipelines of the warm-up are saved at the first save even if no draw creates another one
+	saved_pipeline_count = 0;
+
+	return pipeline_cache_warm;
+}
+
+void ResourceCache::save_pipeline_cache()
+{
+	if (persistent_pipeline_cache == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	// The workers merge into the pipeline cache in use, which may have been replaced with set_pipeline_cache
+	if (pipeline_cache == persistent_pipeline_cache)
+	{
+		merge_pipeline_caches();
+	}
+
+	size_t   size{0};
+	VkResult result = vkGetPipelineCacheData(device.get_handle(), persistent_pipeline_cache, &size, nullptr);
+
+	std::vector<uint8_t> contents(sizeof(PipelineCacheFileHeader) + size);
+	if (result == VK_SUCCESS)
+	{
+		result = vkGetPipelineCacheData(device.get_handle(), persistent_pipeline_cache, &size, contents.data() + sizeof(PipelineCacheFileHeader));
+		contents.resize(sizeof(PipelineCacheFileHeader) + size);
+	}
+
+	if (result != VK_SUCCESS)
+	{
+		LOGE("Detected Vulkan error: {}, pipeline cache not saved.", vkb::to_string(result));
+		return;
+	}
+
+	if (size == 0)
+	{
+		LOGD("Pipeline cache is empty, not saved");
+		return;
+	}
+
+	auto &properties = device.get_gpu().get_properties();
+
+	PipelineCacheFileHeader header{};
+	std::memcpy(header.magic, PIPELINE_CACHE_MAGIC, sizeof(PIPELINE_CACHE_MAGIC));
+	header.version        = PIPELINE_CACHE_VERSION;
+	header.vendor_id      = properties.vendorID;
+	header.device_id      = properties.deviceID;
+	header.driver_version = properties.driverVersion;
+	std::memcpy(header.pipeline_cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+	header.data_size = size;
+	header.checksum  = hash_bytes(contents.data() + sizeof(header), size);
+	std::memcpy(contents.data(), &header, sizeof(header));
+
+	auto path = get_pipeline_cache_path();
+	write_file_atomically(path, contents);
+
+	if (pipeline_cache_warmup_enabled)
+	{
+		std::lock_guard<std::mutex> guard(recorder_mutex);
+		write_file_atomically(path + ".resources", recorder.get_data());
+	}
+
+	saved_pipeline_count = get_pipeline_count();
+
+	// Pipelines destroyed by clear_pipelines are not counted
+	LOGI("Saved pipeline cache {} ({} KiB), {} pipelines were created from a {} cache",
+	     path,
+	     size / 1024,
+	     saved_pipeline_count > loaded_pipeline_count ? saved_pipeline_count - loaded_pipeline_count : 0,
+	     pipeline_cache_warm ? "warm" : "cold");
+}
+
+void ResourceCache::update_pipeline_cache(float delta_time)
+{
+	if (persistent_pipeline_cache == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	pipeline_cache_save_timer += delta_time;
+	if (pipeline_cache_save_timer < PIPELINE_CACHE_SAVE_INTERVAL)
+	{
+		return;
+	}
+	pipeline_cache_save_timer = 0.0f;
+
+	if (get_pipeline_count() != saved_pipeline_count)
+	{
+		save_pipeline_cache();
+	}
+}
+
+std::string ResourceCache::get_pipeline_cache_path() const
+{
+	// One file per device, so that machines with several GPUs don't keep replacing each other's cache
+	auto &properties = device.get_gpu().get_properties();
+	return fmt::format("{}/{:08x}_{:08x}.vkbpso", PIPELINE_CACHE_DIRECTORY, properties.vendorID, properties.deviceID);
+}
+
+std::size_t ResourceCache::get_pipeline_count() const
+{
+	return state.graphics_pipelines.size() + state.compute_pipelines.size();
+}
+
 ShaderModule &ResourceCache::request_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const ShaderVariant &shader_variant)
 {
 	std::string entry_point{"main"};
-	return request_resource(device, recorder, shader_module_mutex, state.shader_modules, stage, glsl_source, entry_point, shader_variant);
+	return request_resource(device, recorder, recorder_mutex, state.shader_modules, stage, glsl_source, entry_point, shader_variant);
 }
 
 PipelineLayout &ResourceCache::request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
 {
-	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules);
+	return request_resource(device, recorder, recorder_mutex, state.pipeline_layouts, shader_modules);
 }
 
 DescriptorSetLayout &ResourceCache::request_descriptor_set_layout(const uint32_t                     set_index,
                                                                   const std::vector<ShaderModule *> &shader_modules,
                                                                   const std::vector<ShaderResource> &set_resources)
 {
-	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
+	return request_resource(device, recorder, recorder_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
 }
 
 GraphicsPipeline &ResourceCache::request_graphics_pipeline(PipelineState &pipeline_state)
 {
-	return request_resource(device, recorder, graphics_pipeline_mutex, state.graphics_pipelines, pipeline_cache, pipeline_state);
+	return request_resource(device, recorder, recorder_mutex, state.graphics_pipelines, pipeline_cache, pipeline_state);
 }
 
 ComputePipeline &ResourceCache::request_compute_pipeline(PipelineState &pipeline_state)
 {
-	return request_resource(device, recorder, compute_pipeline_mutex, state.compute_pipelines, pipeline_cache, pipeline_state);
+	return request_resource(device, recorder, recorder_mutex, state.compute_pipelines, pipeline_cache, pipeline_state);
+}
+
+void ResourceCache::set_async_pipeline_compilation(ThreadPool *thread_pool, PipelineCompileMode mode)
+{
+	// Jobs already queued keep using the previous pool
+	if (!thread_pool)
+	{
+		wait_for_pipelines();
+	}
+
+	pipeline_compile_mode.store(mode);
+	pipeline_thread_pool.store(thread_pool);
+}
+
+template <class T>
+T *ResourceCache::request_pipeline_for_draw(ShardedResourceMap<T>                &pipelines,
+                                            std::unordered_map<std::size_t, T *> &fallback_pipelines,
+                                            PipelineState                        &pipeline_state,
+                                            bool                                 &is_fallback)
+{
+	is_fallback = false;
+
+	// The pipeline cache is not part of the key, so pipelines compiled with a worker cache are found under the same one
+	std::size_t hash{0U};
+	hash_param(hash, pipeline_cache, pipeline_state);
+
+	if (auto pipeline = pipelines.find(hash))
+	{
+		return pipeline;
+	}
+
+	// Loaded once, set_async_pipeline_compilation may change them while the draw runs
+	ThreadPool         *thread_pool = pipeline_thread_pool.load();
+	PipelineCompileMode mode        = pipeline_compile_mode.load();
+
+	if (!thread_pool)
+	{
+		return &request_resource(device, recorder, recorder_mutex, pipelines, pipeline_cache, pipeline_state);
+	}
+
+	std::unique_lock<std::mutex> lock{pipeline_compile_mutex};
+
+	// A job may have finished it since the lookup above, and it is no longer pending
+	if (auto pipeline = pipelines.find(hash))
+	{
+		return pipeline;
+	}
+
+	// Pipelines that failed to compile are not queued again, their draws are skipped or use the fallback
+	bool failed  = failed_pipelines.count(hash) > 0;
+	bool pending = pending_pipelines.count(hash) > 0;
+
+	// A worker waiting for a job could wait for one queued behind itself, and a job queued while every worker is busy
+	// waits for all of them, so these draws compile the pipeline themselves. A duplicate of a pending job is dropped by the insert.
+	if (mode == PipelineCompileMode::Wait && !failed &&
+	    (thread_pool->is_worker_thread() || (!pending && running_compiles >= thread_pool->get_thread_count())))
+	{
+		pending_pipelines.insert(hash);
+		running_compiles++;
+		lock.unlock();
+
+		compile_pipeline(pipelines, hash, pipeline_state);
+
+		// Not found if the compile failed, then the draw is skipped
+		return pipelines.find(hash);
+	}
+
+	if (!failed && !pending)
+	{
+		pending_pipelines.insert(hash);
+		running_compiles++;
+
+		// The job compiles a copy of the state, the one of the command buffer changes with the next draws
+		thread_pool->push([this, &pipelines, hash, pipeline_state]() mutable {
+			compile_pipeline(pipelines, hash, pipeline_state);
+		});
+	}
+
+	if (mode == PipelineCompileMode::Wait && !failed)
+	{
+		// Only draws blocked on a compile job count as stalls, draws compiling the pipeline themselves don't
+		device.get_stats_counters().pipelines.add_stall();
+
+		pipeline_compile_done.wait(lock, [this, hash]() { return pending_pipelines.count(hash) == 0; });
+
+		// Not found if the compile failed, then the draw is skipped
+		return pipelines.find(hash);
+	}
+
+	if (mode == PipelineCompileMode::Fallback)
+	{
+		auto fallback_it = fallback_pipelines.find(get_fallback_key(pipeline_state));
+		if (fallback_it != fallback_pipelines.end())
+		{
+			is_fallback = true;
+			return fallback_it->second;
+		}
+	}
+
+	return nullptr;
+}
+
+template <class T>
+void ResourceCache::compile_pipeline(ShardedResourceMap<T> &pipelines, std::size_t hash, PipelineState &pipeline_state)
+{
+	VkPipelineCache worker_pipeline_cache = acquire_worker_pipeline_cache();
+
+	bool compiled = true;
+	try
+	{
+		// Compiled without the creation lock of the shard, so that it doesn't block the draws missing other pipelines of that shard
+		T pipeline = create_resource<T>(device, worker_pipeline_cache, pipeline_state);
+		pipelines.insert(hash, std::move(pipeline), [&](T &resource) {
+			record_resource(recorder, recorder_mutex, resource, worker_pipeline_cache, pipeline_state);
+		});
+	}
+	catch (const std::exception &e)
+	{
+		LOGE("Failed to compile pipeline in the background: {}", e.what());
+		compiled = false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+
+		if (worker_pipeline_cache != VK_NULL_HANDLE)
+		{
+			idle_worker_pipeline_caches.push_back(worker_pipeline_cache);
+		}
+
+		pending_pipelines.erase(hash);
+		if (!compiled)
+		{
+			failed_pipelines.insert(hash);
+		}
+
+		running_compiles--;
+	}
+
+	pipeline_compile_done.notify_all();
+}
+
+GraphicsPipeline *ResourceCache::request_graphics_pipeline_for_draw(PipelineState &pipeline_state, bool &is_fallback)
+{
+	return request_pipeline_for_draw(state.graphics_pipelines, fallback_graphics_pipelines, pipeline_state, is_fallback);
+}
+
+ComputePipeline *ResourceCache::request_compute_pipeline_for_dispatch(PipelineState &pipeline_state, bool &is_fallback)
+{
+	return request_pipeline_for_draw(state.compute_pipelines, fallback_compute_pipelines, pipeline_state, is_fallback);
+}
+
+VkPipelineCache ResourceCache::acquire_worker_pipeline_cache()
+{
+	// Without a pipeline cache to merge into, the workers don't use one either
+	if (pipeline_cache == VK_NULL_HANDLE)
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+
+		if (!idle_worker_pipeline_caches.empty())
+		{
+			VkPipelineCache worker_pipeline_cache = idle_worker_pipeline_caches.back();
+			idle_worker_pipeline_caches.pop_back();
+			return worker_pipeline_cache;
+		}
+	}
+
+	VkPipelineCacheCreateInfo create_info{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+
+	VkPipelineCache worker_pipeline_cache{VK_NULL_HANDLE};
+	VK_CHECK(vkCreatePipelineCache(device.get_handle(), &create_info, nullptr, &worker_pipeline_cache));
+
+	std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+	worker_pipeline_caches.push_back(worker_pipeline_cache);
+
+	return worker_pipeline_cache;
+}
+
+void ResourceCache::set_fallback_pipeline(GraphicsPipeline &pipeline)
+{
+	std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+	fallback_graphics_pipelines[get_fallback_key(pipeline.get_state())] = &pipeline;
+}
+
+void ResourceCache::set_fallback_pipeline(ComputePipeline &pipeline)
+{
+	std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+	fallback_compute_pipelines[get_fallback_key(pipeline.get_state())] = &pipeline;
+}
+
+void ResourceCache::wait_for_pipelines()
+{
+	std::unique_lock<std::mutex> lock{pipeline_compile_mutex};
+	pipeline_compile_done.wait(lock, [this]() { return running_compiles == 0; });
+}
+
+void ResourceCache::merge_pipeline_caches()
+{
+	if (pipeline_cache == VK_NULL_HANDLE)
+	{
+		return;
+	}
+
+	// Holding the lock keeps the idle caches from being taken by a job while they are merged
+	std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+
+	if (idle_worker_pipeline_caches.empty())
+	{
+		return;
+	}
+
+	VK_CHECK(vkMergePipelineCaches(device.get_handle(), pipeline_cache, to_u32(idle_worker_pipeline_caches.size()), idle_worker_pipeline_caches.data()));
+
+	LOGD("Merged {} worker pipeline caches", idle_worker_pipeline_caches.size());
+
+	// The merged caches are destroyed, so that later jobs start empty and their data is not merged twice
+	for (auto worker_pipeline_cache : idle_worker_pipeline_caches)
+	{
+		vkDestroyPipelineCache(device.get_handle(), worker_pipeline_cache, nullptr);
+		std::erase(worker_pipeline_caches, worker_pipeline_cache);
+	}
+	idle_worker_pipeline_caches.clear();
+}
+
+void ResourceCache::destroy_pipeline_caches()
+{
+	wait_for_pipelines();
+
+	std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+
+	for (auto worker_pipeline_cache : worker_pipeline_caches)
+	{
+		vkDestroyPipelineCache(device.get_handle(), worker_pipeline_cache, nullptr);
+	}
+
+	worker_pipeline_caches.clear();
+	idle_worker_pipeline_caches.clear();
+
+	if (persistent_pipeline_cache != VK_NULL_HANDLE)
+	{
+		if (pipeline_cache == persistent_pipeline_cache)
+		{
+			pipeline_cache = VK_NULL_HANDLE;
+		}
+
+		vkDestroyPipelineCache(device.get_handle(), persistent_pipeline_cache, nullptr);
+		persistent_pipeline_cache = VK_NULL_HANDLE;
+	}
 }
 
 DescriptorSet &ResourceCache::request_descriptor_set(DescriptorSetLayout &descriptor_set_layout, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos)
 {
-	auto &descriptor_pool = request_resource(device, recorder, descriptor_set_mutex, state.descriptor_pools, descriptor_set_layout);
-	return request_resource(device, recorder, descriptor_set_mutex, state.descriptor_sets, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+	auto &descriptor_pool = request_resource(device, recorder, recorder_mutex, state.descriptor_pools, descriptor_set_layout);
+	return request_resource(device, recorder, recorder_mutex, state.descriptor_sets, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
 }
 
 RenderPass &ResourceCache::request_render_pass(const std::vector<Attachment> &attachments, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<SubpassInfo> &subpasses)
 {
-	return request_resource(device, recorder, render_pass_mutex, state.render_passes, attachments, load_store_infos, subpasses);
+	return request_resource(device, recorder, recorder_mutex, state.render_passes, attachments, load_store_infos, subpasses);
 }
 
 Framebuffer &ResourceCache::request_framebuffer(const RenderTarget &render_target, const RenderPass &render_pass)
 {
-	return request_resource(device, recorder, framebuffer_mutex, state.framebuffers, render_target, render_pass);
+	return request_resource(device, recorder, recorder_mutex, state.framebuffers, render_target, render_pass);
 }
 
 void ResourceCache::clear_pipelines()
 {
+	wait_for_pipelines();
+
+	{
+		std::lock_guard<std::mutex> lock{pipeline_compile_mutex};
+		pending_pipelines.clear();
+		failed_pipelines.clear();
+		fallback_graphics_pipelines.clear();
+		fallback_compute_pipelines.clear();
+	}
+
 	state.graphics_pipelines.clear();
 	state.compute_pipelines.clear();
 }
@@ -118,11 +737,7 @@ void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &o
 		auto &old_view = old_views[i];
 		auto &new_view = new_views[i];
 
-		for (auto &kd_pair : state.descriptor_sets)
-		{
-			auto &key            = kd_pair.first;
-			auto &descriptor_set = kd_pair.second;
-
+		state.descriptor_sets.for_each([&](std::size_t key, DescriptorSet &descriptor_set) {
 			auto &image_infos = descriptor_set.get_image_infos();
 
 			for (auto &ba_pair : image_infos)
@@ -166,7 +781,7 @@ void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &o
 					}
 				}
 			}
-		}
+		});
 	}
 
 	if (!set_updates.empty())
@@ -175,20 +790,17 @@ void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &o
 		                       0, nullptr);
 	}
 
-	// Delete old entries (moved out descriptor sets)
+	// Re-key the updated descriptor sets, moving the map nodes so the sets stay at the same address
 	for (auto &match : matches)
 	{
-		// Move out of the map
-		auto it             = state.descriptor_sets.find(match);
-		auto descriptor_set = std::move(it->second);
-		state.descriptor_sets.erase(match);
+		auto node = state.descriptor_sets.extract(match);
 
 		// Generate new key
 		size_t new_key = 0U;
-		hash_param(new_key, descriptor_set.get_layout(), descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
+		hash_param(new_key, node.mapped().get_layout(), node.mapped().get_buffer_infos(), node.mapped().get_image_infos());
 
-		// Add (key, resource) to the cache
-		state.descriptor_sets.emplace(new_key, std::move(descriptor_set));
+		node.key() = new_key;
+		state.descriptor_sets.insert(std::move(node));
 	}
 }
 
@@ -199,6 +811,9 @@ void ResourceCache::clear_framebuffers()
 
 void ResourceCache::clear()
 {
+	// Compile jobs use the shader modules and layouts cleared below
+	wait_for_pipelines();
+
 	state.shader_modules.clear();
 	state.pipeline_layouts.clear();
 	state.descriptor_sets.clear();
@@ -206,6 +821,7 @@ void ResourceCache::clear()
 	state.render_passes.clear();
 	clear_pipelines();
 	clear_framebuffers();
+	destroy_pipeline_caches();
 }
 
 const ResourceCacheState &ResourceCache::get_internal_state() const
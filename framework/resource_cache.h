@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,8 +17,15 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "common/helpers.h"
@@ -41,42 +48,278 @@ using DeviceC = Device<vkb::BindingType::C>;
 class ImageView;
 }        // namespace core
 
+/**
+ * @brief Map of cached resources for concurrent use, split into shards by hash.
+ *
+ * Lookups only take a shared lock on one shard, so threads hitting the cache don't serialize.
+ * A miss takes the creation lock of its shard and checks again before creating the resource, so two threads
+ * missing on the same key create it once. The resource is created without holding the shard lock, so hits on
+ * that shard are only blocked for the insertion itself. Resources that take long to create, e.g. pipelines
+ * compiled in the background, can be created without any lock and inserted afterwards, see insert.
+ * References to resources stay valid until they are erased or the map is cleared.
+ */
+template <class T>
+class ShardedResourceMap
+{
+  public:
+	using Map = std::unordered_map<std::size_t, T>;
+
+	static constexpr std::size_t SHARD_COUNT = 32;
+
+	/**
+	 * @return The resource with the given hash, or nullptr if there is none
+	 */
+	T *find(std::size_t hash)
+	{
+		auto &shard = get_shard(hash);
+
+		std::shared_lock<std::shared_mutex> lock{shard.mutex};
+
+		auto it = shard.resources.find(hash);
+		return it != shard.resources.end() ? &it->second : nullptr;
+	}
+
+	/**
+	 * @brief Returns the resource with the given hash, creating it on a miss
+	 * @param create Callable returning the new resource
+	 * @param on_created Callable receiving the stored resource, called once after insertion while the creation lock is still held.
+	 *                   It is not called if a resource inserted with insert meanwhile took the key.
+	 */
+	template <class Create, class OnCreated>
+	T &find_or_create(std::size_t hash, Create &&create, OnCreated &&on_created)
+	{
+		if (auto resource = find(hash))
+		{
+			return *resource;
+		}
+
+		auto &shard = get_shard(hash);
+
+		std::lock_guard<std::mutex> creation_lock{shard.creation_mutex};
+
+		// Another thread may have created it while we were waiting for the creation lock
+		if (auto resource = find(hash))
+		{
+			return *resource;
+		}
+
+		T new_resource = create();
+
+		return insert(hash, std::move(new_resource), std::forward<OnCreated>(on_created));
+	}
+
+	/**
+	 * @brief Inserts a resource created without taking the creation lock of the shard. If another thread inserted
+	 *        one with the same hash meanwhile, that one is kept and the new resource is left to the caller to destroy.
+	 * @param on_inserted Callable receiving the stored resource, called only if the new resource was inserted
+	 * @return The resource stored with the hash
+	 */
+	template <class OnInserted>
+	T &insert(std::size_t hash, T &&new_resource, OnInserted &&on_inserted)
+	{
+		auto &shard = get_shard(hash);
+
+		T   *resource = nullptr;
+		bool inserted = false;
+		{
+			std::unique_lock<std::shared_mutex> lock{shard.mutex};
+
+			auto res_ins_it = shard.resources.try_emplace(hash, std::move(new_resource));
+			resource        = &res_ins_it.first->second;
+			inserted        = res_ins_it.second;
+		}
+
+		if (inserted)
+		{
+			on_inserted(*resource);
+		}
+
+		return *resource;
+	}
+
+#ifdef VKB_DEBUG
+	/**
+	 * @brief Checks that a key always maps to the same resource description.
+	 *        The first check seen for a hash is stored, a different one on a later request means that two
+	 *        different descriptions collided on the same hash and the cache would return the wrong resource.
+	 * @param hash The key of the resource
+	 * @param check A second hash of the resource description, computed with a different seed
+	 */
+	void verify_key(std::size_t hash, std::size_t check)
+	{
+		auto &shard = get_shard(hash);
+
+		std::lock_guard<std::mutex> lock{shard.key_checks_mutex};
+
+		auto check_it = shard.key_checks.emplace(hash, check).first;
+		if (check_it->second != check)
+		{
+			throw std::runtime_error{"Hash collision in resource cache for key " + std::to_string(hash)};
+		}
+	}
+#endif
+
+	/**
+	 * @brief Calls a function on every resource, with each shard exclusively locked in turn
+	 */
+	template <class F>
+	void for_each(F &&function)
+	{
+		for (auto &shard : shards)
+		{
+			std::unique_lock<std::shared_mutex> lock{shard.mutex};
+
+			for (auto &key_resource : shard.resources)
+			{
+				function(key_resource.first, key_resource.second);
+			}
+		}
+	}
+
+	/**
+	 * @brief Removes a resource from the map without destroying it
+	 */
+	typename Map::node_type extract(std::size_t hash)
+	{
+		auto &shard = get_shard(hash);
+
+#ifdef VKB_DEBUG
+		{
+			std::lock_guard<std::mutex> checks_lock{shard.key_checks_mutex};
+			shard.key_checks.erase(hash);
+		}
+#endif
+
+		std::unique_lock<std::shared_mutex> lock{shard.mutex};
+
+		return shard.resources.extract(hash);
+	}
+
+	/**
+	 * @brief Inserts a resource previously extracted, possibly under a new key
+	 */
+	void insert(typename Map::node_type &&node)
+	{
+		auto &shard = get_shard(node.key());
+
+		std::unique_lock<std::shared_mutex> lock{shard.mutex};
+
+		shard.resources.insert(std::move(node));
+	}
+
+	std::size_t size() const
+	{
+		std::size_t count = 0;
+
+		for (auto &shard : shards)
+		{
+			std::shared_lock<std::shared_mutex> lock{shard.mutex};
+			count += shard.resources.size();
+		}
+
+		return count;
+	}
+
+	void clear()
+	{
+		for (auto &shard : shards)
+		{
+			std::unique_lock<std::shared_mutex> lock{shard.mutex};
+			shard.resources.clear();
+
+#ifdef VKB_DEBUG
+			std::lock_guard<std::mutex> checks_lock{shard.key_checks_mutex};
+			shard.key_checks.clear();
+#endif
+		}
+	}
+
+  private:
+	// Shards are cache line aligned so that readers of neighbouring shards don't share the line of the lock
+	struct alignas(64) Shard
+	{
+		mutable std::shared_mutex mutex;
+
+		std::mutex creation_mutex;
+
+		Map resources;
+
+#ifdef VKB_DEBUG
+		std::mutex key_checks_mutex;
+
+		std::unordered_map<std::size_t, std::size_t> key_checks;
+#endif
+	};
+
+	Shard &get_shard(std::size_t hash)
+	{
+		// The keys come from hash_combine, whose low bits are poorly mixed, so spread them before selecting the shard
+		uint64_t mixed = static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+		return shards[mixed >> 59];
+	}
+
+	std::array<Shard, SHARD_COUNT> shards;
+};
+
 /**
  * @brief Struct to hold the internal state of the Resource Cache
  *
  */
 struct ResourceCacheState
 {
-	std::unordered_map<std::size_t, ShaderModule> shader_modules;
+	ShardedResourceMap<ShaderModule> shader_modules;
+
+	ShardedResourceMap<PipelineLayout> pipeline_layouts;
 
-	std::unordered_map<std::size_t, PipelineLayout> pipeline_layouts;
+	ShardedResourceMap<DescriptorSetLayout> descriptor_set_layouts;
 
-	std::unordered_map<std::size_t, DescriptorSetLayout> descriptor_set_layouts;
+	ShardedResourceMap<DescriptorPool> descriptor_pools;
 
-	std::unordered_map<std::size_t, DescriptorPool> descriptor_pools;
+	ShardedResourceMap<RenderPass> render_passes;
 
-	std::unordered_map<std::size_t, RenderPass> render_passes;
+	ShardedResourceMap<GraphicsPipeline> graphics_pipelines;
 
-	std::unordered_map<std::size_t, GraphicsPipeline> graphics_pipelines;
+	ShardedResourceMap<ComputePipeline> compute_pipelines;
+
+	ShardedResourceMap<DescriptorSet> descriptor_sets;
+
+	ShardedResourceMap<Framebuffer> framebuffers;
+};
 
-	std::unordered_map<std::size_t, ComputePipeline> compute_pipelines;
+/**
+ * @brief What a draw does while the pipeline it needs is compiled in the background
+ */
+enum class PipelineCompileMode
+{
+	/// The draw waits for a worker to compile the pipeline, or compiles it itself, see ResourceCache::set_async_pipeline_compilation
+	Wait,
 
-	std::unordered_map<std::size_t, DescriptorSet> descriptor_sets;
+	/// The draw is skipped
+	Skip,
 
-	std::unordered_map<std::size_t, Framebuffer> framebuffers;
+	/// The draw uses the fallback pipeline registered for its pipeline layout and subpass, or is skipped without one
+	Fallback
 };
 
 /**
  * @brief Cache all sorts of Vulkan objects specific to a Vulkan device.
  * Supports serialization and deserialization of cached resources.
- * There is only one cache for all these objects, with several unordered_map of hash indices
+ * There is only one cache for all these objects, with several sharded maps of hash indices
  * and objects. For every object requested, there is a templated version on request_resource.
  * Some objects may need building if they are not found in the cache.
+ * Requests may come from several threads; hits only take a shared lock, see ShardedResourceMap.
  *
  * The resource cache is also linked with ResourceRecord and ResourceReplay. Replay can warm-up
  * the cache on app startup by creating all necessary objects.
  * The cache holds pointers to objects and has a mapping from such pointers to hashes.
  * It can only be destroyed in bulk, single elements cannot be removed.
+ *
+ * Pipelines that draws miss can be compiled in the background, see set_async_pipeline_compilation.
+ * Each compile job creates its pipeline with a pipeline cache of its own, so the workers never contend on
+ * a cache; merge_pipeline_caches moves what they learned into the pipeline cache set with set_pipeline_cache.
+ *
+ * The pipeline cache can also persist across runs, see load_pipeline_cache. Its file starts with the vendor, device,
+ * driver version and pipeline cache UUID of the device that wrote it, and is only given to the driver if they match.
  */
 class ResourceCache
 {
@@ -91,12 +334,60 @@ class ResourceCache
 
 	ResourceCache &operator=(ResourceCache &&) = delete;
 
-	void warmup(const std::vector<uint8_t> &data);
+	/// Bump when the layout of the pipeline cache files changes
+	static constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+	/// Seconds between two saves of the persistent pipeline cache, while new pipelines are created
+	static constexpr float PIPELINE_CACHE_SAVE_INTERVAL = 30.0f;
+
+	/**
+	 * @brief Makes new devices load their pipeline cache from disk and save it back, see load_pipeline_cache
+	 * @param warmup Also saves the resources requested from the cache, and creates them again when loading, see warmup
+	 */
+	static void set_persistent_pipeline_cache_enabled(bool enabled, bool warmup = false);
+
+	static bool is_persistent_pipeline_cache_enabled();
+
+	/**
+	 * @return The directory of the pipeline cache files, relative to the working directory
+	 */
+	static std::string get_pipeline_cache_directory();
+
+	/**
+	 * @brief Creates the objects recorded by a previous run, see ResourceReplay
+	 * @param data The data returned by serialize, it is rejected if it is stale or corrupt
+	 * @param thread_pool If not null, graphics pipelines are created by the workers of this pool
+	 */
+	void warmup(const std::vector<uint8_t> &data, ThreadPool *thread_pool = nullptr);
+
+	/**
+	 * @brief Creates the objects recorded by a previous run, reading the data in place, e.g. from a mapped file
+	 */
+	void warmup(const uint8_t *data, size_t size, ThreadPool *thread_pool = nullptr);
 
 	std::vector<uint8_t> serialize();
 
 	void set_pipeline_cache(VkPipelineCache pipeline_cache);
 
+	/**
+	 * @brief Creates a pipeline cache owned by the resource cache and uses it for all pipelines, in place of the one
+	 *        set with set_pipeline_cache. It starts with the data saved by a previous run on the same device and driver.
+	 * @param thread_pool If not null, the pipelines of the warm-up are created by the workers of this pool
+	 * @return True if the pipeline cache starts warm
+	 */
+	bool load_pipeline_cache(ThreadPool *thread_pool = nullptr);
+
+	/**
+	 * @brief Merges the pipeline caches of the compile jobs and writes the pipeline cache created by load_pipeline_cache
+	 *        back to disk, replacing the previous file atomically
+	 */
+	void save_pipeline_cache();
+
+	/**
+	 * @brief Saves the pipeline cache every PIPELINE_CACHE_SAVE_INTERVAL seconds if pipelines were created since the last save
+	 */
+	void update_pipeline_cache(float delta_time);
+
 	ShaderModule &request_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const ShaderVariant &shader_variant = {});
 
 	PipelineLayout &request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules);
@@ -109,6 +400,50 @@ class ResourceCache
 
 	ComputePipeline &request_compute_pipeline(PipelineState &pipeline_state);
 
+	/**
+	 * @brief Compiles the pipelines that draws miss with the workers of a thread pool, instead of in the draw
+	 * @param thread_pool The pool of the workers, or nullptr to compile in the draws again. It must outlive the
+	 *                    compiles, see wait_for_pipelines
+	 * @param mode What draws do until their pipeline is compiled. In PipelineCompileMode::Wait, draws recorded on a
+	 *             worker of the pool, or while a compile job is queued for every worker, compile the pipeline themselves
+	 *             instead of waiting. Draws recording on other threads pick up the new pool and mode at their next miss.
+	 */
+	void set_async_pipeline_compilation(ThreadPool *thread_pool, PipelineCompileMode mode = PipelineCompileMode::Skip);
+
+	/**
+	 * @brief Requests the graphics pipeline of a draw. With async compilation, a pipeline missing from the cache is
+	 *        compiled in the background and the draw gets what the compile mode says in the meantime
+	 * @param is_fallback Set to true if the returned pipeline is a fallback, see set_fallback_pipeline
+	 * @return The pipeline to draw with, or nullptr if the draw has to be skipped
+	 */
+	GraphicsPipeline *request_graphics_pipeline_for_draw(PipelineState &pipeline_state, bool &is_fallback);
+
+	/**
+	 * @brief Requests the compute pipeline of a dispatch, see request_graphics_pipeline_for_draw
+	 */
+	ComputePipeline *request_compute_pipeline_for_dispatch(PipelineState &pipeline_state, bool &is_fallback);
+
+	/**
+	 * @brief Registers the pipeline that draws use in PipelineCompileMode::Fallback while the pipeline they need compiles.
+	 *        It stands in for the pipelines with the same pipeline layout, render pass and subpass, so it must not
+	 *        consume more vertex attributes than they do, e.g. an untextured variant of their shaders.
+	 */
+	void set_fallback_pipeline(GraphicsPipeline &pipeline);
+
+	void set_fallback_pipeline(ComputePipeline &pipeline);
+
+	/**
+	 * @brief Waits until the pipelines compiling in the background are done
+	 */
+	void wait_for_pipelines();
+
+	/**
+	 * @brief Merges the pipeline caches of the compile jobs into the pipeline cache set with set_pipeline_cache.
+	 *        Caches of the jobs still running are merged by the next call. Other threads must not create pipelines
+	 *        with the pipeline cache meanwhile, e.g. call it between frames.
+	 */
+	void merge_pipeline_caches();
+
 	DescriptorSet &request_descriptor_set(DescriptorSetLayout                      &descriptor_set_layout,
 	                                      const BindingMap<VkDescriptorBufferInfo> &buffer_infos,
 	                                      const BindingMap<VkDescriptorImageInfo>  &image_infos);
@@ -134,6 +469,30 @@ class ResourceCache
 	const ResourceCacheState &get_internal_state() const;
 
   private:
+	template <class T>
+	T *request_pipeline_for_draw(ShardedResourceMap<T>                &pipelines,
+	                             std::unordered_map<std::size_t, T *> &fallback_pipelines,
+	                             PipelineState                        &pipeline_state,
+	                             bool                                 &is_fallback);
+
+	template <class T>
+	void compile_pipeline(ShardedResourceMap<T> &pipelines, std::size_t hash, PipelineState &pipeline_state);
+
+	/**
+	 * @brief Takes a pipeline cache that no compile job is using, creating one if there is none
+	 */
+	VkPipelineCache acquire_worker_pipeline_cache();
+
+	void destroy_pipeline_caches();
+
+	std::string get_pipeline_cache_path() const;
+
+	std::size_t get_pipeline_count() const;
+
+	static bool persistent_pipeline_cache_enabled;
+
+	static bool pipeline_cache_warmup_enabled;
+
 	vkb::core::DeviceC &device;
 
 	ResourceRecord recorder;
@@ -144,20 +503,46 @@ class ResourceCache
 
 	ResourceCacheState state;
 
-	std::mutex descriptor_set_mutex;
+	/// Guards the recorder, which is written by misses of all resource types
+	std::mutex recorder_mutex;
+
+	/// Atomic, as draws recording on other threads read them without locking
+	std::atomic<ThreadPool *> pipeline_thread_pool{nullptr};
+
+	std::atomic<PipelineCompileMode> pipeline_compile_mode{PipelineCompileMode::Wait};
+
+	/// Guards the members below, which are shared with the compile jobs
+	std::mutex pipeline_compile_mutex;
+
+	std::condition_variable pipeline_compile_done;
+
+	/// Keys of the pipelines queued or compiling, in a job or in a draw
+	std::unordered_set<std::size_t> pending_pipelines;
+
+	/// Keys of the pipelines that failed to compile, so that they are not retried every draw
+	std::unordered_set<std::size_t> failed_pipelines;
+
+	uint32_t running_compiles{0};
+
+	std::vector<VkPipelineCache> worker_pipeline_caches;
+
+	/// Worker pipeline caches not used by a compile job, which can be merged
+	std::vector<VkPipelineCache> idle_worker_pipeline_caches;
 
-	std::mutex pipeline_layout_mutex;
+	std::unordered_map<std::size_t, GraphicsPipeline *> fallback_graphics_pipelines;
 
-	std::mutex shader_module_mutex;
+	std::unordered_map<std::size_t, ComputePipeline *> fallback_compute_pipelines;
 
-	std::mutex descriptor_set_layout_mutex;
+	/// The pipeline cache created by load_pipeline_cache
+	VkPipelineCache persistent_pipeline_cache{VK_NULL_HANDLE};
 
-	std::mutex graphics_pipeline_mutex;
+	bool pipeline_cache_warm{false};
 
-	std::mutex render_pass_mutex;
+	/// Pipelines in the cache when the pipeline cache was loaded and last saved
+	std::size_t loaded_pipeline_count{0};
 
-	std::mutex compute_pipeline_mutex;
+	std::size_t saved_pipeline_count{0};
 
-	std::mutex framebuffer_mutex;
+	float pipeline_cache_save_timer{0.0f};
 };
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,49 +17,115 @@
 
 #include "resource_record.h"
 
+#include <cstring>
+
 #include "core/pipeline.h"
 #include "core/pipeline_layout.h"
 #include "core/render_pass.h"
 #include "core/shader_module.h"
 #include "resource_cache.h"
 
+#include <core/util/hash.hpp>
+
 namespace vkb
 {
 namespace
 {
-inline void write_subpass_info(std::ostringstream &os, const std::vector<SubpassInfo> &value)
+template <typename T>
+inline void write_value(std::vector<uint8_t> &data, const T &value)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written as bytes");
+	auto bytes = reinterpret_cast<const uint8_t *>(&value);
+	data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+inline void write_values(std::vector<uint8_t> &data, const std::vector<T> &values)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written as bytes");
+	write_value(data, to_u32(values.size()));
+	auto bytes = reinterpret_cast<const uint8_t *>(values.data());
+	data.insert(data.end(), bytes, bytes + values.size() * sizeof(T));
+}
+}        // namespace
+
+std::vector<uint8_t> ResourceRecord::get_data() const
 {
-	write(os, value.size());
-	for (const SubpassInfo &item : value)
+	std::vector<uint8_t> data(sizeof(ResourceRecordHeader));
+
+	for (const auto &string : strings)
 	{
-		write(os, item.input_attachments);
-		write(os, item.output_attachments);
+		write_value(data, to_u32(string.size()));
+		data.insert(data.end(), string.begin(), string.end());
 	}
+
+	data.insert(data.end(), records.begin(), records.end());
+
+	ResourceRecordHeader header;
+	header.string_count = to_u32(strings.size());
+	header.record_count = record_count;
+	header.size         = data.size() - sizeof(ResourceRecordHeader);
+	header.checksum     = hash_bytes(data.data() + sizeof(ResourceRecordHeader), header.size);
+
+	std::memcpy(data.data(), &header, sizeof(header));
+
+	return data;
 }
-}        // namespace
 
-void ResourceRecord::set_data(const std::vector<uint8_t> &data)
+size_t ResourceRecord::begin_record(ResourceType type)
 {
-	stream.str(std::string{data.begin(), data.end()});
+	size_t record_offset = records.size();
+
+	write_value(records, type);
+	write_value(records, uint32_t{0});
+
+	++record_count;
+
+	return record_offset;
 }
 
-std::vector<uint8_t> ResourceRecord::get_data()
+void ResourceRecord::end_record(size_t record_offset)
 {
-	std::string str = stream.str();
+	size_t   payload_offset = record_offset + sizeof(ResourceType) + sizeof(uint32_t);
+	uint32_t payload_size   = to_u32(records.size() - payload_offset);
 
-	return std::vector<uint8_t>{str.begin(), str.end()};
+	std::memcpy(records.data() + record_offset + sizeof(ResourceType), &payload_size, sizeof(payload_size));
 }
 
-const std::ostringstream &ResourceRecord::get_stream()
+uint32_t ResourceRecord::add_string(const std::string &value)
 {
-	return stream;
+	auto it = string_indices.find(value);
+	if (it != string_indices.end())
+	{
+		return it->second;
+	}
+
+	uint32_t index = to_u32(strings.size());
+	strings.push_back(value);
+	string_indices.emplace(strings.back(), index);
+
+	return index;
 }
 
 size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const std::string &entry_point, const ShaderVariant &shader_variant)
 {
 	shader_module_indices.push_back(shader_module_indices.size());
 
-	write(stream, ResourceType::ShaderModule, stage, glsl_source.get_source(), entry_point);
+	auto record_offset = begin_record(ResourceType::ShaderModule);
+
+	write_value(records, stage);
+	write_value(records, add_string(glsl_source.get_source()));
+	write_value(records, add_string(entry_point));
+
+	auto &runtime_array_sizes = shader_variant.get_runtime_array_sizes();
+	write_value(records, to_u32(runtime_array_sizes.size()));
+	for (auto &runtime_array_size : runtime_array_sizes)
+	{
+		write_value(records, add_string(runtime_array_size.first));
+		write_value(records, static_cast<uint64_t>(runtime_array_size.second));
+	}
+
+	end_record(record_offset);
 
 	return shader_module_indices.back();
 }
@@ -68,13 +134,15 @@ size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *
 {
 	pipeline_layout_indices.push_back(pipeline_layout_indices.size());
 
-	std::vector<size_t> shader_indices(shader_modules.size());
+	std::vector<uint32_t> shader_indices(shader_modules.size());
 	std::transform(shader_modules.begin(), shader_modules.end(), shader_indices.begin(),
-	               [this](ShaderModule *shader_module) { return shader_module_to_index.at(shader_module); });
+	               [this](ShaderModule *shader_module) { return to_u32(shader_module_to_index.at(shader_module)); });
+
+	auto record_offset = begin_record(ResourceType::PipelineLayout);
 
-	write(stream,
-	      ResourceType::PipelineLayout,
-	      shader_indices);
+	write_values(records, shader_indices);
+
+	end_record(record_offset);
 
 	return pipeline_layout_indices.back();
 }
@@ -83,12 +151,24 @@ size_t ResourceRecord::register_render_pass(const std::vector<Attachment> &attac
 {
 	render_pass_indices.push_back(render_pass_indices.size());
 
-	write(stream,
-	      ResourceType::RenderPass,
-	      attachments,
-	      load_store_infos);
+	auto record_offset = begin_record(ResourceType::RenderPass);
+
+	write_values(records, attachments);
+	write_values(records, load_store_infos);
+
+	write_value(records, to_u32(subpasses.size()));
+	for (const SubpassInfo &subpass : subpasses)
+	{
+		write_values(records, subpass.input_attachments);
+		write_values(records, subpass.output_attachments);
+		write_values(records, subpass.color_resolve_attachments);
+		write_value(records, static_cast<uint32_t>(subpass.disable_depth_stencil_attachment));
+		write_value(records, subpass.depth_stencil_resolve_attachment);
+		write_value(records, subpass.depth_stencil_resolve_mode);
+		write_value(records, add_string(subpass.debug_name));
+	}
 
-	write_subpass_info(stream, subpasses);
+	end_record(record_offset);
 
 	return render_pass_indices.back();
 }
@@ -100,36 +180,39 @@ size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cac
 	auto &pipeline_layout = pipeline_state.get_pipeline_layout();
 	auto  render_pass     = pipeline_state.get_render_pass();
 
-	write(stream,
-	      ResourceType::GraphicsPipeline,
-	      pipeline_layout_to_index.at(&pipeline_layout),
-	      render_pass_to_index.at(render_pass),
-	      pipeline_state.get_subpass_index());
+	auto record_offset = begin_record(ResourceType::GraphicsPipeline);
+
+	write_value(records, to_u32(pipeline_layout_to_index.at(&pipeline_layout)));
+	write_value(records, to_u32(render_pass_to_index.at(render_pass)));
+	write_value(records, pipeline_state.get_subpass_index());
 
 	auto &specialization_constant_state = pipeline_state.get_specialization_constant_state().get_specialization_constant_state();
 
-	write(stream,
-	      specialization_constant_state);
+	write_value(records, to_u32(specialization_constant_state.size()));
+	for (auto &constant : specialization_constant_state)
+	{
+		write_value(records, constant.first);
+		write_values(records, constant.second);
+	}
 
 	auto &vertex_input_state = pipeline_state.get_vertex_input_state();
 
-	write(stream,
-	      vertex_input_state.attributes,
-	      vertex_input_state.bindings);
+	write_values(records, vertex_input_state.attributes);
+	write_values(records, vertex_input_state.bindings);
 
-	write(stream,
-	      pipeline_state.get_input_assembly_state(),
-	      pipeline_state.get_rasterization_state(),
-	      pipeline_state.get_viewport_state(),
-	      pipeline_state.get_multisample_state(),
-	      pipeline_state.get_depth_stencil_state());
+	write_value(records, pipeline_state.get_input_assembly_state());
+	write_value(records, pipeline_state.get_rasterization_state());
+	write_value(records, pipeline_state.get_viewport_state());
+	write_value(records, pipeline_state.get_multisample_state());
+	write_value(records, pipeline_state.get_depth_stencil_state());
 
 	auto &color_blend_state = pipeline_state.get_color_blend_state();
 
-	write(stream,
-	      color_blend_state.logic_op,
-	      color_blend_state.logic_op_enable,
-	      color_blend_state.attachments);
+	write_value(records, color_blend_state.logic_op);
+	write_value(records, color_blend_state.logic_op_enable);
+	write_values(records, color_blend_state.attachments);
+
+	end_record(record_offset);
 
 	return graphics_pipeline_indices.back();
 }
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -20,6 +20,10 @@
 #include "core/render_pass.h"
 #include "rendering/pipeline_state.h"
 #include "rendering/render_target.h"
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace vkb
@@ -29,7 +33,7 @@ class PipelineLayout;
 class RenderPass;
 class ShaderModule;
 
-enum class ResourceType
+enum class ResourceType : uint32_t
 {
 	ShaderModule,
 	PipelineLayout,
@@ -38,16 +42,41 @@ enum class ResourceType
 };
 
 /**
- * @brief Writes Vulkan objects in a memory stream.
+ * @brief Header of a serialized ResourceRecord.
+ *
+ * It is followed by the string table, a sequence of length-prefixed strings, then by the records.
+ * Each record starts with its ResourceType and the size of its payload, so unknown records can be skipped.
+ * Strings such as shader sources and entry points are stored once in the table and referenced by index.
+ * The checksum covers everything after the header.
  */
-class ResourceRecord
+struct ResourceRecordHeader
 {
-  public:
-	void set_data(const std::vector<uint8_t> &data);
+	static constexpr uint32_t MAGIC   = 0x5242'4b56;        // "VKBR"
+	static constexpr uint32_t VERSION = 1;
+
+	uint32_t magic{MAGIC};
+
+	uint32_t version{VERSION};
 
-	std::vector<uint8_t> get_data();
+	uint32_t string_count{0};
 
-	const std::ostringstream &get_stream();
+	uint32_t record_count{0};
+
+	uint64_t size{0};        // Number of bytes after the header
+
+	uint64_t checksum{0};
+};
+
+/**
+ * @brief Writes Vulkan objects in a compact binary format, see ResourceRecordHeader.
+ */
+class ResourceRecord
+{
+  public:
+	/**
+	 * @return The serialized records, with their header and string table
+	 */
+	std::vector<uint8_t> get_data() const;
 
 	size_t register_shader_module(VkShaderStageFlagBits stage,
 	                              const ShaderSource   &glsl_source,
@@ -72,7 +101,27 @@ class ResourceRecord
 	void set_graphics_pipeline(size_t index, const GraphicsPipeline &graphics_pipeline);
 
   private:
-	std::ostringstream stream;
+	/**
+	 * @brief Writes the header of a record, its size is filled in by end_record
+	 * @return The offset of the record
+	 */
+	size_t begin_record(ResourceType type);
+
+	void end_record(size_t record_offset);
+
+	/**
+	 * @return The index of the string in the string table, adding it if missing
+	 */
+	uint32_t add_string(const std::string &value);
+
+	std::vector<uint8_t> records;
+
+	uint32_t record_count{0};
+
+	// A deque keeps the strings in place, so the views used as keys stay valid
+	std::deque<std::string> strings;
+
+	std::unordered_map<std::string_view, uint32_t> string_indices;
 
 	std::vector<size_t> shader_module_indices;
 
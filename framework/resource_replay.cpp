@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,146 +17,428 @@
 
 #include "resource_replay.h"
 
+#include <cstring>
+#include <future>
+
+#include <core/util/hash.hpp>
+#include <core/util/thread_pool.hpp>
+
+#include "common/hpp_vk_common.h"
 #include "common/vk_common.h"
+#include "core/hpp_shader_module.h"
 #include "core/util/logging.hpp"
+#include "hpp_resource_cache.h"
+#include "rendering/hpp_pipeline_state.h"
+#include "rendering/hpp_render_target.h"
 #include "rendering/pipeline_state.h"
 #include "resource_cache.h"
 
 namespace vkb
 {
-namespace
-{
-inline void read_subpass_info(std::istringstream &is, std::vector<SubpassInfo> &value)
+/**
+ * @brief Reads values from serialized records in place. Reading past the end fails the reader
+ *        instead of reading out of bounds, and every later read is ignored.
+ */
+class ResourceRecordReader
 {
-	std::size_t size;
-	read(is, size);
-	value.resize(size);
-	for (SubpassInfo &subpass : value)
+  public:
+	ResourceRecordReader(const uint8_t *data, size_t size) :
+	    data{data}, size{size}
+	{}
+
+	template <typename T>
+	void read(T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read as bytes");
+		if (auto bytes = read_bytes(sizeof(T)))
+		{
+			std::memcpy(&value, bytes, sizeof(T));
+		}
+	}
+
+	template <typename T>
+	void read(std::vector<T> &values)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read as bytes");
+		uint32_t count{0};
+		read(count);
+		if (auto bytes = read_bytes(static_cast<size_t>(count) * sizeof(T)))
+		{
+			values.resize(count);
+			std::memcpy(values.data(), bytes, values.size() * sizeof(T));
+		}
+	}
+
+	template <typename T, typename... Args>
+	void read(T &first_arg, Args &...args)
+	{
+		read(first_arg);
+
+		read(args...);
+	}
+
+	/**
+	 * @return A pointer to the next count bytes, or nullptr if there are not enough bytes left
+	 */
+	const uint8_t *read_bytes(size_t count)
+	{
+		if (failed || count > size - offset)
+		{
+			failed = true;
+			return nullptr;
+		}
+
+		auto bytes = data + offset;
+		offset += count;
+		return bytes;
+	}
+
+	/**
+	 * @brief Marks the data as invalid, e.g. when a value is out of range
+	 */
+	void fail()
+	{
+		failed = true;
+	}
+
+	bool has_failed() const
 	{
-		read(is, subpass.input_attachments);
-		read(is, subpass.output_attachments);
+		return failed;
 	}
+
+	bool at_end() const
+	{
+		return offset == size;
+	}
+
+  private:
+	const uint8_t *data;
+
+	size_t size;
+
+	size_t offset{0};
+
+	bool failed{false};
+};
+
+namespace
+{
+// The replay creates objects through the same code for both caches, these overloads adapt the types to each of them
+
+ShaderModule &request_shader_module(ResourceCache &resource_cache, VkShaderStageFlagBits stage, const ShaderSource &shader_source, const ShaderVariant &shader_variant)
+{
+	return resource_cache.request_shader_module(stage, shader_source, shader_variant);
 }
 
-}        // namespace
+ShaderModule &request_shader_module(HPPResourceCache &resource_cache, VkShaderStageFlagBits stage, const ShaderSource &shader_source, const ShaderVariant &shader_variant)
+{
+	return reinterpret_cast<ShaderModule &>(resource_cache.request_shader_module(static_cast<vk::ShaderStageFlagBits>(stage),
+	                                                                             reinterpret_cast<const vkb::core::HPPShaderSource &>(shader_source),
+	                                                                             reinterpret_cast<const vkb::core::HPPShaderVariant &>(shader_variant)));
+}
 
-ResourceReplay::ResourceReplay()
+PipelineLayout &request_pipeline_layout(ResourceCache &resource_cache, const std::vector<ShaderModule *> &shader_modules)
 {
-	stream_resources[ResourceType::ShaderModule]     = std::bind(&ResourceReplay::create_shader_module, this, std::placeholders::_1, std::placeholders::_2);
-	stream_resources[ResourceType::PipelineLayout]   = std::bind(&ResourceReplay::create_pipeline_layout, this, std::placeholders::_1, std::placeholders::_2);
-	stream_resources[ResourceType::RenderPass]       = std::bind(&ResourceReplay::create_render_pass, this, std::placeholders::_1, std::placeholders::_2);
-	stream_resources[ResourceType::GraphicsPipeline] = std::bind(&ResourceReplay::create_graphics_pipeline, this, std::placeholders::_1, std::placeholders::_2);
+	return resource_cache.request_pipeline_layout(shader_modules);
 }
 
-void ResourceReplay::play(ResourceCache &resource_cache, ResourceRecord &recorder)
+PipelineLayout &request_pipeline_layout(HPPResourceCache &resource_cache, const std::vector<ShaderModule *> &shader_modules)
 {
-	std::istringstream stream{recorder.get_stream().str()};
+	return reinterpret_cast<PipelineLayout &>(
+	    resource_cache.request_pipeline_layout(reinterpret_cast<const std::vector<vkb::core::HPPShaderModule *> &>(shader_modules)));
+}
+
+RenderPass &request_render_pass(ResourceCache                    &resource_cache,
+                                const std::vector<Attachment>    &attachments,
+                                const std::vector<LoadStoreInfo> &load_store_infos,
+                                const std::vector<SubpassInfo>   &subpasses)
+{
+	return resource_cache.request_render_pass(attachments, load_store_infos, subpasses);
+}
 
-	while (true)
+RenderPass &request_render_pass(HPPResourceCache                 &resource_cache,
+                                const std::vector<Attachment>    &attachments,
+                                const std::vector<LoadStoreInfo> &load_store_infos,
+                                const std::vector<SubpassInfo>   &subpasses)
+{
+	return reinterpret_cast<RenderPass &>(
+	    resource_cache.request_render_pass(reinterpret_cast<const std::vector<vkb::rendering::HPPAttachment> &>(attachments),
+	                                       reinterpret_cast<const std::vector<vkb::common::HPPLoadStoreInfo> &>(load_store_infos),
+	                                       reinterpret_cast<const std::vector<vkb::core::HPPSubpassInfo> &>(subpasses)));
+}
+
+GraphicsPipeline &request_graphics_pipeline(ResourceCache &resource_cache, PipelineState &pipeline_state)
+{
+	return resource_cache.request_graphics_pipeline(pipeline_state);
+}
+
+GraphicsPipeline &request_graphics_pipeline(HPPResourceCache &resource_cache, PipelineState &pipeline_state)
+{
+	return reinterpret_cast<GraphicsPipeline &>(
+	    resource_cache.request_graphics_pipeline(reinterpret_cast<vkb::rendering::HPPPipelineState &>(pipeline_state)));
+}
+}        // namespace
+
+template <class ResourceCacheType>
+bool ResourceReplay::play_impl(ResourceCacheType &resource_cache, const uint8_t *data, size_t size, ThreadPool *thread_pool)
+{
+	if (size == 0)
+	{
+		return false;
+	}
+
+	ResourceRecordHeader header;
+	if (size < sizeof(header))
+	{
+		LOGW("Resource record rejected: truncated header");
+		return false;
+	}
+	std::memcpy(&header, data, sizeof(header));
+
+	if (header.magic != ResourceRecordHeader::MAGIC || header.version != ResourceRecordHeader::VERSION)
+	{
+		LOGW("Resource record rejected: version {} is not supported", header.version);
+		return false;
+	}
+
+	if (header.size != size - sizeof(header) || hash_bytes(data + sizeof(header), header.size) != header.checksum)
 	{
-		// Read command id
-		ResourceType resource_type;
-		read(stream, resource_type);
+		LOGW("Resource record rejected: checksum mismatch");
+		return false;
+	}
+
+	ResourceRecordReader reader{data + sizeof(header), header.size};
+
+	strings.clear();
+	shader_modules.clear();
+	pipeline_layouts.clear();
+	render_passes.clear();
 
-		if (stream.eof())
+	strings.reserve(header.string_count);
+	for (uint32_t i = 0; i < header.string_count && !reader.has_failed(); ++i)
+	{
+		uint32_t length{0};
+		reader.read(length);
+		if (auto chars = reader.read_bytes(length))
+		{
+			strings.emplace_back(reinterpret_cast<const char *>(chars), length);
+		}
+	}
+
+	// Every record is read and checked before anything is created, so that corrupt data leaves nothing behind in the cache
+	ResourceRecordReader records_reader{reader};
+
+	bool valid = play_records<ResourceCacheType>(nullptr, reader, header.record_count, nullptr);
+
+	// The check pushed placeholders for the objects, so that records referring to earlier ones could be checked
+	shader_modules.clear();
+	pipeline_layouts.clear();
+	render_passes.clear();
+
+	if (valid)
+	{
+		// Graphics pipelines only refer to earlier objects, so they are created after all the others
+		std::vector<PipelineState> pipeline_states;
+		play_records(&resource_cache, records_reader, header.record_count, &pipeline_states);
+
+		create_graphics_pipelines(resource_cache, pipeline_states, thread_pool);
+	}
+
+	strings.clear();
+
+	return valid;
+}
+
+template <class ResourceCacheType>
+bool ResourceReplay::play_records(ResourceCacheType *resource_cache, ResourceRecordReader &reader, uint32_t record_count, std::vector<PipelineState> *pipeline_states)
+{
+	for (uint32_t i = 0; i < record_count && !reader.has_failed(); ++i)
+	{
+		ResourceType resource_type{};
+		uint32_t     payload_size{0};
+		reader.read(resource_type, payload_size);
+
+		auto payload = reader.read_bytes(payload_size);
+		if (!payload)
 		{
 			break;
 		}
 
-		// Find command function for the given command id
-		auto cmd_it = stream_resources.find(resource_type);
+		ResourceRecordReader record_reader{payload, payload_size};
 
-		// Check if command replayer supports the given command
-		if (cmd_it != stream_resources.end())
+		switch (resource_type)
 		{
-			// Run command function
-			cmd_it->second(resource_cache, stream);
+			case ResourceType::ShaderModule:
+				create_shader_module(resource_cache, record_reader);
+				break;
+			case ResourceType::PipelineLayout:
+				create_pipeline_layout(resource_cache, record_reader);
+				break;
+			case ResourceType::RenderPass:
+				create_render_pass(resource_cache, record_reader);
+				break;
+			case ResourceType::GraphicsPipeline:
+				read_graphics_pipeline(record_reader, pipeline_states ? &pipeline_states->emplace_back() : nullptr);
+				break;
+			default:
+				LOGE("Replay command not supported.");
+				break;
 		}
-		else
+
+		if (record_reader.has_failed())
 		{
-			LOGE("Replay command not supported.");
+			LOGE("Resource record {} is corrupt", i);
+			return false;
 		}
 	}
+
+	if (reader.has_failed() || !reader.at_end())
+	{
+		LOGE("Resource record is truncated");
+		return false;
+	}
+
+	return true;
 }
 
-void ResourceReplay::create_shader_module(ResourceCache &resource_cache, std::istringstream &stream)
+template <class ResourceCacheType>
+void ResourceReplay::create_shader_module(ResourceCacheType *resource_cache, ResourceRecordReader &reader)
 {
-	VkShaderStageFlagBits    stage{};
-	std::string              glsl_source;
-	std::string              entry_point;
+	VkShaderStageFlagBits stage{};
+	uint32_t              source_index{0};
+	uint32_t              entry_point_index{0};
+	uint32_t              runtime_array_count{0};
 
-	read(stream,
-	     stage,
-	     glsl_source,
-	     entry_point);
+	reader.read(stage, source_index, entry_point_index, runtime_array_count);
 
-	ShaderSource shader_source{};
-	shader_source.set_source(std::move(glsl_source));
 	ShaderVariant shader_variant;
+	for (uint32_t i = 0; i < runtime_array_count && !reader.has_failed(); ++i)
+	{
+		uint32_t name_index{0};
+		uint64_t runtime_array_size{0};
+		reader.read(name_index, runtime_array_size);
+
+		if (name_index < strings.size())
+		{
+			shader_variant.add_runtime_array_size(std::string{strings[name_index]}, static_cast<size_t>(runtime_array_size));
+		}
+	}
+
+	// Shader modules are always created with the "main" entry point, the recorded one is not used yet
+	if (reader.has_failed() || source_index >= strings.size() || entry_point_index >= strings.size())
+	{
+		reader.fail();
+		return;
+	}
 
-	auto &shader_module = resource_cache.request_shader_module(stage, shader_source, shader_variant);
+	if (!resource_cache)
+	{
+		shader_modules.push_back(nullptr);
+		return;
+	}
+
+	ShaderSource shader_source{};
+	shader_source.set_source(std::string{strings[source_index]});
+
+	auto &shader_module = request_shader_module(*resource_cache, stage, shader_source, shader_variant);
 
 	shader_modules.push_back(&shader_module);
 }
 
-void ResourceReplay::create_pipeline_layout(ResourceCache &resource_cache, std::istringstream &stream)
+template <class ResourceCacheType>
+void ResourceReplay::create_pipeline_layout(ResourceCacheType *resource_cache, ResourceRecordReader &reader)
 {
-	std::vector<size_t> shader_indices;
+	std::vector<uint32_t> shader_indices;
 
-	read(stream,
-	     shader_indices);
+	reader.read(shader_indices);
+
+	std::vector<ShaderModule *> shader_stages;
+	shader_stages.reserve(shader_indices.size());
+	for (auto shader_index : shader_indices)
+	{
+		if (shader_index >= shader_modules.size())
+		{
+			reader.fail();
+			return;
+		}
+		shader_stages.push_back(shader_modules[shader_index]);
+	}
 
-	std::vector<ShaderModule *> shader_stages(shader_indices.size());
-	std::transform(shader_indices.begin(),
-	               shader_indices.end(),
-	               shader_stages.begin(),
-	               [&](size_t shader_index) {
-		               assert(shader_index < shader_modules.size());
-		               return shader_modules[shader_index];
-	               });
+	if (reader.has_failed() || !resource_cache)
+	{
+		pipeline_layouts.push_back(nullptr);
+		return;
+	}
 
-	auto &pipeline_layout = resource_cache.request_pipeline_layout(shader_stages);
+	auto &pipeline_layout = request_pipeline_layout(*resource_cache, shader_stages);
 
 	pipeline_layouts.push_back(&pipeline_layout);
 }
 
-void ResourceReplay::create_render_pass(ResourceCache &resource_cache, std::istringstream &stream)
+template <class ResourceCacheType>
+void ResourceReplay::create_render_pass(ResourceCacheType *resource_cache, ResourceRecordReader &reader)
 {
 	std::vector<Attachment>    attachments;
 	std::vector<LoadStoreInfo> load_store_infos;
-	std::vector<SubpassInfo>   subpasses;
+	uint32_t                   subpass_count{0};
 
-	read(stream,
-	     attachments,
-	     load_store_infos);
+	reader.read(attachments, load_store_infos, subpass_count);
+
+	std::vector<SubpassInfo> subpasses;
+	for (uint32_t i = 0; i < subpass_count && !reader.has_failed(); ++i)
+	{
+		SubpassInfo subpass{};
+		uint32_t    disable_depth_stencil_attachment{0};
+		uint32_t    debug_name_index{0};
+
+		reader.read(subpass.input_attachments,
+		            subpass.output_attachments,
+		            subpass.color_resolve_attachments,
+		            disable_depth_stencil_attachment,
+		            subpass.depth_stencil_resolve_attachment,
+		            subpass.depth_stencil_resolve_mode,
+		            debug_name_index);
+
+		subpass.disable_depth_stencil_attachment = disable_depth_stencil_attachment != 0;
+		if (debug_name_index < strings.size())
+		{
+			subpass.debug_name = strings[debug_name_index];
+		}
 
-	read_subpass_info(stream, subpasses);
+		subpasses.push_back(std::move(subpass));
+	}
 
-	auto &render_pass = resource_cache.request_render_pass(attachments, load_store_infos, subpasses);
+	if (reader.has_failed() || !resource_cache)
+	{
+		render_passes.push_back(nullptr);
+		return;
+	}
+
+	auto &render_pass = request_render_pass(*resource_cache, attachments, load_store_infos, subpasses);
 
 	render_passes.push_back(&render_pass);
 }
 
-void ResourceReplay::create_graphics_pipeline(ResourceCache &resource_cache, std::istringstream &stream)
+void ResourceReplay::read_graphics_pipeline(ResourceRecordReader &reader, PipelineState *pipeline_state)
 {
-	size_t   pipeline_layout_index{};
-	size_t   render_pass_index{};
-	uint32_t subpass_index{};
+	uint32_t pipeline_layout_index{0};
+	uint32_t render_pass_index{0};
+	uint32_t subpass_index{0};
+	uint32_t specialization_constant_count{0};
 
-	read(stream,
-	     pipeline_layout_index,
-	     render_pass_index,
-	     subpass_index);
+	reader.read(pipeline_layout_index, render_pass_index, subpass_index, specialization_constant_count);
 
-	std::map<uint32_t, std::vector<uint8_t>> specialization_constant_state{};
-	read(stream,
-	     specialization_constant_state);
+	std::vector<std::pair<uint32_t, std::vector<uint8_t>>> specialization_constants;
+	for (uint32_t i = 0; i < specialization_constant_count && !reader.has_failed(); ++i)
+	{
+		auto &constant = specialization_constants.emplace_back();
+		reader.read(constant.first, constant.second);
+	}
 
 	VertexInputState vertex_input_state{};
 
-	read(stream,
-	     vertex_input_state.attributes,
-	     vertex_input_state.bindings);
+	reader.read(vertex_input_state.attributes,
+	            vertex_input_state.bindings);
 
 	InputAssemblyState input_assembly_state{};
 	RasterizationState rasterization_state{};
@@ -164,42 +446,85 @@ void ResourceReplay::create_graphics_pipeline(ResourceCache &resource_cache, std
 	MultisampleState   multisample_state{};
 	DepthStencilState  depth_stencil_state{};
 
-	read(stream,
-	     input_assembly_state,
-	     rasterization_state,
-	     viewport_state,
-	     multisample_state,
-	     depth_stencil_state);
+	reader.read(input_assembly_state,
+	            rasterization_state,
+	            viewport_state,
+	            multisample_state,
+	            depth_stencil_state);
 
 	ColorBlendState color_blend_state{};
 
-	read(stream,
-	     color_blend_state.logic_op,
-	     color_blend_state.logic_op_enable,
-	     color_blend_state.attachments);
+	reader.read(color_blend_state.logic_op,
+	            color_blend_state.logic_op_enable,
+	            color_blend_state.attachments);
 
-	PipelineState pipeline_state{};
-	assert(pipeline_layout_index < pipeline_layouts.size());
-	pipeline_state.set_pipeline_layout(*pipeline_layouts[pipeline_layout_index]);
-	assert(render_pass_index < render_passes.size());
-	pipeline_state.set_render_pass(*render_passes[render_pass_index]);
+	if (reader.has_failed() || pipeline_layout_index >= pipeline_layouts.size() || render_pass_index >= render_passes.size())
+	{
+		reader.fail();
+		return;
+	}
 
-	for (auto &item : specialization_constant_state)
+	if (!pipeline_state)
 	{
-		pipeline_state.set_specialization_constant(item.first, item.second);
+		return;
 	}
 
-	pipeline_state.set_subpass_index(subpass_index);
-	pipeline_state.set_vertex_input_state(vertex_input_state);
-	pipeline_state.set_input_assembly_state(input_assembly_state);
-	pipeline_state.set_rasterization_state(rasterization_state);
-	pipeline_state.set_viewport_state(viewport_state);
-	pipeline_state.set_multisample_state(multisample_state);
-	pipeline_state.set_depth_stencil_state(depth_stencil_state);
-	pipeline_state.set_color_blend_state(color_blend_state);
+	for (auto &constant : specialization_constants)
+	{
+		pipeline_state->set_specialization_constant(constant.first, constant.second);
+	}
+	pipeline_state->set_pipeline_layout(*pipeline_layouts[pipeline_layout_index]);
+	pipeline_state->set_render_pass(*render_passes[render_pass_index]);
+	pipeline_state->set_subpass_index(subpass_index);
+	pipeline_state->set_vertex_input_state(vertex_input_state);
+	pipeline_state->set_input_assembly_state(input_assembly_state);
+	pipeline_state->set_rasterization_state(rasterization_state);
+	pipeline_state->set_viewport_state(viewport_state);
+	pipeline_state->set_multisample_state(multisample_state);
+	pipeline_state->set_depth_stencil_state(depth_stencil_state);
+	pipeline_state->set_color_blend_state(color_blend_state);
+}
 
-	auto &graphics_pipeline = resource_cache.request_graphics_pipeline(pipeline_state);
+template <class ResourceCacheType>
+void ResourceReplay::create_graphics_pipelines(ResourceCacheType &resource_cache, std::vector<PipelineState> &pipeline_states, ThreadPool *thread_pool)
+{
+	if (thread_pool && pipeline_states.size() > 1)
+	{
+		std::vector<std::future<GraphicsPipeline *>> pipelines;
+		pipelines.reserve(pipeline_states.size());
+		for (auto &pipeline_state : pipeline_states)
+		{
+			pipelines.push_back(thread_pool->push([&resource_cache, &pipeline_state]() {
+				return &request_graphics_pipeline(resource_cache, pipeline_state);
+			}));
+		}
+
+		// Wait for all the pipelines before rethrowing a failure, the tasks refer to the pipeline states
+		for (auto &pipeline : pipelines)
+		{
+			pipeline.wait();
+		}
+		for (auto &pipeline : pipelines)
+		{
+			graphics_pipelines.push_back(pipeline.get());
+		}
+	}
+	else
+	{
+		for (auto &pipeline_state : pipeline_states)
+		{
+			graphics_pipelines.push_back(&request_graphics_pipeline(resource_cache, pipeline_state));
+		}
+	}
+}
 
-	graphics_pipelines.push_back(&graphics_pipeline);
+bool ResourceReplay::play(ResourceCache &resource_cache, const uint8_t *data, size_t size, ThreadPool *thread_pool)
+{
+	return play_impl(resource_cache, data, size, thread_pool);
+}
+
+bool ResourceReplay::play(HPPResourceCache &resource_cache, const uint8_t *data, size_t size, ThreadPool *thread_pool)
+{
+	return play_impl(resource_cache, data, size, thread_pool);
 }
 }        // namespace vkb
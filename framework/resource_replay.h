@@ -1,4 +1,4 @@
-/* Copyright (c) 2019, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,35 +17,69 @@
 
 #pragma once
 
+#include <string_view>
+
 #include "resource_record.h"
 
 namespace vkb
 {
+class HPPResourceCache;
 class ResourceCache;
+class ResourceRecordReader;
+class ThreadPool;
 
 /**
- * @brief Reads Vulkan objects from a memory stream and creates them in the resource cache.
+ * @brief Reads Vulkan objects recorded by a ResourceRecord and creates them in the resource cache.
+ *
+ * The serialized data is read in place, it can come straight from a mapped file.
+ * All the records are read and checked once before any object is created, so that corrupt data creates nothing.
+ * Shader modules, pipeline layouts and render passes are then created in record order, graphics pipelines
+ * are created last and can be spread across the workers of a thread pool.
  */
 class ResourceReplay
 {
   public:
-	ResourceReplay();
+	/**
+	 * @brief Creates the objects of a serialized ResourceRecord
+	 * @param resource_cache The cache the objects are requested from
+	 * @param data The serialized records, as returned by ResourceRecord::get_data
+	 * @param size The size of the data in bytes
+	 * @param thread_pool If not null, graphics pipelines are created by the workers of this pool
+	 * @return False if the data was rejected because of a wrong magic, version or checksum, or a corrupt or truncated record.
+	 *         No object is created then.
+	 */
+	bool play(ResourceCache &resource_cache, const uint8_t *data, size_t size, ThreadPool *thread_pool = nullptr);
+
+	bool play(HPPResourceCache &resource_cache, const uint8_t *data, size_t size, ThreadPool *thread_pool = nullptr);
 
-	void play(ResourceCache &resource_cache, ResourceRecord &recorder);
+  private:
+	template <class ResourceCacheType>
+	bool play_impl(ResourceCacheType &resource_cache, const uint8_t *data, size_t size, ThreadPool *thread_pool);
 
-  protected:
-	void create_shader_module(ResourceCache &resource_cache, std::istringstream &stream);
+	/**
+	 * @brief Reads the records, creating their objects if a resource cache is given and only checking them otherwise
+	 * @param pipeline_states Receives the states of the graphics pipelines to create, if not null
+	 * @return False if a record is corrupt or the records are truncated
+	 */
+	template <class ResourceCacheType>
+	bool play_records(ResourceCacheType *resource_cache, ResourceRecordReader &reader, uint32_t record_count, std::vector<PipelineState> *pipeline_states);
 
-	void create_pipeline_layout(ResourceCache &resource_cache, std::istringstream &stream);
+	template <class ResourceCacheType>
+	void create_shader_module(ResourceCacheType *resource_cache, ResourceRecordReader &reader);
 
-	void create_render_pass(ResourceCache &resource_cache, std::istringstream &stream);
+	template <class ResourceCacheType>
+	void create_pipeline_layout(ResourceCacheType *resource_cache, ResourceRecordReader &reader);
 
-	void create_graphics_pipeline(ResourceCache &resource_cache, std::istringstream &stream);
+	template <class ResourceCacheType>
+	void create_render_pass(ResourceCacheType *resource_cache, ResourceRecordReader &reader);
 
-  private:
-	using ResourceFunc = std::function<void(ResourceCache &, std::istringstream &)>;
+	void read_graphics_pipeline(ResourceRecordReader &reader, PipelineState *pipeline_state);
+
+	template <class ResourceCacheType>
+	void create_graphics_pipelines(ResourceCacheType &resource_cache, std::vector<PipelineState> &pipeline_states, ThreadPool *thread_pool);
 
-	std::unordered_map<ResourceType, ResourceFunc> stream_resources;
+	// Views into the string table of the data being played
+	std::vector<std::string_view> strings;
 
 	std::vector<ShaderModule *> shader_modules;
 
@@ -0,0 +1,524 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <filesystem/filesystem.hpp>
+
+#include "common/error.h"
+#include "common/helpers.h"
+#include "common/vk_common.h"
+#include "core/util/logging.hpp"
+
+#define SCENE_CACHE_DIRECTORY "cache/scenes"
+
+namespace vkb
+{
+namespace
+{
+constexpr char     SCENE_CACHE_MAGIC[8]    = {'V', 'K', 'B', 'S', 'C', 'E', 'N', 'E'};
+constexpr uint64_t SCENE_CACHE_ALIGNMENT   = 16;
+constexpr uint32_t SCENE_CACHE_HEADER_SIZE = 48;
+
+struct SceneCacheHeader
+{
+	char     magic[8];
+	uint32_t version;
+	uint32_t image_count;
+	uint32_t primitive_count;
+	uint32_t reserved;
+	uint64_t source_hash;
+	uint64_t payload_offset;
+	uint64_t file_size;
+};
+
+static_assert(sizeof(SceneCacheHeader) == SCENE_CACHE_HEADER_SIZE, "Scene cache header layout changed, bump the version");
+
+// Smallest sizes the records of the tables take in a file, which bound the counts a file of a given size can hold:
+// an image with an empty name, no mipmaps and no offsets, and a primitive without vertex streams
+constexpr size_t SCENE_CACHE_MIN_IMAGE_SIZE         = sizeof(uint32_t) + sizeof(VkFormat) + sizeof(uint32_t) + sizeof(uint64_t) + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+constexpr size_t SCENE_CACHE_MIN_PRIMITIVE_SIZE     = 2 * sizeof(uint32_t) + sizeof(VkIndexType) + 2 * sizeof(glm::vec3) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+constexpr size_t SCENE_CACHE_MIN_VERTEX_STREAM_SIZE = sizeof(uint32_t) + sizeof(VkFormat) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+uint64_t align_up(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+template <typename T>
+void write_value(std::vector<uint8_t> &out, const T &value)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	auto bytes = reinterpret_cast<const uint8_t *>(&value);
+	out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void write_string(std::vector<uint8_t> &out, const std::string &value)
+{
+	write_value(out, static_cast<uint32_t>(value.size()));
+	out.insert(out.end(), value.begin(), value.end());
+}
+
+/**
+ * @brief Bounds checked reader over the contents of a cache file
+ */
+class Reader
+{
+  public:
+	Reader(const uint8_t *data, size_t size) :
+	    data{data}, size{size}
+	{}
+
+	template <typename T>
+	T read()
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		T value;
+		std::memcpy(&value, take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	/**
+	 * @brief Reads the number of records of a table
+	 * @param record_size The smallest size a record takes in the file
+	 */
+	uint32_t read_count(size_t record_size)
+	{
+		auto count = read<uint32_t>();
+		check_count(count, record_size);
+		return count;
+	}
+
+	/**
+	 * @brief Checks that the bytes left can hold count records, so that a corrupt count is rejected before anything is allocated for it
+	 */
+	void check_count(uint64_t count, size_t record_size) const
+	{
+		if (count > (size - offset) / record_size)
+		{
+			throw std::runtime_error{"Scene cache table count out of range"};
+		}
+	}
+
+	std::string read_string()
+	{
+		auto length = read<uint32_t>();
+		auto chars  = reinterpret_cast<const char *>(take(length));
+		return {chars, chars + length};
+	}
+
+	const uint8_t *payload(uint64_t payload_offset, uint64_t offset, uint64_t payload_size) const
+	{
+		if (payload_offset + offset < payload_offset || payload_offset + offset + payload_size > size)
+		{
+			throw std::runtime_error{"Scene cache payload out of range"};
+		}
+		return data + payload_offset + offset;
+	}
+
+  private:
+	const uint8_t *take(size_t count)
+	{
+		if (count > size - offset)
+		{
+			throw std::runtime_error{"Scene cache truncated"};
+		}
+		auto ptr = data + offset;
+		offset += count;
+		return ptr;
+	}
+
+	const uint8_t *data;
+
+	size_t size;
+
+	size_t offset{SCENE_CACHE_HEADER_SIZE};
+};
+
+/**
+ * @brief Checks the mipmaps and layer offsets of a cached image against its payload, so that the upload never copies out of it
+ */
+void validate_image(const SceneCache::Image &image)
+{
+	auto base_mipmap = std::ranges::find_if(image.mipmaps, [](const sg::Mipmap &mipmap) { return mipmap.level == 0; });
+	if (base_mipmap == image.mipmaps.end() || image.layers == 0)
+	{
+		throw std::runtime_error{"Scene cache image " + image.name + " has no base level"};
+	}
+
+	// Block compressed formats have no size per texel, only the start of their levels can be checked
+	auto bits_per_pixel = get_bits_per_pixel(image.format);
+
+	auto get_level_size = [&image, bits_per_pixel](const sg::Mipmap &mipmap) {
+		return bits_per_pixel > 0 ? (uint64_t(mipmap.extent.width) * mipmap.extent.height * mipmap.extent.depth * bits_per_pixel + 7) / 8 : 1;
+	};
+
+	auto check_level = [&image, &get_level_size](uint64_t offset, const sg::Mipmap &mipmap) {
+		if (offset >= image.size || get_level_size(mipmap) > image.size - offset)
+		{
+			throw std::runtime_error{"Scene cache image " + image.name + " has a level out of its payload"};
+		}
+	};
+
+	auto &base_extent = base_mipmap->extent;
+	if (base_extent.width == 0 || base_extent.height == 0 || base_extent.depth == 0)
+	{
+		throw std::runtime_error{"Scene cache image " + image.name + " is empty"};
+	}
+
+	// Each level halves the one above it, down to a single texel
+	for (auto &mipmap : image.mipmaps)
+	{
+		if (mipmap.level >= image.mipmaps.size() || mipmap.level >= 32 ||
+		    mipmap.extent.width != std::max(1u, base_extent.width >> mipmap.level) ||
+		    mipmap.extent.height != std::max(1u, base_extent.height >> mipmap.level) ||
+		    mipmap.extent.depth != std::max(1u, base_extent.depth >> mipmap.level))
+		{
+			throw std::runtime_error{"Scene cache image " + image.name + " has an invalid level extent"};
+		}
+
+		check_level(mipmap.offset, mipmap);
+	}
+
+	if (image.offsets.empty())
+	{
+		return;
+	}
+
+	if (image.offsets.size() != image.layers)
+	{
+		throw std::runtime_error{"Scene cache image " + image.name + " has offsets for the wrong number of layers"};
+	}
+
+	for (auto &layer_offsets : image.offsets)
+	{
+		if (layer_offsets.size() != image.mipmaps.size())
+		{
+			throw std::runtime_error{"Scene cache image " + image.name + " has offsets for the wrong number of levels"};
+		}
+
+		for (size_t i = 0; i < layer_offsets.size(); ++i)
+		{
+			check_level(layer_offsets[i], image.mipmaps[i]);
+		}
+	}
+}
+
+class CachedImage : public sg::Image
+{
+  public:
+	CachedImage(const SceneCache::Image &cached_image, std::vector<uint8_t> &&data) :
+	    sg::Image{cached_image.name, std::move(data), std::vector<sg::Mipmap>(cached_image.mipmaps)}
+	{
+		set_format(cached_image.format);
+		set_layers(cached_image.layers);
+		set_offsets(cached_image.offsets);
+		update_hash(cached_image.data_hash);
+	}
+
+	virtual ~CachedImage() = default;
+};
+}        // namespace
+
+const uint8_t *SceneCache::Writer::store(const uint8_t *data, size_t size)
+{
+	payloads.emplace_back(data, data + size);
+	return payloads.back().data();
+}
+
+void SceneCache::Writer::add_image(const sg::Image &image)
+{
+	assert(!image.get_data().empty() && "Image data was already cleared");
+
+	Image cached_image;
+	cached_image.name      = image.get_name();
+	cached_image.format    = image.get_format();
+	cached_image.layers    = image.get_layers();
+	cached_image.data_hash = image.get_data_hash();
+	cached_image.mipmaps   = image.get_mipmaps();
+	cached_image.offsets   = image.get_offsets();
+	cached_image.size      = image.get_data().size();
+	cached_image.data      = store(image.get_data().data(), cached_image.size);
+
+	images.push_back(std::move(cached_image));
+}
+
+void SceneCache::Writer::add_primitive(const Primitive &primitive)
+{
+	Primitive cached_primitive = primitive;
+
+	for (auto &vertex_stream : cached_primitive.vertex_streams)
+	{
+		vertex_stream.data = store(vertex_stream.data, vertex_stream.size);
+	}
+
+	if (cached_primitive.index_data)
+	{
+		cached_primitive.index_data = store(cached_primitive.index_data, cached_primitive.index_size);
+	}
+
+	primitives.push_back(std::move(cached_primitive));
+}
+
+void SceneCache::Writer::write(const std::string &path, uint64_t source_hash) const
+{
+	// Payloads are laid out one after the other, each aligned, so the tables can refer to them by offset
+	std::vector<std::pair<const uint8_t *, size_t>> payload_list;
+	uint64_t                                        payload_size = 0;
+
+	auto add_payload = [&payload_list, &payload_size](const uint8_t *data, size_t size) {
+		uint64_t offset = align_up(payload_size, SCENE_CACHE_ALIGNMENT);
+		payload_list.emplace_back(data, size);
+		payload_size = offset + size;
+		return offset;
+	};
+
+	std::vector<uint8_t> tables;
+
+	for (auto &image : images)
+	{
+		write_string(tables, image.name);
+		write_value(tables, image.format);
+		write_value(tables, image.layers);
+		write_value(tables, static_cast<uint64_t>(image.data_hash));
+
+		write_value(tables, static_cast<uint32_t>(image.mipmaps.size()));
+		for (auto &mipmap : image.mipmaps)
+		{
+			write_value(tables, mipmap);
+		}
+
+		write_value(tables, static_cast<uint32_t>(image.offsets.size()));
+		for (auto &layer_offsets : image.offsets)
+		{
+			write_value(tables, static_cast<uint32_t>(layer_offsets.size()));
+			for (auto offset : layer_offsets)
+			{
+				write_value(tables, static_cast<uint64_t>(offset));
+			}
+		}
+
+		write_value(tables, add_payload(image.data, image.size));
+		write_value(tables, static_cast<uint64_t>(image.size));
+	}
+
+	for (auto &primitive : primitives)
+	{
+		write_value(tables, primitive.vertices_count);
+		write_value(tables, primitive.vertex_indices);
+		write_value(tables, primitive.index_type);
+		write_value(tables, primitive.bounds_min);
+		write_value(tables, primitive.bounds_max);
+
+		write_value(tables, static_cast<uint32_t>(primitive.vertex_streams.size()));
+		for (auto &vertex_stream : primitive.vertex_streams)
+		{
+			write_string(tables, vertex_stream.name);
+			write_value(tables, vertex_stream.format);
+			write_value(tables, vertex_stream.stride);
+			write_value(tables, add_payload(vertex_stream.data, vertex_stream.size));
+			write_value(tables, static_cast<uint64_t>(vertex_stream.size));
+		}
+
+		uint64_t index_offset = primitive.index_data ? add_payload(primitive.index_data, primitive.index_size) : 0;
+		write_value(tables, index_offset);
+		write_value(tables, static_cast<uint64_t>(primitive.index_data ? primitive.index_size : 0));
+	}
+
+	SceneCacheHeader header{};
+	std::memcpy(header.magic, SCENE_CACHE_MAGIC, sizeof(SCENE_CACHE_MAGIC));
+	header.version         = VERSION;
+	header.image_count     = to_u32(images.size());
+	header.primitive_count = to_u32(primitives.size());
+	header.source_hash     = source_hash;
+	header.payload_offset  = align_up(SCENE_CACHE_HEADER_SIZE + tables.size(), SCENE_CACHE_ALIGNMENT);
+	header.file_size       = header.payload_offset + payload_size;
+
+	std::vector<uint8_t> file_contents;
+	file_contents.reserve(header.file_size);
+
+	write_value(file_contents, header);
+	file_contents.insert(file_contents.end(), tables.begin(), tables.end());
+
+	uint64_t payload_cursor = 0;
+	for (auto &[data, size] : payload_list)
+	{
+		payload_cursor = align_up(payload_cursor, SCENE_CACHE_ALIGNMENT);
+		file_contents.resize(header.payload_offset + payload_cursor);
+		file_contents.insert(file_contents.end(), data, data + size);
+		payload_cursor += size;
+	}
+	file_contents.resize(header.file_size);
+
+	// A run interrupted while writing must not leave a partial cache behind, which the next run would map
+	vkb::filesystem::get()->write_file_atomically(path, file_contents);
+
+	LOGI("Wrote scene cache {} ({} images, {} primitives, {} bytes)", path, images.size(), primitives.size(), file_contents.size());
+}
+
+std::unique_ptr<SceneCache> SceneCache::load(const std::string &path, uint64_t source_hash)
+{
+	auto fs = vkb::filesystem::get();
+
+	if (!fs->exists(path))
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<SceneCache> cache{new SceneCache()};
+
+	try
+	{
+		cache->contents = fs->map_file(path);
+
+		const auto &contents = cache->contents;
+
+		SceneCacheHeader header{};
+		if (contents.size() < sizeof(header))
+		{
+			throw std::runtime_error{"Scene cache truncated"};
+		}
+		std::memcpy(&header, contents.data(), sizeof(header));
+
+		if (std::memcmp(header.magic, SCENE_CACHE_MAGIC, sizeof(SCENE_CACHE_MAGIC)) != 0)
+		{
+			throw std::runtime_error{"Invalid magic"};
+		}
+
+		if (header.version != VERSION)
+		{
+			LOGI("Scene cache {} has version {}, expected {}. Falling back to glTF.", path, header.version, VERSION);
+			return nullptr;
+		}
+
+		if (header.source_hash != source_hash)
+		{
+			LOGI("Scene cache {} is stale. Falling back to glTF.", path);
+			return nullptr;
+		}
+
+		if (header.file_size != contents.size())
+		{
+			throw std::runtime_error{"Scene cache size mismatch"};
+		}
+
+		Reader reader{contents.data(), contents.size()};
+
+		reader.check_count(header.image_count, SCENE_CACHE_MIN_IMAGE_SIZE);
+		cache->images.resize(header.image_count);
+		for (auto &image : cache->images)
+		{
+			image.name      = reader.read_string();
+			image.format    = reader.read<VkFormat>();
+			image.layers    = reader.read<uint32_t>();
+			image.data_hash = static_cast<size_t>(reader.read<uint64_t>());
+
+			image.mipmaps.resize(reader.read_count(sizeof(sg::Mipmap)));
+			for (auto &mipmap : image.mipmaps)
+			{
+				mipmap = reader.read<sg::Mipmap>();
+			}
+
+			image.offsets.resize(reader.read_count(sizeof(uint32_t)));
+			for (auto &layer_offsets : image.offsets)
+			{
+				layer_offsets.resize(reader.read_count(sizeof(uint64_t)));
+				for (auto &offset : layer_offsets)
+				{
+					offset = reader.read<uint64_t>();
+				}
+			}
+
+			auto offset = reader.read<uint64_t>();
+			image.size  = reader.read<uint64_t>();
+			image.data  = reader.payload(header.payload_offset, offset, image.size);
+
+			validate_image(image);
+		}
+
+		reader.check_count(header.primitive_count, SCENE_CACHE_MIN_PRIMITIVE_SIZE);
+		cache->primitives.resize(header.primitive_count);
+		for (auto &primitive : cache->primitives)
+		{
+			primitive.vertices_count = reader.read<uint32_t>();
+			primitive.vertex_indices = reader.read<uint32_t>();
+			primitive.index_type     = reader.read<VkIndexType>();
+			primitive.bounds_min     = reader.read<glm::vec3>();
+			primitive.bounds_max     = reader.read<glm::vec3>();
+
+			primitive.vertex_streams.resize(reader.read_count(SCENE_CACHE_MIN_VERTEX_STREAM_SIZE));
+			for (auto &vertex_stream : primitive.vertex_streams)
+			{
+				vertex_stream.name   = reader.read_string();
+				vertex_stream.format = reader.read<VkFormat>();
+				vertex_stream.stride = reader.read<uint32_t>();
+				auto offset          = reader.read<uint64_t>();
+				vertex_stream.size   = reader.read<uint64_t>();
+				vertex_stream.data   = reader.payload(header.payload_offset, offset, vertex_stream.size);
+			}
+
+			auto index_offset    = reader.read<uint64_t>();
+			primitive.index_size = reader.read<uint64_t>();
+			if (primitive.index_size > 0)
+			{
+				primitive.index_data = reader.payload(header.payload_offset, index_offset, primitive.index_size);
+			}
+		}
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGW("Rejecting scene cache {}: {}", path, e.what());
+		return nullptr;
+	}
+
+	return cache;
+}
+
+std::string SceneCache::get_path(const std::string &gltf_file)
+{
+	std::string name = gltf_file;
+	std::ranges::replace(name, '/', '_');
+	std::ranges::replace(name, '\\', '_');
+	return fmt::format("{}/{}.vkbscene", SCENE_CACHE_DIRECTORY, name);
+}
+
+const std::vector<SceneCache::Image> &SceneCache::get_images() const
+{
+	return images;
+}
+
+const std::vector<SceneCache::Primitive> &SceneCache::get_primitives() const
+{
+	return primitives;
+}
+
+std::unique_ptr<sg::Image> SceneCache::create_image(const Image &cached_image, bool copy_pixels)
+{
+	std::vector<uint8_t> data;
+	if (copy_pixels)
+	{
+		data.assign(cached_image.data, cached_image.data + cached_image.size);
+	}
+
+	return std::make_unique<CachedImage>(cached_image, std::move(data));
+}
+}        // namespace vkb
@@ -0,0 +1,170 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <volk.h>
+
+#include "common/glm_common.h"
+#include "filesystem/filesystem.hpp"
+#include "scene_graph/components/image.h"
+
+namespace vkb
+{
+/**
+ * @brief Binary cache of the expensive parts of a glTF scene: decoded images with their mip chains,
+ *        and the vertex/index streams and bounds of every mesh primitive.
+ *
+ * The file starts with a fixed header holding a magic, the format version and the hash of the glTF sources
+ * it was baked from, followed by tables and 16-byte aligned payloads. Payloads are referenced by offset, so a
+ * loaded cache hands out pointers into the mapped file instead of copying them.
+ * A cache whose version or source hash doesn't match is rejected and the caller falls back to the glTF path.
+ */
+class SceneCache
+{
+  public:
+	static constexpr uint32_t VERSION = 2;
+
+	struct Image
+	{
+		std::string name;
+
+		VkFormat format{VK_FORMAT_UNDEFINED};
+
+		uint32_t layers{1};
+
+		size_t data_hash{0};
+
+		std::vector<sg::Mipmap> mipmaps;
+
+		// Offsets stored like offsets[array_layer][mipmap_layer]
+		std::vector<std::vector<VkDeviceSize>> offsets;
+
+		const uint8_t *data{nullptr};
+
+		size_t size{0};
+	};
+
+	struct VertexStream
+	{
+		std::string name;
+
+		VkFormat format{VK_FORMAT_UNDEFINED};
+
+		uint32_t stride{0};
+
+		const uint8_t *data{nullptr};
+
+		size_t size{0};
+	};
+
+	struct Primitive
+	{
+		uint32_t vertices_count{0};
+
+		uint32_t vertex_indices{0};
+
+		VkIndexType index_type{VK_INDEX_TYPE_UINT32};
+
+		std::vector<VertexStream> vertex_streams;
+
+		const uint8_t *index_data{nullptr};
+
+		size_t index_size{0};
+
+		glm::vec3 bounds_min{0.0f};
+
+		glm::vec3 bounds_max{0.0f};
+	};
+
+	/**
+	 * @brief Accumulates the contents of a cache and serializes them
+	 */
+	class Writer
+	{
+	  public:
+		/**
+		 * @brief Adds an image, its CPU data must not have been cleared yet
+		 */
+		void add_image(const sg::Image &image);
+
+		/**
+		 * @brief Adds a primitive, the data pointers of the primitive and its streams are copied from
+		 */
+		void add_primitive(const Primitive &primitive);
+
+		/**
+		 * @brief Serializes the cache to the given path
+		 * @param path The path of the cache file
+		 * @param source_hash The hash of the glTF sources the contents were generated from
+		 */
+		void write(const std::string &path, uint64_t source_hash) const;
+
+	  private:
+		std::vector<Image> images;
+
+		std::vector<Primitive> primitives;
+
+		// Owned copies of the payloads referenced by the images and primitives
+		std::vector<std::vector<uint8_t>> payloads;
+
+		const uint8_t *store(const uint8_t *data, size_t size);
+	};
+
+	/**
+	 * @brief Loads a cache file
+	 * @param path The path of the cache file
+	 * @param source_hash The hash of the current glTF sources
+	 * @return The cache, or nullptr if the file is missing, stale or corrupt
+	 */
+	static std::unique_ptr<SceneCache> load(const std::string &path, uint64_t source_hash);
+
+	/**
+	 * @param gltf_file The glTF file, relative to the assets directory
+	 * @return The path of the cache file used for the given glTF file
+	 */
+	static std::string get_path(const std::string &gltf_file);
+
+	const std::vector<Image> &get_images() const;
+
+	/**
+	 * @return The primitives of all meshes, in glTF mesh and primitive order
+	 */
+	const std::vector<Primitive> &get_primitives() const;
+
+	/**
+	 * @brief Creates a scene graph image from a cached image
+	 * @param copy_pixels If false, the image has no CPU data and the pixels are uploaded straight from the cache payload.
+	 *        If true, the pixels are copied into the image, for images that are transcoded on the CPU.
+	 */
+	static std::unique_ptr<sg::Image> create_image(const Image &cached_image, bool copy_pixels = false);
+
+  private:
+	SceneCache() = default;
+
+	// The images and primitives point into the mapped file
+	filesystem::MappedFile contents;
+
+	std::vector<Image> images;
+
+	std::vector<Primitive> primitives;
+};
+}        // namespace vkb
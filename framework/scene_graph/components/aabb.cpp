@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #include "aabb.h"
 
+#include <limits>
+
 #include "core/util/logging.hpp"
 
 namespace vkb
@@ -68,16 +70,18 @@ void AABB::update(const std::vector<glm::vec3> &vertex_data, const std::vector<u
 
 void AABB::transform(glm::mat4 &transform)
 {
-	min = max = glm::vec4(min, 1.0f) * transform;
-
-	// Update bounding box for the remaining 7 corners of the box
-	update(glm::vec4(min.x, min.y, max.z, 1.0f) * transform);
-	update(glm::vec4(min.x, max.y, min.z, 1.0f) * transform);
-	update(glm::vec4(min.x, max.y, max.z, 1.0f) * transform);
-	update(glm::vec4(max.x, min.y, min.z, 1.0f) * transform);
-	update(glm::vec4(max.x, min.y, max.z, 1.0f) * transform);
-	update(glm::vec4(max.x, max.y, min.z, 1.0f) * transform);
-	update(glm::vec4(max, 1.0f) * transform);
+	if (is_empty())
+	{
+		return;
+	}
+
+	// The transformed box is centered on the transformed center, and each of its half extents
+	// is the sum of the absolute projections of the original half extents on that axis
+	glm::vec3 center  = transform * glm::vec4(get_center(), 1.0f);
+	glm::vec3 extents = glm::mat3(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])), glm::abs(glm::vec3(transform[2]))) * ((max - min) * 0.5f);
+
+	min = center - extents;
+	max = center + extents;
 }
 
 glm::vec3 AABB::get_scale() const
@@ -100,11 +104,16 @@ glm::vec3 AABB::get_max() const
 	return max;
 }
 
+bool AABB::is_empty() const
+{
+	return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
 void AABB::reset()
 {
-	min = std::numeric_limits<glm::vec3>::max();
+	min = glm::vec3(std::numeric_limits<float>::max());
 
-	max = std::numeric_limits<glm::vec3>::min();
+	max = glm::vec3(std::numeric_limits<float>::lowest());
 }
 
 }        // namespace sg
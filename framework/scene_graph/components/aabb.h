@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -91,7 +91,12 @@ class AABB : public Component
 	glm::vec3 get_max() const;
 
 	/**
-	 * @brief Resets the min and max position coordinates
+	 * @return True if no point was added since the box was reset
+	 */
+	bool is_empty() const;
+
+	/**
+	 * @brief Resets the min and max position coordinates, leaving an empty box
 	 */
 	void reset();
 
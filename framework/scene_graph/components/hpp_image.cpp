@@ -21,8 +21,8 @@
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/image/ktx.h"
+#include "scene_graph/components/image/mip_generator.h"
 #include "scene_graph/components/image/stb.h"
-#include <stb_image_resize.h>
 #include <vulkan/vulkan.hpp>
 #include <vulkan/vulkan_format_traits.hpp>
 
@@ -51,7 +51,8 @@ std::unique_ptr<vkb::scene_graph::components::HPPImage> HPPImage::load(const std
 {
 	std::unique_ptr<vkb::scene_graph::components::HPPImage> image{nullptr};
 
-	auto data = fs::read_asset(uri);
+	auto file = fs::map_asset(uri);
+	auto data = file.view();
 
 	// Get extension
 	auto extension = get_extension(uri);
@@ -220,7 +221,7 @@ void HPPImage::create_vk_image(vkb::core::DeviceCpp &device, vk::ImageViewType i
 	vk_image_view->set_debug_name("View on " + get_name());
 }
 
-void HPPImage::generate_mipmaps()
+void HPPImage::generate_mipmaps(vkb::ThreadPool *thread_pool)
 {
 	assert(mipmaps.size() == 1 && "Mipmaps already generated");
 
@@ -229,41 +230,24 @@ void HPPImage::generate_mipmaps()
 		return;        // Do not generate again
 	}
 
-	auto extent      = get_extent();
-	auto next_width  = std::max<uint32_t>(1u, extent.width / 2);
-	auto next_height = std::max<uint32_t>(1u, extent.height / 2);
-	auto channels    = 4;
-	auto next_size   = next_width * next_height * channels;
+	auto extent = get_extent();
+	auto levels = vkb::sg::get_mip_chain_layout(extent.width, extent.height);
 
-	while (true)
-	{
-		// Make space for next mipmap
-		auto old_size = to_u32(data.size());
-		data.resize(old_size + next_size);
-
-		auto &prev_mipmap = mipmaps.back();
-		// Update mipmaps
-		vkb::scene_graph::components::HPPMipmap next_mipmap{};
-		next_mipmap.level  = prev_mipmap.level + 1;
-		next_mipmap.offset = old_size;
-		next_mipmap.extent = vk::Extent3D{next_width, next_height, 1u};
+	// Allocate for all the mips at once
+	data.resize(levels.back().offset + levels.back().get_size());
 
-		// Fill next mipmap memory
-		stbir_resize_uint8(data.data() + prev_mipmap.offset, prev_mipmap.extent.width, prev_mipmap.extent.height, 0,
-		                   data.data() + next_mipmap.offset, next_mipmap.extent.width, next_mipmap.extent.height, 0, channels);
-
-		mipmaps.emplace_back(std::move(next_mipmap));
+	for (size_t i = 1; i < levels.size(); ++i)
+	{
+		vkb::scene_graph::components::HPPMipmap mipmap{};
+		mipmap.level  = to_u32(i);
+		mipmap.offset = to_u32(levels[i].offset);
+		mipmap.extent = vk::Extent3D{levels[i].width, levels[i].height, 1u};
+		mipmaps.push_back(mipmap);
+	}
 
-		// Next mipmap values
-		next_width  = std::max<uint32_t>(1u, next_width / 2);
-		next_height = std::max<uint32_t>(1u, next_height / 2);
-		next_size   = next_width * next_height * channels;
+	bool srgb = format == vk::Format::eR8G8B8A8Srgb || format == vk::Format::eB8G8R8A8Srgb;
 
-		if (next_width == 1 && next_height == 1)
-		{
-			break;
-		}
-	}
+	vkb::sg::generate_mip_chain(data.data(), levels, srgb, thread_pool);
 }
 
 void HPPImage::update_hash()
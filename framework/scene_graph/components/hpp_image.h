@@ -24,6 +24,8 @@
 
 namespace vkb
 {
+class ThreadPool;
+
 namespace core
 {
 template <vkb::BindingType bindingType>
@@ -78,7 +80,7 @@ class HPPImage : public vkb::sg::Component
 	void                                                        clear_data();
 	void                                                        coerce_format_to_srgb();
 	void                                                        create_vk_image(vkb::core::DeviceCpp &device, vk::ImageViewType image_view_type = vk::ImageViewType::e2D, vk::ImageCreateFlags flags = {});
-	void                                                        generate_mipmaps();
+	void                                                        generate_mipmaps(vkb::ThreadPool *thread_pool = nullptr);
 	const std::vector<uint8_t>                                 &get_data() const;
 	const vk::Extent3D                                         &get_extent() const;
 	vk::Format                                                  get_format() const;
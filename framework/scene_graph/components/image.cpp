@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,17 +18,15 @@
 #include "image.h"
 
 #include <cstddef>
+#include <cstring>
 #include <mutex>
 
 #include "common/error.h"
-
-#define STB_IMAGE_RESIZE_IMPLEMENTATION
-#include <stb_image_resize.h>
-
 #include "common/utils.h"
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/image/ktx.h"
+#include "scene_graph/components/image/mip_generator.h"
 #include "scene_graph/components/image/stb.h"
 
 namespace vkb
@@ -177,6 +175,46 @@ void Image::clear_data()
 	data.shrink_to_fit();
 }
 
+const core::BufferC *Image::get_staging_buffer() const
+{
+	return staging_buffer.get();
+}
+
+std::unique_ptr<core::BufferC> Image::release_staging_buffer()
+{
+	if (staging_buffer)
+	{
+		// The memory may not be host coherent
+		staging_buffer->flush();
+	}
+
+	return std::move(staging_buffer);
+}
+
+uint8_t *Image::allocate_data(size_t size)
+{
+	assert(data.empty() && !staging_buffer && "Image data already allocated");
+
+	if (staging_device)
+	{
+		staging_buffer = std::make_unique<core::BufferC>(core::BufferC::create_staging_buffer(*staging_device, size, nullptr));
+		return staging_buffer->map();
+	}
+
+	data.resize(size);
+	return data.data();
+}
+
+void Image::set_staging_device(vkb::core::DeviceC *device)
+{
+	staging_device = device;
+}
+
+vkb::core::DeviceC *Image::get_staging_device() const
+{
+	return staging_device;
+}
+
 VkFormat Image::get_format() const
 {
 	return format;
@@ -241,25 +279,7 @@ Mipmap &Image::get_mipmap(const size_t index)
 	return mipmaps[index];
 }
 
-// Note that this function returns the required size for ALL mip levels, *including* the base level.
-uint32_t get_required_mipmaps_size(const VkExtent3D &extent)
-{
-	constexpr uint32_t channels = 4;
-	auto               width    = std::max<uint32_t>(1, extent.width);
-	auto               height   = std::max<uint32_t>(1, extent.height);
-	auto               size     = width * height * channels;
-	auto               result   = size;
-	while (size != channels)
-	{
-		width  = std::max<uint32_t>(1u, width >> 1);
-		height = std::max<uint32_t>(1u, height >> 1);
-		size   = width * height * channels;
-		result += size;
-	}
-	return result;
-}
-
-void Image::generate_mipmaps()
+void Image::generate_mipmaps(ThreadPool *thread_pool, ContentType content_type)
 {
 	assert(mipmaps.size() == 1 && "Mipmaps already generated");
 
@@ -268,45 +288,75 @@ void Image::generate_mipmaps()
 		return;        // Do not generate again
 	}
 
-	auto extent      = get_extent();
-	auto next_width  = std::max<uint32_t>(1u, extent.width / 2);
-	auto next_height = std::max<uint32_t>(1u, extent.height / 2);
-	auto channels    = 4;
-	auto next_size   = next_width * next_height * channels;
+	// Staged pixels are not in the CPU data, and the staging buffer only has room for the base level
+	assert(!staging_buffer && "The mips of staged images are generated while decoding, see the mip_chain argument of load");
 
-	// Allocate for all the mips at once.  The function returns the total size needed for the
-	// existing base mip as well as all the mips that will be generated.
-	data.reserve(get_required_mipmaps_size(extent));
-
-	while (true)
+	if (staging_buffer)
 	{
-		// Make space for next mipmap
-		auto old_size = to_u32(data.size());
-		data.resize(old_size + next_size);
+		return;
+	}
+
+	auto extent = get_extent();
+	auto levels = get_mip_chain_layout(extent.width, extent.height);
+
+	// Allocate for all the mips at once
+	data.resize(levels.back().offset + levels.back().get_size());
+
+	add_mip_levels(levels);
 
-		auto &prev_mipmap = mipmaps.back();
-		// Update mipmaps
-		Mipmap next_mipmap{};
-		next_mipmap.level  = prev_mipmap.level + 1;
-		next_mipmap.offset = old_size;
-		next_mipmap.extent = {next_width, next_height, 1u};
+	generate_mip_chain(data.data(), levels, is_filtered_as_srgb(content_type), thread_pool);
+}
+
+void Image::set_data_with_mip_chain(const uint8_t *base_level, ContentType content_type)
+{
+	assert(mipmaps.size() == 1 && "Mipmaps already generated");
 
-		// Fill next mipmap memory
-		stbir_resize_uint8(data.data() + prev_mipmap.offset, prev_mipmap.extent.width, prev_mipmap.extent.height, 0,
-		                   data.data() + next_mipmap.offset, next_mipmap.extent.width, next_mipmap.extent.height, 0, channels);
+	auto extent = get_extent();
+	auto levels = get_mip_chain_layout(extent.width, extent.height);
 
-		mipmaps.emplace_back(std::move(next_mipmap));
+	auto base_size = levels.front().get_size();
+	auto chain     = allocate_data(levels.back().offset + levels.back().get_size());
 
-		// Next mipmap values
-		next_width  = std::max<uint32_t>(1u, next_width / 2);
-		next_height = std::max<uint32_t>(1u, next_height / 2);
-		next_size   = next_width * next_height * channels;
+	std::memcpy(chain, base_level, base_size);
 
-		if (next_width == 1 && next_height == 1)
+	if (levels.size() > 1)
+	{
+		bool srgb = is_filtered_as_srgb(content_type);
+
+		if (staging_buffer)
 		{
-			break;
+			// Staging memory is slow to read back, and each level is filtered from the one above it
+			std::vector<uint8_t> mips(levels.back().offset + levels.back().get_size() - base_size);
+			generate_mip_levels(base_level, mips.data(), levels, srgb);
+			std::memcpy(chain + base_size, mips.data(), mips.size());
+		}
+		else
+		{
+			generate_mip_chain(chain, levels, srgb);
 		}
 	}
+
+	add_mip_levels(levels);
+
+	// Hash the source rather than the staging memory, which is slow to read back
+	update_hash(calculate_hash({base_level, base_size}));
+}
+
+void Image::add_mip_levels(const std::vector<MipLevelLayout> &levels)
+{
+	for (size_t i = 1; i < levels.size(); ++i)
+	{
+		Mipmap mipmap{};
+		mipmap.level  = to_u32(i);
+		mipmap.offset = to_u32(levels[i].offset);
+		mipmap.extent = {levels[i].width, levels[i].height, 1u};
+		mipmaps.push_back(mipmap);
+	}
+}
+
+bool Image::is_filtered_as_srgb(ContentType content_type) const
+{
+	return format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_B8G8R8A8_SRGB || content_type == Color;
 }
 
 std::vector<Mipmap> &Image::get_mut_mipmaps()
@@ -331,9 +381,10 @@ void Image::update_hash(size_t hash)
 
 void Image::set_data(const uint8_t *raw_data, size_t size)
 {
-	assert(data.empty() && "Image data already set");
-	data = {raw_data, raw_data + size};
-	update_hash();
+	std::memcpy(allocate_data(size), raw_data, size);
+
+	// Hash the source rather than the staging memory, which is slow to read back
+	update_hash(calculate_hash({raw_data, size}));
 }
 
 void Image::set_format(const VkFormat f)
@@ -375,30 +426,32 @@ void Image::coerce_format_to_srgb()
 }
 
 std::unique_ptr<Image> Image::load(const std::string &name, const std::string &uri,
-                                   ContentType content_type)
+                                   ContentType content_type, vkb::core::DeviceC *staging_device, std::optional<ContentType> mip_chain)
 {
 	std::unique_ptr<Image> image{nullptr};
 
-	auto data = fs::read_asset(uri);
+	// The decoders only read the file, so it is mapped rather than copied
+	auto file = fs::map_asset(uri);
+	auto data = file.view();
 
 	// Get extension
 	auto extension = get_extension(uri);
 
 	if (extension == "png" || extension == "jpg")
 	{
-		image = std::make_unique<Stb>(name, data, content_type);
+		image = std::make_unique<Stb>(name, data, content_type, staging_device, mip_chain);
 	}
 	else if (extension == "astc")
 	{
-		image = std::make_unique<Astc>(name, data);
+		image = std::make_unique<Astc>(name, data, staging_device, mip_chain);
 	}
 	else if (extension == "ktx")
 	{
-		image = std::make_unique<Ktx>(name, data, content_type);
+		image = std::make_unique<Ktx>(name, data, content_type, staging_device, mip_chain);
 	}
 	else if (extension == "ktx2")
 	{
-		image = std::make_unique<Ktx>(name, data, content_type);
+		image = std::make_unique<Ktx>(name, data, content_type, staging_device, mip_chain);
 	}
 
 	return image;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,20 +18,27 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <typeinfo>
 #include <vector>
 
 #include <volk.h>
 
+#include "core/buffer.h"
 #include "core/image.h"
 #include "core/image_view.h"
 #include "scene_graph/component.h"
 
 namespace vkb
 {
+class ThreadPool;
+
 namespace sg
 {
+struct MipLevelLayout;
+
 /**
  * @param format Vulkan format
  * @return Whether the vulkan format is ASTC
@@ -72,7 +79,15 @@ class Image : public Component
 
 	Image(const std::string &name, std::vector<uint8_t> &&data = {}, std::vector<Mipmap> &&mipmaps = {{}});
 
-	static std::unique_ptr<Image> load(const std::string &name, const std::string &uri, ContentType content_type);
+	/**
+	 * @brief Loads an image file
+	 * @param staging_device If set, the loaders that support it decode the pixels straight into a staging buffer
+	 *        created on this device, instead of into the CPU data of the image. See get_staging_buffer.
+	 * @param mip_chain If set, RGBA8 images with a single level get their mip chain generated while they are decoded,
+	 *        filtered as generate_mipmaps does for this content type. Staged images get it in their staging buffer.
+	 */
+	static std::unique_ptr<Image> load(const std::string &name, const std::string &uri, ContentType content_type, vkb::core::DeviceC *staging_device = nullptr,
+	                                   std::optional<ContentType> mip_chain = std::nullopt);
 
 	virtual ~Image() = default;
 
@@ -94,7 +109,13 @@ class Image : public Component
 
 	const std::vector<std::vector<VkDeviceSize>> &get_offsets() const;
 
-	void generate_mipmaps();
+	/**
+	 * @brief Generates the full mip chain of an RGBA8 image with a single base level in its CPU data.
+	 *        Images decoded into a staging buffer are left as they are, see the mip_chain argument of load.
+	 * @param thread_pool Optional pool the rows of large levels are split across, see generate_mip_chain
+	 * @param content_type Color to filter in linear space as if the format was sRGB, for sRGB encoded pixels in a UNORM image
+	 */
+	void generate_mipmaps(ThreadPool *thread_pool = nullptr, ContentType content_type = Unknown);
 
 	void create_vk_image(vkb::core::DeviceC &device, VkImageViewType image_view_type = VK_IMAGE_VIEW_TYPE_2D, VkImageCreateFlags flags = 0);
 
@@ -104,11 +125,46 @@ class Image : public Component
 
 	void coerce_format_to_srgb();
 
+	/**
+	 * @return The staging buffer holding the decoded pixels, or nullptr if they are in the CPU data of the image
+	 */
+	const core::BufferC *get_staging_buffer() const;
+
+	/**
+	 * @brief Hands over the staging buffer holding the decoded pixels, flushed and ready to be copied from.
+	 *        The buffer has the same layout as the CPU data would have had.
+	 * @return The staging buffer, or nullptr if the pixels are in the CPU data of the image
+	 */
+	std::unique_ptr<core::BufferC> release_staging_buffer();
+
   protected:
+	/**
+	 * @brief Allocates the storage decoded pixels are written to, the staging buffer if the image has
+	 *        a staging device and the CPU data otherwise
+	 * @return A pointer to size writable bytes
+	 */
+	uint8_t *allocate_data(size_t size);
+
+	/**
+	 * @brief Selects the device the pixels are staged on, nullptr to decode into the CPU data.
+	 *        Loaders call it before allocating the data.
+	 */
+	void set_staging_device(vkb::core::DeviceC *device);
+
+	vkb::core::DeviceC *get_staging_device() const;
+
 	std::vector<uint8_t> &get_mut_data();
 
 	void set_data(const uint8_t *raw_data, size_t size);
 
+	/**
+	 * @brief Stores the base level of an RGBA8 image with the generated mip chain below it, in the staging buffer
+	 *        if the image has a staging device. The mips are generated from base_level, so staging memory is only written.
+	 *        The format and extent of the image must be set first.
+	 * @param content_type Color to filter in linear space, see generate_mipmaps
+	 */
+	void set_data_with_mip_chain(const uint8_t *base_level, ContentType content_type);
+
 	void set_format(VkFormat format);
 
 	void set_width(uint32_t width);
@@ -130,6 +186,16 @@ class Image : public Component
 	void update_hash(size_t data_hash);
 
   private:
+	/**
+	 * @brief Adds the levels of a generated mip chain after the base level
+	 */
+	void add_mip_levels(const std::vector<MipLevelLayout> &levels);
+
+	/**
+	 * @return Whether the color channels of a generated mip chain are filtered in linear space
+	 */
+	bool is_filtered_as_srgb(ContentType content_type) const;
+
 	std::vector<uint8_t> data;
 
 	size_t data_hash{0};
@@ -146,6 +212,10 @@ class Image : public Component
 	std::unique_ptr<core::Image> vk_image;
 
 	std::unique_ptr<core::ImageView> vk_image_view;
+
+	vkb::core::DeviceC *staging_device{nullptr};
+
+	std::unique_ptr<core::BufferC> staging_buffer;
 };
 
 }        // namespace sg
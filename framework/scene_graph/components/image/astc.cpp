@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,11 +17,17 @@
 
 #include "scene_graph/components/image/astc.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include "common/error.h"
 #include "core/util/profiling.hpp"
+#include "timer.h"
+#include <core/util/hash.hpp>
+#include <core/util/thread_pool.hpp>
 
 #include "common/glm_common.h"
 #if defined(_WIN32) || defined(_WIN64)
@@ -38,6 +44,9 @@
 constexpr uint32_t ASTC_CACHE_HEADER_SIZE = 64;
 constexpr uint32_t ASTC_CACHE_SEED        = 1619;
 
+// Number of blocks each decode thread should at least get, smaller images are decoded on fewer threads
+constexpr uint32_t ASTC_BLOCKS_PER_THREAD = 4096;
+
 namespace vkb
 {
 namespace sg
@@ -146,20 +155,115 @@ struct AstcHeader
 	uint8_t zsize[3];        // block count is inferred
 };
 
+namespace
+{
+/**
+ * @brief Keeps the astcenc contexts alive between decodes. Allocating a context builds large tables,
+ *        so contexts are reset and reused for images with the same profile, block size and thread count.
+ */
+class DecodeContextPool
+{
+  public:
+	using Key = uint64_t;
+
+	~DecodeContextPool()
+	{
+		for (auto &contexts : free_contexts)
+		{
+			for (auto context : contexts.second)
+			{
+				astcenc_context_free(context);
+			}
+		}
+	}
+
+	static Key make_key(astcenc_profile profile, BlockDim blockdim, uint32_t thread_count)
+	{
+		return static_cast<Key>(profile) | (static_cast<Key>(blockdim.x) << 8) | (static_cast<Key>(blockdim.y) << 16) |
+		       (static_cast<Key>(blockdim.z) << 24) | (static_cast<Key>(thread_count) << 32);
+	}
+
+	astcenc_context *acquire(Key key, const astcenc_config &config, uint32_t thread_count)
+	{
+		{
+			std::lock_guard<std::mutex> lock{mutex};
+
+			auto &contexts = free_contexts[key];
+			if (!contexts.empty())
+			{
+				auto context = contexts.back();
+				contexts.pop_back();
+				return context;
+			}
+		}
+
+		astcenc_context *context{nullptr};
+		if (astcenc_context_alloc(&config, thread_count, &context) != ASTCENC_SUCCESS)
+		{
+			throw std::runtime_error{"Error allocating astc context"};
+		}
+		return context;
+	}
+
+	void release(Key key, astcenc_context *context)
+	{
+		astcenc_decompress_reset(context);
+
+		std::lock_guard<std::mutex> lock{mutex};
+		free_contexts[key].push_back(context);
+	}
+
+  private:
+	std::mutex mutex;
+
+	std::unordered_map<Key, std::vector<astcenc_context *>> free_contexts;
+};
+
+DecodeContextPool &get_decode_context_pool()
+{
+	static DecodeContextPool pool;
+	return pool;
+}
+
+inline uint32_t get_block_count(BlockDim blockdim, VkExtent3D extent)
+{
+	return ((extent.width + blockdim.x - 1) / blockdim.x) *
+	       ((extent.height + blockdim.y - 1) / blockdim.y) *
+	       ((extent.depth + blockdim.z - 1) / blockdim.z);
+}
+}        // namespace
+
 void Astc::init()
 {
 }
 
-void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *compressed_data, uint32_t compressed_size)
+void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *compressed_data, uint32_t compressed_size, bool srgb, std::optional<ContentType> mip_chain)
 {
 	PROFILE_SCOPE("Decode ASTC Image");
 
+	if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
+	{
+		throw std::runtime_error{"Error reading astc: invalid size"};
+	}
+
+	// Every block takes 16 bytes, whatever its dimensions
+	auto block_count = get_block_count(blockdim, extent);
+	if (compressed_size < block_count * 16)
+	{
+		throw std::runtime_error{"Error reading astc: truncated data"};
+	}
+
+	Timer timer;
+	timer.start();
+
 	// Actual decoding
 	astcenc_swizzle swizzle = {ASTCENC_SWZ_R, ASTCENC_SWZ_G, ASTCENC_SWZ_B, ASTCENC_SWZ_A};
+	const auto      profile = srgb ? ASTCENC_PRF_LDR_SRGB : ASTCENC_PRF_LDR;
+
 	// Configure the compressor run
 	astcenc_config astc_config;
 	auto           atscresult = astcenc_config_init(
-        ASTCENC_PRF_LDR_SRGB,
+        profile,
         blockdim.x,
         blockdim.y,
         blockdim.z,
@@ -172,14 +276,12 @@ void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *compresse
 		throw std::runtime_error{"Error initializing astc"};
 	}
 
-	if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
-	{
-		throw std::runtime_error{"Error reading astc: invalid size"};
-	}
+	// Split the blocks between threads, which all decode into the same image through one context
+	uint32_t thread_count = std::clamp(block_count / ASTC_BLOCKS_PER_THREAD, 1u, ThreadPool::get_hardware_thread_count());
 
-	// Allocate working state given config and thread_count
-	astcenc_context *astc_context;
-	astcenc_context_alloc(&astc_config, 1, &astc_context);
+	auto &context_pool = get_decode_context_pool();
+	auto  context_key  = DecodeContextPool::make_key(profile, blockdim, thread_count);
+	auto  astc_context = context_pool.acquire(context_key, astc_config, thread_count);
 
 	astcenc_image decoded{};
 	decoded.dim_x     = extent.width;
@@ -188,24 +290,56 @@ void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *compresse
 	decoded.data_type = ASTCENC_TYPE_U8;
 
 	// allocate storage for the decoded image
-	// The astcenc_decompress_image function will write directly to the image data vector
-	auto  uncompressed_size = decoded.dim_x * decoded.dim_y * decoded.dim_z * 4;
-	auto &decoded_data      = get_mut_data();
-	decoded_data.resize(uncompressed_size);
-	void *data_ptr = static_cast<void *>(decoded_data.data());
+	// The astcenc_decompress_image function will write directly to the image data vector or staging buffer,
+	// unless a mip chain is generated from the pixels, which then go to CPU memory that is fast to read
+	bool with_mip_chain    = mip_chain && extent.depth == 1;
+	auto uncompressed_size = size_t(decoded.dim_x) * decoded.dim_y * decoded.dim_z * 4;
+
+	std::vector<uint8_t> base_level;
+	if (with_mip_chain)
+	{
+		base_level.resize(uncompressed_size);
+	}
+
+	void *data_ptr = with_mip_chain ? static_cast<void *>(base_level.data()) : static_cast<void *>(allocate_data(uncompressed_size));
 	decoded.data   = &data_ptr;
 
-	atscresult = astcenc_decompress_image(astc_context, compressed_data, compressed_size, &decoded, &swizzle, 0);
-	if (atscresult != ASTCENC_SUCCESS)
+	std::vector<astcenc_error> results(thread_count, ASTCENC_SUCCESS);
+
+	auto decode_blocks = [&](uint32_t thread_index) {
+		results[thread_index] = astcenc_decompress_image(astc_context, compressed_data, compressed_size, &decoded, &swizzle, thread_index);
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(thread_count - 1);
+	for (uint32_t thread_index = 1; thread_index < thread_count; ++thread_index)
+	{
+		workers.emplace_back(decode_blocks, thread_index);
+	}
+	decode_blocks(0);
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+
+	context_pool.release(context_key, astc_context);
+
+	if (std::ranges::any_of(results, [](astcenc_error result) { return result != ASTCENC_SUCCESS; }))
 	{
 		throw std::runtime_error("Error decoding astc");
 	}
-	astcenc_context_free(astc_context);
 
-	set_format(VK_FORMAT_R8G8B8A8_SRGB);
+	set_format(srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM);
 	set_width(decoded.dim_x);
 	set_height(decoded.dim_y);
 	set_depth(decoded.dim_z);
+
+	if (with_mip_chain)
+	{
+		set_data_with_mip_chain(base_level.data(), *mip_chain);
+	}
+
+	LOGI("Decoded ASTC image {} ({}x{}) on {} threads in {:.1f} ms", get_name(), extent.width, extent.height, thread_count, timer.stop<Timer::Milliseconds>());
 }
 
 Astc::Astc(const Image &image) :
@@ -216,14 +350,14 @@ Astc::Astc(const Image &image) :
 	auto fs = vkb::filesystem::get();
 
 	size_t key = ASTC_CACHE_SEED;
-	glm::detail::hash_combine(key, image.get_data_hash());
+	hash_combine(key, image.get_data_hash());
 
 	constexpr bool       use_cache                                 = true;
-	constexpr uint32_t   bytes_per_pixel                           = 4;
-	constexpr const char file_cache_header[ASTC_CACHE_HEADER_SIZE] = "ASTCConvertedDataV01";
-	const auto           profile                                   = to_profile(image.get_format());
+	constexpr const char file_cache_header[ASTC_CACHE_HEADER_SIZE] = "ASTCConvertedDataV02";
+	const bool           srgb                                      = to_profile(image.get_format()) == ASTCENC_PRF_LDR_SRGB;
 
-	auto can_load_from_file = [this, profile, fs, file_cache_header, bytes_per_pixel, use_cache](const Path &path, std::vector<uint8_t> &dst_data, uint32_t width, uint32_t height, uint32_t depth) {
+	// The cache file holds the header, the format, the mip count, the mip table and the pixels of the whole mip chain
+	auto can_load_from_file = [this, fs, file_cache_header, use_cache](const Path &path, VkExtent3D extent, bool srgb) {
 		if (!use_cache)
 		{
 			LOGD("Device does not support ASTC format and cache is disabled. ASTC image {} will be decoded.", get_name())
@@ -236,47 +370,61 @@ Astc::Astc(const Image &image) :
 				LOGW("Device does not support ASTC format and cache file {} does not exist. ASTC image {} will be decoded.", path.string(), get_name())
 				return false;
 			}
-			else
-			{
-				LOGD("Loading ASTC image {} from cache file {}", get_name(), path.string())
-			}
-			size_t offset = 0;
 
-			auto copy_from_file = [fs, path](void *dst, size_t *offset, size_t content_size) {
-				const auto bin_content = fs->read_chunk(path, *offset, content_size);
-				std::memcpy(dst, &bin_content[0], content_size);
-				*offset += content_size;
+			Timer timer;
+			timer.start();
+
+			// One read for the whole file, the contents are then parsed in place
+			const auto content = fs->read_file_binary(path);
+			size_t     offset  = 0;
+
+			auto copy_from_file = [&content, &offset](void *dst, size_t content_size) {
+				if (content_size > content.size() - offset)
+				{
+					throw std::runtime_error{"ASTC cache file is truncated"};
+				}
+				std::memcpy(dst, content.data() + offset, content_size);
+				offset += content_size;
 			};
 
 			char header[ASTC_CACHE_HEADER_SIZE];
-			copy_from_file(&header, &offset, ASTC_CACHE_HEADER_SIZE);
-			if (std::strcmp(header, file_cache_header) != 0)
+			copy_from_file(&header, ASTC_CACHE_HEADER_SIZE);
+			if (std::strncmp(header, file_cache_header, ASTC_CACHE_HEADER_SIZE) != 0)
 			{
 				return false;
 			}
 
-			uint32_t file_width, file_height, file_depth;
-			copy_from_file(&file_width, &offset, sizeof(std::uint32_t));
-			copy_from_file(&file_height, &offset, sizeof(std::uint32_t));
-			copy_from_file(&file_depth, &offset, sizeof(std::uint32_t));
+			uint32_t file_width, file_height, file_depth, file_format, mip_count;
+			copy_from_file(&file_width, sizeof(std::uint32_t));
+			copy_from_file(&file_height, sizeof(std::uint32_t));
+			copy_from_file(&file_depth, sizeof(std::uint32_t));
+			copy_from_file(&file_format, sizeof(std::uint32_t));
+			copy_from_file(&mip_count, sizeof(std::uint32_t));
 
-			if (file_width != width || width == 0 ||
-			    file_height != height || height == 0 ||
-			    file_depth != depth || depth == 0)
+			VkFormat format = srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+			if (file_width != extent.width || file_height != extent.height || file_depth != extent.depth ||
+			    file_format != static_cast<uint32_t>(format) || mip_count == 0)
 			{
 				return false;
 			}
-			else
-			{
-				set_width(width);
-				set_height(height);
-				set_depth(depth);
-				set_format(profile == ASTCENC_PRF_LDR_SRGB ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM);
-			}
 
-			auto image_size = width * height * depth * bytes_per_pixel;
-			dst_data.resize(image_size);
-			copy_from_file(dst_data.data(), &offset, image_size);
+			std::vector<Mipmap> mipmaps(mip_count);
+			copy_from_file(mipmaps.data(), mip_count * sizeof(Mipmap));
+
+			uint64_t data_size;
+			copy_from_file(&data_size, sizeof(data_size));
+
+			auto &data = get_mut_data();
+			data.resize(static_cast<size_t>(data_size));
+			copy_from_file(data.data(), data.size());
+
+			set_width(extent.width);
+			set_height(extent.height);
+			set_depth(extent.depth);
+			set_format(format);
+			get_mut_mipmaps() = std::move(mipmaps);
+
+			LOGI("Loaded ASTC image {} from cache file {} in {:.1f} ms", get_name(), path.string(), timer.stop<Timer::Milliseconds>());
 
 			return true;
 		}
@@ -288,7 +436,7 @@ Astc::Astc(const Image &image) :
 		}
 	};
 
-	auto save_to_file = [fs, file_cache_header, bytes_per_pixel, use_cache](const Path &path, uint8_t *dst_data, uint32_t width, uint32_t height, uint32_t depth) {
+	auto save_to_file = [this, fs, file_cache_header, use_cache](const Path &path) {
 		if (!use_cache)
 		{
 			return;
@@ -297,20 +445,31 @@ Astc::Astc(const Image &image) :
 		{
 			LOGI("Saving ASTC cache data to file: {}", path.string());
 
-			auto image_size = width * height * depth * bytes_per_pixel;
+			auto &data    = get_data();
+			auto &mipmaps = get_mipmaps();
 
 			std::vector<uint8_t> astc_file_content;
-			astc_file_content.reserve(sizeof(file_cache_header) + (3 * sizeof(std::uint32_t)) + image_size);
+			astc_file_content.reserve(sizeof(file_cache_header) + (5 * sizeof(std::uint32_t)) + mipmaps.size() * sizeof(Mipmap) + sizeof(uint64_t) + data.size());
 
-			auto append_to_file = [](std::vector<uint8_t> &dst_file, const std::uint8_t *content, size_t content_size) {
-				dst_file.insert(dst_file.end(), content, content + content_size);
+			auto append_to_file = [&astc_file_content](const void *content, size_t content_size) {
+				auto bytes = static_cast<const uint8_t *>(content);
+				astc_file_content.insert(astc_file_content.end(), bytes, bytes + content_size);
 			};
 
-			append_to_file(astc_file_content, (uint8_t *) &file_cache_header, sizeof(file_cache_header));
-			append_to_file(astc_file_content, (uint8_t *) &width, sizeof(uint32_t));
-			append_to_file(astc_file_content, (uint8_t *) &height, sizeof(uint32_t));
-			append_to_file(astc_file_content, (uint8_t *) &depth, sizeof(uint32_t));
-			append_to_file(astc_file_content, (uint8_t *) dst_data, image_size);
+			auto     extent    = get_extent();
+			uint32_t format    = static_cast<uint32_t>(get_format());
+			uint32_t mip_count = to_u32(mipmaps.size());
+			uint64_t data_size = data.size();
+
+			append_to_file(file_cache_header, sizeof(file_cache_header));
+			append_to_file(&extent.width, sizeof(uint32_t));
+			append_to_file(&extent.height, sizeof(uint32_t));
+			append_to_file(&extent.depth, sizeof(uint32_t));
+			append_to_file(&format, sizeof(uint32_t));
+			append_to_file(&mip_count, sizeof(uint32_t));
+			append_to_file(mipmaps.data(), mipmaps.size() * sizeof(Mipmap));
+			append_to_file(&data_size, sizeof(data_size));
+			append_to_file(data.data(), data.size());
 
 			fs->write_file(path, astc_file_content);
 		}
@@ -327,28 +486,31 @@ Astc::Astc(const Image &image) :
 
 	const std::string path = fmt::format("{}/{}.bin", ASTC_CACHE_DIRECTORY, uint64_t(key));
 
-	if (!can_load_from_file(path, get_mut_data(), mip_it->extent.width, mip_it->extent.height, mip_it->extent.depth))
+	if (!can_load_from_file(path, mip_it->extent, srgb))
 	{
 		// When decoding ASTC on CPU (as it is the case in here), we don't decode all mips in the mip chain.
-		// Instead, we just decode mip #0 and re-generate the other LODs later (via image->generate_mipmaps()).
+		// Instead, we just decode mip #0 and re-generate the other LODs, which are stored in the cache as well.
 		const auto     blockdim = to_blockdim(image.get_format());
-		const auto    &extent   = mip_it->extent;
-		auto           size     = extent.width * extent.height * extent.depth * 4;
 		const uint8_t *data_ptr = image.get_data().data() + mip_it->offset;
+		auto           size     = to_u32(image.get_data().size() - mip_it->offset);
+
+		decode(blockdim, mip_it->extent, data_ptr, size, srgb);
 
-		decode(blockdim, mip_it->extent, data_ptr, size);
+		generate_mipmaps();
 
-		save_to_file(path, get_mut_data().data(), mip_it->extent.width, mip_it->extent.height, mip_it->extent.depth);
+		save_to_file(path);
 	}
 
 	update_hash(image.get_data_hash());
 }
 
-Astc::Astc(const std::string &name, const std::vector<uint8_t> &data) :
+Astc::Astc(const std::string &name, std::span<const uint8_t> data, vkb::core::DeviceC *staging_device, std::optional<ContentType> mip_chain) :
     Image{name}
 {
 	init();
 
+	set_staging_device(staging_device);
+
 	// Read header
 	if (data.size() < sizeof(AstcHeader))
 	{
@@ -372,9 +534,17 @@ Astc::Astc(const std::string &name, const std::vector<uint8_t> &data) :
 	    /* height = */ static_cast<uint32_t>(header.ysize[0] + 256 * header.ysize[1] + 65536 * header.ysize[2]),
 	    /* depth  = */ static_cast<uint32_t>(header.zsize[0] + 256 * header.zsize[1] + 65536 * header.zsize[2])};
 
-	decode(blockdim, extent, data.data() + sizeof(AstcHeader), to_u32(data.size() - sizeof(AstcHeader)));
+	decode(blockdim, extent, data.data() + sizeof(AstcHeader), to_u32(data.size() - sizeof(AstcHeader)), true, mip_chain);
 
-	update_hash(get_data_hash());
+	// Staged pixels are slow to read back, so those images are identified by the file contents instead
+	if (get_staging_buffer())
+	{
+		update_hash(static_cast<size_t>(vkb::hash_bytes(data.data(), data.size())));
+	}
+	else
+	{
+		update_hash();
+	}
 }
 
 }        // namespace sg
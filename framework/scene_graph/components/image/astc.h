@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -35,7 +35,8 @@ class Astc : public Image
 {
   public:
 	/**
-	 * @brief Decodes an ASTC image
+	 * @brief Decodes an ASTC image and generates its mip chain.
+	 *        The result is cached in a file, so the next run only has to read it.
 	 * @param image Image to decode
 	 */
 	Astc(const Image &image);
@@ -44,19 +45,25 @@ class Astc : public Image
 	 * @brief Decodes ASTC data with an ASTC header
 	 * @param name Name of the component
 	 * @param data ASTC data with header
+	 * @param staging_device If set, the pixels are decoded into a staging buffer on this device instead of the CPU data
+	 * @param mip_chain If set, the mip chain of 2D images is generated from the decoded pixels, see Image::load
 	 */
-	Astc(const std::string &name, const std::vector<uint8_t> &data);
+	Astc(const std::string &name, std::span<const uint8_t> data, vkb::core::DeviceC *staging_device = nullptr,
+	     std::optional<ContentType> mip_chain = std::nullopt);
 
 	virtual ~Astc() = default;
 
   private:
 	/**
-	 * @brief Decodes ASTC data
+	 * @brief Decodes ASTC data, large images are split across several threads
 	 * @param blockdim Dimensions of the block
 	 * @param extent Extent of the image
 	 * @param data Pointer to ASTC image data
+	 * @param size Size of the ASTC image data
+	 * @param srgb Whether the data is decoded with the sRGB profile
+	 * @param mip_chain If set, the mip chain of a 2D image is generated with the pixels, see Image::set_data_with_mip_chain
 	 */
-	void decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *data, uint32_t size);
+	void decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *data, uint32_t size, bool srgb, std::optional<ContentType> mip_chain = std::nullopt);
 
 	/**
 	 * @brief Initializes ASTC library
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  * Copyright (c) 2019-2025, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -19,6 +19,7 @@
 #include "scene_graph/components/image/ktx.h"
 
 #include "common/error.h"
+#include <core/util/hash.hpp>
 
 #include <ktx.h>
 #include <ktxvulkan.h>
@@ -65,7 +66,7 @@ static ktx_error_code_e KTX_APIENTRY optimal_tiling_callback(int          mip_le
 	return KTX_SUCCESS;
 }
 
-Ktx::Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType content_type) :
+Ktx::Ktx(const std::string &name, std::span<const uint8_t> data, ContentType content_type, vkb::core::DeviceC *staging_device, std::optional<ContentType> mip_chain) :
     Image{name}
 {
 	auto data_buffer = reinterpret_cast<const ktx_uint8_t *>(data.data());
@@ -81,6 +82,17 @@ Ktx::Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType
 		throw std::runtime_error{"Error loading KTX texture: " + name};
 	}
 
+	// ASTC textures the device can't sample are decoded on the CPU later, so they have to stay readable,
+	// and so do the RGBA8 textures the mip chain is generated from
+	auto texture_format    = ktxTexture_GetVkFormat(texture);
+	bool generates_mipmaps = mip_chain && texture->numLevels == 1 && texture->numLayers == 1 && texture->numFaces == 1 && texture->baseDepth == 1 &&
+	                         (texture_format == VK_FORMAT_R8G8B8A8_UNORM || texture_format == VK_FORMAT_R8G8B8A8_SRGB);
+	bool needs_transcoding = is_astc(texture_format) && staging_device && !staging_device->is_image_format_supported(texture_format);
+	if (staging_device && !needs_transcoding && !generates_mipmaps)
+	{
+		set_staging_device(staging_device);
+	}
+
 	if (texture->pData)
 	{
 		// Already loaded
@@ -88,11 +100,9 @@ Ktx::Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType
 	}
 	else
 	{
-		// Load
-		auto &mut_data = get_mut_data();
-		auto  size     = texture->dataSize;
-		mut_data.resize(size);
-		auto load_data_result = ktxTexture_LoadImageData(texture, mut_data.data(), size);
+		// Load straight into the image data or staging buffer
+		auto size             = texture->dataSize;
+		auto load_data_result = ktxTexture_LoadImageData(texture, allocate_data(size), size);
 		if (load_data_result != KTX_SUCCESS)
 		{
 			throw std::runtime_error{"Error loading KTX image data: " + name};
@@ -103,7 +113,16 @@ Ktx::Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType
 	set_height(texture->baseHeight);
 	set_depth(texture->baseDepth);
 	set_layers(texture->numLayers);
-	update_hash();
+
+	// Staged pixels are slow to read back, so those images are identified by the file contents instead
+	if (get_staging_buffer())
+	{
+		update_hash(static_cast<size_t>(vkb::hash_bytes(data.data(), data.size())));
+	}
+	else
+	{
+		update_hash();
+	}
 
 	bool cubemap = false;
 
@@ -139,6 +158,11 @@ Ktx::Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType
 		throw std::runtime_error("Error loading KTX texture");
 	}
 
+	if (generates_mipmaps)
+	{
+		generate_mipmaps(nullptr, *mip_chain);
+	}
+
 	// If the texture contains more than one layer, then populate the offsets otherwise take the mipmap level offsets
 	if (texture->numLayers > 1 || cubemap)
 	{
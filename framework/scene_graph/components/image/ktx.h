@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -26,7 +26,14 @@ namespace sg
 class Ktx : public Image
 {
   public:
-	Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType content_type);
+	/**
+	 * @brief Loads a KTX or KTX2 texture
+	 * @param staging_device If set, the image data is loaded straight into a staging buffer on this device instead of
+	 *        the CPU data, unless the device can't sample the format and the image has to be transcoded first
+	 * @param mip_chain If set, RGBA8 textures with a single level get a mip chain generated in their CPU data, see Image::load
+	 */
+	Ktx(const std::string &name, std::span<const uint8_t> data, ContentType content_type, vkb::core::DeviceC *staging_device = nullptr,
+	    std::optional<ContentType> mip_chain = std::nullopt);
 
 	virtual ~Ktx() = default;
 };
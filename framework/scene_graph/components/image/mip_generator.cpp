@@ -0,0 +1,270 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_graph/components/image/mip_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+
+#include <core/util/thread_pool.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define MIP_GENERATOR_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#	include <arm_neon.h>
+#	define MIP_GENERATOR_NEON
+#endif
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+constexpr uint32_t CHANNELS = 4;
+
+// Number of destination texels below which a level is not worth splitting across the pool
+constexpr uint32_t MIP_TEXELS_PER_TASK = 64 * 1024;
+
+// Resolution of the linear to sRGB table, fine enough to round trip every 8-bit sRGB value
+constexpr uint32_t LINEAR_TO_SRGB_SIZE = 1 << 14;
+
+struct SrgbTables
+{
+	SrgbTables()
+	{
+		for (uint32_t i = 0; i < to_linear.size(); ++i)
+		{
+			float srgb   = static_cast<float>(i) / 255.0f;
+			to_linear[i] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+		}
+
+		for (uint32_t i = 0; i < to_srgb.size(); ++i)
+		{
+			float linear = static_cast<float>(i) / static_cast<float>(LINEAR_TO_SRGB_SIZE - 1);
+			float srgb   = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+			to_srgb[i]   = static_cast<uint8_t>(std::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+		}
+	}
+
+	std::array<float, 256> to_linear;
+
+	std::array<uint8_t, LINEAR_TO_SRGB_SIZE> to_srgb;
+};
+
+const SrgbTables &get_srgb_tables()
+{
+	static const SrgbTables tables;
+	return tables;
+}
+
+/**
+ * @brief Averages pairs of texels of two source rows into one destination row
+ * @param next_texel Offset of the second texel of a pair, 0 when the source is a single texel wide
+ */
+template <uint32_t next_texel>
+void downsample_row_unorm(const uint8_t *row0, const uint8_t *row1, uint8_t *out, uint32_t width)
+{
+	uint32_t x = 0;
+
+	if constexpr (next_texel == CHANNELS)
+	{
+		// Four destination texels from eight texels of each source row per iteration
+#if defined(MIP_GENERATOR_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i two  = _mm_set1_epi16(2);
+
+		// Sums the texel pairs of four texels of both rows, into the 16-bit lanes of two texels
+		auto sum_pairs = [&zero](__m128i r0, __m128i r1) {
+			__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero));
+			__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero));
+			return _mm_unpacklo_epi64(_mm_add_epi16(lo, _mm_srli_si128(lo, 8)), _mm_add_epi16(hi, _mm_srli_si128(hi, 8)));
+		};
+
+		for (; x + 4 <= width; x += 4)
+		{
+			const uint8_t *a = row0 + size_t(x) * 2 * CHANNELS;
+			const uint8_t *b = row1 + size_t(x) * 2 * CHANNELS;
+
+			__m128i first  = sum_pairs(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(b)));
+			__m128i second = sum_pairs(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + 16)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + 16)));
+
+			first  = _mm_srli_epi16(_mm_add_epi16(first, two), 2);
+			second = _mm_srli_epi16(_mm_add_epi16(second, two), 2);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out + size_t(x) * CHANNELS), _mm_packus_epi16(first, second));
+		}
+#elif defined(MIP_GENERATOR_NEON)
+		for (; x + 4 <= width; x += 4)
+		{
+			// De-interleaving loads split the even and odd texels of each row
+			uint32x4x2_t a = vld2q_u32(reinterpret_cast<const uint32_t *>(row0 + size_t(x) * 2 * CHANNELS));
+			uint32x4x2_t b = vld2q_u32(reinterpret_cast<const uint32_t *>(row1 + size_t(x) * 2 * CHANNELS));
+
+			uint8x16_t a_even = vreinterpretq_u8_u32(a.val[0]);
+			uint8x16_t a_odd  = vreinterpretq_u8_u32(a.val[1]);
+			uint8x16_t b_even = vreinterpretq_u8_u32(b.val[0]);
+			uint8x16_t b_odd  = vreinterpretq_u8_u32(b.val[1]);
+
+			uint16x8_t lo = vaddl_u8(vget_low_u8(a_even), vget_low_u8(a_odd));
+			lo            = vaddw_u8(vaddw_u8(lo, vget_low_u8(b_even)), vget_low_u8(b_odd));
+			uint16x8_t hi = vaddl_u8(vget_high_u8(a_even), vget_high_u8(a_odd));
+			hi            = vaddw_u8(vaddw_u8(hi, vget_high_u8(b_even)), vget_high_u8(b_odd));
+
+			// Rounding narrowing shift, (sum + 2) >> 2
+			vst1q_u8(out + size_t(x) * CHANNELS, vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2)));
+		}
+#endif
+	}
+
+	for (; x < width; ++x)
+	{
+		const uint8_t *a = row0 + size_t(x) * 2 * CHANNELS;
+		const uint8_t *b = row1 + size_t(x) * 2 * CHANNELS;
+
+		for (uint32_t c = 0; c < CHANNELS; ++c)
+		{
+			out[x * CHANNELS + c] = static_cast<uint8_t>((a[c] + a[c + next_texel] + b[c] + b[c + next_texel] + 2) >> 2);
+		}
+	}
+}
+
+void downsample_row_srgb(const uint8_t *row0, const uint8_t *row1, uint32_t next_texel, uint8_t *out, uint32_t width)
+{
+	const auto &tables = get_srgb_tables();
+
+	constexpr float scale = 0.25f * static_cast<float>(LINEAR_TO_SRGB_SIZE - 1);
+
+	for (uint32_t x = 0; x < width; ++x)
+	{
+		const uint8_t *a = row0 + size_t(x) * 2 * CHANNELS;
+		const uint8_t *b = row1 + size_t(x) * 2 * CHANNELS;
+
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			float sum = tables.to_linear[a[c]] + tables.to_linear[a[c + next_texel]] + tables.to_linear[b[c]] + tables.to_linear[b[c + next_texel]];
+
+			out[x * CHANNELS + c] = tables.to_srgb[static_cast<uint32_t>(sum * scale + 0.5f)];
+		}
+
+		out[x * CHANNELS + 3] = static_cast<uint8_t>((a[3] + a[3 + next_texel] + b[3] + b[3 + next_texel] + 2) >> 2);
+	}
+}
+
+void downsample_rows(const uint8_t *src, const MipLevelLayout &src_level, uint8_t *dst, const MipLevelLayout &dst_level, bool srgb, uint32_t first_row, uint32_t end_row)
+{
+	const size_t src_stride = size_t(src_level.width) * CHANNELS;
+	const size_t dst_stride = size_t(dst_level.width) * CHANNELS;
+
+	// A level that is a single texel wide or high has no second column or row to average with
+	const uint32_t next_texel = src_level.width > 1 ? CHANNELS : 0;
+	const size_t   next_row   = src_level.height > 1 ? src_stride : 0;
+
+	for (uint32_t y = first_row; y < end_row; ++y)
+	{
+		const uint8_t *row0 = src + size_t(y) * 2 * src_stride;
+		const uint8_t *row1 = row0 + next_row;
+		uint8_t       *out  = dst + size_t(y) * dst_stride;
+
+		if (srgb)
+		{
+			downsample_row_srgb(row0, row1, next_texel, out, dst_level.width);
+		}
+		else if (next_texel)
+		{
+			downsample_row_unorm<CHANNELS>(row0, row1, out, dst_level.width);
+		}
+		else
+		{
+			downsample_row_unorm<0>(row0, row1, out, dst_level.width);
+		}
+	}
+}
+}        // namespace
+
+size_t MipLevelLayout::get_size() const
+{
+	return size_t(width) * height * CHANNELS;
+}
+
+std::vector<MipLevelLayout> get_mip_chain_layout(uint32_t width, uint32_t height)
+{
+	std::vector<MipLevelLayout> levels;
+
+	MipLevelLayout level{0, std::max(1u, width), std::max(1u, height)};
+	levels.push_back(level);
+
+	while (level.width > 1 || level.height > 1)
+	{
+		level.offset += level.get_size();
+		level.width  = std::max(1u, level.width / 2);
+		level.height = std::max(1u, level.height / 2);
+		levels.push_back(level);
+	}
+
+	return levels;
+}
+
+void generate_mip_chain(uint8_t *data, const std::vector<MipLevelLayout> &levels, bool srgb, ThreadPool *thread_pool)
+{
+	if (levels.size() > 1)
+	{
+		generate_mip_levels(data, data + levels[1].offset, levels, srgb, thread_pool);
+	}
+}
+
+void generate_mip_levels(const uint8_t *base_level, uint8_t *mips, const std::vector<MipLevelLayout> &levels, bool srgb, ThreadPool *thread_pool)
+{
+	std::vector<std::future<void>> futures;
+
+	for (size_t i = 1; i < levels.size(); ++i)
+	{
+		auto &src_level = levels[i - 1];
+		auto &dst_level = levels[i];
+
+		const uint8_t *src = i == 1 ? base_level : mips + (src_level.offset - levels[1].offset);
+		uint8_t       *dst = mips + (dst_level.offset - levels[1].offset);
+
+		uint32_t rows_per_task = std::max(1u, MIP_TEXELS_PER_TASK / dst_level.width);
+
+		if (!thread_pool || dst_level.height <= rows_per_task)
+		{
+			downsample_rows(src, src_level, dst, dst_level, srgb, 0, dst_level.height);
+			continue;
+		}
+
+		// Each level reads the one above it, so all of its rows are done before moving on
+		for (uint32_t row = 0; row < dst_level.height; row += rows_per_task)
+		{
+			uint32_t end_row = std::min(row + rows_per_task, dst_level.height);
+			futures.push_back(thread_pool->push([=, &src_level, &dst_level]() {
+				downsample_rows(src, src_level, dst, dst_level, srgb, row, end_row);
+			}));
+		}
+
+		for (auto &future : futures)
+		{
+			future.get();
+		}
+		futures.clear();
+	}
+}
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,71 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkb
+{
+class ThreadPool;
+
+namespace sg
+{
+/**
+ * @brief Position and size of one level of an RGBA8 mip chain
+ */
+struct MipLevelLayout
+{
+	/// Byte offset of the level from the start of the chain
+	size_t offset{0};
+
+	uint32_t width{1};
+
+	uint32_t height{1};
+
+	size_t get_size() const;
+};
+
+/**
+ * @brief Lays out a full RGBA8 mip chain down to 1x1, with the levels packed one after another
+ * @return The levels, starting with the base level at offset 0
+ */
+std::vector<MipLevelLayout> get_mip_chain_layout(uint32_t width, uint32_t height);
+
+/**
+ * @brief Fills every level of an RGBA8 mip chain but the first from the level above it, with a 2x2 box filter.
+ *        The color channels of sRGB data are averaged in linear space, alpha is always averaged as is.
+ * @param data The whole chain, laid out as returned by get_mip_chain_layout, with the base level filled in
+ * @param levels The layout of the chain
+ * @param srgb Whether the color channels are sRGB encoded
+ * @param thread_pool Optional pool the rows of large levels are split across.
+ *        The call waits for its tasks, so it must not be made from a task of the same pool.
+ */
+void generate_mip_chain(uint8_t *data, const std::vector<MipLevelLayout> &levels, bool srgb, ThreadPool *thread_pool = nullptr);
+
+/**
+ * @brief Fills every level of an RGBA8 mip chain but the first, reading the base level from its own memory.
+ *        Only mips is read from past the first level, so the chain can be copied to memory which is slow to read back.
+ * @param base_level The base level, laid out as the first level of the chain
+ * @param mips The levels after the first one, laid out as returned by get_mip_chain_layout but starting at the second level
+ * @see generate_mip_chain
+ */
+void generate_mip_levels(const uint8_t *base_level, uint8_t *mips, const std::vector<MipLevelLayout> &levels, bool srgb, ThreadPool *thread_pool = nullptr);
+}        // namespace sg
+}        // namespace vkb
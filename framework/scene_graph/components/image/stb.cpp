@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -24,9 +24,12 @@ namespace vkb
 {
 namespace sg
 {
-Stb::Stb(const std::string &name, const std::vector<uint8_t> &data, ContentType content_type) :
+Stb::Stb(const std::string &name, std::span<const uint8_t> data, ContentType content_type, vkb::core::DeviceC *staging_device,
+         std::optional<ContentType> mip_chain) :
     Image{name}
 {
+	set_staging_device(staging_device);
+
 	int width;
 	int height;
 	int comp;
@@ -42,13 +45,20 @@ Stb::Stb(const std::string &name, const std::vector<uint8_t> &data, ContentType
 		throw std::runtime_error{"Failed to load " + name + ": " + stbi_failure_reason()};
 	}
 
-	set_data(raw_data, width * height * req_comp);
-	stbi_image_free(raw_data);
-
 	set_format(content_type == Color ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM);
 	set_width(to_u32(width));
 	set_height(to_u32(height));
 	set_depth(1u);
+
+	if (mip_chain)
+	{
+		set_data_with_mip_chain(raw_data, *mip_chain);
+	}
+	else
+	{
+		set_data(raw_data, width * height * req_comp);
+	}
+	stbi_image_free(raw_data);
 }
 
 }        // namespace sg
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -26,7 +26,13 @@ namespace sg
 class Stb : public Image
 {
   public:
-	Stb(const std::string &name, const std::vector<uint8_t> &data, ContentType content_type);
+	/**
+	 * @brief Decodes a PNG or JPEG image
+	 * @param staging_device If set, the pixels are decoded into a staging buffer on this device instead of the CPU data
+	 * @param mip_chain If set, the mip chain is generated from the decoded pixels, see Image::load
+	 */
+	Stb(const std::string &name, std::span<const uint8_t> data, ContentType content_type, vkb::core::DeviceC *staging_device = nullptr,
+	    std::optional<ContentType> mip_chain = std::nullopt);
 
 	virtual ~Stb() = default;
 };
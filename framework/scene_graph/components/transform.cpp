@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -103,6 +103,7 @@ glm::mat4 Transform::get_world_matrix()
 void Transform::invalidate_world_matrix()
 {
 	update_world_matrix = true;
+	local_changed       = true;
 }
 
 void Transform::update_world_transform()
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -40,6 +40,8 @@ using NodeC = Node<vkb::BindingType::C>;
 
 namespace sg
 {
+class TransformSystem;
+
 class Transform : public Component
 {
   public:
@@ -77,6 +79,8 @@ class Transform : public Component
 	void invalidate_world_matrix();
 
   private:
+	friend class TransformSystem;
+
 	vkb::scene_graph::NodeC &node;
 
 	glm::vec3 translation = glm::vec3(0.0, 0.0, 0.0);
@@ -89,6 +93,9 @@ class Transform : public Component
 
 	bool update_world_matrix = false;
 
+	// Set when the local transform changes, until the scene's TransformSystem propagated it to the children
+	bool local_changed = false;
+
 	void update_world_transform();
 };
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -45,16 +45,19 @@ void Scene::set_nodes(std::vector<std::unique_ptr<vkb::scene_graph::NodeC>> &&n)
 {
 	assert(nodes.empty() && "Scene nodes were already set");
 	nodes = std::move(n);
+	transform_system.invalidate_hierarchy();
 }
 
 void Scene::add_node(std::unique_ptr<vkb::scene_graph::NodeC> &&n)
 {
 	nodes.emplace_back(std::move(n));
+	transform_system.invalidate_hierarchy();
 }
 
 void Scene::add_child(vkb::scene_graph::NodeC &child)
 {
 	root->add_child(child);
+	transform_system.invalidate_hierarchy();
 }
 
 std::unique_ptr<Component> Scene::get_model(uint32_t index)
@@ -129,11 +132,25 @@ vkb::scene_graph::NodeC *Scene::find_node(const std::string &node_name)
 void Scene::set_root_node(vkb::scene_graph::NodeC &node)
 {
 	root = &node;
+	transform_system.invalidate_hierarchy();
 }
 
 vkb::scene_graph::NodeC &Scene::get_root_node()
 {
 	return *root;
 }
+
+void Scene::update_transforms()
+{
+	if (root)
+	{
+		transform_system.update(*root);
+	}
+}
+
+TransformSystem &Scene::get_transform_system()
+{
+	return transform_system;
+}
 }        // namespace sg
 }        // namespace vkb
\ No newline at end of file
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -27,6 +27,7 @@
 #include "scene_graph/components/light.h"
 #include "scene_graph/components/texture.h"
 #include "scene_graph/node.h"
+#include "scene_graph/transform_system.h"
 
 namespace vkb
 {
@@ -130,6 +131,13 @@ class Scene
 
 	vkb::scene_graph::NodeC &get_root_node();
 
+	/**
+	 * @brief Updates the world matrices of the nodes whose transform, or an ancestor's, changed since the last call
+	 */
+	void update_transforms();
+
+	TransformSystem &get_transform_system();
+
   private:
 	std::string name;
 
@@ -139,6 +147,8 @@ class Scene
 	vkb::scene_graph::NodeC *root{nullptr};
 
 	std::unordered_map<std::type_index, std::vector<std::unique_ptr<Component>>> components;
+
+	TransformSystem transform_system;
 };
 }        // namespace sg
 }        // namespace vkb
\ No newline at end of file
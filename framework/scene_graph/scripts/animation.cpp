@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,9 @@
 
 #include "animation.h"
 
+#include <algorithm>
+
+#include "common/helpers.h"
 #include "scene_graph/node.h"
 
 namespace vkb
@@ -29,13 +32,109 @@ Animation::Animation(const std::string &name) :
 }
 
 Animation::Animation(const Animation &other) :
-    channels{other.channels}
+    tracks{other.tracks},
+    samplers{other.samplers},
+    sampler_tracks{other.sampler_tracks},
+    channels{other.channels},
+    start_time{other.start_time},
+    end_time{other.end_time}
+{
+}
+
+uint32_t Animation::add_sampler(const AnimationSampler &sampler)
+{
+	// Samplers reading the same keyframe times share their track
+	auto track_it = std::find_if(tracks.begin(), tracks.end(), [&sampler](const Track &track) { return track.inputs == sampler.inputs; });
+	if (track_it == tracks.end())
+	{
+		tracks.push_back({sampler.inputs});
+		track_it = tracks.end() - 1;
+	}
+
+	sampler_tracks.push_back(to_u32(std::distance(tracks.begin(), track_it)));
+	samplers.push_back(sampler);
+
+	return to_u32(samplers.size() - 1);
+}
+
+void Animation::add_channel(vkb::scene_graph::NodeC &node, const AnimationTarget &target, uint32_t sampler)
 {
+	channels[target].push_back({node, target, sampler});
 }
 
 void Animation::add_channel(vkb::scene_graph::NodeC &node, const AnimationTarget &target, const AnimationSampler &sampler)
 {
-	channels.push_back({node, target, sampler});
+	add_channel(node, target, add_sampler(sampler));
+}
+
+void Animation::update_track(Track &track) const
+{
+	track.active = track.inputs && track.inputs->size() >= 2 && current_time >= track.inputs->front() && current_time <= track.inputs->back();
+	if (!track.active)
+	{
+		return;
+	}
+
+	auto  &inputs   = *track.inputs;
+	size_t last_key = inputs.size() - 2;
+
+	// Playing forward moves the cursor by a key or two per frame at most, so try a few steps before searching
+	constexpr size_t max_steps = 4;
+
+	size_t cursor = std::min(track.cursor, last_key);
+	for (size_t steps = 0; steps < max_steps && cursor < last_key && current_time >= inputs[cursor + 1]; ++steps)
+	{
+		++cursor;
+	}
+
+	if (current_time < inputs[cursor] || (cursor < last_key && current_time >= inputs[cursor + 1]))
+	{
+		// The last keyframe at or before the current time
+		auto next_key = std::upper_bound(inputs.begin(), inputs.end(), current_time);
+		cursor        = std::min(static_cast<size_t>(std::distance(inputs.begin(), next_key)) - 1, last_key);
+	}
+
+	track.cursor = cursor;
+
+	float interval = inputs[cursor + 1] - inputs[cursor];
+	track.factor   = interval > 0.0f ? (current_time - inputs[cursor]) / interval : 0.0f;
+}
+
+glm::vec4 Animation::sample(const AnimationSampler &sampler, const Track &track) const
+{
+	size_t i    = track.cursor;
+	float  time = track.factor;
+
+	switch (sampler.type)
+	{
+		case AnimationType::Linear:
+			return glm::mix(sampler.outputs[i], sampler.outputs[i + 1], time);
+
+		case AnimationType::Step:
+			// At the time of a keyframe, its own output, as glTF specifies. The factor only reaches 1 at the last keyframe.
+			return sampler.outputs[time >= 1.0f ? i + 1 : i];
+
+		case AnimationType::CubicSpline:
+		{
+			auto &inputs = *track.inputs;
+
+			float delta = inputs[i + 1] - inputs[i];
+
+			glm::vec4 p0 = sampler.outputs[i * 3 + 1];              // Starting point
+			glm::vec4 p1 = sampler.outputs[(i + 1) * 3 + 1];        // Ending point
+
+			glm::vec4 m0 = delta * sampler.outputs[i * 3 + 2];              // Delta time * out tangent
+			glm::vec4 m1 = delta * sampler.outputs[(i + 1) * 3 + 0];        // Delta time * in tangent of next point
+
+			float time2 = time * time;
+			float time3 = time2 * time;
+
+			// This equation is taken from the GLTF 2.0 specification Appendix C (https://github.com/KhronosGroup/glTF/tree/main/specification/2.0#appendix-c-spline-interpolation)
+			return (2.0f * time3 - 3.0f * time2 + 1.0f) * p0 + (time3 - 2.0f * time2 + time) * m0 + (-2.0f * time3 + 3.0f * time2) * p1 + (time3 - time2) * m1;
+		}
+	}
+
+	return sampler.outputs[i];
 }
 
 void Animation::update(float delta_time)
@@ -46,121 +145,53 @@ void Animation::update(float delta_time)
 		current_time -= end_time;
 	}
 
-	for (auto &channel : channels)
+	for (auto &track : tracks)
+	{
+		update_track(track);
+	}
+
+	for (auto &channel : channels[Translation])
+	{
+		auto &track = tracks[sampler_tracks[channel.sampler]];
+		if (track.active)
+		{
+			channel.node.get_transform().set_translation(glm::vec3(sample(samplers[channel.sampler], track)));
+		}
+	}
+
+	for (auto &channel : channels[Rotation])
+	{
+		auto &track = tracks[sampler_tracks[channel.sampler]];
+		if (!track.active)
+		{
+			continue;
+		}
+
+		auto     &sampler = samplers[channel.sampler];
+		glm::quat rotation;
+
+		if (sampler.type == AnimationType::Linear)
+		{
+			auto &q1 = sampler.outputs[track.cursor];
+			auto &q2 = sampler.outputs[track.cursor + 1];
+
+			rotation = glm::slerp(glm::quat(q1.w, q1.x, q1.y, q1.z), glm::quat(q2.w, q2.x, q2.y, q2.z), track.factor);
+		}
+		else
+		{
+			glm::vec4 result = sample(sampler, track);
+			rotation         = glm::quat(result.w, result.x, result.y, result.z);
+		}
+
+		channel.node.get_transform().set_rotation(glm::normalize(rotation));
+	}
+
+	for (auto &channel : channels[Scale])
 	{
-		for (size_t i = 0; i < channel.sampler.inputs.size() - 1; ++i)
+		auto &track = tracks[sampler_tracks[channel.sampler]];
+		if (track.active)
 		{
-			if ((current_time >= channel.sampler.inputs[i]) && (current_time <= channel.sampler.inputs[i + 1]))
-			{
-				float time = (current_time - channel.sampler.inputs[i]) / (channel.sampler.inputs[i + 1] - channel.sampler.inputs[i]);
-
-				auto &transform = channel.node.get_transform();
-
-				if (channel.sampler.type == AnimationType::Linear)
-				{
-					switch (channel.target)
-					{
-						case Translation:
-						{
-							transform.set_translation(glm::vec3(glm::mix(channel.sampler.outputs[i],
-							                                             channel.sampler.outputs[i + 1],
-							                                             time)));
-							break;
-						}
-						case Rotation:
-						{
-							glm::quat q1;
-							q1.x = channel.sampler.outputs[i].x;
-							q1.y = channel.sampler.outputs[i].y;
-							q1.z = channel.sampler.outputs[i].z;
-							q1.w = channel.sampler.outputs[i].w;
-
-							glm::quat q2;
-							q2.x = channel.sampler.outputs[i + 1].x;
-							q2.y = channel.sampler.outputs[i + 1].y;
-							q2.z = channel.sampler.outputs[i + 1].z;
-							q2.w = channel.sampler.outputs[i + 1].w;
-
-							transform.set_rotation(glm::normalize(glm::slerp(q1, q2, time)));
-							break;
-						}
-
-						case Scale:
-						{
-							transform.set_scale(glm::vec3(glm::mix(channel.sampler.outputs[i],
-							                                       channel.sampler.outputs[i + 1],
-							                                       time)));
-						}
-					}
-				}
-				else if (channel.sampler.type == AnimationType::Step)
-				{
-					switch (channel.target)
-					{
-						case Translation:
-						{
-							transform.set_translation(glm::vec3(channel.sampler.outputs[i]));
-							break;
-						}
-						case Rotation:
-						{
-							glm::quat q1;
-							q1.x = channel.sampler.outputs[i].x;
-							q1.y = channel.sampler.outputs[i].y;
-							q1.z = channel.sampler.outputs[i].z;
-							q1.w = channel.sampler.outputs[i].w;
-
-							transform.set_rotation(glm::normalize(q1));
-							break;
-						}
-
-						case Scale:
-						{
-							transform.set_scale(glm::vec3(channel.sampler.outputs[i]));
-						}
-					}
-				}
-				else if (channel.sampler.type == AnimationType::CubicSpline)
-				{
-					float delta = channel.sampler.inputs[i + 1] - channel.sampler.inputs[i];
-
-					glm::vec4 p0 = channel.sampler.outputs[i * 3 + 1];              // Starting point
-					glm::vec4 p1 = channel.sampler.outputs[(i + 1) * 3 + 1];        // Ending point
-
-					glm::vec4 m0 = delta * channel.sampler.outputs[i * 3 + 2];              // Delta time * out tangent
-					glm::vec4 m1 = delta * channel.sampler.outputs[(i + 1) * 3 + 0];        // Delta time * in tangent of next point
-
-					// This equation is taken from the GLTF 2.0 specification Appendix C (https://github.com/KhronosGroup/glTF/tree/main/specification/2.0#appendix-c-spline-interpolation)
-					glm::vec4 result = (2.0f * glm::pow(time, 3.0f) - 3.0f * glm::pow(time, 2.0f) + 1.0f) * p0 + (glm::pow(time, 3.0f) - 2.0f * glm::pow(time, 2.0f) + time) * m0 + (-2.0f * glm::pow(time, 3.0f) + 3.0f * glm::pow(time, 2.0f)) * p1 + (glm::pow(time, 3.0f) - glm::pow(time, 2.0f)) * m1;
-
-					auto &transform = channel.node.get_transform();
-
-					switch (channel.target)
-					{
-						case Translation:
-						{
-							transform.set_translation(glm::vec3(result));
-							break;
-						}
-						case Rotation:
-						{
-							glm::quat q1;
-							q1.x = result.x;
-							q1.y = result.y;
-							q1.z = result.z;
-							q1.w = result.w;
-
-							transform.set_rotation(glm::normalize(q1));
-							break;
-						}
-
-						case Scale:
-						{
-							transform.set_scale(glm::vec3(result));
-						}
-					}
-				}
-			}
+			channel.node.get_transform().set_scale(glm::vec3(sample(samplers[channel.sampler], track)));
 		}
 	}
 }
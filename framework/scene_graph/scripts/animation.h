@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2025, Arm Limited and Contributors
+/* Copyright (c) 2020-2026, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <string>
@@ -48,7 +49,8 @@ struct AnimationSampler
 {
 	AnimationType type{Linear};
 
-	std::vector<float> inputs{};
+	/// Keyframe times, shared between samplers reading the same glTF input accessor
+	std::shared_ptr<const std::vector<float>> inputs{};
 
 	std::vector<glm::vec4> outputs{};
 };
@@ -59,9 +61,20 @@ struct AnimationChannel
 
 	AnimationTarget target;
 
-	AnimationSampler sampler;
+	/// Index of the sampler in the animation
+	uint32_t sampler;
 };
 
+/**
+ * @brief Animates node transforms from keyframes.
+ *
+ * Samplers reading the same keyframe times share a track, so the current keyframe is looked up once per track
+ * rather than once per channel. Each track keeps a cursor on its last keyframe: playing forward only moves it
+ * a few keys, and a jump in time falls back to a binary search.
+ * Channels are kept in one list per target, so each update evaluates all translations, then all rotations,
+ * then all scales in tight loops.
+ * At the exact time of a keyframe, a step sampler gives the output of that keyframe rather than of the one before.
+ */
 class Animation : public Script
 {
   public:
@@ -73,10 +86,50 @@ class Animation : public Script
 
 	void update_times(float start_time, float end_time);
 
+	/**
+	 * @brief Adds a sampler which channels can refer to
+	 * @return The index of the sampler
+	 */
+	uint32_t add_sampler(const AnimationSampler &sampler);
+
+	void add_channel(vkb::scene_graph::NodeC &node, const AnimationTarget &target, uint32_t sampler);
+
+	/**
+	 * @brief Adds a channel with its own copy of a sampler
+	 */
 	void add_channel(vkb::scene_graph::NodeC &node, const AnimationTarget &target, const AnimationSampler &sampler);
 
   private:
-	std::vector<AnimationChannel> channels;
+	/**
+	 * @brief Keyframe times shared by samplers, with the keyframe found at the current time
+	 */
+	struct Track
+	{
+		std::shared_ptr<const std::vector<float>> inputs;
+
+		/// Index of the keyframe starting the current interval
+		size_t cursor{0};
+
+		/// Position within the current interval, between 0 and 1
+		float factor{0.0f};
+
+		/// Whether the current time is within the keyframes of the track
+		bool active{false};
+	};
+
+	void update_track(Track &track) const;
+
+	glm::vec4 sample(const AnimationSampler &sampler, const Track &track) const;
+
+	std::vector<Track> tracks;
+
+	std::vector<AnimationSampler> samplers;
+
+	/// Index of the track of each sampler
+	std::vector<uint32_t> sampler_tracks;
+
+	/// Channels by target, indexed by AnimationTarget
+	std::array<std::vector<AnimationChannel>, 3> channels;
 
 	float current_time{0.0f};
 
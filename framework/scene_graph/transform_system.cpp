@@ -0,0 +1,209 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transform_system.h"
+
+#include <algorithm>
+#include <future>
+
+#include <core/util/thread_pool.hpp>
+
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+// Hierarchies smaller than this are always updated on the calling thread
+constexpr uint32_t PARALLEL_UPDATE_THRESHOLD = 4096;
+
+// Smallest number of nodes updated by one task
+constexpr uint32_t MIN_TASK_SIZE = 1024;
+}        // namespace
+
+void TransformSystem::invalidate_hierarchy()
+{
+	hierarchy_dirty = true;
+}
+
+void TransformSystem::set_thread_pool(ThreadPool *thread_pool_)
+{
+	thread_pool = thread_pool_;
+
+	// The split into tasks depends on the number of workers
+	hierarchy_dirty = true;
+}
+
+uint32_t TransformSystem::get_updated_count() const
+{
+	return updated_count;
+}
+
+void TransformSystem::update(vkb::scene_graph::NodeC &root)
+{
+	bool full_update = hierarchy_dirty || built_root != &root;
+	if (full_update)
+	{
+		build(root);
+	}
+
+	auto count = static_cast<uint32_t>(transforms.size());
+
+	// After a rebuild the cached world matrices are not in flattened order, so every node is recomputed
+	if (full_update)
+	{
+		for (auto transform : transforms)
+		{
+			transform->invalidate_world_matrix();
+		}
+	}
+
+	if (!thread_pool || count < PARALLEL_UPDATE_THRESHOLD)
+	{
+		updated_count = update_range(0, count);
+		return;
+	}
+
+	updated_count = 0;
+	for (auto index : shared_ancestors)
+	{
+		updated_count += update_range(index, index + 1);
+	}
+
+	std::vector<std::future<uint32_t>> tasks;
+	tasks.reserve(ranges.size());
+	for (auto &range : ranges)
+	{
+		tasks.push_back(thread_pool->push([this, range]() { return update_range(range.first, range.second); }));
+	}
+
+	for (auto &task : tasks)
+	{
+		updated_count += task.get();
+	}
+}
+
+void TransformSystem::build(vkb::scene_graph::NodeC &root)
+{
+	transforms.clear();
+	parents.clear();
+	subtree_ends.clear();
+	shared_ancestors.clear();
+	ranges.clear();
+
+	// Depth-first traversal with an explicit stack, children are pushed in reverse to keep their order
+	std::vector<std::pair<vkb::scene_graph::NodeC *, int32_t>> stack{{&root, -1}};
+	while (!stack.empty())
+	{
+		auto [node, parent] = stack.back();
+		stack.pop_back();
+
+		auto index = static_cast<int32_t>(transforms.size());
+		transforms.push_back(&node->get_transform());
+		parents.push_back(parent);
+
+		auto &children = node->get_children();
+		for (auto child = children.rbegin(); child != children.rend(); ++child)
+		{
+			stack.emplace_back(*child, index);
+		}
+	}
+
+	auto count = static_cast<uint32_t>(transforms.size());
+
+	subtree_ends.resize(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		subtree_ends[i] = i + 1;
+	}
+	for (uint32_t i = count; i-- > 1;)
+	{
+		auto &parent_end = subtree_ends[parents[i]];
+		parent_end       = std::max(parent_end, subtree_ends[i]);
+	}
+
+	world_matrices.resize(count);
+	dirty.resize(count);
+
+	// Split the hierarchy into tasks: subtrees small enough are grouped with their adjacent siblings,
+	// larger ones have their root updated up front and their children split in turn.
+	// Ancestors are visited breadth first so that each one comes after its parent.
+	if (thread_pool && count >= PARALLEL_UPDATE_THRESHOLD)
+	{
+		uint32_t task_size = std::max(MIN_TASK_SIZE, count / (thread_pool->get_thread_count() * 4));
+
+		shared_ancestors.push_back(0);
+		for (size_t i = 0; i < shared_ancestors.size(); ++i)
+		{
+			uint32_t parent     = shared_ancestors[i];
+			bool     can_extend = false;
+
+			for (uint32_t child = parent + 1; child < subtree_ends[parent]; child = subtree_ends[child])
+			{
+				uint32_t end = subtree_ends[child];
+				if (end - child > task_size)
+				{
+					shared_ancestors.push_back(child);
+					can_extend = false;
+				}
+				else if (can_extend && end - ranges.back().first <= task_size)
+				{
+					ranges.back().second = end;
+				}
+				else
+				{
+					ranges.emplace_back(child, end);
+					can_extend = true;
+				}
+			}
+		}
+	}
+
+	built_root      = &root;
+	hierarchy_dirty = false;
+}
+
+uint32_t TransformSystem::update_range(uint32_t begin, uint32_t end)
+{
+	uint32_t updated = 0;
+
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		auto &transform = *transforms[i];
+		auto  parent    = parents[i];
+
+		bool changed = transform.local_changed || (parent >= 0 && dirty[parent]);
+		dirty[i]     = changed;
+
+		if (changed)
+		{
+			world_matrices[i] = parent >= 0 ? world_matrices[parent] * transform.get_matrix() : transform.get_matrix();
+
+			transform.world_matrix        = world_matrices[i];
+			transform.update_world_matrix = false;
+			transform.local_changed       = false;
+			++updated;
+		}
+	}
+
+	return updated;
+}
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,106 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+class ThreadPool;
+
+namespace scene_graph
+{
+template <vkb::BindingType bindingType>
+class Node;
+using NodeC = Node<vkb::BindingType::C>;
+}        // namespace scene_graph
+
+namespace sg
+{
+class Transform;
+
+/**
+ * @brief Updates the world matrices of a node hierarchy in one linear pass.
+ *
+ * The hierarchy is flattened in depth-first order, so a parent always comes before its children and every
+ * subtree is a contiguous range. Changed transforms are found and their changes propagated to the children
+ * while walking the arrays once, and only the changed world matrices are recomputed.
+ * Independent subtrees can be updated on the workers of a thread pool.
+ *
+ * The flattened order is cached: call invalidate_hierarchy when nodes are reparented outside of the scene.
+ */
+class TransformSystem
+{
+  public:
+	/**
+	 * @brief Rebuilds the flattened hierarchy on the next update
+	 */
+	void invalidate_hierarchy();
+
+	/**
+	 * @brief Updates the world matrices of all the nodes under root whose transform or an ancestor's changed
+	 */
+	void update(vkb::scene_graph::NodeC &root);
+
+	/**
+	 * @brief Sets the thread pool used to update large hierarchies, nullptr updates them on the calling thread
+	 */
+	void set_thread_pool(ThreadPool *thread_pool);
+
+	/**
+	 * @return The number of transforms updated by the last call to update
+	 */
+	uint32_t get_updated_count() const;
+
+  private:
+	void build(vkb::scene_graph::NodeC &root);
+
+	// Returns the number of updated transforms
+	uint32_t update_range(uint32_t begin, uint32_t end);
+
+	// Flattened hierarchy, in depth-first order
+	std::vector<Transform *> transforms;
+
+	std::vector<int32_t> parents;
+
+	// One past the last node of the subtree starting at each index
+	std::vector<uint32_t> subtree_ends;
+
+	std::vector<glm::mat4> world_matrices;
+
+	std::vector<uint8_t> dirty;
+
+	// Nodes updated on the calling thread before the parallel ranges, because their subtree is too large for one task
+	std::vector<uint32_t> shared_ancestors;
+
+	// Subtrees updated by one task each
+	std::vector<std::pair<uint32_t, uint32_t>> ranges;
+
+	vkb::scene_graph::NodeC *built_root{nullptr};
+
+	bool hierarchy_dirty{true};
+
+	ThreadPool *thread_pool{nullptr};
+
+	uint32_t updated_count{0};
+};
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,371 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shader_reflection_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <core/util/hash.hpp>
+#include <filesystem/filesystem.hpp>
+
+#include "common/helpers.h"
+#include "core/util/logging.hpp"
+#include "spirv_reflection.h"
+#include "timer.h"
+
+#define SHADER_CACHE_DIRECTORY "cache/shaders"
+
+namespace vkb
+{
+namespace
+{
+constexpr char SHADER_CACHE_MAGIC[8] = {'V', 'K', 'B', 'R', 'E', 'F', 'L', '\0'};
+
+struct ShaderReflectionCacheHeader
+{
+	char     magic[8];
+	uint32_t version;
+	uint32_t resource_count;
+	uint64_t key;
+	uint64_t reflection_ns;
+	uint64_t checksum;        // Of everything after the header
+};
+
+static_assert(sizeof(ShaderReflectionCacheHeader) == 40, "Shader reflection cache header layout changed, bump the version");
+
+template <typename T>
+void write_value(std::vector<uint8_t> &out, const T &value)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	auto bytes = reinterpret_cast<const uint8_t *>(&value);
+	out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void write_string(std::vector<uint8_t> &out, const std::string &value)
+{
+	write_value(out, static_cast<uint32_t>(value.size()));
+	out.insert(out.end(), value.begin(), value.end());
+}
+
+/**
+ * @brief Bounds checked reader over the contents of a cache file
+ */
+class Reader
+{
+  public:
+	Reader(const uint8_t *data, size_t size) :
+	    data{data}, size{size}
+	{}
+
+	template <typename T>
+	T read()
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		T value;
+		std::memcpy(&value, take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	std::string read_string()
+	{
+		auto length = read<uint32_t>();
+		auto chars  = reinterpret_cast<const char *>(take(length));
+		return {chars, chars + length};
+	}
+
+	bool at_end() const
+	{
+		return offset == size;
+	}
+
+  private:
+	const uint8_t *take(size_t count)
+	{
+		if (count > size - offset)
+		{
+			throw std::runtime_error{"Shader reflection cache truncated"};
+		}
+		auto ptr = data + offset;
+		offset += count;
+		return ptr;
+	}
+
+	const uint8_t *data;
+
+	size_t size;
+
+	size_t offset{sizeof(ShaderReflectionCacheHeader)};
+};
+
+std::string get_path(size_t key)
+{
+	return fmt::format("{}/{:016x}.vkbrefl", SHADER_CACHE_DIRECTORY, static_cast<uint64_t>(key));
+}
+}        // namespace
+
+bool ShaderReflectionCache::disk_cache_enabled = false;
+
+ShaderReflectionCache &ShaderReflectionCache::get()
+{
+	static ShaderReflectionCache cache;
+	return cache;
+}
+
+void ShaderReflectionCache::set_disk_cache_enabled(bool enabled)
+{
+	disk_cache_enabled = enabled;
+}
+
+std::string ShaderReflectionCache::get_directory()
+{
+	return SHADER_CACHE_DIRECTORY;
+}
+
+size_t ShaderReflectionCache::get_key(uint64_t spirv_hash, VkShaderStageFlagBits stage, const ShaderVariant &variant)
+{
+	size_t key = static_cast<size_t>(spirv_hash);
+	hash_combine(key, static_cast<uint32_t>(stage));
+
+	// The runtime array sizes are an unordered map, sort them so that the key is the same in every run
+	std::vector<std::pair<std::string, size_t>> runtime_array_sizes(variant.get_runtime_array_sizes().begin(), variant.get_runtime_array_sizes().end());
+	std::ranges::sort(runtime_array_sizes);
+	for (auto &[name, size] : runtime_array_sizes)
+	{
+		hash_combine_bytes(key, name.data(), name.size());
+		hash_combine(key, static_cast<uint64_t>(size));
+	}
+
+	return key;
+}
+
+bool ShaderReflectionCache::reflect_shader_resources(size_t                       key,
+                                                     VkShaderStageFlagBits        stage,
+                                                     const std::vector<uint32_t> &spirv,
+                                                     std::vector<ShaderResource> &resources,
+                                                     const ShaderVariant         &variant)
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+
+		auto entry_it = entries.find(key);
+		if (entry_it != entries.end())
+		{
+			resources = entry_it->second.resources;
+
+			stats.memory_hits++;
+			stats.saved_ms += entry_it->second.reflection_ns / 1e6;
+			return true;
+		}
+	}
+
+	Timer timer;
+	timer.start();
+
+	if (disk_cache_enabled)
+	{
+		if (auto entry = load(key))
+		{
+			resources = entry->resources;
+
+			double load_ms = timer.stop<Timer::Milliseconds>();
+
+			std::lock_guard<std::mutex> guard(mutex);
+			stats.disk_hits++;
+			stats.saved_ms += std::max(0.0, entry->reflection_ns / 1e6 - load_ms);
+			entries.try_emplace(key, std::move(*entry));
+			return true;
+		}
+	}
+
+	SPIRVReflection spirv_reflection;
+	if (!spirv_reflection.reflect_shader_resources(stage, spirv, resources, variant))
+	{
+		return false;
+	}
+
+	Entry entry{resources, static_cast<uint64_t>(timer.stop<Timer::Nanoseconds>())};
+
+	bool inserted = false;
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		stats.misses++;
+		stats.reflection_ms += entry.reflection_ns / 1e6;
+
+		// Another thread may have reflected the same shader in the meantime, only the first one writes the file
+		inserted = entries.try_emplace(key, entry).second;
+	}
+
+	if (disk_cache_enabled && inserted)
+	{
+		store(key, entry);
+	}
+
+	return true;
+}
+
+ShaderReflectionCache::Stats ShaderReflectionCache::get_stats() const
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	return stats;
+}
+
+void ShaderReflectionCache::clear()
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	entries.clear();
+}
+
+void ShaderReflectionCache::log_stats() const
+{
+	auto current_stats = get_stats();
+
+	LOGI("Shader reflection cache: {} memory hits, {} disk hits, {} misses. Reflection took {:.1f} ms, the hits saved {:.1f} ms",
+	     current_stats.memory_hits,
+	     current_stats.disk_hits,
+	     current_stats.misses,
+	     current_stats.reflection_ms,
+	     current_stats.saved_ms);
+}
+
+std::unique_ptr<ShaderReflectionCache::Entry> ShaderReflectionCache::load(size_t key)
+{
+	auto fs   = vkb::filesystem::get();
+	auto path = get_path(key);
+
+	if (!fs->exists(path))
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		auto contents = fs->read_file_binary(path);
+
+		ShaderReflectionCacheHeader header{};
+		if (contents.size() < sizeof(header))
+		{
+			throw std::runtime_error{"Shader reflection cache truncated"};
+		}
+		std::memcpy(&header, contents.data(), sizeof(header));
+
+		if (std::memcmp(header.magic, SHADER_CACHE_MAGIC, sizeof(SHADER_CACHE_MAGIC)) != 0)
+		{
+			throw std::runtime_error{"Invalid magic"};
+		}
+
+		// Files of another version are replaced when the shader is reflected again
+		if (header.version != VERSION)
+		{
+			return nullptr;
+		}
+
+		if (header.key != static_cast<uint64_t>(key))
+		{
+			throw std::runtime_error{"Key mismatch"};
+		}
+
+		if (header.checksum != hash_bytes(contents.data() + sizeof(header), contents.size() - sizeof(header)))
+		{
+			throw std::runtime_error{"Checksum mismatch"};
+		}
+
+		Reader reader{contents.data(), contents.size()};
+
+		auto entry           = std::make_unique<Entry>();
+		entry->reflection_ns = header.reflection_ns;
+
+		entry->resources.resize(header.resource_count);
+		for (auto &resource : entry->resources)
+		{
+			resource.stages                 = reader.read<VkShaderStageFlags>();
+			resource.type                   = reader.read<ShaderResourceType>();
+			resource.mode                   = reader.read<ShaderResourceMode>();
+			resource.set                    = reader.read<uint32_t>();
+			resource.binding                = reader.read<uint32_t>();
+			resource.location               = reader.read<uint32_t>();
+			resource.input_attachment_index = reader.read<uint32_t>();
+			resource.vec_size               = reader.read<uint32_t>();
+			resource.columns                = reader.read<uint32_t>();
+			resource.array_size             = reader.read<uint32_t>();
+			resource.offset                 = reader.read<uint32_t>();
+			resource.size                   = reader.read<uint32_t>();
+			resource.constant_id            = reader.read<uint32_t>();
+			resource.qualifiers             = reader.read<uint32_t>();
+			resource.name                   = reader.read_string();
+		}
+
+		if (!reader.at_end())
+		{
+			throw std::runtime_error{"Trailing data"};
+		}
+
+		return entry;
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGW("Rejecting shader reflection cache {}: {}", path, e.what());
+		return nullptr;
+	}
+}
+
+void ShaderReflectionCache::store(size_t key, const Entry &entry)
+{
+	std::vector<uint8_t> contents(sizeof(ShaderReflectionCacheHeader));
+
+	for (auto &resource : entry.resources)
+	{
+		write_value(contents, resource.stages);
+		write_value(contents, resource.type);
+		write_value(contents, resource.mode);
+		write_value(contents, resource.set);
+		write_value(contents, resource.binding);
+		write_value(contents, resource.location);
+		write_value(contents, resource.input_attachment_index);
+		write_value(contents, resource.vec_size);
+		write_value(contents, resource.columns);
+		write_value(contents, resource.array_size);
+		write_value(contents, resource.offset);
+		write_value(contents, resource.size);
+		write_value(contents, resource.constant_id);
+		write_value(contents, resource.qualifiers);
+		write_string(contents, resource.name);
+	}
+
+	ShaderReflectionCacheHeader header{};
+	std::memcpy(header.magic, SHADER_CACHE_MAGIC, sizeof(SHADER_CACHE_MAGIC));
+	header.version        = VERSION;
+	header.resource_count = to_u32(entry.resources.size());
+	header.key            = static_cast<uint64_t>(key);
+	header.reflection_ns  = entry.reflection_ns;
+	header.checksum       = hash_bytes(contents.data() + sizeof(header), contents.size() - sizeof(header));
+	std::memcpy(contents.data(), &header, sizeof(header));
+
+	// Write to a temporary file first, so that an interrupted run never leaves a partial entry behind
+	auto path = get_path(key);
+	try
+	{
+		vkb::filesystem::get()->write_file_atomically(path, contents);
+	}
+	catch (const std::runtime_error &e)
+	{
+		LOGW("Failed to write shader reflection cache {}: {}", path, e.what());
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,132 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/shader_module.h"
+
+namespace vkb
+{
+/**
+ * @brief Caches the reflected resources of shader modules, so that a shader is only reflected with spirv_cross once.
+ *
+ * Entries are content addressed: the key hashes the SPIR-V, the stage and the runtime array sizes of the variant,
+ * so a changed shader gets a new key and stale entries are never read. Entries are kept in memory for the lifetime of
+ * the application, and when the disk cache is enabled each one is also written to its own file, so that later runs
+ * skip the reflection too. A file starts with a magic, the format version and the key, and is rejected on any mismatch.
+ */
+class ShaderReflectionCache
+{
+  public:
+	/// Bump when the file layout or the output of SPIRVReflection changes
+	static constexpr uint32_t VERSION = 1;
+
+	struct Stats
+	{
+		/// Reflections served by an entry already in memory
+		uint32_t memory_hits{0};
+
+		/// Reflections served by an entry read from disk
+		uint32_t disk_hits{0};
+
+		uint32_t misses{0};
+
+		/// Time spent reflecting the misses
+		double reflection_ms{0.0};
+
+		/// Time the hits would have spent reflecting, minus the time spent reading entries from disk
+		double saved_ms{0.0};
+	};
+
+	/**
+	 * @return The cache shared by all the devices of the application
+	 */
+	static ShaderReflectionCache &get();
+
+	/**
+	 * @brief Enables reading and writing entries in the cache directory, see get_directory()
+	 */
+	static void set_disk_cache_enabled(bool enabled);
+
+	/**
+	 * @return The directory of the cache files, relative to the working directory
+	 */
+	static std::string get_directory();
+
+	/**
+	 * @param spirv_hash Hash of the SPIR-V bytes, as computed by hash_bytes
+	 * @return The key of the reflection of a shader for the given stage and variant
+	 */
+	static size_t get_key(uint64_t spirv_hash, VkShaderStageFlagBits stage, const ShaderVariant &variant);
+
+	/**
+	 * @brief Reflects shader resources through the cache, see SPIRVReflection::reflect_shader_resources
+	 * @param key The key of the shader, see get_key()
+	 * @return False if the shader could not be reflected
+	 */
+	bool reflect_shader_resources(size_t                       key,
+	                              VkShaderStageFlagBits        stage,
+	                              const std::vector<uint32_t> &spirv,
+	                              std::vector<ShaderResource> &resources,
+	                              const ShaderVariant         &variant);
+
+	Stats get_stats() const;
+
+	/**
+	 * @brief Drops the entries kept in memory, the files of the disk cache are kept
+	 */
+	void clear();
+
+	/**
+	 * @brief Logs the hits and misses of the cache, and the time the hits saved
+	 */
+	void log_stats() const;
+
+  private:
+	struct Entry
+	{
+		std::vector<ShaderResource> resources;
+
+		/// Time the reflection took when the entry was created
+		uint64_t reflection_ns{0};
+	};
+
+	ShaderReflectionCache() = default;
+
+	/**
+	 * @return The entry of the file for the given key, or nullptr if there is no valid one
+	 */
+	static std::unique_ptr<Entry> load(size_t key);
+
+	static void store(size_t key, const Entry &entry);
+
+	static bool disk_cache_enabled;
+
+	mutable std::mutex mutex;
+
+	std::unordered_map<size_t, Entry> entries;
+
+	Stats stats;
+};
+}        // namespace vkb
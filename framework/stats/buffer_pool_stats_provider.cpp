@@ -0,0 +1,87 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "buffer_pool_stats_provider.h"
+
+namespace vkb
+{
+BufferPoolStatsProvider::BufferPoolStatsProvider(std::set<StatIndex> &requested_stats, BufferPoolCounters &counters) :
+    counters{counters}
+{
+	for (auto index : {StatIndex::buffer_pool_allocated, StatIndex::buffer_pool_padding})
+	{
+		if (requested_stats.erase(index))
+		{
+			availability.insert(index);
+		}
+	}
+}
+
+bool BufferPoolStatsProvider::is_available(StatIndex index) const
+{
+	return availability.count(index) > 0;
+}
+
+void BufferPoolStatsProvider::read_frames()
+{
+	uint64_t allocated = counters.allocated_bytes.exchange(0);
+	uint64_t padding   = counters.padding_bytes.exchange(0);
+	uint32_t frames    = counters.frame_count.exchange(0);
+
+	// Report the average of the frames reset since the last sample
+	double scale = frames > 0 ? 1.0 / frames : 0.0;
+
+	last_allocated = allocated * scale;
+	last_padding   = padding * scale;
+}
+
+StatsProvider::Counters BufferPoolStatsProvider::sample(float delta_time)
+{
+	Counters res;
+
+	read_frames();
+
+	if (is_available(StatIndex::buffer_pool_allocated))
+	{
+		res[StatIndex::buffer_pool_allocated].result = last_allocated;
+	}
+	if (is_available(StatIndex::buffer_pool_padding))
+	{
+		res[StatIndex::buffer_pool_padding].result = last_padding;
+	}
+
+	return res;
+}
+
+void BufferPoolStatsProvider::continuous_sample(float delta_time, StatsSample &sample)
+{
+	// Frames report once per reset, faster samples repeat the usage of the last frame
+	if (counters.frame_count.load() != 0)
+	{
+		read_frames();
+	}
+
+	if (is_available(StatIndex::buffer_pool_allocated))
+	{
+		sample.set(StatIndex::buffer_pool_allocated, last_allocated);
+	}
+	if (is_available(StatIndex::buffer_pool_padding))
+	{
+		sample.set(StatIndex::buffer_pool_padding, last_padding);
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,81 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "culling_stats_provider.h"
+
+namespace vkb
+{
+CullingStatsProvider::CullingStatsProvider(std::set<StatIndex> &requested_stats, CullingCounters &counters) :
+    counters{counters}
+{
+	for (auto index : {StatIndex::visible_instances, StatIndex::culled_instances})
+	{
+		if (requested_stats.erase(index))
+		{
+			availability.insert(index);
+		}
+	}
+}
+
+bool CullingStatsProvider::is_available(StatIndex index) const
+{
+	return availability.count(index) > 0;
+}
+
+void CullingStatsProvider::read_counts()
+{
+	// Counts are per frame, so they are reset rather than scaled by the delta time
+	last_visible = counters.visible_instances.exchange(0);
+	last_culled  = counters.culled_instances.exchange(0);
+}
+
+StatsProvider::Counters CullingStatsProvider::sample(float delta_time)
+{
+	Counters res;
+
+	read_counts();
+
+	if (is_available(StatIndex::visible_instances))
+	{
+		res[StatIndex::visible_instances].result = last_visible;
+	}
+	if (is_available(StatIndex::culled_instances))
+	{
+		res[StatIndex::culled_instances].result = last_culled;
+	}
+
+	return res;
+}
+
+void CullingStatsProvider::continuous_sample(float delta_time, StatsSample &sample)
+{
+	// Culling happens once per frame, faster samples repeat the counts of the last frame
+	if (counters.visible_instances.load() != 0 || counters.culled_instances.load() != 0)
+	{
+		read_counts();
+	}
+
+	if (is_available(StatIndex::visible_instances))
+	{
+		sample.set(StatIndex::visible_instances, last_visible);
+	}
+	if (is_available(StatIndex::culled_instances))
+	{
+		sample.set(StatIndex::culled_instances, last_culled);
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,73 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "stats_counters.h"
+#include "stats_provider.h"
+#include <set>
+
+namespace vkb
+{
+/**
+ * @brief Provides the number of mesh instances kept and rejected by CPU culling.
+ *        Culling stages report their counts to the CullingCounters of the device, from any thread;
+ *        every sample returns the counts reported since the previous one.
+ */
+class CullingStatsProvider : public StatsProvider
+{
+  public:
+	/**
+	 * @brief Constructs a CullingStatsProvider
+	 * @param requested_stats Set of stats to be collected. Supported stats will be removed from the set.
+	 * @param counters Counters the culling stages report to
+	 */
+	CullingStatsProvider(std::set<StatIndex> &requested_stats, CullingCounters &counters);
+
+	/**
+	 * @brief Checks if this provider can supply the given enabled stat
+	 * @param index The stat index
+	 * @return True if the stat is available, false otherwise
+	 */
+	bool is_available(StatIndex index) const override;
+
+	/**
+	 * @brief Retrieve a new sample set
+	 * @param delta_time Time since last sample
+	 */
+	Counters sample(float delta_time) override;
+
+	/**
+	 * @brief Retrieve a new sample set from continuous sampling
+	 * @param delta_time Time since last sample
+	 * @param sample The sample to write the available stats to
+	 */
+	void continuous_sample(float delta_time, StatsSample &sample) override;
+
+  private:
+	std::set<StatIndex> availability;
+
+	CullingCounters &counters;
+
+	/// Counts of the last frame, read and reset from the counters
+	double last_visible{0.0};
+
+	double last_culled{0.0};
+
+	void read_counts();
+};
+}        // namespace vkb
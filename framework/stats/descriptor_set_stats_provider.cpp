@@ -0,0 +1,98 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "descriptor_set_stats_provider.h"
+
+namespace vkb
+{
+DescriptorSetStatsProvider::DescriptorSetStatsProvider(std::set<StatIndex> &requested_stats, DescriptorSetCounters &counters) :
+    counters{counters}
+{
+	for (auto index : {StatIndex::descriptor_hit_ratio, StatIndex::descriptor_sets, StatIndex::descriptor_pool_pages})
+	{
+		if (requested_stats.erase(index))
+		{
+			availability.insert(index);
+		}
+	}
+}
+
+bool DescriptorSetStatsProvider::is_available(StatIndex index) const
+{
+	return availability.count(index) > 0;
+}
+
+void DescriptorSetStatsProvider::read_frames()
+{
+	uint64_t hits       = counters.hit_count.exchange(0);
+	uint64_t misses     = counters.miss_count.exchange(0);
+	uint64_t sets       = counters.set_count.exchange(0);
+	uint64_t pool_pages = counters.pool_page_count.exchange(0);
+	uint32_t frames     = counters.frame_count.exchange(0);
+
+	// Report the sizes averaged over the frames reset since the last sample
+	double scale = frames > 0 ? 1.0 / frames : 0.0;
+
+	last_hit_ratio  = hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+	last_sets       = sets * scale;
+	last_pool_pages = pool_pages * scale;
+}
+
+StatsProvider::Counters DescriptorSetStatsProvider::sample(float delta_time)
+{
+	Counters res;
+
+	read_frames();
+
+	if (is_available(StatIndex::descriptor_hit_ratio))
+	{
+		res[StatIndex::descriptor_hit_ratio].result = last_hit_ratio;
+	}
+	if (is_available(StatIndex::descriptor_sets))
+	{
+		res[StatIndex::descriptor_sets].result = last_sets;
+	}
+	if (is_available(StatIndex::descriptor_pool_pages))
+	{
+		res[StatIndex::descriptor_pool_pages].result = last_pool_pages;
+	}
+
+	return res;
+}
+
+void DescriptorSetStatsProvider::continuous_sample(float delta_time, StatsSample &sample)
+{
+	// Frames report once per reset, faster samples repeat the values of the last frame
+	if (counters.frame_count.load() != 0)
+	{
+		read_frames();
+	}
+
+	if (is_available(StatIndex::descriptor_hit_ratio))
+	{
+		sample.set(StatIndex::descriptor_hit_ratio, last_hit_ratio);
+	}
+	if (is_available(StatIndex::descriptor_sets))
+	{
+		sample.set(StatIndex::descriptor_sets, last_sets);
+	}
+	if (is_available(StatIndex::descriptor_pool_pages))
+	{
+		sample.set(StatIndex::descriptor_pool_pages, last_pool_pages);
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,92 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_time_summary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace vkb
+{
+namespace
+{
+/**
+ * @brief Nearest-rank percentile of sorted values
+ */
+float percentile(const std::vector<float> &sorted_values, float fraction)
+{
+	auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<float>(sorted_values.size())));
+	return sorted_values[std::clamp<size_t>(rank, 1, sorted_values.size()) - 1];
+}
+}        // namespace
+
+FrameTimeSummary summarize_frame_times(std::vector<float> frame_times)
+{
+	FrameTimeSummary summary;
+	summary.histogram.resize(FRAME_TIME_HISTOGRAM_BOUNDS_MS.size() + 1, 0);
+
+	if (frame_times.empty())
+	{
+		return summary;
+	}
+
+	for (auto &frame_time : frame_times)
+	{
+		frame_time *= 1000.0f;
+		summary.histogram[std::ranges::lower_bound(FRAME_TIME_HISTOGRAM_BOUNDS_MS, frame_time) - FRAME_TIME_HISTOGRAM_BOUNDS_MS.begin()]++;
+	}
+
+	std::ranges::sort(frame_times);
+
+	summary.frame_count = frame_times.size();
+	summary.mean        = static_cast<float>(std::accumulate(frame_times.begin(), frame_times.end(), 0.0) / frame_times.size());
+	summary.min         = frame_times.front();
+	summary.p50         = percentile(frame_times, 0.50f);
+	summary.p95         = percentile(frame_times, 0.95f);
+	summary.p99         = percentile(frame_times, 0.99f);
+	summary.max         = frame_times.back();
+
+	return summary;
+}
+
+float get_mean_stddev(const std::vector<FrameTimeSummary> &summaries)
+{
+	std::vector<double> means;
+	for (auto &summary : summaries)
+	{
+		if (summary.frame_count > 0)
+		{
+			means.push_back(summary.mean);
+		}
+	}
+
+	if (means.size() < 2)
+	{
+		return 0.0f;
+	}
+
+	double mean     = std::accumulate(means.begin(), means.end(), 0.0) / means.size();
+	double variance = 0.0;
+	for (auto value : means)
+	{
+		variance += (value - mean) * (value - mean);
+	}
+
+	return static_cast<float>(std::sqrt(variance / (means.size() - 1)));
+}
+}        // namespace vkb
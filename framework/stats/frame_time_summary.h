@@ -0,0 +1,65 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkb
+{
+/// Upper bounds of the histogram buckets of a FrameTimeSummary in milliseconds, around common refresh intervals.
+/// The last bucket has no bound.
+constexpr std::array<float, 13> FRAME_TIME_HISTOGRAM_BOUNDS_MS{4.0f, 8.0f, 11.1f, 16.7f, 20.0f, 25.0f, 33.3f, 41.7f, 50.0f, 66.7f, 100.0f, 200.0f, 500.0f};
+
+/**
+ * @brief Distribution of a set of frame times, in milliseconds
+ */
+struct FrameTimeSummary
+{
+	size_t frame_count{0};
+
+	float mean{0.0f};
+
+	float min{0.0f};
+
+	float p50{0.0f};
+
+	float p95{0.0f};
+
+	float p99{0.0f};
+
+	float max{0.0f};
+
+	/// Number of frames in each bucket of FRAME_TIME_HISTOGRAM_BOUNDS_MS
+	std::vector<uint32_t> histogram;
+};
+
+/**
+ * @brief Summarizes frame times, with nearest-rank percentiles
+ * @param frame_times Frame times in seconds
+ * @return The summary, with no frames if there are no frame times
+ */
+FrameTimeSummary summarize_frame_times(std::vector<float> frame_times);
+
+/**
+ * @return The sample standard deviation of the means of the summaries that have frames, 0 if fewer than two have
+ */
+float get_mean_stddev(const std::vector<FrameTimeSummary> &summaries);
+}        // namespace vkb
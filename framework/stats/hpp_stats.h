@@ -38,12 +38,15 @@ namespace stats
 class HPPStats : private vkb::Stats
 {
   public:
+	using vkb::Stats::enable_gpu_frame_timing;
 	using vkb::Stats::get_data;
+	using vkb::Stats::get_gpu_frame_time;
 	using vkb::Stats::get_graph_data;
 	using vkb::Stats::get_requested_stats;
 	using vkb::Stats::is_available;
 	using vkb::Stats::request_stats;
 	using vkb::Stats::resize;
+	using vkb::Stats::set_export_path;
 	using vkb::Stats::update;
 
 	explicit HPPStats(vkb::rendering::RenderContextCpp &render_context, size_t buffer_size = 16) :
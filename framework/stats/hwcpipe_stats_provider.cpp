@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  * Copyright (c) 2020-2025, Broadcom Inc.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -204,9 +204,25 @@ StatsProvider::Counters HWCPipeStatsProvider::sample(float delta_time)
 {
 	Counters res;
 
+	StatsSample values;
+	continuous_sample(delta_time, values);
+
+	for (auto &iter : stat_data)
+	{
+		if (values.has(iter.first))
+		{
+			res[iter.first].result = values.get(iter.first);
+		}
+	}
+
+	return res;
+}
+
+void HWCPipeStatsProvider::continuous_sample(float delta_time, StatsSample &values)
+{
 	if (stat_data_count < 1)
 	{
-		return res;
+		return;
 	}
 
 	std::error_code ec;
@@ -259,16 +275,9 @@ StatsProvider::Counters HWCPipeStatsProvider::sample(float delta_time)
 				}
 			}
 
-			res[index].result = d;
+			values.set(index, d);
 		}
 	}
-
-	return res;
-}
-
-StatsProvider::Counters HWCPipeStatsProvider::continuous_sample(float delta_time)
-{
-	return sample(delta_time);
 }
 
 }        // namespace vkb
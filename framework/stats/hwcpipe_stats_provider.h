@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  * Copyright (c) 2020-2025, Broadcom Inc.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -87,8 +87,9 @@ class HWCPipeStatsProvider : public StatsProvider
 	/**
 	 * @brief Retrieve a new sample set from continuous sampling
 	 * @param delta_time Time since last sample
+	 * @param sample The sample to write the available stats to
 	 */
-	Counters continuous_sample(float delta_time) override;
+	void continuous_sample(float delta_time, StatsSample &sample) override;
 
   private:
 	std::unique_ptr<hwcpipe::sampler<>> sampler;
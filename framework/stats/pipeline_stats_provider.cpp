@@ -0,0 +1,89 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline_stats_provider.h"
+
+namespace vkb
+{
+PipelineStatsProvider::PipelineStatsProvider(std::set<StatIndex> &requested_stats, PipelineCounters &counters) :
+    counters{counters}
+{
+	for (auto index : {StatIndex::pipeline_compile_time, StatIndex::pipeline_stall_frames})
+	{
+		if (requested_stats.erase(index))
+		{
+			availability.insert(index);
+		}
+	}
+}
+
+bool PipelineStatsProvider::is_available(StatIndex index) const
+{
+	return availability.count(index) > 0;
+}
+
+void PipelineStatsProvider::read_frames()
+{
+	uint64_t compiles       = counters.compile_count.exchange(0);
+	uint64_t microseconds   = counters.compile_us.exchange(0);
+	uint32_t stalled_frames = counters.stalled_frame_count.exchange(0);
+	uint32_t frames         = counters.frame_count.exchange(0);
+
+	// Without new compiles the last compile time is kept, so that the graph shows the latency of the last ones
+	if (compiles > 0)
+	{
+		last_compile_time = microseconds / 1000.0 / compiles;
+	}
+	last_stall_ratio = frames > 0 ? static_cast<double>(stalled_frames) / frames : 0.0;
+}
+
+StatsProvider::Counters PipelineStatsProvider::sample(float delta_time)
+{
+	Counters res;
+
+	read_frames();
+
+	if (is_available(StatIndex::pipeline_compile_time))
+	{
+		res[StatIndex::pipeline_compile_time].result = last_compile_time;
+	}
+	if (is_available(StatIndex::pipeline_stall_frames))
+	{
+		res[StatIndex::pipeline_stall_frames].result = last_stall_ratio;
+	}
+
+	return res;
+}
+
+void PipelineStatsProvider::continuous_sample(float delta_time, StatsSample &sample)
+{
+	// Frames report once per reset, faster samples repeat the values of the last frame
+	if (counters.frame_count.load() != 0)
+	{
+		read_frames();
+	}
+
+	if (is_available(StatIndex::pipeline_compile_time))
+	{
+		sample.set(StatIndex::pipeline_compile_time, last_compile_time);
+	}
+	if (is_available(StatIndex::pipeline_stall_frames))
+	{
+		sample.set(StatIndex::pipeline_stall_frames, last_stall_ratio);
+	}
+}
+}        // namespace vkb
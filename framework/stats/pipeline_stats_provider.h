@@ -0,0 +1,74 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "stats_counters.h"
+#include "stats_provider.h"
+#include <set>
+
+namespace vkb
+{
+/**
+ * @brief Provides how long pipelines take to compile and how many frames stalled on a compile.
+ *        The resource cache reports every compiled pipeline and every draw that had to wait for one to the
+ *        PipelineCounters of the device, and frames report when they are reset; every sample returns the average
+ *        compile time and the share of stalled frames since the previous one.
+ */
+class PipelineStatsProvider : public StatsProvider
+{
+  public:
+	/**
+	 * @brief Constructs a PipelineStatsProvider
+	 * @param requested_stats Set of stats to be collected. Supported stats will be removed from the set.
+	 * @param counters Counters the resource cache and the render frames report to
+	 */
+	PipelineStatsProvider(std::set<StatIndex> &requested_stats, PipelineCounters &counters);
+
+	/**
+	 * @brief Checks if this provider can supply the given enabled stat
+	 * @param index The stat index
+	 * @return True if the stat is available, false otherwise
+	 */
+	bool is_available(StatIndex index) const override;
+
+	/**
+	 * @brief Retrieve a new sample set
+	 * @param delta_time Time since last sample
+	 */
+	Counters sample(float delta_time) override;
+
+	/**
+	 * @brief Retrieve a new sample set from continuous sampling
+	 * @param delta_time Time since last sample
+	 * @param sample The sample to write the available stats to
+	 */
+	void continuous_sample(float delta_time, StatsSample &sample) override;
+
+  private:
+	std::set<StatIndex> availability;
+
+	PipelineCounters &counters;
+
+	/// Values of the frames read by the last sample
+	double last_compile_time{0.0};
+
+	double last_stall_ratio{0.0};
+
+	void read_frames();
+};
+}        // namespace vkb
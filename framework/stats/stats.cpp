@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  * Copyright (c) 2020-2025, Broadcom Inc.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -22,17 +22,122 @@
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.hpp>
 
+#include "buffer_pool_stats_provider.h"
 #include "core/device.h"
+#include "culling_stats_provider.h"
+#include "descriptor_set_stats_provider.h"
 #include "frame_time_stats_provider.h"
+#include "pipeline_stats_provider.h"
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 #	include "hwcpipe_stats_provider.h"
 #endif
 #include "core/allocated.h"
+#include "core/command_buffer.h"
+#include "core/query_pool.h"
 #include "rendering/render_context.h"
 #include "vulkan_stats_provider.h"
 
 namespace vkb
 {
+namespace
+{
+// Capacity of the ring between the sampling thread and the main thread, 2 seconds at the default interval
+constexpr size_t CONTINUOUS_SAMPLE_CAPACITY = 2048;
+
+// Samples waiting to be displayed beyond this are dropped from the graphs, but still exported
+constexpr size_t MAX_PENDING_SAMPLES = 100;
+
+// For now names are taken from the stats_provider.cpp file
+const char *to_string(StatIndex index)
+{
+	switch (index)
+	{
+		case StatIndex::frame_times:
+			return "Frame Times (ms)";
+		case StatIndex::cpu_cycles:
+			return "CPU Cycles (M/s)";
+		case StatIndex::cpu_instructions:
+			return "CPU Instructions (M/s)";
+		case StatIndex::cpu_cache_miss_ratio:
+			return "Cache Miss Ratio (%)";
+		case StatIndex::cpu_branch_miss_ratio:
+			return "Branch Miss Ratio (%)";
+		case StatIndex::cpu_l1_accesses:
+			return "CPU L1 Accesses (M/s)";
+		case StatIndex::cpu_instr_retired:
+			return "CPU Instructions Retired (M/s)";
+		case StatIndex::cpu_l2_accesses:
+			return "CPU L2 Accesses (M/s)";
+		case StatIndex::cpu_l3_accesses:
+			return "CPU L3 Accesses (M/s)";
+		case StatIndex::cpu_bus_reads:
+			return "CPU Bus Read Beats (M/s)";
+		case StatIndex::cpu_bus_writes:
+			return "CPU Bus Write Beats (M/s)";
+		case StatIndex::cpu_mem_reads:
+			return "CPU Memory Read Instructions (M/s)";
+		case StatIndex::cpu_mem_writes:
+			return "CPU Memory Write Instructions (M/s)";
+		case StatIndex::cpu_ase_spec:
+			return "CPU Speculatively Exec. SIMD Instructions (M/s)";
+		case StatIndex::cpu_vfp_spec:
+			return "CPU Speculatively Exec. FP Instructions (M/s)";
+		case StatIndex::cpu_crypto_spec:
+			return "CPU Speculatively Exec. Crypto Instructions (M/s)";
+		case StatIndex::gpu_cycles:
+			return "GPU Cycles (M/s)";
+		case StatIndex::gpu_vertex_cycles:
+			return "Vertex Cycles (M/s)";
+		case StatIndex::gpu_load_store_cycles:
+			return "Load Store Cycles (k/s)";
+		case StatIndex::gpu_tiles:
+			return "Tiles (k/s)";
+		case StatIndex::gpu_killed_tiles:
+			return "Tiles killed by CRC match (k/s)";
+		case StatIndex::gpu_fragment_jobs:
+			return "Fragment Jobs (s)";
+		case StatIndex::gpu_fragment_cycles:
+			return "Fragment Cycles (M/s)";
+		case StatIndex::gpu_tex_cycles:
+			return "Shader Texture Cycles (k/s)";
+		case StatIndex::gpu_ext_reads:
+			return "External Reads (M/s)";
+		case StatIndex::gpu_ext_writes:
+			return "External Writes (M/s)";
+		case StatIndex::gpu_ext_read_stalls:
+			return "External Read Stalls (M/s)";
+		case StatIndex::gpu_ext_write_stalls:
+			return "External Write Stalls (M/s)";
+		case StatIndex::gpu_ext_read_bytes:
+			return "External Read Bytes (MiB/s)";
+		case StatIndex::gpu_ext_write_bytes:
+			return "External Write Bytes (MiB/s)";
+		case StatIndex::visible_instances:
+			return "Visible Instances";
+		case StatIndex::culled_instances:
+			return "Culled Instances";
+		case StatIndex::buffer_pool_allocated:
+			return "Buffer Pool Allocated (KiB)";
+		case StatIndex::buffer_pool_padding:
+			return "Buffer Pool Padding (KiB)";
+		case StatIndex::descriptor_hit_ratio:
+			return "Descriptor Set Hit Ratio (%)";
+		case StatIndex::descriptor_sets:
+			return "Cached Descriptor Sets";
+		case StatIndex::descriptor_pool_pages:
+			return "Descriptor Pool Pages";
+		case StatIndex::pipeline_compile_time:
+			return "Pipeline Compile Time (ms)";
+		case StatIndex::pipeline_stall_frames:
+			return "Frames Stalled on Pipelines (%)";
+		default:
+			return nullptr;
+	}
+}
+}        // namespace
+
+std::string Stats::export_path;
+
 Stats::Stats(vkb::rendering::RenderContextC &render_context, size_t buffer_size) :
     render_context(render_context),
     buffer_size(buffer_size)
@@ -51,6 +156,16 @@ Stats::~Stats()
 	{
 		worker_thread.join();
 	}
+
+	if (continuous_samples && continuous_samples->get_dropped_count() > 0)
+	{
+		LOGW("{} continuous stats samples were dropped as the ring between the threads was full", continuous_samples->get_dropped_count());
+	}
+}
+
+void Stats::set_export_path(const std::string &path)
+{
+	export_path = path;
 }
 
 void Stats::request_stats(const std::set<StatIndex> &wanted_stats,
@@ -63,14 +178,21 @@ void Stats::request_stats(const std::set<StatIndex> &wanted_stats,
 
 	requested_stats = wanted_stats;
 	sampling_config = config;
+	start_time      = std::chrono::steady_clock::now();
 
 	// Copy the requested stats, so they can be changed by the providers below
 	std::set<StatIndex> stats = requested_stats;
 
+	auto &counters = render_context.get_device().get_stats_counters();
+
 	// Initialize our list of providers (in priority order)
 	// All supported stats will be removed from the given 'stats' set by the provider's constructor
 	// so subsequent providers only see requests for stats that aren't already supported.
 	providers.emplace_back(std::make_unique<FrameTimeStatsProvider>(stats));
+	providers.emplace_back(std::make_unique<CullingStatsProvider>(stats, counters.culling));
+	providers.emplace_back(std::make_unique<BufferPoolStatsProvider>(stats, counters.buffer_pool));
+	providers.emplace_back(std::make_unique<DescriptorSetStatsProvider>(stats, counters.descriptor_sets));
+	providers.emplace_back(std::make_unique<PipelineStatsProvider>(stats, counters.pipelines));
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 	providers.emplace_back(std::make_unique<HWCPipeStatsProvider>(stats));
 #endif
@@ -85,8 +207,27 @@ void Stats::request_stats(const std::set<StatIndex> &wanted_stats,
 		counters[stat] = std::vector<float>(buffer_size, 0);
 	}
 
+	if (!export_path.empty())
+	{
+		std::vector<StatsExporter::Column> columns;
+		for (auto index : requested_stats)
+		{
+			if (is_available(index))
+			{
+				auto &graph_data = get_graph_data(index);
+				auto *name       = to_string(index);
+				columns.push_back({index, name ? name : graph_data.name, graph_data.scale_factor});
+			}
+		}
+
+		exporter = std::make_unique<StatsExporter>(export_path, StatsExporter::get_format(export_path), std::move(columns));
+		LOGI("Writing stats to {}", export_path);
+	}
+
 	if (sampling_config.mode == CounterSamplingMode::Continuous)
 	{
+		continuous_samples = std::make_unique<StatsRing>(CONTINUOUS_SAMPLE_CAPACITY);
+
 		// Start a thread for continuous sample capture
 		stop_worker = std::make_unique<std::promise<void>>();
 
@@ -152,49 +293,59 @@ void Stats::update(float delta_time)
 	{
 		case CounterSamplingMode::Polling:
 		{
-			StatsProvider::Counters sample;
+			StatsSample sample;
+			sample.time = get_sample_time();
 
 			for (auto &p : providers)
 			{
-				auto s = p->sample(delta_time);
-				sample.insert(s.begin(), s.end());
+				for (auto &[index, counter] : p->sample(delta_time))
+				{
+					sample.set(index, counter.result);
+				}
+			}
+
+			if (exporter)
+			{
+				exporter->write(sample);
 			}
 			push_sample(sample);
 			break;
 		}
 		case CounterSamplingMode::Continuous:
 		{
-			// Check that we have no pending samples to be shown
-			if (pending_samples.size() == 0)
+			if (continuous_samples->size() == 0)
 			{
-				std::unique_lock<std::mutex> lock(continuous_sampling_mutex);
-				if (!should_add_to_continuous_samples)
+				return;
+			}
+
+			// Get the frame time stats (not a continuous stat)
+			StatsProvider::Counters frame_time_sample = frame_time_provider->sample(delta_time);
+
+			StatsSample sample;
+
+			auto take_sample = [this, &frame_time_sample, &sample]() {
+				continuous_samples->pop(sample);
+
+				// Write the correct frame time into the continuous stats
+				for (auto &[index, counter] : frame_time_sample)
 				{
-					// If we have no pending samples, we let the worker thread
-					// capture samples for the next frame
-					should_add_to_continuous_samples = true;
+					sample.set(index, counter.result);
 				}
-				else
+
+				if (exporter)
 				{
-					// The worker thread has captured a frame, so we stop it
-					// and read the samples
-					should_add_to_continuous_samples = false;
-					pending_samples.clear();
-					std::swap(pending_samples, continuous_samples);
+					exporter->write(sample);
 				}
-			}
-
-			if (pending_samples.size() == 0)
-			{
-				return;
-			}
+			};
 
 			// Ensure the number of pending samples is capped at a reasonable value
-			if (pending_samples.size() > 100)
+			if (continuous_samples->size() > MAX_PENDING_SAMPLES)
 			{
-				// Prefer later samples over new samples.
-				std::move(pending_samples.end() - 100, pending_samples.end(), pending_samples.begin());
-				pending_samples.erase(pending_samples.begin() + 100, pending_samples.end());
+				// Prefer later samples over older samples
+				while (continuous_samples->size() > MAX_PENDING_SAMPLES)
+				{
+					take_sample();
+				}
 
 				// If we get to this point, we're not reading samples fast enough, nudge a little ahead.
 				fractional_pending_samples += 1.0f;
@@ -210,19 +361,14 @@ void Stats::update(float delta_time)
 			auto sample_count = static_cast<size_t>(floating_sample_count);
 
 			// Clamp the number of samples
-			sample_count = std::max<size_t>(1, std::min<size_t>(sample_count, pending_samples.size()));
-
-			// Get the frame time stats (not a continuous stat)
-			StatsProvider::Counters frame_time_sample = frame_time_provider->sample(delta_time);
+			sample_count = std::max<size_t>(1, std::min<size_t>(sample_count, continuous_samples->size()));
 
 			// Push the samples to circular buffers
-			std::for_each(pending_samples.begin(), pending_samples.begin() + sample_count, [this, frame_time_sample](auto &s) {
-				// Write the correct frame time into the continuous stats
-				s.insert(frame_time_sample.begin(), frame_time_sample.end());
-				// Then push the sample to the counters list
-				this->push_sample(s);
-			});
-			pending_samples.erase(pending_samples.begin(), pending_samples.begin() + sample_count);
+			for (size_t i = 0; i < sample_count; ++i)
+			{
+				take_sample();
+				push_sample(sample);
+			}
 
 			break;
 		}
@@ -233,11 +379,14 @@ void Stats::update(float delta_time)
 
 void Stats::continuous_sampling_worker(std::future<void> should_terminate)
 {
+	// Reused for every sample, so that sampling does not allocate
+	StatsSample sample;
+
 	worker_timer.tick();
 
 	for (auto &p : providers)
 	{
-		p->continuous_sample(0.0f);
+		p->continuous_sample(0.0f, sample);
 	}
 
 	while (should_terminate.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
@@ -253,117 +402,42 @@ void Stats::continuous_sampling_worker(std::future<void> should_terminate)
 		}
 
 		// Sample counters
-		StatsProvider::Counters sample;
+		sample.valid.reset();
+		sample.time = get_sample_time();
 		for (auto &p : providers)
 		{
-			StatsProvider::Counters s = p->continuous_sample(delta_time);
-			sample.insert(s.begin(), s.end());
+			p->continuous_sample(delta_time, sample);
 		}
 
-		// Add the new sample to the vector of continuous samples
-		{
-			std::unique_lock<std::mutex> lock(continuous_sampling_mutex);
-			if (should_add_to_continuous_samples)
-			{
-				continuous_samples.push_back(sample);
-			}
-		}
+		// If the main thread is not keeping up the ring is full, and the sample is dropped and counted
+		continuous_samples->push(sample);
 	}
 }
 
-void Stats::push_sample(const StatsProvider::Counters &sample)
+double Stats::get_sample_time() const
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+void Stats::push_sample(const StatsSample &sample)
 {
 	for (auto &c : counters)
 	{
 		StatIndex           idx    = c.first;
 		std::vector<float> &values = c.second;
 
-		// Find the counter matching this StatIndex in the Sample
-		const auto &smp = sample.find(idx);
-		if (smp == sample.end())
+		// Skip the counters that are not in the sample
+		if (!sample.has(idx))
 		{
 			continue;
 		}
 
-		float measurement = static_cast<float>(smp->second.result);
+		float measurement = static_cast<float>(sample.get(idx));
 
 		add_smoothed_value(values, measurement, alpha_smoothing);
 	}
 }
 
-namespace
-{
-// For now names are taken from the stats_provider.cpp file
-const char *to_string(StatIndex index)
-{
-	switch (index)
-	{
-		case StatIndex::frame_times:
-			return "Frame Times (ms)";
-		case StatIndex::cpu_cycles:
-			return "CPU Cycles (M/s)";
-		case StatIndex::cpu_instructions:
-			return "CPU Instructions (M/s)";
-		case StatIndex::cpu_cache_miss_ratio:
-			return "Cache Miss Ratio (%)";
-		case StatIndex::cpu_branch_miss_ratio:
-			return "Branch Miss Ratio (%)";
-		case StatIndex::cpu_l1_accesses:
-			return "CPU L1 Accesses (M/s)";
-		case StatIndex::cpu_instr_retired:
-			return "CPU Instructions Retired (M/s)";
-		case StatIndex::cpu_l2_accesses:
-			return "CPU L2 Accesses (M/s)";
-		case StatIndex::cpu_l3_accesses:
-			return "CPU L3 Accesses (M/s)";
-		case StatIndex::cpu_bus_reads:
-			return "CPU Bus Read Beats (M/s)";
-		case StatIndex::cpu_bus_writes:
-			return "CPU Bus Write Beats (M/s)";
-		case StatIndex::cpu_mem_reads:
-			return "CPU Memory Read Instructions (M/s)";
-		case StatIndex::cpu_mem_writes:
-			return "CPU Memory Write Instructions (M/s)";
-		case StatIndex::cpu_ase_spec:
-			return "CPU Speculatively Exec. SIMD Instructions (M/s)";
-		case StatIndex::cpu_vfp_spec:
-			return "CPU Speculatively Exec. FP Instructions (M/s)";
-		case StatIndex::cpu_crypto_spec:
-			return "CPU Speculatively Exec. Crypto Instructions (M/s)";
-		case StatIndex::gpu_cycles:
-			return "GPU Cycles (M/s)";
-		case StatIndex::gpu_vertex_cycles:
-			return "Vertex Cycles (M/s)";
-		case StatIndex::gpu_load_store_cycles:
-			return "Load Store Cycles (k/s)";
-		case StatIndex::gpu_tiles:
-			return "Tiles (k/s)";
-		case StatIndex::gpu_killed_tiles:
-			return "Tiles killed by CRC match (k/s)";
-		case StatIndex::gpu_fragment_jobs:
-			return "Fragment Jobs (s)";
-		case StatIndex::gpu_fragment_cycles:
-			return "Fragment Cycles (M/s)";
-		case StatIndex::gpu_tex_cycles:
-			return "Shader Texture Cycles (k/s)";
-		case StatIndex::gpu_ext_reads:
-			return "External Reads (M/s)";
-		case StatIndex::gpu_ext_writes:
-			return "External Writes (M/s)";
-		case StatIndex::gpu_ext_read_stalls:
-			return "External Read Stalls (M/s)";
-		case StatIndex::gpu_ext_write_stalls:
-			return "External Write Stalls (M/s)";
-		case StatIndex::gpu_ext_read_bytes:
-			return "External Read Bytes (MiB/s)";
-		case StatIndex::gpu_ext_write_bytes:
-			return "External Write Bytes (MiB/s)";
-		default:
-			return nullptr;
-	}
-}
-}        // namespace
-
 void Stats::profile_counters() const
 {
 #if VKB_PROFILING
@@ -432,6 +506,33 @@ void Stats::profile_counters() const
 
 void Stats::begin_sampling(vkb::core::CommandBufferC &cb)
 {
+	if (gpu_timestamp_pool)
+	{
+		uint32_t frame_index = render_context.get_active_frame_index();
+
+		gpu_frame_time.reset();
+
+		// RenderContext::begin waited for the previous use of this frame, so its timestamps are ready
+		if (pending_gpu_timestamps[frame_index])
+		{
+			std::array<uint64_t, 2> timestamps;
+
+			VkResult result = gpu_timestamp_pool->get_results(frame_index * 2, 2,
+			                                                  timestamps.size() * sizeof(uint64_t),
+			                                                  timestamps.data(), sizeof(uint64_t),
+			                                                  VK_QUERY_RESULT_64_BIT);
+			if (result == VK_SUCCESS)
+			{
+				gpu_frame_time = timestamp_period * static_cast<float>(timestamps[1] - timestamps[0]) * 0.000000001f;
+			}
+
+			pending_gpu_timestamps[frame_index] = false;
+		}
+
+		cb.reset_query_pool(*gpu_timestamp_pool, frame_index * 2, 2);
+		cb.write_timestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, *gpu_timestamp_pool, frame_index * 2);
+	}
+
 	// Inform the providers
 	for (auto &p : providers)
 	{
@@ -446,6 +547,49 @@ void Stats::end_sampling(vkb::core::CommandBufferC &cb)
 	{
 		p->end_sampling(cb);
 	}
+
+	if (gpu_timestamp_pool)
+	{
+		uint32_t frame_index = render_context.get_active_frame_index();
+
+		cb.write_timestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, *gpu_timestamp_pool, frame_index * 2 + 1);
+
+		pending_gpu_timestamps[frame_index] = true;
+	}
+}
+
+void Stats::enable_gpu_frame_timing()
+{
+	if (gpu_timestamp_pool)
+	{
+		return;
+	}
+
+	vkb::core::DeviceC               &device = render_context.get_device();
+	vkb::core::PhysicalDeviceC const &gpu    = device.get_gpu();
+
+	if (!gpu.get_properties().limits.timestampComputeAndGraphics)
+	{
+		LOGW("GPU frame timing is not available, the device does not support timestamps on all graphics queues");
+		return;
+	}
+
+	timestamp_period = gpu.get_properties().limits.timestampPeriod;
+
+	auto frame_count = static_cast<uint32_t>(render_context.get_render_frames().size());
+
+	VkQueryPoolCreateInfo create_info{};
+	create_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	create_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+	create_info.queryCount = frame_count * 2;        // 2 timestamps per frame (start & end)
+
+	gpu_timestamp_pool = std::make_unique<QueryPool>(device, create_info);
+	pending_gpu_timestamps.assign(frame_count, false);
+}
+
+std::optional<float> Stats::get_gpu_frame_time() const
+{
+	return gpu_frame_time;
 }
 
 const StatGraphData &Stats::get_graph_data(StatIndex index) const
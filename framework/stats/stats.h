@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2025, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  * Copyright (c) 2020-2025, Broadcom Inc.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -22,15 +22,19 @@
 #include <ctime>
 #include <future>
 #include <map>
+#include <optional>
 #include <set>
 #include <vector>
 
 #include "stats_common.h"
+#include "stats_exporter.h"
 #include "stats_provider.h"
+#include "stats_ring.h"
 #include "timer.h"
 
 namespace vkb
 {
+class QueryPool;
 
 namespace core
 {
@@ -72,6 +76,13 @@ class Stats
 	void request_stats(const std::set<StatIndex> &requested_stats,
 	                   CounterSamplingConfig      sampling_config = {CounterSamplingMode::Polling});
 
+	/**
+	 * @brief Sets a file that the stats requested from then on are written to, at the full sampling rate.
+	 *        The format follows the extension, see StatsExporter::get_format.
+	 * @param path The file to write, or an empty string to stop exporting
+	 */
+	static void set_export_path(const std::string &path);
+
 	/**
 	 * @brief Resizes the stats buffers according to the width of the screen
 	 * @param width The width of the screen
@@ -144,6 +155,19 @@ class Stats
 	 */
 	void end_sampling(vkb::core::CommandBufferC &cb);
 
+	/**
+	 * @brief Measures the GPU time of the command buffers passed to begin_sampling and end_sampling with timestamp
+	 *        queries, whether or not any stats were requested. Does nothing if the device has no timestamps.
+	 */
+	void enable_gpu_frame_timing();
+
+	/**
+	 * @brief GPU time of the frame whose timestamps were read by the last begin_sampling. Timestamps are read when
+	 *        their frame in flight is reused, so the frame is a few frames behind the one being recorded.
+	 * @return The time in seconds, or nothing if no frame was ready or GPU frame timing is not enabled
+	 */
+	std::optional<float> get_gpu_frame_time() const;
+
   private:
 	/// The render context
 	vkb::rendering::RenderContextC &render_context;
@@ -181,27 +205,41 @@ class Stats
 	/// Promise to stop the worker thread
 	std::unique_ptr<std::promise<void>> stop_worker;
 
-	/// A mutex for accessing measurements during continuous sampling
-	std::mutex continuous_sampling_mutex;
+	/// The samples read during continuous sampling and waiting to be displayed,
+	/// written by the worker thread and read by the main thread
+	std::unique_ptr<StatsRing> continuous_samples;
 
-	/// The samples read during continuous sampling
-	std::vector<StatsProvider::Counters> continuous_samples;
+	/// A value which helps keep a steady pace of continuous samples output.
+	float fractional_pending_samples{0.0f};
 
-	/// A flag specifying if the worker thread should add entries to continuous_samples
-	bool should_add_to_continuous_samples{false};
+	/// Time the stats were requested, the samples are timed from it
+	std::chrono::steady_clock::time_point start_time;
 
-	/// The samples waiting to be displayed
-	std::vector<StatsProvider::Counters> pending_samples;
+	/// Writes every sample to the export file, if one was set
+	std::unique_ptr<StatsExporter> exporter;
 
-	/// A value which helps keep a steady pace of continuous samples output.
-	float fractional_pending_samples{0.0f};
+	static std::string export_path;
 
 	/// The worker thread function for continuous sampling;
 	/// it adds a new entry to continuous_samples at every interval
 	void continuous_sampling_worker(std::future<void> should_terminate);
 
+	/// Seconds since the stats were requested
+	double get_sample_time() const;
+
+	/// Timestamps at the beginning and end of the sampled command buffer of each frame in flight
+	std::unique_ptr<QueryPool> gpu_timestamp_pool;
+
+	/// Nanoseconds per timestamp tick
+	float timestamp_period{1.0f};
+
+	/// Frames in flight whose timestamps were written and not read yet
+	std::vector<bool> pending_gpu_timestamps;
+
+	std::optional<float> gpu_frame_time;
+
 	/// Updates circular buffers for CPU and GPU counters
-	void push_sample(const StatsProvider::Counters &sample);
+	void push_sample(const StatsSample &sample);
 
 	// Push counters to external profilers
 	void profile_counters() const;
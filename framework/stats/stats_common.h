@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2022, Arm Limited and Contributors
+/* Copyright (c) 2018-2026, Arm Limited and Contributors
  * Copyright (c) 2020-2022, Broadcom Inc.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <array>
+#include <bitset>
 #include <chrono>
 #include <string>
 
@@ -63,8 +65,24 @@ enum class StatIndex
 	gpu_ext_read_bytes,
 	gpu_ext_write_bytes,
 	gpu_tex_cycles,
+
+	visible_instances,
+	culled_instances,
+
+	buffer_pool_allocated,
+	buffer_pool_padding,
+
+	descriptor_hit_ratio,
+	descriptor_sets,
+	descriptor_pool_pages,
+
+	pipeline_compile_time,
+	pipeline_stall_frames,
 };
 
+/// Number of stats in StatIndex
+constexpr size_t STAT_INDEX_COUNT = static_cast<size_t>(StatIndex::pipeline_stall_frames) + 1;
+
 struct StatIndexHash
 {
 	template <typename T>
@@ -107,6 +125,36 @@ struct CounterSamplingConfig
 	float speed{0.5f};
 };
 
+/**
+ * @brief The values of the stats at one point in time, as a flat record that is copied without allocating
+ */
+struct StatsSample
+{
+	/// Seconds since the stats were requested
+	double time{0.0};
+
+	std::array<double, STAT_INDEX_COUNT> values{};
+
+	/// Which of the values were set by a provider
+	std::bitset<STAT_INDEX_COUNT> valid;
+
+	void set(StatIndex index, double value)
+	{
+		values[static_cast<size_t>(index)] = value;
+		valid.set(static_cast<size_t>(index));
+	}
+
+	bool has(StatIndex index) const
+	{
+		return valid.test(static_cast<size_t>(index));
+	}
+
+	double get(StatIndex index) const
+	{
+		return values[static_cast<size_t>(index)];
+	}
+};
+
 // Per-statistic graph data
 class StatGraphData
 {
@@ -0,0 +1,162 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace vkb
+{
+/**
+ * @brief Number of mesh instances kept and rejected by CPU culling since the CullingStatsProvider last read them
+ */
+struct CullingCounters
+{
+	std::atomic<uint32_t> visible_instances{0};
+
+	std::atomic<uint32_t> culled_instances{0};
+
+	/**
+	 * @brief Reports the result of culling a set of instances, from any thread
+	 * @param visible_count Number of instances kept
+	 * @param culled_count Number of instances rejected
+	 */
+	void add_counts(uint32_t visible_count, uint32_t culled_count)
+	{
+		visible_instances += visible_count;
+		culled_instances += culled_count;
+	}
+};
+
+/**
+ * @brief Buffer pool usage of the frames reset since the BufferPoolStatsProvider last read it
+ */
+struct BufferPoolCounters
+{
+	std::atomic<uint64_t> allocated_bytes{0};
+
+	std::atomic<uint64_t> padding_bytes{0};
+
+	std::atomic<uint32_t> frame_count{0};
+
+	/**
+	 * @brief Reports the buffer pool usage of a frame
+	 * @param allocated_size Number of bytes allocated, including padding
+	 * @param padding_size Number of bytes skipped to align allocations
+	 */
+	void add_frame(uint64_t allocated_size, uint64_t padding_size)
+	{
+		allocated_bytes += allocated_size;
+		padding_bytes += padding_size;
+		++frame_count;
+	}
+};
+
+/**
+ * @brief Descriptor set caches of the frames reset since the DescriptorSetStatsProvider last read them
+ */
+struct DescriptorSetCounters
+{
+	std::atomic<uint64_t> hit_count{0};
+
+	std::atomic<uint64_t> miss_count{0};
+
+	std::atomic<uint64_t> set_count{0};
+
+	std::atomic<uint64_t> pool_page_count{0};
+
+	std::atomic<uint32_t> frame_count{0};
+
+	/**
+	 * @brief Reports the descriptor set cache of a frame
+	 * @param hits Number of requests served from the cache
+	 * @param misses Number of requests that wrote a new descriptor set
+	 * @param sets Number of descriptor sets in the cache
+	 * @param pool_pages Number of descriptor pools the sets are allocated from
+	 */
+	void add_frame(uint64_t hits, uint64_t misses, uint64_t sets, uint64_t pool_pages)
+	{
+		hit_count += hits;
+		miss_count += misses;
+		set_count += sets;
+		pool_page_count += pool_pages;
+		++frame_count;
+	}
+};
+
+/**
+ * @brief Pipeline compiles and stalled frames since the PipelineStatsProvider last read them
+ */
+struct PipelineCounters
+{
+	std::atomic<uint64_t> compile_count{0};
+
+	std::atomic<uint64_t> compile_us{0};
+
+	std::atomic<bool> stalled{false};
+
+	std::atomic<uint32_t> stalled_frame_count{0};
+
+	std::atomic<uint32_t> frame_count{0};
+
+	/**
+	 * @brief Reports a compiled pipeline, from any thread
+	 * @param milliseconds Time the pipeline took to create
+	 */
+	void add_compile(double milliseconds)
+	{
+		compile_us += static_cast<uint64_t>(milliseconds * 1000.0);
+		++compile_count;
+	}
+
+	/**
+	 * @brief Reports that a draw or dispatch waited for a pipeline to compile
+	 */
+	void add_stall()
+	{
+		stalled = true;
+	}
+
+	/**
+	 * @brief Reports the end of a frame, which stalled if add_stall was called since the previous one
+	 */
+	void add_frame()
+	{
+		if (stalled.exchange(false))
+		{
+			++stalled_frame_count;
+		}
+		++frame_count;
+	}
+};
+
+/**
+ * @brief Counters that rendering code reports to and that the stats providers read and reset.
+ *        The device owns them, so that each device reports to the stats created for its own render context.
+ */
+struct StatsCounters
+{
+	CullingCounters culling;
+
+	BufferPoolCounters buffer_pool;
+
+	DescriptorSetCounters descriptor_sets;
+
+	PipelineCounters pipelines;
+};
+}        // namespace vkb
@@ -0,0 +1,124 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_exporter.h"
+
+#include <iterator>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace vkb
+{
+StatsExporter::StatsExporter(const std::string &path, StatsExportFormat format, std::vector<Column> columns) :
+    file{path, std::ios::out | std::ios::trunc},
+    format{format},
+    columns{std::move(columns)}
+{
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Failed to open stats export file " + path);
+	}
+
+	switch (format)
+	{
+		case StatsExportFormat::Csv:
+		{
+			file << "\"Time (s)\"";
+			for (auto &column : this->columns)
+			{
+				file << ",\"" << column.name << '"';
+			}
+			file << '\n';
+			break;
+		}
+		case StatsExportFormat::ChromeTrace:
+		{
+			// The viewers accept an array without its closing bracket, so a run that crashes still leaves a usable trace
+			file << "[\n";
+			break;
+		}
+	}
+}
+
+StatsExporter::~StatsExporter()
+{
+	if (format == StatsExportFormat::ChromeTrace)
+	{
+		file << "\n]\n";
+	}
+}
+
+void StatsExporter::write(const StatsSample &sample)
+{
+	std::ostreambuf_iterator<char> out{file};
+
+	// The scale factors are floats, so more digits than these would only show their rounding
+
+	switch (format)
+	{
+		case StatsExportFormat::Csv:
+		{
+			fmt::format_to(out, "{:.6f}", sample.time);
+			for (auto &column : columns)
+			{
+				if (sample.has(column.index))
+				{
+					fmt::format_to(out, ",{:.6g}", sample.get(column.index) * column.scale_factor);
+				}
+				else
+				{
+					file << ',';
+				}
+			}
+			file << '\n';
+			break;
+		}
+		case StatsExportFormat::ChromeTrace:
+		{
+			// Counter events take their timestamp in microseconds, one event per stat keeps each on its own track
+			double timestamp = sample.time * 1e6;
+			for (auto &column : columns)
+			{
+				if (!sample.has(column.index))
+				{
+					continue;
+				}
+
+				fmt::format_to(out,
+				               "{}{{\"name\":\"{}\",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":1,\"tid\":1,\"args\":{{\"value\":{:.6g}}}}}",
+				               first_event ? "" : ",\n",
+				               column.name,
+				               timestamp,
+				               sample.get(column.index) * column.scale_factor);
+				first_event = false;
+			}
+			break;
+		}
+	}
+}
+
+StatsExportFormat StatsExporter::get_format(const std::string &path)
+{
+	if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0)
+	{
+		return StatsExportFormat::Csv;
+	}
+
+	return StatsExportFormat::ChromeTrace;
+}
+}        // namespace vkb
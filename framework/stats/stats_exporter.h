@@ -0,0 +1,86 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "stats_common.h"
+
+namespace vkb
+{
+enum class StatsExportFormat
+{
+	/// A header row with the stat names, then a row per sample
+	Csv,
+
+	/// A JSON array of counter events, which loads in chrome://tracing and https://ui.perfetto.dev
+	ChromeTrace
+};
+
+/**
+ * @brief Streams every sample of a set of stats to a file, so that long runs can be analyzed offline
+ */
+class StatsExporter
+{
+  public:
+	struct Column
+	{
+		StatIndex index;
+
+		/// Name of the stat, with its unit
+		std::string name;
+
+		/// Converts the sampled value to the unit of the name
+		float scale_factor{1.0f};
+	};
+
+	/**
+	 * @brief Opens the file and writes the header of the format
+	 * @param path The file to write, replaced if it exists
+	 * @param format The format of the file
+	 * @param columns The stats to write, in order
+	 */
+	StatsExporter(const std::string &path, StatsExportFormat format, std::vector<Column> columns);
+
+	/**
+	 * @brief Writes the end of the format and closes the file
+	 */
+	~StatsExporter();
+
+	/**
+	 * @brief Appends a sample, stats that are not set in the sample are left out
+	 */
+	void write(const StatsSample &sample);
+
+	/**
+	 * @return Csv for a .csv extension, ChromeTrace for anything else
+	 */
+	static StatsExportFormat get_format(const std::string &path);
+
+  private:
+	std::ofstream file;
+
+	StatsExportFormat format;
+
+	std::vector<Column> columns;
+
+	bool first_event{true};
+};
+}        // namespace vkb
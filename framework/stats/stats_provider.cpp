@@ -54,6 +54,19 @@ std::map<StatIndex, StatGraphData> StatsProvider::default_graph_map{
     {StatIndex::gpu_ext_write_stalls,  {"External Write Stalls",                       "{:4.1f} M/s",   static_cast<float>(1e-6)}},
     {StatIndex::gpu_ext_read_bytes,    {"External Read Bytes",                         "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
     {StatIndex::gpu_ext_write_bytes,   {"External Write Bytes",                        "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
+
+    {StatIndex::visible_instances,     {"Visible Instances",                           "{:4.0f}"}},
+    {StatIndex::culled_instances,      {"Culled Instances",                            "{:4.0f}"}},
+
+    {StatIndex::buffer_pool_allocated, {"Buffer Pool Allocated",                       "{:4.1f} KiB",   1.0f / 1024.0f}},
+    {StatIndex::buffer_pool_padding,   {"Buffer Pool Padding",                         "{:4.1f} KiB",   1.0f / 1024.0f}},
+
+    {StatIndex::descriptor_hit_ratio,  {"Descriptor Set Hit Ratio",                    "{:3.1f}%",      100.0f,                       true,     100.0f}},
+    {StatIndex::descriptor_sets,       {"Cached Descriptor Sets",                      "{:4.0f}"}},
+    {StatIndex::descriptor_pool_pages, {"Descriptor Pool Pages",                       "{:4.0f}"}},
+
+    {StatIndex::pipeline_compile_time, {"Pipeline Compile Time",                       "{:4.1f} ms"}},
+    {StatIndex::pipeline_stall_frames, {"Frames Stalled on Pipelines",                 "{:3.1f}%",      100.0f,                       true,     100.0f}},
     // clang-format on
 };
 
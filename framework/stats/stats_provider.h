@@ -77,13 +77,12 @@ class StatsProvider
 	virtual Counters sample(float delta_time) = 0;
 
 	/**
-	 * @brief Retrieve a new sample set from continuous sampling
+	 * @brief Retrieve a new sample set from continuous sampling, called from the sampling thread
 	 * @param delta_time Time since last sample
+	 * @param sample The sample to write the available stats to, without allocating
 	 */
-	virtual Counters continuous_sample(float delta_time)
-	{
-		return Counters();
-	}
+	virtual void continuous_sample(float delta_time, StatsSample &sample)
+	{}
 
 	/**
 	 * @brief A command buffer that we want stats about has just begun
@@ -0,0 +1,80 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_ring.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace vkb
+{
+StatsRing::StatsRing(size_t capacity) :
+    samples(std::bit_ceil(std::max<size_t>(capacity, 1))),
+    mask(samples.size() - 1)
+{
+}
+
+bool StatsRing::push(const StatsSample &sample)
+{
+	size_t write = write_index.load(std::memory_order_relaxed);
+
+	// Acquire pairs with the release in pop, so the consumer is done reading the slot before it is overwritten
+	if (write - read_index.load(std::memory_order_acquire) == samples.size())
+	{
+		dropped_count.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	samples[write & mask] = sample;
+	write_index.store(write + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool StatsRing::pop(StatsSample &sample)
+{
+	size_t read = read_index.load(std::memory_order_relaxed);
+
+	// Acquire pairs with the release in push, so the sample is complete before it is read
+	if (read == write_index.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	sample = samples[read & mask];
+	read_index.store(read + 1, std::memory_order_release);
+
+	return true;
+}
+
+size_t StatsRing::size() const
+{
+	// The read index is loaded first, as the write index is never behind it
+	size_t read = read_index.load(std::memory_order_acquire);
+	return write_index.load(std::memory_order_acquire) - read;
+}
+
+size_t StatsRing::get_capacity() const
+{
+	return samples.size();
+}
+
+size_t StatsRing::get_dropped_count() const
+{
+	return dropped_count.load(std::memory_order_relaxed);
+}
+}        // namespace vkb
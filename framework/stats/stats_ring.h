@@ -0,0 +1,77 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "stats_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Fixed-capacity queue of stats samples between one producer thread and one consumer thread.
+ *        Neither side locks or allocates, a sample pushed while the ring is full is dropped and counted.
+ */
+class StatsRing
+{
+  public:
+	/**
+	 * @param capacity Number of samples the ring holds, rounded up to a power of two
+	 */
+	explicit StatsRing(size_t capacity);
+
+	/**
+	 * @brief Called by the producer thread only
+	 * @return False if the ring was full and the sample was dropped
+	 */
+	bool push(const StatsSample &sample);
+
+	/**
+	 * @brief Called by the consumer thread only
+	 * @return False if the ring was empty
+	 */
+	bool pop(StatsSample &sample);
+
+	/**
+	 * @return The number of samples waiting, exact when called by the consumer thread
+	 */
+	size_t size() const;
+
+	size_t get_capacity() const;
+
+	/**
+	 * @return The number of samples dropped because the ring was full
+	 */
+	size_t get_dropped_count() const;
+
+  private:
+	std::vector<StatsSample> samples;
+
+	size_t mask;
+
+	/// Index of the next sample to write, only written by the producer.
+	/// Both indices only grow and wrap through the mask, and have a cache line each so the two threads don't share one.
+	alignas(64) std::atomic<size_t> write_index{0};
+
+	/// Index of the next sample to read, only written by the consumer
+	alignas(64) std::atomic<size_t> read_index{0};
+
+	std::atomic<size_t> dropped_count{0};
+};
+}        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2025, Arm Limited and Contributors
+/* Copyright (c) 2019-2026, Arm Limited and Contributors
  * Copyright (c) 2021-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -1326,6 +1326,8 @@ inline void VulkanSample<bindingType>::update(float delta_time)
 
 	update_gui(delta_time);
 
+	device->get_resource_cache().update_pipeline_cache(delta_time);
+
 	auto command_buffer = render_context->begin();
 
 	// Collect the performance data for the sample graphs
@@ -1427,6 +1429,9 @@ inline void VulkanSample<bindingType>::update_scene(float delta_time)
 				animation->update(delta_time);
 			}
 		}
+
+		// Propagate the changes of scripts and animations to the world matrices
+		scene->update_transforms();
 	}
 }
 
@@ -317,27 +317,14 @@ std::shared_ptr<vkb::core::CommandBufferC>
 
 void CommandBufferUsage::ForwardSubpassSecondary::draw(vkb::core::CommandBufferC &primary_command_buffer)
 {
-	std::multimap<float, std::pair<vkb::scene_graph::NodeC *, vkb::sg::SubMesh *>> opaque_nodes;
-
-	std::multimap<float, std::pair<vkb::scene_graph::NodeC *, vkb::sg::SubMesh *>> transparent_nodes;
-
-	get_sorted_nodes(opaque_nodes, transparent_nodes);
-
-	// Sort opaque objects in front-to-back order
+	// Opaque objects come grouped by state and front-to-back within a group, transparent objects back-to-front
 	// Note: sorting objects does not help on PowerVR, so it can be avoided to save CPU cycles
 	std::vector<std::pair<vkb::scene_graph::NodeC *, vkb::sg::SubMesh *>> sorted_opaque_nodes;
-	for (auto node_it = opaque_nodes.begin(); node_it != opaque_nodes.end(); node_it++)
-	{
-		sorted_opaque_nodes.push_back(node_it->second);
-	}
-	const auto opaque_submeshes = vkb::to_u32(sorted_opaque_nodes.size());
-
-	// Sort transparent objects in back-to-front order
 	std::vector<std::pair<vkb::scene_graph::NodeC *, vkb::sg::SubMesh *>> sorted_transparent_nodes;
-	for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
-	{
-		sorted_transparent_nodes.push_back(node_it->second);
-	}
+
+	get_sorted_nodes(sorted_opaque_nodes, sorted_transparent_nodes);
+
+	const auto opaque_submeshes      = vkb::to_u32(sorted_opaque_nodes.size());
 	const auto transparent_submeshes = vkb::to_u32(sorted_transparent_nodes.size());
 
 	allocate_lights<vkb::ForwardLights>(get_scene().get_components<vkb::sg::Light>(), MAX_FORWARD_LIGHT_COUNT);
@@ -0,0 +1,242 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <memory>
+#include <random>
+
+#include "scene_graph/node.h"
+#include "scene_graph/scripts/animation.h"
+
+namespace
+{
+using vkb::scene_graph::NodeC;
+
+/**
+ * @brief Keyframe times with uneven gaps between them
+ */
+std::shared_ptr<const std::vector<float>> make_inputs(size_t count, uint32_t seed)
+{
+	std::mt19937                          random{seed};
+	std::uniform_real_distribution<float> gap{0.01f, 0.1f};
+
+	auto  inputs = std::make_shared<std::vector<float>>(count);
+	float time   = 0.0f;
+	for (auto &input : *inputs)
+	{
+		input = time;
+		time += gap(random);
+	}
+	return inputs;
+}
+
+vkb::sg::AnimationSampler make_sampler(vkb::sg::AnimationType type, const std::shared_ptr<const std::vector<float>> &inputs, uint32_t seed)
+{
+	std::mt19937                          random{seed};
+	std::uniform_real_distribution<float> value{-10.0f, 10.0f};
+
+	vkb::sg::AnimationSampler sampler;
+	sampler.type   = type;
+	sampler.inputs = inputs;
+	for (size_t i = 0; i < inputs->size(); ++i)
+	{
+		sampler.outputs.emplace_back(value(random), value(random), value(random), 0.0f);
+	}
+	return sampler;
+}
+
+/**
+ * @brief Samples a linear translation the way Animation::update did before it kept keyframe cursors:
+ *        the first interval containing the time, found by scanning from the first keyframe
+ */
+bool sample_by_scan(const vkb::sg::AnimationSampler &sampler, float time, glm::vec3 &translation)
+{
+	auto &inputs = *sampler.inputs;
+	for (size_t i = 0; i + 1 < inputs.size(); ++i)
+	{
+		if (time >= inputs[i] && time <= inputs[i + 1])
+		{
+			float factor = (time - inputs[i]) / (inputs[i + 1] - inputs[i]);
+			translation  = glm::vec3(glm::mix(sampler.outputs[i], sampler.outputs[i + 1], factor));
+			return true;
+		}
+	}
+	return false;
+}
+}        // namespace
+
+BENCH_CASE(animation_keyframes)
+{
+	// Two samplers share their keyframe times, and so a track; a third has its own
+	auto shared_inputs = make_inputs(200, 1);
+	auto own_inputs    = make_inputs(150, 2);
+
+	std::vector<vkb::sg::AnimationSampler> samplers{make_sampler(vkb::sg::Linear, shared_inputs, 3),
+	                                                make_sampler(vkb::sg::Linear, shared_inputs, 4),
+	                                                make_sampler(vkb::sg::Linear, own_inputs, 5)};
+
+	std::vector<std::unique_ptr<NodeC>> nodes;
+	vkb::sg::Animation                  animation{"test"};
+	for (auto &sampler : samplers)
+	{
+		nodes.push_back(std::make_unique<NodeC>(nodes.size(), "node"));
+		animation.add_channel(*nodes.back(), vkb::sg::Translation, sampler);
+		animation.update_times(sampler.inputs->front(), sampler.inputs->back());
+	}
+
+	float end_time = std::max(shared_inputs->back(), own_inputs->back());
+
+	// Small steps move the cursors forward, large ones make them search, and both wrap around the end
+	std::mt19937                          random{6};
+	std::uniform_real_distribution<float> small_step{0.0f, 0.05f};
+	std::uniform_real_distribution<float> large_step{0.0f, 5.0f};
+
+	float    time           = 0.0f;
+	uint32_t mismatch_count = 0;
+	uint32_t sample_count   = 0;
+	for (uint32_t update = 0; update < 5000; ++update)
+	{
+		float delta_time = update % 50 == 0 ? large_step(random) : small_step(random);
+
+		animation.update(delta_time);
+
+		time += delta_time;
+		if (time > end_time)
+		{
+			time -= end_time;
+		}
+
+		for (size_t i = 0; i < samplers.size(); ++i)
+		{
+			glm::vec3 expected;
+			if (!sample_by_scan(samplers[i], time, expected))
+			{
+				continue;
+			}
+
+			auto &translation = nodes[i]->get_transform().get_translation();
+			if (glm::any(glm::greaterThan(glm::abs(translation - expected), glm::vec3{1e-3f})))
+			{
+				++mismatch_count;
+			}
+			++sample_count;
+		}
+	}
+
+	BENCH_CHECK(mismatch_count == 0);
+	BENCH_CHECK(sample_count > 0);
+
+	context.measure("Animation::update, 3 channels on 2 tracks, per update", 1, [&]() {
+		animation.update(0.016f);
+	});
+}
+
+BENCH_CASE(animation_step_keyframes)
+{
+	// Keyframes on whole seconds, so that the updates land exactly on them
+	auto inputs  = std::make_shared<const std::vector<float>>(std::vector<float>{0.0f, 1.0f, 2.0f, 3.0f, 4.0f});
+	auto sampler = make_sampler(vkb::sg::Step, inputs, 7);
+
+	NodeC              node{0, "node"};
+	vkb::sg::Animation animation{"step"};
+	animation.add_channel(node, vkb::sg::Translation, sampler);
+	animation.update_times(inputs->front(), inputs->back());
+
+	auto &translation = node.get_transform().get_translation();
+
+	// At the time of a keyframe its own output is used, the last keyframe included
+	animation.update(0.0f);
+	BENCH_CHECK(translation == glm::vec3(sampler.outputs[0]));
+	for (size_t key = 1; key < inputs->size(); ++key)
+	{
+		animation.update(1.0f);
+		BENCH_CHECK(translation == glm::vec3(sampler.outputs[key]));
+	}
+
+	// Between keyframes the output of the previous one is held
+	animation.update(0.5f);
+	BENCH_CHECK(translation == glm::vec3(sampler.outputs[0]));
+	animation.update(2.0f);
+	BENCH_CHECK(translation == glm::vec3(sampler.outputs[2]));
+}
+
+BENCH_CASE(animation_channels)
+{
+	// A crowd of characters: 1000 nodes with a translation, a rotation and a scale channel each,
+	// whose samplers read 10 sets of keyframe times, as the clips of a skinned glTF model do
+	const uint32_t node_count  = 1000;
+	const uint32_t track_count = 10;
+
+	std::vector<std::shared_ptr<const std::vector<float>>> inputs;
+	for (uint32_t i = 0; i < track_count; ++i)
+	{
+		inputs.push_back(make_inputs(100, 10 + i));
+	}
+
+	std::vector<std::unique_ptr<NodeC>>    nodes;
+	std::vector<vkb::sg::AnimationSampler> samplers;
+	vkb::sg::Animation                     animation{"crowd"};
+	for (uint32_t i = 0; i < node_count; ++i)
+	{
+		nodes.push_back(std::make_unique<NodeC>(i, "node"));
+
+		auto &track_inputs = inputs[i % track_count];
+		for (auto target : {vkb::sg::Translation, vkb::sg::Rotation, vkb::sg::Scale})
+		{
+			auto sampler = make_sampler(vkb::sg::Linear, track_inputs, i * 3 + target);
+			if (target == vkb::sg::Rotation)
+			{
+				for (auto &output : sampler.outputs)
+				{
+					output = glm::normalize(output + glm::vec4{0.0f, 0.0f, 0.0f, 1.0f});
+				}
+			}
+
+			animation.add_channel(*nodes.back(), target, animation.add_sampler(sampler));
+			animation.update_times(track_inputs->front(), track_inputs->back());
+			samplers.push_back(std::move(sampler));
+		}
+	}
+
+	context.report("channels", static_cast<double>(samplers.size()), "channels");
+
+	context.measure("Animation::update, 3000 channels on 10 tracks, per channel", samplers.size(), [&]() {
+		animation.update(0.016f);
+	});
+
+	// The keyframe lookup Animation::update did per channel before tracks: a scan from the first keyframe
+	float time = 0.0f;
+	context.measure("keyframe scan per channel, 3000 channels, per channel", samplers.size(), [&]() {
+		time += 0.016f;
+		if (time > inputs.front()->back())
+		{
+			time -= inputs.front()->back();
+		}
+
+		glm::vec3 sum{0.0f};
+		for (auto &sampler : samplers)
+		{
+			glm::vec3 translation;
+			if (sample_by_scan(sampler, time, translation))
+			{
+				sum += translation;
+			}
+		}
+		vkb::bench::do_not_optimize(sum);
+	});
+}
@@ -0,0 +1,272 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <filesystem/filesystem.hpp>
+
+namespace vkb
+{
+namespace bench
+{
+namespace
+{
+struct Case
+{
+	const char *name;
+
+	CaseFunction function;
+};
+
+std::vector<Case> &get_cases()
+{
+	static std::vector<Case> cases;
+	return cases;
+}
+
+struct CaseReport
+{
+	std::string name;
+
+	std::vector<std::string> failures;
+
+	std::vector<Result> results;
+};
+
+std::string escape_json(const std::string &text)
+{
+	std::string escaped;
+	for (char c : text)
+	{
+		switch (c)
+		{
+			case '"':
+				escaped += "\\\"";
+				break;
+			case '\\':
+				escaped += "\\\\";
+				break;
+			case '\n':
+				escaped += "\\n";
+				break;
+			default:
+				escaped += c;
+				break;
+		}
+	}
+	return escaped;
+}
+
+/**
+ * @brief Writes the reports as a JSON document: an array of cases, each with its failures and results
+ */
+std::string to_json(const std::vector<CaseReport> &reports)
+{
+	std::ostringstream json;
+	json << "{\n  \"cases\": [";
+
+	for (size_t case_index = 0; case_index < reports.size(); ++case_index)
+	{
+		auto &report = reports[case_index];
+
+		json << (case_index ? ",\n" : "\n") << "    {\n";
+		json << "      \"name\": \"" << escape_json(report.name) << "\",\n";
+		json << "      \"passed\": " << (report.failures.empty() ? "true" : "false") << ",\n";
+
+		json << "      \"failures\": [";
+		for (size_t i = 0; i < report.failures.size(); ++i)
+		{
+			json << (i ? ", " : "") << "\"" << escape_json(report.failures[i]) << "\"";
+		}
+		json << "],\n";
+
+		json << "      \"results\": [";
+		for (size_t i = 0; i < report.results.size(); ++i)
+		{
+			auto &result = report.results[i];
+			json << (i ? "," : "") << "\n        {\"name\": \"" << escape_json(result.name) << "\", \"value\": " << result.value
+			     << ", \"unit\": \"" << escape_json(result.unit) << "\"}";
+		}
+		json << (report.results.empty() ? "]\n" : "\n      ]\n");
+
+		json << "    }";
+	}
+
+	json << "\n  ]\n}\n";
+	return json.str();
+}
+
+void print_usage()
+{
+	std::cout << "Usage: vkb_framework_bench [--quick] [--filter <text>] [--json <file>] [--list]\n"
+	             "  --quick          Run every measurement once, to check the cases without timing them\n"
+	             "  --filter <text>  Only run the cases whose name contains the text\n"
+	             "  --json <file>    Write the results as JSON to the file, - for the standard output\n"
+	             "  --list           List the cases and exit\n";
+}
+}        // namespace
+
+Context::Context(bool quick) :
+    quick{quick}
+{
+}
+
+void Context::check(bool condition, const char *expression, const char *file, int line)
+{
+	if (!condition)
+	{
+		failures.push_back(std::string{file} + ":" + std::to_string(line) + ": " + expression);
+	}
+}
+
+void Context::report(const std::string &name, double value, const std::string &unit)
+{
+	results.push_back({name, value, unit});
+}
+
+bool Context::is_quick() const
+{
+	return quick;
+}
+
+const std::vector<std::string> &Context::get_failures() const
+{
+	return failures;
+}
+
+const std::vector<Result> &Context::get_results() const
+{
+	return results;
+}
+
+Registration::Registration(const char *name, CaseFunction function)
+{
+	get_cases().push_back({name, function});
+}
+}        // namespace bench
+}        // namespace vkb
+
+int main(int argc, char *argv[])
+{
+	using namespace vkb::bench;
+
+	bool        quick = false;
+	bool        list  = false;
+	std::string filter;
+	std::string json_path;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--quick") == 0)
+		{
+			quick = true;
+		}
+		else if (std::strcmp(argv[i], "--list") == 0)
+		{
+			list = true;
+		}
+		else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+		{
+			json_path = argv[++i];
+		}
+		else
+		{
+			print_usage();
+			return 2;
+		}
+	}
+
+	// Some cases read and write files, relative to the working directory
+	vkb::filesystem::init();
+
+	std::vector<CaseReport> reports;
+	size_t                  failed_count = 0;
+
+	// The human readable report goes to stderr when the JSON document goes to stdout
+	std::ostream &log = json_path == "-" ? std::cerr : std::cout;
+
+	for (auto &bench_case : get_cases())
+	{
+		if (!filter.empty() && std::string{bench_case.name}.find(filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		if (list)
+		{
+			std::cout << bench_case.name << "\n";
+			continue;
+		}
+
+		Context context{quick};
+
+		try
+		{
+			bench_case.function(context);
+		}
+		catch (const std::exception &e)
+		{
+			context.check(false, e.what(), bench_case.name, 0);
+		}
+
+		bool passed = context.get_failures().empty();
+		failed_count += passed ? 0 : 1;
+
+		log << (passed ? "[ PASS ] " : "[ FAIL ] ") << bench_case.name << "\n";
+		for (auto &failure : context.get_failures())
+		{
+			log << "         " << failure << "\n";
+		}
+		for (auto &result : context.get_results())
+		{
+			log << "         " << result.name << ": " << result.value << " " << result.unit << "\n";
+		}
+
+		reports.push_back({bench_case.name, context.get_failures(), context.get_results()});
+	}
+
+	if (!json_path.empty() && !list)
+	{
+		auto json = to_json(reports);
+		if (json_path == "-")
+		{
+			std::cout << json;
+		}
+		else
+		{
+			std::ofstream file{json_path};
+			file << json;
+			if (!file)
+			{
+				std::cerr << "Failed to write " << json_path << "\n";
+				return 1;
+			}
+		}
+	}
+
+	return failed_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkb
+{
+namespace bench
+{
+/**
+ * @brief Keeps the compiler from optimizing away a value that a measured function computes
+ */
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile(""
+	             :
+	             : "m"(value)
+	             : "memory");
+#else
+	static volatile const T *sink;
+	sink = &value;
+#endif
+}
+
+/**
+ * @brief A value measured by a case
+ */
+struct Result
+{
+	std::string name;
+
+	double value{0.0};
+
+	std::string unit;
+};
+
+/**
+ * @brief State of the case being run: its failed checks and its results
+ */
+class Context
+{
+  public:
+	/**
+	 * @param quick If true, measurements run a single short batch, enough to exercise the code but not to time it
+	 */
+	explicit Context(bool quick);
+
+	/**
+	 * @brief Records a failed check, the case carries on so that all its failures are reported
+	 */
+	void check(bool condition, const char *expression, const char *file, int line);
+
+	/**
+	 * @brief Records a value which is not a time, such as a rate or a ratio
+	 */
+	void report(const std::string &name, double value, const std::string &unit);
+
+	/**
+	 * @brief Times a function and records the median of several batches, in nanoseconds per item
+	 * @param name Name of the result
+	 * @param items_per_call Number of items, such as keys or pixels, that one call processes
+	 * @param function The function to time, called repeatedly
+	 * @return The median time per item in nanoseconds
+	 */
+	template <typename Function>
+	double measure(const std::string &name, uint64_t items_per_call, Function &&function);
+
+	bool is_quick() const;
+
+	const std::vector<std::string> &get_failures() const;
+
+	const std::vector<Result> &get_results() const;
+
+  private:
+	bool quick;
+
+	std::vector<std::string> failures;
+
+	std::vector<Result> results;
+};
+
+template <typename Function>
+double Context::measure(const std::string &name, uint64_t items_per_call, Function &&function)
+{
+	using Clock = std::chrono::steady_clock;
+
+	const auto   min_batch_time = quick ? std::chrono::microseconds(100) : std::chrono::microseconds(20000);
+	const size_t batch_count    = quick ? 1 : 7;
+
+	// Warm up, and find the number of calls which makes a batch long enough for the clock resolution
+	uint64_t calls_per_batch = 1;
+	while (true)
+	{
+		auto start = Clock::now();
+		for (uint64_t call = 0; call < calls_per_batch; ++call)
+		{
+			function();
+		}
+		if (Clock::now() - start >= min_batch_time || calls_per_batch >= (1ull << 30))
+		{
+			break;
+		}
+		calls_per_batch *= 2;
+	}
+
+	std::vector<double> batch_times;
+	for (size_t batch = 0; batch < batch_count; ++batch)
+	{
+		auto start = Clock::now();
+		for (uint64_t call = 0; call < calls_per_batch; ++call)
+		{
+			function();
+		}
+		std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+		batch_times.push_back(elapsed.count() / static_cast<double>(calls_per_batch * items_per_call));
+	}
+
+	std::nth_element(batch_times.begin(), batch_times.begin() + batch_times.size() / 2, batch_times.end());
+	double median = batch_times[batch_times.size() / 2];
+
+	report(name, median, "ns");
+
+	return median;
+}
+
+using CaseFunction = void (*)(Context &context);
+
+/**
+ * @brief Adds a case to the list the bench runs, see BENCH_CASE
+ */
+struct Registration
+{
+	Registration(const char *name, CaseFunction function);
+};
+}        // namespace bench
+}        // namespace vkb
+
+/**
+ * @brief Defines a case, which checks the results of a piece of the framework and times it
+ */
+#define BENCH_CASE(name)                                                              \
+	static void                    name(vkb::bench::Context &context);                \
+	static vkb::bench::Registration name##_registration{#name, name};                 \
+	static void                    name(vkb::bench::Context &context)
+
+/**
+ * @brief Checks a condition in a case, a failure is reported with the expression and makes the bench fail
+ */
+#define BENCH_CHECK(expression) context.check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,247 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "resource_binding_state.h"
+
+namespace
+{
+/**
+ * @brief Addresses standing in for resources. The binding state only stores their addresses, it never reads them,
+ *        so the bench needs no device to create real ones.
+ */
+struct MockResources
+{
+	alignas(64) std::array<uint8_t, 64> buffer_storage[2];
+
+	alignas(64) std::array<uint8_t, 64> image_view_storage[3];
+
+	alignas(64) std::array<uint8_t, 64> sampler_storage;
+
+	const vkb::core::BufferC &get_buffer(uint32_t i) const
+	{
+		return *reinterpret_cast<const vkb::core::BufferC *>(&buffer_storage[i]);
+	}
+
+	const vkb::core::ImageView &get_image_view(uint32_t i) const
+	{
+		return *reinterpret_cast<const vkb::core::ImageView *>(&image_view_storage[i]);
+	}
+
+	const vkb::core::Sampler &get_sampler() const
+	{
+		return *reinterpret_cast<const vkb::core::Sampler *>(&sampler_storage);
+	}
+};
+
+/**
+ * @brief The binding state command buffers kept before the bitmask arrays: nested maps of sets, bindings and
+ *        array elements, with a single dirty flag per set, so that a flush rewrote every binding of a changed set
+ */
+class MapBindingState
+{
+  public:
+	void reset()
+	{
+		sets.clear();
+	}
+
+	void bind_buffer(const vkb::core::BufferC &buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t set, uint32_t binding, uint32_t array_element)
+	{
+		auto &resource_set = sets[set];
+		auto &info         = resource_set.bindings[binding][array_element];
+		info.dirty         = true;
+		info.buffer        = &buffer;
+		info.offset        = offset;
+		info.range         = range;
+		resource_set.dirty = true;
+	}
+
+	void bind_image(const vkb::core::ImageView &image_view, const vkb::core::Sampler &sampler, uint32_t set, uint32_t binding, uint32_t array_element)
+	{
+		auto &resource_set = sets[set];
+		auto &info         = resource_set.bindings[binding][array_element];
+		info.dirty         = true;
+		info.image_view    = &image_view;
+		info.sampler       = &sampler;
+		resource_set.dirty = true;
+	}
+
+	/**
+	 * @return The number of resources the flush writes
+	 */
+	uint32_t flush()
+	{
+		uint32_t write_count = 0;
+		for (auto &[set, resource_set] : sets)
+		{
+			if (!resource_set.dirty)
+			{
+				continue;
+			}
+			for (auto &[binding, elements] : resource_set.bindings)
+			{
+				write_count += static_cast<uint32_t>(elements.size());
+			}
+			resource_set.dirty = false;
+		}
+		return write_count;
+	}
+
+  private:
+	struct ResourceSet
+	{
+		bool dirty{false};
+
+		std::unordered_map<uint32_t, std::unordered_map<uint32_t, vkb::ResourceInfo>> bindings;
+	};
+
+	std::unordered_map<uint32_t, ResourceSet> sets;
+};
+
+/**
+ * @brief Walks the dirty bindings of the dirty sets, as CommandBuffer::flush_descriptor_state_impl does
+ * @return The number of resources the flush writes
+ */
+uint32_t flush(vkb::ResourceBindingState &state)
+{
+	uint32_t write_count = 0;
+	for (uint32_t sets = state.get_dirty_sets(); sets != 0; sets &= sets - 1)
+	{
+		auto &resource_set = state.get_resource_set(std::countr_zero(sets));
+		for (uint32_t bindings = resource_set.get_dirty_bindings(); bindings != 0; bindings &= bindings - 1)
+		{
+			write_count += static_cast<uint32_t>(resource_set.get_resources(std::countr_zero(bindings)).size());
+		}
+	}
+	state.clear_dirty();
+	return write_count;
+}
+
+/**
+ * @brief The bindings of a typical draw: a per-frame uniform buffer, a per-draw dynamic uniform buffer,
+ *        and the three textures of a material
+ */
+template <typename State>
+void bind_draw(State &state, const MockResources &resources, uint32_t draw)
+{
+	state.bind_buffer(resources.get_buffer(1), (draw % 256) * 256, 256, 0, 1, 0);
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		state.bind_image(resources.get_image_view((draw + i) % 3), resources.get_sampler(), 1, i, 0);
+	}
+}
+
+template <typename Function>
+bool throws_out_of_range(Function &&function)
+{
+	try
+	{
+		function();
+	}
+	catch (const std::out_of_range &)
+	{
+		return true;
+	}
+	return false;
+}
+}        // namespace
+
+BENCH_CASE(resource_binding_state)
+{
+	MockResources resources{};
+
+	vkb::ResourceBindingState state;
+	state.bind_buffer(resources.get_buffer(0), 0, 64, 0, 0, 0);
+	bind_draw(state, resources, 0);
+
+	// Masks of the bound and changed sets and bindings
+	BENCH_CHECK(state.get_bound_sets() == 0b11 && state.get_dirty_sets() == 0b11);
+	BENCH_CHECK(state.get_resource_set(0).get_bound_bindings() == 0b11);
+	BENCH_CHECK(state.get_resource_set(1).get_bound_bindings() == 0b111);
+	BENCH_CHECK(state.get_resource_set(1).get_resources(2)[0].image_view == &resources.get_image_view(2));
+	BENCH_CHECK(flush(state) == 5);
+
+	// Only what changed since the last flush is written again
+	state.bind_buffer(resources.get_buffer(1), 256, 256, 0, 1, 0);
+	BENCH_CHECK(state.get_dirty_sets() == 0b01);
+	BENCH_CHECK(state.get_resource_set(0).get_dirty_bindings() == 0b10);
+	BENCH_CHECK(flush(state) == 1);
+	BENCH_CHECK(!state.is_dirty());
+
+	// Binding an array element grows the binding up to it, leaving the elements before it empty
+	state.bind_image(resources.get_image_view(0), resources.get_sampler(), 2, 4, 3);
+	BENCH_CHECK(state.get_resource_set(2).get_resources(4).size() == 4);
+	BENCH_CHECK(state.get_resource_set(2).get_resources(4)[3].dirty);
+	BENCH_CHECK(state.get_resource_set(2).get_resources(4)[0].image_view == nullptr);
+
+	// A reset forgets the resources but keeps the storage, so binding them again doesn't allocate
+	auto storage = state.get_resource_set(1).get_resources(2).data();
+	state.reset();
+	BENCH_CHECK(state.get_bound_sets() == 0 && !state.is_dirty());
+	BENCH_CHECK(state.get_resource_set(1).get_resources(2).empty());
+	bind_draw(state, resources, 1);
+	BENCH_CHECK(state.get_resource_set(1).get_resources(2).data() == storage);
+
+	// Sets and bindings past the masks are rejected in every build type, without marking anything bound
+	state.reset();
+	BENCH_CHECK(throws_out_of_range([&]() { state.bind_buffer(resources.get_buffer(0), 0, 64, vkb::MAX_BOUND_DESCRIPTOR_SETS, 0, 0); }));
+	BENCH_CHECK(throws_out_of_range([&]() { state.bind_image(resources.get_image_view(0), 0, vkb::MAX_RESOURCE_BINDINGS, 0); }));
+	BENCH_CHECK(throws_out_of_range([&]() { state.get_resource_set(vkb::MAX_BOUND_DESCRIPTOR_SETS); }));
+	BENCH_CHECK(throws_out_of_range([&]() { state.get_resource_set(0).get_resources(vkb::MAX_RESOURCE_BINDINGS); }));
+	BENCH_CHECK(state.get_bound_sets() == 0b00);
+	BENCH_CHECK(state.get_resource_set(0).get_bound_bindings() == 0);
+
+	// A frame of 1000 draws, starting from a reset command buffer
+	const uint32_t draw_count = 1000;
+
+	double flat_time = context.measure("ResourceBindingState bind and flush, per draw", draw_count, [&]() {
+		state.reset();
+		state.bind_buffer(resources.get_buffer(0), 0, 64, 0, 0, 0);
+
+		uint32_t write_count = 0;
+		for (uint32_t draw = 0; draw < draw_count; ++draw)
+		{
+			bind_draw(state, resources, draw);
+			write_count += flush(state);
+		}
+		vkb::bench::do_not_optimize(write_count);
+	});
+
+	MapBindingState map_state;
+
+	double map_time = context.measure("map based binding state bind and flush, per draw", draw_count, [&]() {
+		map_state.reset();
+		map_state.bind_buffer(resources.get_buffer(0), 0, 64, 0, 0, 0);
+
+		uint32_t write_count = 0;
+		for (uint32_t draw = 0; draw < draw_count; ++draw)
+		{
+			bind_draw(map_state, resources, draw);
+			write_count += map_state.flush();
+		}
+		vkb::bench::do_not_optimize(write_count);
+	});
+
+	context.report("map based time over ResourceBindingState time", map_time / flat_time, "x");
+}
@@ -0,0 +1,285 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <core/util/thread_pool.hpp>
+
+#include "common/glm_common.h"
+#include "geometry/frustum.h"
+#include "geometry/frustum_culler.h"
+#include "scene_graph/components/aabb.h"
+
+namespace
+{
+struct Box
+{
+	glm::vec3 min;
+
+	glm::vec3 max;
+
+	glm::mat4 transform;
+};
+
+/**
+ * @brief Boxes of random sizes, rotations, scales and positions around the origin
+ */
+std::vector<Box> make_boxes(size_t count, uint32_t seed)
+{
+	std::mt19937                          random{seed};
+	std::uniform_real_distribution<float> position{-100.0f, 100.0f};
+	std::uniform_real_distribution<float> size{0.1f, 5.0f};
+	std::uniform_real_distribution<float> angle{0.0f, 6.2831853f};
+	std::uniform_real_distribution<float> scale{0.25f, 4.0f};
+
+	std::vector<Box> boxes(count);
+	for (auto &box : boxes)
+	{
+		glm::vec3 half_size{size(random), size(random), size(random)};
+		glm::vec3 offset{position(random) * 0.01f, position(random) * 0.01f, position(random) * 0.01f};
+
+		box.min = offset - half_size;
+		box.max = offset + half_size;
+
+		// Negative scales mirror the box, which the transform of the bounds must handle too
+		glm::vec3 box_scale{scale(random), scale(random), scale(random)};
+		if (random() % 4 == 0)
+		{
+			box_scale.x = -box_scale.x;
+		}
+
+		box.transform = glm::translate(glm::vec3{position(random), position(random), position(random)}) *
+		                glm::rotate(angle(random), glm::normalize(glm::vec3{position(random), position(random), position(random)} + glm::vec3{0.0f, 0.0f, 0.001f})) *
+		                glm::scale(box_scale);
+	}
+	return boxes;
+}
+
+/**
+ * @brief The world space bounds of a box, from its eight transformed corners
+ */
+void transform_corners(const Box &box, glm::vec3 &world_min, glm::vec3 &world_max)
+{
+	world_min = glm::vec3{std::numeric_limits<float>::max()};
+	world_max = glm::vec3{std::numeric_limits<float>::lowest()};
+
+	for (uint32_t corner = 0; corner < 8; ++corner)
+	{
+		glm::vec3 local{corner & 1 ? box.max.x : box.min.x, corner & 2 ? box.max.y : box.min.y, corner & 4 ? box.max.z : box.min.z};
+		glm::vec3 world = box.transform * glm::vec4(local, 1.0f);
+
+		world_min = glm::min(world_min, world);
+		world_max = glm::max(world_max, world);
+	}
+}
+
+enum class Visibility
+{
+	Culled,
+	Visible,
+	Borderline
+};
+
+/**
+ * @brief Tests the world bounds of a box against each plane by testing all its corners.
+ *        Boxes within a rounding error of a plane are borderline, either answer is right for them.
+ */
+Visibility test_corners(const std::array<glm::vec4, 6> &planes, const glm::vec3 &world_min, const glm::vec3 &world_max)
+{
+	constexpr float tolerance = 1e-2f;
+
+	bool borderline = false;
+	for (auto &plane : planes)
+	{
+		float max_distance = std::numeric_limits<float>::lowest();
+		for (uint32_t corner = 0; corner < 8; ++corner)
+		{
+			glm::vec3 point{corner & 1 ? world_max.x : world_min.x, corner & 2 ? world_max.y : world_min.y, corner & 4 ? world_max.z : world_min.z};
+			max_distance = std::max(max_distance, glm::dot(glm::vec3(plane), point) + plane.w);
+		}
+
+		if (max_distance < -tolerance)
+		{
+			return Visibility::Culled;
+		}
+		borderline |= max_distance <= tolerance;
+	}
+	return borderline ? Visibility::Borderline : Visibility::Visible;
+}
+
+glm::mat4 make_view_projection(const glm::vec3 &camera_position)
+{
+	return glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f) * glm::lookAt(camera_position, glm::vec3{10.0f, 5.0f, 0.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+}
+}        // namespace
+
+BENCH_CASE(aabb_transform)
+{
+	auto boxes = make_boxes(10000, 1);
+
+	uint32_t mismatch_count = 0;
+	for (auto &box : boxes)
+	{
+		vkb::sg::AABB aabb{box.min, box.max};
+		aabb.transform(box.transform);
+
+		glm::vec3 world_min, world_max;
+		transform_corners(box, world_min, world_max);
+
+		// The bounds must be exactly those of the transformed corners, up to rounding
+		float tolerance = 1e-4f * (1.0f + glm::length(world_max - world_min) + glm::length(glm::vec3(box.transform[3])));
+		if (glm::any(glm::greaterThan(glm::abs(aabb.get_min() - world_min), glm::vec3{tolerance})) ||
+		    glm::any(glm::greaterThan(glm::abs(aabb.get_max() - world_max), glm::vec3{tolerance})))
+		{
+			++mismatch_count;
+		}
+	}
+	BENCH_CHECK(mismatch_count == 0);
+
+	// An empty box stays empty
+	vkb::sg::AABB empty;
+	glm::mat4     translation = glm::translate(glm::vec3{1.0f, 2.0f, 3.0f});
+	empty.transform(translation);
+	BENCH_CHECK(empty.is_empty());
+
+	size_t box_index = 0;
+	context.measure("AABB::transform, per box", 1, [&]() {
+		auto         &box = boxes[box_index];
+		vkb::sg::AABB aabb{box.min, box.max};
+		aabb.transform(box.transform);
+		vkb::bench::do_not_optimize(aabb);
+		box_index = (box_index + 1) % boxes.size();
+	});
+}
+
+BENCH_CASE(frustum_culling)
+{
+	const glm::vec3 camera_position{-20.0f, 10.0f, 30.0f};
+	const glm::mat4 view_projection = make_view_projection(camera_position);
+
+	vkb::Frustum frustum;
+	frustum.update(view_projection);
+
+	auto boxes = make_boxes(20000, 2);
+
+	vkb::FrustumCuller culler;
+	for (auto &box : boxes)
+	{
+		culler.add(box.min, box.max, box.transform);
+	}
+	uint32_t always_visible = culler.add_always_visible();
+
+	culler.cull(view_projection, camera_position);
+
+	// The culler must give the same answer as testing the corners of each box against each plane
+	uint32_t mismatch_count = 0;
+	uint32_t visible_count  = 0;
+	for (uint32_t i = 0; i < boxes.size(); ++i)
+	{
+		glm::vec3 world_min, world_max;
+		transform_corners(boxes[i], world_min, world_max);
+
+		auto expected = test_corners(frustum.get_planes(), world_min, world_max);
+		if (expected != Visibility::Borderline && culler.is_visible(i) != (expected == Visibility::Visible))
+		{
+			++mismatch_count;
+		}
+		visible_count += culler.is_visible(i) ? 1 : 0;
+	}
+
+	BENCH_CHECK(mismatch_count == 0);
+	BENCH_CHECK(culler.is_visible(always_visible));
+	BENCH_CHECK(culler.get_visible_count() == visible_count + 1);
+
+	// Some boxes are in view and some are not, otherwise the test above proves little
+	BENCH_CHECK(visible_count > 0 && visible_count < boxes.size());
+
+	// Splitting the boxes across workers doesn't change the result
+	vkb::ThreadPool thread_pool{4};
+	{
+		vkb::FrustumCuller threaded_culler;
+		threaded_culler.set_thread_pool(&thread_pool);
+		for (auto &box : boxes)
+		{
+			threaded_culler.add(box.min, box.max, box.transform);
+		}
+		threaded_culler.cull(view_projection, camera_position);
+
+		uint32_t threaded_mismatch_count = 0;
+		for (uint32_t i = 0; i < boxes.size(); ++i)
+		{
+			threaded_mismatch_count += threaded_culler.is_visible(i) != culler.is_visible(i) ? 1 : 0;
+		}
+		BENCH_CHECK(threaded_mismatch_count == 0);
+	}
+
+	// The distance threshold culls the boxes whose bounding sphere is entirely further away
+	{
+		const float max_distance = 60.0f;
+
+		culler.set_max_distance(max_distance);
+		culler.cull(view_projection, camera_position);
+
+		uint32_t distance_mismatch_count = 0;
+		for (uint32_t i = 0; i < boxes.size(); ++i)
+		{
+			glm::vec3 world_min, world_max;
+			transform_corners(boxes[i], world_min, world_max);
+
+			auto  expected = test_corners(frustum.get_planes(), world_min, world_max);
+			float distance = glm::length((world_min + world_max) * 0.5f - camera_position) - glm::length(world_max - world_min) * 0.5f;
+			if (expected != Visibility::Borderline && std::abs(distance - max_distance) > 1e-2f &&
+			    culler.is_visible(i) != (expected == Visibility::Visible && distance <= max_distance))
+			{
+				++distance_mismatch_count;
+			}
+		}
+		BENCH_CHECK(distance_mismatch_count == 0);
+
+		culler.set_max_distance(0.0f);
+	}
+
+	context.report("visible boxes", static_cast<double>(visible_count), "boxes");
+
+	context.measure("FrustumCuller::cull, 20000 boxes, per box", boxes.size(), [&]() {
+		culler.cull(view_projection, camera_position);
+		vkb::bench::do_not_optimize(culler.get_visible_count());
+	});
+
+	culler.set_thread_pool(&thread_pool);
+	context.measure("FrustumCuller::cull on 4 workers, 20000 boxes, per box", boxes.size(), [&]() {
+		culler.cull(view_projection, camera_position);
+		vkb::bench::do_not_optimize(culler.get_visible_count());
+	});
+
+	// The reference the culler replaces: the bounds of each box, then a sphere test per box
+	context.measure("AABB::transform and Frustum::check_sphere, per box", boxes.size(), [&]() {
+		uint32_t count = 0;
+		for (auto &box : boxes)
+		{
+			vkb::sg::AABB aabb{box.min, box.max};
+			aabb.transform(box.transform);
+			count += frustum.check_sphere(aabb.get_center(), glm::length(aabb.get_scale()) * 0.5f) ? 1 : 0;
+		}
+		vkb::bench::do_not_optimize(count);
+	});
+}
@@ -0,0 +1,217 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <cmath>
+#include <map>
+#include <random>
+
+#include "rendering/draw_key.h"
+
+namespace
+{
+using namespace vkb::rendering;
+
+struct Draw
+{
+	float distance;
+
+	uint16_t pipeline_bits;
+
+	uint16_t material_bits;
+};
+
+/**
+ * @brief Random draws, with distinct distances unless duplicates are requested, and a few pipelines and materials
+ */
+std::vector<Draw> make_draws(size_t count, uint32_t pipeline_count, uint32_t material_count, bool duplicate_distances, uint32_t seed)
+{
+	std::mt19937                          random{seed};
+	std::uniform_real_distribution<float> distance_distribution{0.0f, 10000.0f};
+
+	std::vector<Draw> draws(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		draws[i].distance      = duplicate_distances ? static_cast<float>(random() % 64) : distance_distribution(random);
+		draws[i].pipeline_bits = static_cast<uint16_t>(random() % pipeline_count);
+		draws[i].material_bits = static_cast<uint16_t>(random() % material_count);
+	}
+	return draws;
+}
+
+/**
+ * @brief The order GeometrySubpass drew opaque draws in before draw keys: a multimap on distance, iterated forward
+ */
+std::vector<uint32_t> multimap_front_to_back(const std::vector<Draw> &draws)
+{
+	std::multimap<float, uint32_t> sorted;
+	for (uint32_t i = 0; i < draws.size(); ++i)
+	{
+		sorted.emplace(draws[i].distance, i);
+	}
+
+	std::vector<uint32_t> order;
+	for (auto &entry : sorted)
+	{
+		order.push_back(entry.second);
+	}
+	return order;
+}
+
+/**
+ * @brief The order GeometrySubpass drew blended draws in before draw keys: a multimap on distance, iterated backwards
+ */
+std::vector<uint32_t> multimap_back_to_front(const std::vector<Draw> &draws)
+{
+	std::multimap<float, uint32_t> sorted;
+	for (uint32_t i = 0; i < draws.size(); ++i)
+	{
+		sorted.emplace(draws[i].distance, i);
+	}
+
+	std::vector<uint32_t> order;
+	for (auto entry = sorted.rbegin(); entry != sorted.rend(); ++entry)
+	{
+		order.push_back(entry->second);
+	}
+	return order;
+}
+
+std::vector<uint32_t> radix_order(std::vector<DrawKey> &keys, std::vector<DrawKey> &scratch)
+{
+	sort_draw_keys(keys, scratch);
+
+	std::vector<uint32_t> order;
+	for (auto &draw_key : keys)
+	{
+		order.push_back(draw_key.index);
+	}
+	return order;
+}
+
+std::vector<DrawKey> make_opaque_keys(const std::vector<Draw> &draws)
+{
+	std::vector<DrawKey> keys;
+	for (uint32_t i = 0; i < draws.size(); ++i)
+	{
+		keys.push_back({make_opaque_draw_key(draws[i].pipeline_bits, draws[i].material_bits, draws[i].distance), i});
+	}
+	return keys;
+}
+
+std::vector<DrawKey> make_transparent_keys(const std::vector<Draw> &draws)
+{
+	std::vector<DrawKey> keys;
+	for (uint32_t i = 0; i < draws.size(); ++i)
+	{
+		keys.push_back({make_transparent_draw_key(draws[i].distance), i});
+	}
+	return keys;
+}
+}        // namespace
+
+BENCH_CASE(draw_key_order)
+{
+	std::vector<DrawKey> scratch;
+
+	// With a single pipeline and material, opaque draws come out in the multimap order, ties included as both are stable
+	for (bool duplicate_distances : {false, true})
+	{
+		auto draws = make_draws(5000, 1, 1, duplicate_distances, 1);
+		auto keys  = make_opaque_keys(draws);
+		BENCH_CHECK(radix_order(keys, scratch) == multimap_front_to_back(draws));
+	}
+
+	// Blended draws come out in the reversed multimap order. Ties keep their submission order rather than being reversed.
+	{
+		auto draws = make_draws(5000, 1, 1, false, 2);
+		auto keys  = make_transparent_keys(draws);
+		BENCH_CHECK(radix_order(keys, scratch) == multimap_back_to_front(draws));
+	}
+
+	// With several pipelines and materials, draws are grouped by pipeline then material,
+	// and each group is in the multimap order of its own draws
+	{
+		auto draws = make_draws(20000, 8, 32, false, 3);
+		auto keys  = make_opaque_keys(draws);
+		auto order = radix_order(keys, scratch);
+
+		BENCH_CHECK(order.size() == draws.size());
+
+		std::map<uint32_t, std::vector<Draw>>     group_draws;
+		std::map<uint32_t, std::vector<uint32_t>> group_indices;
+		for (uint32_t i = 0; i < draws.size(); ++i)
+		{
+			uint32_t group = (static_cast<uint32_t>(draws[i].pipeline_bits) << 16) | draws[i].material_bits;
+			group_draws[group].push_back(draws[i]);
+			group_indices[group].push_back(i);
+		}
+
+		size_t position = 0;
+		for (auto &[group, group_draw_list] : group_draws)
+		{
+			auto &indices = group_indices[group];
+			for (auto local_index : multimap_front_to_back(group_draw_list))
+			{
+				BENCH_CHECK(position < order.size() && order[position] == indices[local_index]);
+				++position;
+			}
+		}
+	}
+
+	// Distances only differing in their last float bit still sort
+	{
+		std::vector<Draw> draws{{1.0f, 0, 0}, {std::nextafter(1.0f, 2.0f), 0, 0}, {0.0f, 0, 0}, {-0.0f, 0, 0}};
+		auto              keys  = make_opaque_keys(draws);
+		auto              order = radix_order(keys, scratch);
+		BENCH_CHECK(order == (std::vector<uint32_t>{2, 3, 0, 1}));
+	}
+}
+
+BENCH_CASE(draw_key_sort)
+{
+	auto draws = make_draws(10000, 8, 64, false, 4);
+	auto keys  = make_opaque_keys(draws);
+
+	std::vector<DrawKey> sorted;
+	std::vector<DrawKey> scratch;
+
+	double radix_time = context.measure("radix sort, 10000 opaque draws, per draw", draws.size(), [&]() {
+		sorted = keys;
+		sort_draw_keys(sorted, scratch);
+		vkb::bench::do_not_optimize(sorted.front());
+	});
+
+	// What GeometrySubpass did every frame before draw keys: fill a multimap, which allocates a node per draw, and walk it
+	double multimap_time = context.measure("multimap, 10000 opaque draws, per draw", draws.size(), [&]() {
+		std::multimap<float, uint32_t> sorted_draws;
+		for (uint32_t i = 0; i < draws.size(); ++i)
+		{
+			sorted_draws.emplace(draws[i].distance, i);
+		}
+
+		uint32_t checksum = 0;
+		for (auto &entry : sorted_draws)
+		{
+			checksum = checksum * 31 + entry.second;
+		}
+		vkb::bench::do_not_optimize(checksum);
+	});
+
+	context.report("multimap time over radix sort time", multimap_time / radix_time, "x");
+}
@@ -0,0 +1,289 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+
+#include <core/util/hash.hpp>
+
+#include "common/resource_caching.h"
+
+namespace
+{
+struct RenderPassKey
+{
+	std::vector<vkb::Attachment> attachments;
+
+	std::vector<vkb::LoadStoreInfo> load_store_infos;
+
+	std::vector<vkb::SubpassInfo> subpasses;
+};
+
+/**
+ * @return The key the ResourceCache looks a render pass up with, see ResourceCache::request_render_pass
+ */
+size_t hash_render_pass_key(const RenderPassKey &key)
+{
+	size_t hash = 0;
+	vkb::hash_param(hash, key.attachments, key.load_store_infos, key.subpasses);
+	return hash;
+}
+
+/**
+ * @brief Every combination of a few attachment formats, sample counts, load and store operations and subpass layouts,
+ *        all of which are distinct render passes
+ */
+std::vector<RenderPassKey> make_render_pass_keys()
+{
+	const VkFormat              color_formats[] = {VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_R8G8B8A8_SRGB, VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_R16G16B16A16_SFLOAT};
+	const VkFormat              depth_formats[] = {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D24_UNORM_S8_UINT};
+	const VkSampleCountFlagBits sample_counts[] = {VK_SAMPLE_COUNT_1_BIT, VK_SAMPLE_COUNT_4_BIT};
+	const VkAttachmentLoadOp    load_ops[]      = {VK_ATTACHMENT_LOAD_OP_LOAD, VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_LOAD_OP_DONT_CARE};
+	const VkAttachmentStoreOp   store_ops[]     = {VK_ATTACHMENT_STORE_OP_STORE, VK_ATTACHMENT_STORE_OP_DONT_CARE};
+
+	std::vector<RenderPassKey> keys;
+	for (auto color_format : color_formats)
+	{
+		for (auto depth_format : depth_formats)
+		{
+			for (auto samples : sample_counts)
+			{
+				for (auto color_load_op : load_ops)
+				{
+					for (auto color_store_op : store_ops)
+					{
+						for (auto depth_load_op : load_ops)
+						{
+							for (auto depth_store_op : store_ops)
+							{
+								for (uint32_t subpass_count = 1; subpass_count <= 3; ++subpass_count)
+								{
+									RenderPassKey key;
+									key.attachments      = {{color_format, samples, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT},
+									                        {depth_format, samples, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT}};
+									key.load_store_infos = {{color_load_op, color_store_op}, {depth_load_op, depth_store_op}};
+									for (uint32_t subpass = 0; subpass < subpass_count; ++subpass)
+									{
+										key.subpasses.push_back({{}, {0}, {}, subpass != 0, 0, VK_RESOLVE_MODE_NONE, ""});
+									}
+									keys.push_back(std::move(key));
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return keys;
+}
+
+/**
+ * @return The number of values equal to another one, after keeping only the bits of the mask
+ */
+size_t count_collisions(std::vector<uint64_t> values, uint64_t mask)
+{
+	for (auto &value : values)
+	{
+		value &= mask;
+	}
+	std::sort(values.begin(), values.end());
+
+	size_t collisions = 0;
+	for (size_t i = 1; i < values.size(); ++i)
+	{
+		collisions += values[i] == values[i - 1] ? 1 : 0;
+	}
+	return collisions;
+}
+
+/**
+ * @return Whether all the values differ, none of them being zero
+ */
+bool are_distinct_and_non_zero(const std::vector<size_t> &values)
+{
+	std::unordered_set<size_t> distinct{values.begin(), values.end()};
+	return distinct.size() == values.size() && distinct.count(0) == 0;
+}
+}        // namespace
+
+BENCH_CASE(hash_zero_operands)
+{
+	// A zero seed still gives distinct keys for distinct hashes, zero included
+	{
+		std::vector<size_t> keys;
+		for (size_t hash = 0; hash < 4096; ++hash)
+		{
+			size_t seed = 0;
+			vkb::hash_combine(seed, hash);
+			keys.push_back(seed);
+		}
+		BENCH_CHECK(are_distinct_and_non_zero(keys));
+	}
+
+	// Combining a zero hash still depends on the seed, so a zero field can't make keys that differ elsewhere equal
+	{
+		std::vector<size_t> keys;
+		for (size_t seed = 0; seed < 4096; ++seed)
+		{
+			size_t key = seed;
+			vkb::hash_combine(key, size_t{0});
+			keys.push_back(key);
+		}
+		BENCH_CHECK(are_distinct_and_non_zero(keys));
+	}
+
+	// Operands that cancel the secrets zero one side of the multiplication, the other input must still count
+	if constexpr (sizeof(size_t) == sizeof(uint64_t))
+	{
+		std::vector<size_t> seed_cancelled;
+		std::vector<size_t> hash_cancelled;
+		for (size_t value = 0; value < 4096; ++value)
+		{
+			size_t seed = static_cast<size_t>(vkb::hash_detail::SECRET[0]);
+			vkb::hash_combine(seed, value);
+			seed_cancelled.push_back(seed);
+
+			size_t key = value;
+			vkb::hash_combine(key, static_cast<size_t>(vkb::hash_detail::SECRET[1]));
+			hash_cancelled.push_back(key);
+		}
+		BENCH_CHECK(are_distinct_and_non_zero(seed_cancelled));
+		BENCH_CHECK(are_distinct_and_non_zero(hash_cancelled));
+	}
+
+	// Runs of zero bytes hash differently for every length, and differently for every seed
+	{
+		std::vector<uint8_t> zeros(256, 0);
+		std::vector<size_t>  by_length;
+		std::vector<size_t>  by_seed;
+		for (size_t i = 0; i <= zeros.size(); ++i)
+		{
+			by_length.push_back(static_cast<size_t>(vkb::hash_bytes(zeros.data(), i)));
+			by_seed.push_back(static_cast<size_t>(vkb::hash_bytes(zeros.data(), 64, i)));
+		}
+		BENCH_CHECK(are_distinct_and_non_zero(by_length));
+		BENCH_CHECK(are_distinct_and_non_zero(by_seed));
+	}
+}
+
+BENCH_CASE(hash_collisions)
+{
+	// Keys made of a few small fields, like the Vulkan state the cache hashes, combined field by field
+	const uint32_t field_range = context.is_quick() ? 16 : 32;
+
+	std::vector<uint64_t> keys;
+	for (uint32_t a = 0; a < field_range; ++a)
+	{
+		for (uint32_t b = 0; b < field_range; ++b)
+		{
+			for (uint32_t c = 0; c < field_range; ++c)
+			{
+				for (uint32_t d = 0; d < field_range; ++d)
+				{
+					size_t key = 0;
+					vkb::hash_combine(key, a);
+					vkb::hash_combine(key, b);
+					vkb::hash_combine(key, c);
+					vkb::hash_combine(key, d);
+					keys.push_back(key);
+				}
+			}
+		}
+	}
+
+	BENCH_CHECK(count_collisions(keys, ~uint64_t{0}) == 0);
+
+	// A good hash collides on 32 of its bits as often as random values do, whichever half is kept
+	double count    = static_cast<double>(keys.size());
+	double expected = count * (count - 1) / 2.0 / 4294967296.0;
+
+	auto low_collisions  = count_collisions(keys, 0xFFFFFFFFull);
+	auto high_collisions = count_collisions(keys, 0xFFFFFFFF00000000ull);
+
+	BENCH_CHECK(low_collisions <= 2 * expected + 16);
+	BENCH_CHECK(high_collisions <= 2 * expected + 16);
+
+	context.report("keys", count, "keys");
+	context.report("collisions on the low 32 bits", static_cast<double>(low_collisions), "keys");
+	context.report("collisions on the high 32 bits", static_cast<double>(high_collisions), "keys");
+	context.report("collisions expected of random 32-bit values", expected, "keys");
+}
+
+BENCH_CASE(hash_throughput)
+{
+	std::vector<uint8_t> data(64 * 1024);
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<uint8_t>(i * 131 + (i >> 8));
+	}
+
+	for (size_t size : {16, 64, 1024, 64 * 1024})
+	{
+		auto name = std::to_string(size) + " bytes, per byte";
+
+		context.measure("hash_bytes, " + name, size, [&]() {
+			vkb::bench::do_not_optimize(vkb::hash_bytes(data.data(), size));
+		});
+
+		// What the framework hashed blobs with before hash_bytes, without the std::string copy it also made
+		std::string_view view{reinterpret_cast<const char *>(data.data()), size};
+		context.measure("std::hash<std::string_view>, " + name, size, [&]() {
+			vkb::bench::do_not_optimize(std::hash<std::string_view>{}(view));
+		});
+	}
+
+	size_t seed  = 0;
+	size_t value = 0;
+	context.measure("hash_combine, per call", 1, [&]() {
+		vkb::hash_combine(seed, value++);
+		vkb::bench::do_not_optimize(seed);
+	});
+}
+
+BENCH_CASE(resource_cache_key_hashing)
+{
+	auto keys = make_render_pass_keys();
+
+	std::unordered_set<size_t> hashes;
+	for (auto &key : keys)
+	{
+		hashes.insert(hash_render_pass_key(key));
+	}
+
+	// Distinct render passes must not share a key, as the cache would hand out the wrong one
+	BENCH_CHECK(hashes.size() == keys.size());
+
+	// Equal render passes must share a key, or the cache would create a render pass per request
+	auto copy = keys[keys.size() / 2];
+	BENCH_CHECK(hash_render_pass_key(copy) == hash_render_pass_key(keys[keys.size() / 2]));
+
+	// Changing a single field changes the key
+	copy.load_store_infos[1].store_op = copy.load_store_infos[1].store_op == VK_ATTACHMENT_STORE_OP_STORE ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+	BENCH_CHECK(hash_render_pass_key(copy) != hash_render_pass_key(keys[keys.size() / 2]));
+
+	context.report("distinct render pass keys", static_cast<double>(keys.size()), "keys");
+
+	size_t key_index = 0;
+	context.measure("render pass key hash, per key", 1, [&]() {
+		vkb::bench::do_not_optimize(hash_render_pass_key(keys[key_index]));
+		key_index = (key_index + 1) % keys.size();
+	});
+}
@@ -0,0 +1,405 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+#include <core/util/thread_pool.hpp>
+
+#include "scene_graph/components/image/mip_generator.h"
+#include "scene_graph/components/image/stb.h"
+
+namespace
+{
+/**
+ * @brief RGBA8 pixels with smooth gradients and some noise, so that every level of the mip chain differs
+ */
+std::vector<uint8_t> make_pixels(uint32_t width, uint32_t height, uint32_t seed)
+{
+	std::mt19937 random{seed};
+
+	std::vector<uint8_t> pixels(size_t(width) * height * 4);
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			uint8_t *texel = &pixels[(size_t(y) * width + x) * 4];
+			texel[0]       = static_cast<uint8_t>(x * 255 / std::max(1u, width - 1));
+			texel[1]       = static_cast<uint8_t>(y * 255 / std::max(1u, height - 1));
+			texel[2]       = static_cast<uint8_t>(random());
+			texel[3]       = static_cast<uint8_t>(128 + random() % 128);
+		}
+	}
+	return pixels;
+}
+
+void append_u32(std::vector<uint8_t> &bytes, uint32_t value)
+{
+	bytes.push_back(static_cast<uint8_t>(value >> 24));
+	bytes.push_back(static_cast<uint8_t>(value >> 16));
+	bytes.push_back(static_cast<uint8_t>(value >> 8));
+	bytes.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t crc32(const uint8_t *data, size_t size)
+{
+	uint32_t crc = 0xFFFFFFFFu;
+	for (size_t i = 0; i < size; ++i)
+	{
+		crc ^= data[i];
+		for (uint32_t bit = 0; bit < 8; ++bit)
+		{
+			crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+		}
+	}
+	return ~crc;
+}
+
+void append_chunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data)
+{
+	append_u32(png, static_cast<uint32_t>(data.size()));
+
+	size_t type_offset = png.size();
+	png.insert(png.end(), type, type + 4);
+	png.insert(png.end(), data.begin(), data.end());
+
+	append_u32(png, crc32(png.data() + type_offset, png.size() - type_offset));
+}
+
+/**
+ * @brief Encodes RGBA8 pixels as a PNG, without filters and with uncompressed deflate blocks.
+ *        That is enough for the decoder to go through its whole PNG path, without a PNG encoder in the tree.
+ */
+std::vector<uint8_t> encode_png(const std::vector<uint8_t> &pixels, uint32_t width, uint32_t height)
+{
+	std::vector<uint8_t> rows;
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		rows.push_back(0);        // No filter
+		auto row = pixels.begin() + size_t(y) * width * 4;
+		rows.insert(rows.end(), row, row + size_t(width) * 4);
+	}
+
+	// A zlib stream of stored blocks, followed by the Adler-32 of the rows
+	std::vector<uint8_t> idat{0x78, 0x01};
+	for (size_t offset = 0; offset < rows.size(); offset += 65535)
+	{
+		auto size = static_cast<uint16_t>(std::min<size_t>(65535, rows.size() - offset));
+
+		idat.push_back(offset + size == rows.size() ? 1 : 0);
+		idat.push_back(static_cast<uint8_t>(size));
+		idat.push_back(static_cast<uint8_t>(size >> 8));
+		idat.push_back(static_cast<uint8_t>(~size));
+		idat.push_back(static_cast<uint8_t>(~size >> 8));
+		idat.insert(idat.end(), rows.begin() + offset, rows.begin() + offset + size);
+	}
+
+	uint32_t a = 1;
+	uint32_t b = 0;
+	for (auto byte : rows)
+	{
+		a = (a + byte) % 65521;
+		b = (b + a) % 65521;
+	}
+	append_u32(idat, (b << 16) | a);
+
+	std::vector<uint8_t> ihdr;
+	append_u32(ihdr, width);
+	append_u32(ihdr, height);
+	ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0});        // 8 bits per channel, RGBA, no interlacing
+
+	std::vector<uint8_t> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	append_chunk(png, "IHDR", ihdr);
+	append_chunk(png, "IDAT", idat);
+	append_chunk(png, "IEND", {});
+	return png;
+}
+
+double srgb_to_linear(double srgb)
+{
+	return srgb <= 0.04045 ? srgb / 12.92 : std::pow((srgb + 0.055) / 1.055, 2.4);
+}
+
+double linear_to_srgb(double linear)
+{
+	return linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+}
+
+/**
+ * @brief Halves a level with a 2x2 box filter in double precision
+ */
+std::vector<uint8_t> downsample_reference(const uint8_t *src, uint32_t width, uint32_t height, bool srgb)
+{
+	uint32_t next_width  = std::max(1u, width / 2);
+	uint32_t next_height = std::max(1u, height / 2);
+
+	std::vector<uint8_t> dst(size_t(next_width) * next_height * 4);
+	for (uint32_t y = 0; y < next_height; ++y)
+	{
+		for (uint32_t x = 0; x < next_width; ++x)
+		{
+			for (uint32_t c = 0; c < 4; ++c)
+			{
+				double sum = 0.0;
+				for (uint32_t dy = 0; dy < 2; ++dy)
+				{
+					for (uint32_t dx = 0; dx < 2; ++dx)
+					{
+						uint32_t sx    = std::min(x * 2 + dx, width - 1);
+						uint32_t sy    = std::min(y * 2 + dy, height - 1);
+						double   value = src[(size_t(sy) * width + sx) * 4 + c] / 255.0;
+						sum += srgb && c < 3 ? srgb_to_linear(value) : value;
+					}
+				}
+
+				double average = sum / 4.0;
+				if (srgb && c < 3)
+				{
+					average = linear_to_srgb(average);
+				}
+				dst[(size_t(y) * next_width + x) * 4 + c] = static_cast<uint8_t>(std::clamp(average * 255.0 + 0.5, 0.0, 255.0));
+			}
+		}
+	}
+	return dst;
+}
+
+/**
+ * @brief Compares each level of a chain with the reference filter applied to the level above it.
+ *        Comparing with a chain filtered from the base instead would let rounding differences add up over the levels.
+ * @return The largest difference between a channel of the chain and the reference
+ */
+int compare_levels(const uint8_t *chain, const std::vector<vkb::sg::MipLevelLayout> &levels, bool srgb)
+{
+	int max_difference = 0;
+	for (size_t level = 1; level < levels.size(); ++level)
+	{
+		auto &src      = levels[level - 1];
+		auto  expected = downsample_reference(chain + src.offset, src.width, src.height, srgb);
+
+		if (expected.size() != levels[level].get_size())
+		{
+			return 256;
+		}
+
+		for (size_t i = 0; i < expected.size(); ++i)
+		{
+			max_difference = std::max(max_difference, std::abs(int(chain[levels[level].offset + i]) - int(expected[i])));
+		}
+	}
+	return max_difference;
+}
+
+/**
+ * @return The largest difference between a level of the image and the reference filter, or 256 if the image
+ *         doesn't have the levels and offsets of a full chain
+ */
+int compare_mipmaps(const vkb::sg::Image &image, bool srgb)
+{
+	auto &extent  = image.get_extent();
+	auto &mipmaps = image.get_mipmaps();
+	auto  levels  = vkb::sg::get_mip_chain_layout(extent.width, extent.height);
+
+	if (mipmaps.size() != levels.size() || image.get_data().size() < levels.back().offset + levels.back().get_size())
+	{
+		return 256;
+	}
+	for (size_t level = 0; level < levels.size(); ++level)
+	{
+		if (mipmaps[level].offset != levels[level].offset || mipmaps[level].extent.width != levels[level].width ||
+		    mipmaps[level].extent.height != levels[level].height)
+		{
+			return 256;
+		}
+	}
+
+	return compare_levels(image.get_data().data(), levels, srgb);
+}
+}        // namespace
+
+BENCH_CASE(image_decode)
+{
+	// An odd size, so that the decoder handles rows that are not a multiple of anything
+	const uint32_t width  = 67;
+	const uint32_t height = 45;
+
+	auto pixels = make_pixels(width, height, 1);
+	auto png    = encode_png(pixels, width, height);
+
+	vkb::sg::Stb color{"color.png", png, vkb::sg::Image::Color};
+	BENCH_CHECK(color.get_format() == VK_FORMAT_R8G8B8A8_SRGB);
+	BENCH_CHECK(color.get_extent().width == width && color.get_extent().height == height && color.get_extent().depth == 1);
+	BENCH_CHECK(color.get_data() == pixels);
+
+	vkb::sg::Stb other{"other.png", png, vkb::sg::Image::Unknown};
+	BENCH_CHECK(other.get_format() == VK_FORMAT_R8G8B8A8_UNORM);
+	BENCH_CHECK(other.get_data() == pixels);
+
+	// Corrupt data is reported rather than decoded
+	auto corrupt = png;
+	corrupt.resize(corrupt.size() / 2);
+	bool threw = false;
+	try
+	{
+		vkb::sg::Stb truncated{"truncated.png", corrupt, vkb::sg::Image::Unknown};
+	}
+	catch (const std::runtime_error &)
+	{
+		threw = true;
+	}
+	BENCH_CHECK(threw);
+
+	auto large_pixels = make_pixels(512, 512, 2);
+	auto large_png    = encode_png(large_pixels, 512, 512);
+
+	context.measure("sg::Stb, 512x512 PNG, per texel", 512 * 512, [&]() {
+		vkb::sg::Stb image{"large.png", large_png, vkb::sg::Image::Unknown};
+		vkb::bench::do_not_optimize(image.get_data().front());
+	});
+}
+
+BENCH_CASE(image_mipmaps)
+{
+	// Odd sizes reach levels a single texel wide before they are a single texel high
+	const uint32_t width  = 67;
+	const uint32_t height = 9;
+
+	auto pixels = make_pixels(width, height, 3);
+	auto png    = encode_png(pixels, width, height);
+
+	// Linear data is averaged as is
+	{
+		vkb::sg::Stb image{"linear.png", png, vkb::sg::Image::Unknown};
+		image.generate_mipmaps();
+
+		BENCH_CHECK(std::equal(pixels.begin(), pixels.end(), image.get_data().begin()));
+		BENCH_CHECK(compare_mipmaps(image, false) <= 1);
+	}
+
+	// Color data is averaged in linear space, whether its format says so or only its content type does
+	{
+		vkb::sg::Stb srgb_image{"srgb.png", png, vkb::sg::Image::Color};
+		srgb_image.generate_mipmaps();
+		BENCH_CHECK(compare_mipmaps(srgb_image, true) <= 1);
+
+		vkb::sg::Stb unorm_image{"color.png", png, vkb::sg::Image::Unknown};
+		unorm_image.generate_mipmaps(nullptr, vkb::sg::Image::Color);
+		BENCH_CHECK(unorm_image.get_format() == VK_FORMAT_R8G8B8A8_UNORM);
+		BENCH_CHECK(compare_mipmaps(unorm_image, true) <= 1);
+		BENCH_CHECK(unorm_image.get_data() == srgb_image.get_data());
+	}
+
+	// A chain generated while decoding, as the glTF loader asks for, matches one generated afterwards
+	for (auto content_type : {vkb::sg::Image::Unknown, vkb::sg::Image::Color})
+	{
+		vkb::sg::Stb decoded{"decoded.png", png, vkb::sg::Image::Unknown, nullptr, content_type};
+		BENCH_CHECK(decoded.get_mipmaps().size() == vkb::sg::get_mip_chain_layout(width, height).size());
+
+		vkb::sg::Stb generated{"generated.png", png, vkb::sg::Image::Unknown};
+		generated.generate_mipmaps(nullptr, content_type);
+
+		BENCH_CHECK(decoded.get_data() == generated.get_data());
+		BENCH_CHECK(decoded.get_data_hash() == generated.get_data_hash());
+	}
+
+	// Splitting large levels across workers doesn't change the result
+	vkb::ThreadPool thread_pool{4};
+	{
+		auto large_pixels = make_pixels(1024, 768, 4);
+		auto large_png    = encode_png(large_pixels, 1024, 768);
+
+		for (auto content_type : {vkb::sg::Image::Unknown, vkb::sg::Image::Color})
+		{
+			vkb::sg::Stb serial{"serial.png", large_png, vkb::sg::Image::Unknown};
+			serial.generate_mipmaps(nullptr, content_type);
+
+			vkb::sg::Stb threaded{"threaded.png", large_png, vkb::sg::Image::Unknown};
+			threaded.generate_mipmaps(&thread_pool, content_type);
+
+			BENCH_CHECK(serial.get_data() == threaded.get_data());
+		}
+	}
+}
+
+BENCH_CASE(mip_chain)
+{
+	// Every shape of level: square, wider or higher than square, odd, and a single texel wide or high
+	const std::pair<uint32_t, uint32_t> sizes[] = {{1, 1}, {2, 2}, {1, 13}, {13, 1}, {3, 5}, {64, 64}, {100, 37}, {37, 100}, {513, 257}};
+
+	for (auto [width, height] : sizes)
+	{
+		auto levels = vkb::sg::get_mip_chain_layout(width, height);
+		auto pixels = make_pixels(width, height, width * 1000 + height);
+
+		// Down to 1x1, each level halving the one above it
+		BENCH_CHECK(levels.back().width == 1 && levels.back().height == 1);
+		BENCH_CHECK(levels.size() == 1 + static_cast<size_t>(std::log2(std::max(width, height))));
+
+		for (bool srgb : {false, true})
+		{
+			std::vector<uint8_t> chain(levels.back().offset + levels.back().get_size());
+			std::copy(pixels.begin(), pixels.end(), chain.begin());
+			vkb::sg::generate_mip_chain(chain.data(), levels, srgb);
+
+			BENCH_CHECK(compare_levels(chain.data(), levels, srgb) <= 1);
+
+			// Generating the mips apart from the base level, as for staging memory, gives the same levels
+			std::vector<uint8_t> mips(chain.size() - pixels.size());
+			vkb::sg::generate_mip_levels(pixels.data(), mips.data(), levels, srgb);
+			BENCH_CHECK(std::equal(mips.begin(), mips.end(), chain.begin() + pixels.size()));
+		}
+	}
+
+	vkb::ThreadPool thread_pool{4};
+
+	std::vector<uint32_t> measured_sizes{256, 1024};
+	if (!context.is_quick())
+	{
+		measured_sizes.push_back(4096);
+	}
+
+	for (auto size : measured_sizes)
+	{
+		auto levels = vkb::sg::get_mip_chain_layout(size, size);
+		auto base   = make_pixels(size, size, size);
+
+		std::vector<uint8_t> chain(levels.back().offset + levels.back().get_size());
+		std::copy(base.begin(), base.end(), chain.begin());
+
+		auto name   = std::to_string(size) + "x" + std::to_string(size);
+		auto texels = uint64_t(size) * size;
+
+		context.measure("mip chain of a " + name + " UNORM image, per base texel", texels, [&]() {
+			vkb::sg::generate_mip_chain(chain.data(), levels, false);
+			vkb::bench::do_not_optimize(chain.back());
+		});
+
+		context.measure("mip chain of a " + name + " sRGB image, per base texel", texels, [&]() {
+			vkb::sg::generate_mip_chain(chain.data(), levels, true);
+			vkb::bench::do_not_optimize(chain.back());
+		});
+
+		context.measure("mip chain of a " + name + " UNORM image on 4 workers, per base texel", texels, [&]() {
+			vkb::sg::generate_mip_chain(chain.data(), levels, false, &thread_pool);
+			vkb::bench::do_not_optimize(chain.back());
+		});
+	}
+}
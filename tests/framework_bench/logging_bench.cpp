@@ -0,0 +1,173 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <core/util/async_sink.hpp>
+#include <spdlog/logger.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+namespace
+{
+/**
+ * @brief Keeps the messages it receives, optionally taking a while over each one like a slow console
+ */
+class CollectingSink : public spdlog::sinks::base_sink<std::mutex>
+{
+  public:
+	explicit CollectingSink(std::chrono::microseconds delay = {}) :
+	    delay{delay}
+	{}
+
+	std::vector<std::string> messages;
+
+  protected:
+	void sink_it_(const spdlog::details::log_msg &msg) override
+	{
+		messages.emplace_back(msg.payload.data(), msg.payload.size());
+		if (delay.count() > 0)
+		{
+			std::this_thread::sleep_for(delay);
+		}
+	}
+
+	void flush_() override
+	{}
+
+  private:
+	std::chrono::microseconds delay;
+};
+
+/**
+ * @brief Logs from several threads at once and times each call
+ * @return The latencies of all the calls, in nanoseconds
+ */
+std::vector<double> log_from_threads(spdlog::logger &logger, uint32_t thread_count, uint32_t messages_per_thread)
+{
+	std::vector<std::vector<double>> latencies(thread_count);
+	std::vector<std::thread>         threads;
+	for (uint32_t thread_index = 0; thread_index < thread_count; ++thread_index)
+	{
+		threads.emplace_back([&, thread_index]() {
+			auto &thread_latencies = latencies[thread_index];
+			thread_latencies.reserve(messages_per_thread);
+
+			for (uint32_t i = 0; i < messages_per_thread; ++i)
+			{
+				auto start = std::chrono::steady_clock::now();
+				logger.info("Frame {} of thread {}: {} draws in {:.3f} ms", i, thread_index, i * 7 % 1000, i * 0.001);
+				std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+				thread_latencies.push_back(elapsed.count());
+			}
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	std::vector<double> all;
+	for (auto &thread_latencies : latencies)
+	{
+		all.insert(all.end(), thread_latencies.begin(), thread_latencies.end());
+	}
+	return all;
+}
+
+double get_percentile(std::vector<double> &values, double percentile)
+{
+	auto index = static_cast<size_t>(percentile / 100.0 * (values.size() - 1));
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
+}        // namespace
+
+BENCH_CASE(async_log_sink)
+{
+	const uint32_t thread_count        = 4;
+	const uint32_t messages_per_thread = context.is_quick() ? 2000 : 20000;
+
+	// A small queue that blocks when full loses nothing, and keeps the order of the messages of each thread
+	{
+		auto collecting = std::make_shared<CollectingSink>();
+		auto async_sink = std::make_shared<vkb::logging::AsyncSink>(std::vector<spdlog::sink_ptr>{collecting}, vkb::logging::AsyncOptions{64, vkb::logging::OverflowPolicy::Block});
+
+		spdlog::logger logger{"bench", async_sink};
+		log_from_threads(logger, thread_count, messages_per_thread);
+		logger.flush();
+
+		BENCH_CHECK(collecting->messages.size() == size_t(thread_count) * messages_per_thread);
+		BENCH_CHECK(async_sink->get_dropped_count() == 0);
+
+		std::map<std::string, uint32_t> next_frames;
+		uint32_t                        out_of_order_count = 0;
+		for (auto &message : collecting->messages)
+		{
+			auto thread_name = message.substr(message.find(" of thread "), message.find(':') - message.find(" of thread "));
+			auto frame       = static_cast<uint32_t>(std::stoul(message.substr(6)));
+
+			out_of_order_count += frame != next_frames[thread_name] ? 1 : 0;
+			next_frames[thread_name] = frame + 1;
+		}
+		BENCH_CHECK(out_of_order_count == 0);
+	}
+
+	// A queue that drops when full accounts for every message it didn't write
+	{
+		auto collecting = std::make_shared<CollectingSink>(std::chrono::microseconds{20});
+		auto async_sink = std::make_shared<vkb::logging::AsyncSink>(std::vector<spdlog::sink_ptr>{collecting}, vkb::logging::AsyncOptions{16, vkb::logging::OverflowPolicy::Drop});
+
+		spdlog::logger logger{"bench", async_sink};
+		log_from_threads(logger, thread_count, 500);
+		logger.flush();
+
+		BENCH_CHECK(async_sink->get_dropped_count() > 0);
+		BENCH_CHECK(collecting->messages.size() + async_sink->get_dropped_count() == size_t(thread_count) * 500);
+	}
+
+	// Latency of each call from several threads, writing to a file straight away or through the queue
+	auto path = (std::filesystem::temp_directory_path() / "vkb_framework_bench.log").string();
+
+	{
+		auto file_sink  = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path, true);
+		auto async_sink = std::make_shared<vkb::logging::AsyncSink>(std::vector<spdlog::sink_ptr>{file_sink}, vkb::logging::AsyncOptions{8192, vkb::logging::OverflowPolicy::Block});
+
+		spdlog::logger sync_logger{"sync", file_sink};
+		spdlog::logger async_logger{"async", async_sink};
+
+		for (auto logger : {&sync_logger, &async_logger})
+		{
+			auto latencies = log_from_threads(*logger, thread_count, messages_per_thread);
+			logger->flush();
+
+			auto prefix = logger->name() + " file sink, " + std::to_string(thread_count) + " threads, ";
+			context.report(prefix + "p50 per call", get_percentile(latencies, 50.0), "ns");
+			context.report(prefix + "p99 per call", get_percentile(latencies, 99.0), "ns");
+			context.report(prefix + "p99.9 per call", get_percentile(latencies, 99.9), "ns");
+		}
+	}
+
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,268 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <set>
+
+#include <core/util/thread_pool.hpp>
+
+#include "geometry/meshlet_builder.h"
+
+namespace
+{
+struct Mesh
+{
+	std::vector<uint32_t> indices;
+
+	std::vector<glm::vec3> positions;
+};
+
+/**
+ * @brief A wavy grid of quads, with its triangles in random order as exporters that don't optimize meshes leave them
+ */
+Mesh make_grid(uint32_t size, uint32_t seed)
+{
+	Mesh mesh;
+	for (uint32_t y = 0; y <= size; ++y)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			mesh.positions.emplace_back(static_cast<float>(x), static_cast<float>(y), std::sin(x * 0.3f) * std::cos(y * 0.2f) * 2.0f);
+		}
+	}
+
+	std::vector<std::array<uint32_t, 3>> triangles;
+	for (uint32_t y = 0; y < size; ++y)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			uint32_t v = y * (size + 1) + x;
+			triangles.push_back({v, v + 1, v + size + 2});
+			triangles.push_back({v, v + size + 2, v + size + 1});
+		}
+	}
+
+	std::mt19937 random{seed};
+	std::shuffle(triangles.begin(), triangles.end(), random);
+
+	for (auto &triangle : triangles)
+	{
+		mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+	}
+	return mesh;
+}
+
+/**
+ * @brief How the glTF loader split meshes before build_meshlets: runs of consecutive indices, collected in a set,
+ *        cut at 64 vertices or 96 indices, and moved back to the start of a triangle cut in the middle
+ * @return The number of vertices of each meshlet
+ */
+std::vector<uint32_t> split_in_runs(const std::vector<uint32_t> &indices)
+{
+	std::vector<uint32_t> vertex_counts;
+	std::set<uint32_t>    vertices;
+	uint32_t              index_count    = 0;
+	uint32_t              triangle_check = 0;
+
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		vertices.insert(indices[i]);
+		index_count++;
+		triangle_check = triangle_check < 3 ? triangle_check + 1 : 1;
+
+		if (vertices.size() == 64 || index_count == 96 || i == indices.size() - 1)
+		{
+			if (triangle_check != 3)
+			{
+				i -= triangle_check;
+				triangle_check = 0;
+			}
+
+			vertex_counts.push_back(static_cast<uint32_t>(vertices.size()));
+			index_count = 0;
+			vertices.clear();
+		}
+	}
+
+	return vertex_counts;
+}
+
+/**
+ * @brief Counts the ways the meshlets break the contract of MeshletBuffer for a mesh
+ */
+uint32_t count_meshlet_errors(const vkb::MeshletBuffer &meshlets, const Mesh &mesh, const vkb::MeshletLimits &limits)
+{
+	uint32_t errors = 0;
+
+	std::vector<std::array<uint32_t, 3>> triangles;
+	for (size_t m = 0; m < meshlets.size(); ++m)
+	{
+		auto vertex_count   = meshlets.vertex_counts[m];
+		auto triangle_count = meshlets.triangle_counts[m];
+
+		errors += vertex_count > limits.max_vertices || triangle_count > limits.max_triangles || triangle_count == 0 ? 1 : 0;
+
+		auto vertices = meshlets.vertices.data() + meshlets.vertex_offsets[m];
+		auto local    = meshlets.triangles.data() + size_t(meshlets.triangle_offsets[m]) * 3;
+
+		glm::vec3 center{meshlets.bounds[m]};
+		float     radius = meshlets.bounds[m].w;
+
+		for (uint32_t t = 0; t < triangle_count; ++t)
+		{
+			std::array<uint32_t, 3> triangle;
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				if (local[t * 3 + k] >= vertex_count)
+				{
+					++errors;
+					continue;
+				}
+				triangle[k] = vertices[local[t * 3 + k]];
+
+				// The bounding sphere holds every vertex
+				errors += glm::length(mesh.positions[triangle[k]] - center) > radius * 1.0001f + 1e-4f ? 1 : 0;
+			}
+
+			// Rotated so that the lowest index comes first, which keeps the winding
+			std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+			triangles.push_back(triangle);
+		}
+	}
+
+	// Every triangle of the mesh is in exactly one meshlet, with its winding
+	std::vector<std::array<uint32_t, 3>> expected;
+	for (size_t i = 0; i < mesh.indices.size(); i += 3)
+	{
+		std::array<uint32_t, 3> triangle{mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]};
+		std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		expected.push_back(triangle);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	std::sort(expected.begin(), expected.end());
+	errors += triangles != expected ? 1 : 0;
+
+	return errors;
+}
+
+/**
+ * @brief Counts the meshlets that their normal cone culls from a camera while one of their triangles faces it
+ */
+uint32_t count_wrongly_culled(const vkb::MeshletBuffer &meshlets, const Mesh &mesh, const glm::vec3 &camera, uint32_t &culled_count)
+{
+	uint32_t wrongly_culled = 0;
+	for (size_t m = 0; m < meshlets.size(); ++m)
+	{
+		glm::vec3 center{meshlets.bounds[m]};
+		glm::vec3 axis{meshlets.cones[m]};
+		glm::vec3 view = center - camera;
+
+		if (glm::dot(view, axis) < meshlets.cones[m].w * glm::length(view) + meshlets.bounds[m].w)
+		{
+			continue;
+		}
+		++culled_count;
+
+		auto vertices = meshlets.vertices.data() + meshlets.vertex_offsets[m];
+		auto local    = meshlets.triangles.data() + size_t(meshlets.triangle_offsets[m]) * 3;
+		for (uint32_t t = 0; t < meshlets.triangle_counts[m]; ++t)
+		{
+			auto &a = mesh.positions[vertices[local[t * 3 + 0]]];
+			auto &b = mesh.positions[vertices[local[t * 3 + 1]]];
+			auto &c = mesh.positions[vertices[local[t * 3 + 2]]];
+
+			// Counter-clockwise triangles face the camera when their normal points towards it
+			if (glm::dot(glm::cross(b - a, c - a), a - camera) < 0.0f)
+			{
+				++wrongly_culled;
+				break;
+			}
+		}
+	}
+	return wrongly_culled;
+}
+}        // namespace
+
+BENCH_CASE(meshlet_builder)
+{
+	// The limits the glTF loader uses for the mesh shader samples
+	vkb::MeshletLimits limits;
+	limits.max_vertices  = 64;
+	limits.max_triangles = 32;
+
+	auto mesh     = make_grid(context.is_quick() ? 60 : 400, 1);
+	auto meshlets = vkb::build_meshlets({mesh.indices, mesh.positions}, limits);
+
+	BENCH_CHECK(meshlets.size() > 0);
+	BENCH_CHECK(count_meshlet_errors(meshlets, mesh, limits) == 0);
+
+	// Cones only cull meshlets whose triangles all face away, from above the grid, from below, and from the side
+	uint32_t culled_count = 0;
+	for (auto camera : {glm::vec3{30.0f, 30.0f, 50.0f}, glm::vec3{30.0f, 30.0f, -50.0f}, glm::vec3{-40.0f, 10.0f, 3.0f}})
+	{
+		BENCH_CHECK(count_wrongly_culled(meshlets, mesh, camera, culled_count) == 0);
+	}
+	BENCH_CHECK(culled_count > 0);
+
+	// Building several meshes on a pool gives the same meshlets
+	{
+		vkb::ThreadPool thread_pool{4};
+
+		auto other = make_grid(40, 2);
+
+		std::vector<vkb::MeshletSource> sources{{mesh.indices, mesh.positions}, {other.indices, other.positions}};
+
+		auto built = vkb::build_meshlets(sources, thread_pool, limits);
+		BENCH_CHECK(built.size() == 2);
+		BENCH_CHECK(built[0].vertices == meshlets.vertices && built[0].triangles == meshlets.triangles);
+		BENCH_CHECK(count_meshlet_errors(built[1], other, limits) == 0);
+	}
+
+	// Meshlets sharing their vertices need fewer of them, which is what the mesh shader transforms
+	auto     run_vertex_counts = split_in_runs(mesh.indices);
+	uint64_t run_vertices      = 0;
+	for (auto count : run_vertex_counts)
+	{
+		run_vertices += count;
+	}
+
+	BENCH_CHECK(meshlets.vertices.size() < run_vertices);
+
+	auto triangle_count = mesh.indices.size() / 3;
+
+	context.report("triangles", static_cast<double>(triangle_count), "triangles");
+	context.report("meshlets, build_meshlets", static_cast<double>(meshlets.size()), "meshlets");
+	context.report("meshlets, runs of triangles", static_cast<double>(run_vertex_counts.size()), "meshlets");
+	context.report("vertices per meshlet, build_meshlets", static_cast<double>(meshlets.vertices.size()) / meshlets.size(), "vertices");
+	context.report("vertices per meshlet, runs of triangles", static_cast<double>(run_vertices) / run_vertex_counts.size(), "vertices");
+
+	context.measure("build_meshlets, per triangle", triangle_count, [&]() {
+		auto built = vkb::build_meshlets({mesh.indices, mesh.positions}, limits);
+		vkb::bench::do_not_optimize(built.vertices.size());
+	});
+
+	context.measure("runs of triangles, per triangle", triangle_count, [&]() {
+		auto counts = split_in_runs(mesh.indices);
+		vkb::bench::do_not_optimize(counts.size());
+	});
+}
@@ -0,0 +1,253 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+#include <core/util/thread_pool.hpp>
+
+#include "resource_cache.h"
+
+namespace
+{
+struct Resource
+{
+	uint64_t value;
+};
+
+/**
+ * @brief The map the ResourceCache kept per resource type before it was sharded: one mutex for all lookups
+ */
+class LockedMap
+{
+  public:
+	Resource *find(size_t hash)
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+
+		auto it = resources.find(hash);
+		return it != resources.end() ? &it->second : nullptr;
+	}
+
+	void insert(size_t hash, Resource resource)
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		resources.emplace(hash, resource);
+	}
+
+  private:
+	std::mutex mutex;
+
+	std::unordered_map<size_t, Resource> resources;
+};
+
+std::vector<size_t> make_keys(size_t count, uint32_t seed)
+{
+	std::mt19937_64     random{seed};
+	std::vector<size_t> keys(count);
+	for (auto &key : keys)
+	{
+		key = static_cast<size_t>(random());
+	}
+	return keys;
+}
+
+/**
+ * @brief Looks every key up from several threads at once, as recording threads hitting the cache do
+ * @return The sum of the values found, so that the lookups are not optimized away
+ */
+template <typename Map>
+uint64_t look_up_from_threads(Map &map, const std::vector<size_t> &keys, uint32_t thread_count, uint32_t lookups_per_thread)
+{
+	std::atomic<uint64_t>    total{0};
+	std::vector<std::thread> threads;
+	for (uint32_t thread_index = 0; thread_index < thread_count; ++thread_index)
+	{
+		threads.emplace_back([&, thread_index]() {
+			uint64_t sum = 0;
+			for (uint32_t i = 0; i < lookups_per_thread; ++i)
+			{
+				// Each thread walks the keys from its own offset, so that threads don't all hit the same shard together
+				if (auto resource = map.find(keys[(i + thread_index * 97) % keys.size()]))
+				{
+					sum += resource->value;
+				}
+			}
+			total += sum;
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+	return total;
+}
+}        // namespace
+
+BENCH_CASE(resource_cache_hits)
+{
+	auto keys = make_keys(1024, 1);
+
+	// Threads racing on the same misses create each resource once, and all get the stored one
+	{
+		vkb::ShardedResourceMap<Resource> map;
+
+		std::atomic<uint32_t> create_count{0};
+		std::atomic<uint32_t> mismatch_count{0};
+
+		std::vector<std::thread> threads;
+		for (uint32_t thread_index = 0; thread_index < 8; ++thread_index)
+		{
+			threads.emplace_back([&]() {
+				for (auto key : keys)
+				{
+					auto create = [&]() {
+						create_count++;
+						return Resource{key};
+					};
+
+					auto &resource = map.find_or_create(key, create, [](Resource &) {});
+					if (resource.value != key || map.find(key) != &resource)
+					{
+						mismatch_count++;
+					}
+				}
+			});
+		}
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		BENCH_CHECK(create_count == keys.size());
+		BENCH_CHECK(mismatch_count == 0);
+		BENCH_CHECK(map.size() == keys.size());
+	}
+
+	vkb::ShardedResourceMap<Resource> sharded_map;
+	LockedMap                         locked_map;
+	for (auto key : keys)
+	{
+		sharded_map.insert(key, Resource{key}, [](Resource &) {});
+		locked_map.insert(key, Resource{key});
+	}
+
+	const uint32_t lookups_per_thread = 1 << 16;
+
+	context.report("hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "threads");
+
+	// Times are per lookup over all threads, so perfect scaling divides them by the thread count
+	double sharded_single = 0.0;
+	double locked_single  = 0.0;
+	for (uint32_t thread_count : {1u, 2u, 4u, 8u})
+	{
+		auto suffix = ", " + std::to_string(thread_count) + " threads, per lookup";
+
+		double sharded = context.measure("ShardedResourceMap hit" + suffix, uint64_t(thread_count) * lookups_per_thread, [&]() {
+			vkb::bench::do_not_optimize(look_up_from_threads(sharded_map, keys, thread_count, lookups_per_thread));
+		});
+
+		double locked = context.measure("single mutex map hit" + suffix, uint64_t(thread_count) * lookups_per_thread, [&]() {
+			vkb::bench::do_not_optimize(look_up_from_threads(locked_map, keys, thread_count, lookups_per_thread));
+		});
+
+		if (thread_count == 1)
+		{
+			sharded_single = sharded;
+			locked_single  = locked;
+		}
+		else
+		{
+			context.report("ShardedResourceMap hit throughput, " + std::to_string(thread_count) + " threads over 1", sharded_single / sharded, "x");
+			context.report("single mutex map hit throughput, " + std::to_string(thread_count) + " threads over 1", locked_single / locked, "x");
+		}
+	}
+}
+
+BENCH_CASE(resource_cache_insert)
+{
+	auto keys = make_keys(1024, 2);
+
+	// Background compiles insert what they created without the creation lock, racing draws that create on a miss.
+	// Each key keeps the first resource stored, which is recorded once, and every thread gets that one.
+	vkb::ShardedResourceMap<Resource> map;
+
+	std::atomic<uint32_t> recorded_count{0};
+	std::atomic<uint32_t> mismatch_count{0};
+
+	std::vector<std::thread> threads;
+	for (uint32_t thread_index = 0; thread_index < 8; ++thread_index)
+	{
+		threads.emplace_back([&, thread_index]() {
+			auto record = [&](Resource &) { recorded_count++; };
+
+			for (auto key : keys)
+			{
+				Resource *resource;
+				if (thread_index % 2 == 0)
+				{
+					resource = &map.insert(key, Resource{key}, record);
+				}
+				else
+				{
+					resource = &map.find_or_create(key, [&]() { return Resource{key}; }, record);
+				}
+
+				if (resource->value != key || map.find(key) != resource)
+				{
+					mismatch_count++;
+				}
+			}
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	BENCH_CHECK(recorded_count == keys.size());
+	BENCH_CHECK(mismatch_count == 0);
+	BENCH_CHECK(map.size() == keys.size());
+
+	// The cost a background compile pays when a draw created the same pipeline first
+	context.measure("ShardedResourceMap insert of a stored key, per insert", keys.size(), [&]() {
+		for (auto key : keys)
+		{
+			vkb::bench::do_not_optimize(map.insert(key, Resource{0}, [](Resource &) {}).value);
+		}
+	});
+}
+
+BENCH_CASE(pipeline_compile_worker_detection)
+{
+	// Draws in PipelineCompileMode::Wait recorded on a worker compile the pipeline themselves rather than wait for a job
+	vkb::ThreadPool thread_pool{2};
+	vkb::ThreadPool other_thread_pool{1};
+
+	BENCH_CHECK(!thread_pool.is_worker_thread());
+
+	BENCH_CHECK(thread_pool.push([&]() { return thread_pool.is_worker_thread(); }).get());
+	BENCH_CHECK(!other_thread_pool.push([&]() { return thread_pool.is_worker_thread(); }).get());
+
+	// A task of one pool pushing to another is not a worker of that one, so it can wait for it
+	BENCH_CHECK(!thread_pool.push([&]() { return other_thread_pool.push([&]() { return thread_pool.is_worker_thread(); }).get(); }).get());
+}
@@ -0,0 +1,164 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#include <core/util/hash.hpp>
+
+#include "shader_reflection_cache.h"
+#include "spirv_reflection.h"
+
+namespace
+{
+/**
+ * @brief Reads a precompiled shader of the shaders directory of the repository
+ */
+std::vector<uint32_t> read_spirv(const std::string &filename)
+{
+	std::ifstream file{std::string{VKB_BENCH_SHADER_DIR} + "/" + filename, std::ios::binary};
+	if (!file)
+	{
+		throw std::runtime_error{"Failed to open " + filename};
+	}
+
+	std::vector<char> bytes{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	if (bytes.empty() || bytes.size() % sizeof(uint32_t) != 0)
+	{
+		throw std::runtime_error{filename + " is not SPIR-V"};
+	}
+
+	std::vector<uint32_t> spirv(bytes.size() / sizeof(uint32_t));
+	std::memcpy(spirv.data(), bytes.data(), bytes.size());
+	return spirv;
+}
+
+bool is_equal(const vkb::ShaderResource &a, const vkb::ShaderResource &b)
+{
+	return a.stages == b.stages && a.type == b.type && a.mode == b.mode && a.set == b.set && a.binding == b.binding &&
+	       a.location == b.location && a.input_attachment_index == b.input_attachment_index && a.vec_size == b.vec_size &&
+	       a.columns == b.columns && a.array_size == b.array_size && a.offset == b.offset && a.size == b.size &&
+	       a.constant_id == b.constant_id && a.qualifiers == b.qualifiers && a.name == b.name;
+}
+
+bool is_equal(const std::vector<vkb::ShaderResource> &a, const std::vector<vkb::ShaderResource> &b)
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		if (!is_equal(a[i], b[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+}        // namespace
+
+BENCH_CASE(shader_reflection_cache)
+{
+	struct Shader
+	{
+		const char *filename;
+
+		VkShaderStageFlagBits stage;
+	};
+
+	const Shader shaders[] = {{"base.vert.spv", VK_SHADER_STAGE_VERTEX_BIT}, {"base.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT}};
+
+	auto &cache = vkb::ShaderReflectionCache::get();
+	cache.clear();
+
+	vkb::ShaderVariant variant;
+
+	for (auto &shader : shaders)
+	{
+		auto spirv = read_spirv(shader.filename);
+		auto key   = vkb::ShaderReflectionCache::get_key(vkb::hash_bytes(spirv.data(), spirv.size() * sizeof(uint32_t)), shader.stage, variant);
+
+		std::vector<vkb::ShaderResource> expected;
+		vkb::SPIRVReflection             spirv_reflection;
+		BENCH_CHECK(spirv_reflection.reflect_shader_resources(shader.stage, spirv, expected, variant));
+		BENCH_CHECK(!expected.empty());
+
+		// A miss reflects the shader, a second request is served from memory, both with the resources of a direct reflection
+		vkb::ShaderReflectionCache::set_disk_cache_enabled(false);
+		{
+			auto stats = cache.get_stats();
+
+			std::vector<vkb::ShaderResource> missed;
+			BENCH_CHECK(cache.reflect_shader_resources(key, shader.stage, spirv, missed, variant));
+			BENCH_CHECK(is_equal(missed, expected));
+			BENCH_CHECK(cache.get_stats().misses == stats.misses + 1);
+
+			std::vector<vkb::ShaderResource> hit;
+			BENCH_CHECK(cache.reflect_shader_resources(key, shader.stage, spirv, hit, variant));
+			BENCH_CHECK(is_equal(hit, expected));
+			BENCH_CHECK(cache.get_stats().memory_hits == stats.memory_hits + 1);
+		}
+
+		// The entry round-trips through its file. The first request writes the file unless a previous run did,
+		// the second one has nothing in memory and must read it back.
+		vkb::ShaderReflectionCache::set_disk_cache_enabled(true);
+		{
+			std::vector<vkb::ShaderResource> resources;
+
+			cache.clear();
+			BENCH_CHECK(cache.reflect_shader_resources(key, shader.stage, spirv, resources, variant));
+			BENCH_CHECK(is_equal(resources, expected));
+
+			auto stats = cache.get_stats();
+
+			cache.clear();
+			resources.clear();
+			BENCH_CHECK(cache.reflect_shader_resources(key, shader.stage, spirv, resources, variant));
+			BENCH_CHECK(is_equal(resources, expected));
+			BENCH_CHECK(cache.get_stats().disk_hits == stats.disk_hits + 1);
+			BENCH_CHECK(cache.get_stats().misses == stats.misses);
+		}
+		vkb::ShaderReflectionCache::set_disk_cache_enabled(false);
+	}
+
+	auto spirv = read_spirv("base.frag.spv");
+	auto key   = vkb::ShaderReflectionCache::get_key(vkb::hash_bytes(spirv.data(), spirv.size() * sizeof(uint32_t)), VK_SHADER_STAGE_FRAGMENT_BIT, variant);
+
+	std::vector<vkb::ShaderResource> resources;
+
+	context.measure("SPIRVReflection::reflect_shader_resources, base.frag", 1, [&]() {
+		vkb::SPIRVReflection spirv_reflection;
+		spirv_reflection.reflect_shader_resources(VK_SHADER_STAGE_FRAGMENT_BIT, spirv, resources, variant);
+		vkb::bench::do_not_optimize(resources.size());
+	});
+
+	context.measure("ShaderReflectionCache memory hit, base.frag", 1, [&]() {
+		cache.reflect_shader_resources(key, VK_SHADER_STAGE_FRAGMENT_BIT, spirv, resources, variant);
+		vkb::bench::do_not_optimize(resources.size());
+	});
+
+	context.measure("ShaderReflectionCache key, base.frag", 1, [&]() {
+		vkb::bench::do_not_optimize(vkb::ShaderReflectionCache::get_key(vkb::hash_bytes(spirv.data(), spirv.size() * sizeof(uint32_t)), VK_SHADER_STAGE_FRAGMENT_BIT, variant));
+	});
+
+	cache.clear();
+}
@@ -0,0 +1,360 @@
+/* Copyright (c) 2026, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "stats/frame_time_summary.h"
+#include "stats/pipeline_stats_provider.h"
+#include "stats/stats_exporter.h"
+#include "stats/stats_ring.h"
+
+namespace
+{
+vkb::StatsSample make_sample(uint32_t i)
+{
+	vkb::StatsSample sample;
+	sample.time = i * 0.001;
+	sample.set(vkb::StatIndex::frame_times, 0.016 + (i % 7) * 0.001);
+	sample.set(vkb::StatIndex::gpu_cycles, static_cast<double>(i));
+
+	// Some stats are only set in some samples, as when a provider samples slower than the others
+	if (i % 3 == 0)
+	{
+		sample.set(vkb::StatIndex::visible_instances, static_cast<double>(i % 1000));
+	}
+	return sample;
+}
+
+std::vector<std::string> read_lines(const std::string &path)
+{
+	std::ifstream            file{path};
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(file, line);)
+	{
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+/**
+ * @brief Counts the lines of a Chrome trace that are not one counter event object, with an optional comma
+ */
+uint32_t count_malformed_events(const std::vector<std::string> &lines, size_t begin, size_t end)
+{
+	uint32_t malformed_count = 0;
+	for (size_t i = begin; i < end; ++i)
+	{
+		auto event = lines[i];
+		if (!event.empty() && event.back() == ',')
+		{
+			event.pop_back();
+		}
+
+		int  depth    = 0;
+		bool balanced = true;
+		for (auto c : event)
+		{
+			depth += c == '{' ? 1 : c == '}' ? -1 :
+			                                   0;
+			balanced = balanced && depth >= 0;
+		}
+
+		bool is_event = event.starts_with("{\"name\":\"") && event.ends_with("}}") && event.find("\"ph\":\"C\"") != std::string::npos;
+		malformed_count += !balanced || depth != 0 || !is_event ? 1 : 0;
+	}
+	return malformed_count;
+}
+}        // namespace
+
+BENCH_CASE(stats_ring)
+{
+	// The sampling thread and the frame thread see every sample, in order
+	{
+		vkb::StatsRing ring{100};
+		BENCH_CHECK(ring.get_capacity() == 128);
+
+		const uint32_t sample_count = context.is_quick() ? 20000 : 2000000;
+
+		std::thread producer{[&]() {
+			for (uint32_t i = 0; i < sample_count; ++i)
+			{
+				while (!ring.push(make_sample(i)))
+				{
+					std::this_thread::yield();
+				}
+			}
+		}};
+
+		uint32_t         mismatch_count = 0;
+		vkb::StatsSample sample;
+		for (uint32_t i = 0; i < sample_count;)
+		{
+			if (!ring.pop(sample))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			auto expected = make_sample(i++);
+			mismatch_count += sample.time != expected.time || sample.values != expected.values || sample.valid != expected.valid ? 1 : 0;
+		}
+		producer.join();
+
+		BENCH_CHECK(mismatch_count == 0);
+		BENCH_CHECK(ring.size() == 0);
+	}
+
+	// A full ring drops the new samples and counts them, and keeps the ones it holds
+	{
+		vkb::StatsRing ring{4};
+		for (uint32_t i = 0; i < 6; ++i)
+		{
+			ring.push(make_sample(i));
+		}
+		BENCH_CHECK(ring.size() == 4);
+		BENCH_CHECK(ring.get_dropped_count() == 2);
+
+		vkb::StatsSample sample;
+		BENCH_CHECK(ring.pop(sample) && sample.time == make_sample(0).time);
+		BENCH_CHECK(ring.push(make_sample(6)) && ring.size() == 4);
+	}
+
+	vkb::StatsRing   ring{1024};
+	vkb::StatsSample sample = make_sample(1);
+	vkb::StatsSample popped;
+
+	context.measure("push and pop, one thread, per sample", 1000, [&]() {
+		for (uint32_t i = 0; i < 1000; ++i)
+		{
+			ring.push(sample);
+			ring.pop(popped);
+		}
+		vkb::bench::do_not_optimize(popped.time);
+	});
+}
+
+BENCH_CASE(stats_export)
+{
+	std::vector<vkb::StatsExporter::Column> columns{{vkb::StatIndex::frame_times, "Frame Times (ms)", 1000.0f},
+	                                                {vkb::StatIndex::gpu_cycles, "GPU Cycles (M/s)", 1e-6f},
+	                                                {vkb::StatIndex::visible_instances, "Visible Instances"}};
+
+	auto directory = std::filesystem::temp_directory_path();
+	auto csv_path  = (directory / "vkb_framework_bench_stats.csv").string();
+	auto json_path = (directory / "vkb_framework_bench_stats.json").string();
+
+	BENCH_CHECK(vkb::StatsExporter::get_format(csv_path) == vkb::StatsExportFormat::Csv);
+	BENCH_CHECK(vkb::StatsExporter::get_format(json_path) == vkb::StatsExportFormat::ChromeTrace);
+
+	const uint32_t sample_count = 300;
+
+	// A header row, then a row per sample with an empty field for each stat that was not set
+	{
+		vkb::StatsExporter exporter{csv_path, vkb::StatsExportFormat::Csv, columns};
+		for (uint32_t i = 0; i < sample_count; ++i)
+		{
+			exporter.write(make_sample(i));
+		}
+	}
+	{
+		auto lines = read_lines(csv_path);
+		BENCH_CHECK(lines.size() == sample_count + 1);
+		BENCH_CHECK(lines[0] == "\"Time (s)\",\"Frame Times (ms)\",\"GPU Cycles (M/s)\",\"Visible Instances\"");
+		BENCH_CHECK(lines[1] == "0.000000,16,0,0");
+		BENCH_CHECK(lines[2] == "0.001000,17,1e-06,");
+	}
+
+	// An array with an event per stat set in each sample
+	{
+		vkb::StatsExporter exporter{json_path, vkb::StatsExportFormat::ChromeTrace, columns};
+		for (uint32_t i = 0; i < sample_count; ++i)
+		{
+			exporter.write(make_sample(i));
+		}
+	}
+	{
+		auto lines       = read_lines(json_path);
+		auto event_count = sample_count * 2 + sample_count / 3;
+		BENCH_CHECK(lines.size() == event_count + 2);
+		BENCH_CHECK(lines.front() == "[" && lines.back() == "]");
+		BENCH_CHECK(count_malformed_events(lines, 1, lines.size() - 1) == 0);
+		BENCH_CHECK(lines[1] == "{\"name\":\"Frame Times (ms)\",\"ph\":\"C\",\"ts\":0.000,\"pid\":1,\"tid\":1,\"args\":{\"value\":16}},");
+		BENCH_CHECK(lines[lines.size() - 2].back() == '}');
+	}
+
+	auto sample = make_sample(3);
+
+	for (auto format : {vkb::StatsExportFormat::Csv, vkb::StatsExportFormat::ChromeTrace})
+	{
+		auto path = format == vkb::StatsExportFormat::Csv ? csv_path : json_path;
+		auto name = format == vkb::StatsExportFormat::Csv ? std::string{"CSV"} : std::string{"Chrome trace"};
+
+		vkb::StatsExporter exporter{path, format, columns};
+		context.measure(name + " write, per sample", 1000, [&]() {
+			for (uint32_t i = 0; i < 1000; ++i)
+			{
+				exporter.write(sample);
+			}
+		});
+	}
+
+	std::filesystem::remove(csv_path);
+	std::filesystem::remove(json_path);
+}
+
+BENCH_CASE(frame_time_summary)
+{
+	auto is_near = [](float value, float expected) { return std::abs(value - expected) < 1e-3f; };
+
+	// No frames, as when an app closes during its warm-up
+	{
+		auto summary = vkb::summarize_frame_times({});
+		BENCH_CHECK(summary.frame_count == 0);
+		BENCH_CHECK(summary.histogram.size() == vkb::FRAME_TIME_HISTOGRAM_BOUNDS_MS.size() + 1);
+	}
+
+	// Nearest-rank percentiles of 1 to 100 ms, given in any order
+	{
+		std::vector<float> frame_times;
+		for (uint32_t i = 100; i > 0; --i)
+		{
+			frame_times.push_back(((i * 37) % 100 + 1) * 0.001f);
+		}
+
+		auto summary = vkb::summarize_frame_times(frame_times);
+		BENCH_CHECK(summary.frame_count == 100);
+		BENCH_CHECK(is_near(summary.mean, 50.5f) && is_near(summary.min, 1.0f) && is_near(summary.max, 100.0f));
+		BENCH_CHECK(is_near(summary.p50, 50.0f) && is_near(summary.p95, 95.0f) && is_near(summary.p99, 99.0f));
+
+		uint32_t histogram_total = 0;
+		for (auto count : summary.histogram)
+		{
+			histogram_total += count;
+		}
+		BENCH_CHECK(histogram_total == 100);
+	}
+
+	// A single frame is every percentile
+	{
+		auto summary = vkb::summarize_frame_times({0.0125f});
+		BENCH_CHECK(is_near(summary.p50, 12.5f) && is_near(summary.p99, 12.5f) && is_near(summary.max, 12.5f));
+	}
+
+	// Buckets include their upper bound, and the last one takes everything above the last bound
+	{
+		auto summary = vkb::summarize_frame_times({0.0166f, 0.0168f, 0.6f});
+		BENCH_CHECK(summary.histogram[3] == 1 && summary.histogram[4] == 1 && summary.histogram.back() == 1);
+	}
+
+	// Deviation of the means of the runs, skipping runs without frames
+	{
+		std::vector<vkb::FrameTimeSummary> runs{vkb::summarize_frame_times({0.010f}),
+		                                        vkb::summarize_frame_times({}),
+		                                        vkb::summarize_frame_times({0.011f, 0.013f}),
+		                                        vkb::summarize_frame_times({0.014f})};
+		BENCH_CHECK(is_near(vkb::get_mean_stddev(runs), 2.0f));
+		BENCH_CHECK(vkb::get_mean_stddev({runs[0], runs[1]}) == 0.0f);
+	}
+
+	// A run of 10000 frames of 15 to 19 ms with some hitches
+	std::vector<float> frame_times;
+	for (uint32_t i = 0; i < 10000; ++i)
+	{
+		frame_times.push_back(i % 500 == 0 ? 0.05f : 0.015f + (i * 7919 % 4000) * 1e-6f);
+	}
+
+	context.measure("summarize_frame_times, 10000 frames, per frame", frame_times.size(), [&]() {
+		auto summary = vkb::summarize_frame_times(frame_times);
+		vkb::bench::do_not_optimize(summary.p99);
+	});
+}
+
+BENCH_CASE(pipeline_stats)
+{
+	vkb::PipelineCounters counters;
+
+	std::set<vkb::StatIndex>   requested_stats{vkb::StatIndex::frame_times, vkb::StatIndex::pipeline_compile_time, vkb::StatIndex::pipeline_stall_frames};
+	vkb::PipelineStatsProvider provider{requested_stats, counters};
+
+	BENCH_CHECK(requested_stats == std::set<vkb::StatIndex>{vkb::StatIndex::frame_times});
+	BENCH_CHECK(provider.is_available(vkb::StatIndex::pipeline_compile_time) && provider.is_available(vkb::StatIndex::pipeline_stall_frames));
+
+	// A frame with several stalls counts once
+	counters.add_compile(2.0);
+	counters.add_compile(4.0);
+	counters.add_frame();
+	counters.add_stall();
+	counters.add_stall();
+	counters.add_frame();
+	counters.add_frame();
+	counters.add_frame();
+
+	auto counters_sampled = provider.sample(0.016f);
+	BENCH_CHECK(std::abs(counters_sampled[vkb::StatIndex::pipeline_compile_time].result - 3.0) < 1e-9);
+	BENCH_CHECK(counters_sampled[vkb::StatIndex::pipeline_stall_frames].result == 0.25);
+
+	// Without new compiles the last compile time is kept, and frames without stalls bring the share back to 0
+	counters.add_frame();
+	counters_sampled = provider.sample(0.016f);
+	BENCH_CHECK(std::abs(counters_sampled[vkb::StatIndex::pipeline_compile_time].result - 3.0) < 1e-9);
+	BENCH_CHECK(counters_sampled[vkb::StatIndex::pipeline_stall_frames].result == 0.0);
+
+	// Continuous samples taken between frames repeat the values of the last frame
+	counters.add_stall();
+	counters.add_frame();
+
+	vkb::StatsSample sample;
+	provider.continuous_sample(0.001f, sample);
+	provider.continuous_sample(0.001f, sample);
+	BENCH_CHECK(sample.has(vkb::StatIndex::pipeline_stall_frames) && sample.get(vkb::StatIndex::pipeline_stall_frames) == 1.0);
+
+	// Workers report their compiles concurrently
+	{
+		std::vector<std::thread> threads;
+		for (uint32_t thread_index = 0; thread_index < 4; ++thread_index)
+		{
+			threads.emplace_back([&]() {
+				for (uint32_t i = 0; i < 1000; ++i)
+				{
+					counters.add_compile(0.5);
+				}
+			});
+		}
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+	}
+	BENCH_CHECK(counters.compile_count == 4000);
+	counters.add_frame();
+	counters_sampled = provider.sample(0.016f);
+	BENCH_CHECK(std::abs(counters_sampled[vkb::StatIndex::pipeline_compile_time].result - 0.5) < 1e-9);
+
+	context.measure("PipelineCounters add_compile, per compile", 1000, [&]() {
+		for (uint32_t i = 0; i < 1000; ++i)
+		{
+			counters.add_compile(0.5);
+		}
+	});
+}